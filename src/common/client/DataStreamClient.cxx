@@ -0,0 +1,449 @@
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include <google/protobuf/duration.pb.h>
+#include <google/protobuf/timestamp.pb.h>
+#include <google/protobuf/util/time_util.h>
+#include <grpcpp/alarm.h>
+#include <grpcpp/support/status.h>
+#include <microsoft/net/remote/DataStreamClient.hxx>
+#include <microsoft/net/remote/datastream/LatencyStatistics.hxx>
+#include <microsoft/net/remote/datastream/RandomDataGenerator.hxx>
+#include <microsoft/net/remote/protocol/NetRemoteDataStream.pb.h>
+#include <microsoft/net/remote/protocol/NetRemoteDataStreamingService.grpc.pb.h>
+#include <plog/Log.h>
+
+using namespace Microsoft::Net::Remote;
+using namespace Microsoft::Net::Remote::DataStream;
+
+using Microsoft::Net::Remote::Service::NetRemoteDataStreaming;
+
+namespace detail
+{
+/**
+ * @brief Convert a protocol timestamp to a system clock time point.
+ *
+ * @param timestamp The timestamp to convert.
+ * @return std::chrono::system_clock::time_point
+ */
+std::chrono::system_clock::time_point
+ToTimePoint(const google::protobuf::Timestamp& timestamp) noexcept
+{
+    const auto timeSinceEpoch = std::chrono::nanoseconds(google::protobuf::util::TimeUtil::TimestampToNanoseconds(timestamp));
+    return std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(timeSinceEpoch));
+}
+} // namespace detail
+
+/* static */
+std::unique_ptr<DataStreamClient>
+DataStreamClient::Create(DataStreamDirection direction, NetRemoteDataStreaming::Stub* client, DataStreamClientConfiguration configuration)
+{
+    switch (direction) {
+    case DataStreamDirection::Upload:
+        return std::make_unique<DataStreamUploader>(client, std::move(configuration));
+    case DataStreamDirection::Download:
+        return std::make_unique<DataStreamDownloader>(client, std::move(configuration));
+    case DataStreamDirection::Bidirectional:
+        return std::make_unique<DataStreamTransceiver>(client, std::move(configuration));
+    default:
+        return nullptr;
+    }
+}
+
+DataStreamClient::DataStreamClient(DataStreamClientConfiguration configuration) :
+    m_configuration(std::move(configuration))
+{
+}
+
+void
+DataStreamClient::Cancel()
+{
+    m_clientContext.TryCancel();
+}
+
+std::optional<grpc::Status>
+DataStreamClient::Await(std::chrono::milliseconds timeout)
+{
+    std::unique_lock lock(m_statusGate);
+    m_statusAvailable.wait_for(lock, timeout, [this] {
+        return m_status.has_value();
+    });
+
+    return m_status;
+}
+
+bool
+DataStreamClient::IsDone() const noexcept
+{
+    const std::lock_guard lock(m_statusGate);
+    return m_status.has_value();
+}
+
+DataStreamClientProgress
+DataStreamClient::GetProgress() const noexcept
+{
+    return DataStreamClientProgress{
+        .NumberOfDataBlocksSent = m_numberOfDataBlocksSent.load(std::memory_order_relaxed),
+        .NumberOfBytesSent = m_numberOfBytesSent.load(std::memory_order_relaxed),
+        .NumberOfDataBlocksReceived = m_numberOfDataBlocksReceived.load(std::memory_order_relaxed),
+        .NumberOfBytesReceived = m_numberOfBytesReceived.load(std::memory_order_relaxed),
+    };
+}
+
+const DataStreamUploadResult&
+DataStreamClient::GetUploadResult() const noexcept
+{
+    return m_uploadResult;
+}
+
+void
+DataStreamClient::RecordSent(std::size_t numberOfBytes) noexcept
+{
+    m_numberOfDataBlocksSent.fetch_add(1, std::memory_order_relaxed);
+    m_numberOfBytesSent.fetch_add(numberOfBytes, std::memory_order_relaxed);
+}
+
+void
+DataStreamClient::RecordReceived(std::size_t numberOfBytes, std::size_t numberOfDataBlocks) noexcept
+{
+    m_numberOfDataBlocksReceived.fetch_add(numberOfDataBlocks, std::memory_order_relaxed);
+    m_numberOfBytesReceived.fetch_add(numberOfBytes, std::memory_order_relaxed);
+}
+
+void
+DataStreamClient::Complete(const grpc::Status& status)
+{
+    const std::lock_guard lock(m_statusGate);
+    m_status = status;
+    m_statusAvailable.notify_all();
+}
+
+void
+DataStreamClient::CancelAndAwait()
+{
+    if (!m_isStarted.load()) {
+        return;
+    }
+
+    m_clientContext.TryCancel();
+
+    std::unique_lock lock(m_statusGate);
+    m_statusAvailable.wait(lock, [this] {
+        return m_status.has_value();
+    });
+}
+
+DataStreamProperties
+DataStreamClient::CreateDataStreamProperties() const
+{
+    DataStreamProperties dataStreamProperties{};
+    dataStreamProperties.set_type(DataStreamType::DataStreamTypeTimed);
+    dataStreamProperties.set_pattern(DataStreamPattern::DataStreamPatternConstant);
+    dataStreamProperties.set_datablocksize(static_cast<uint32_t>(m_configuration.DataBlockSize));
+    *dataStreamProperties.mutable_timed()->mutable_duration() = google::protobuf::util::TimeUtil::MillisecondsToDuration(m_configuration.Duration.count());
+    if (!std::empty(m_configuration.SessionId)) {
+        dataStreamProperties.set_sessionid(m_configuration.SessionId);
+    }
+    if (m_configuration.DataBlocksPerMessage > 1) {
+        dataStreamProperties.set_datablockspermessage(m_configuration.DataBlocksPerMessage);
+    }
+
+    return dataStreamProperties;
+}
+
+DataStreamUploader::DataStreamUploader(NetRemoteDataStreaming::Stub* client, DataStreamClientConfiguration configuration) :
+    DataStreamClient(std::move(configuration)),
+    m_client(client)
+{
+    // The content of the data blocks is irrelevant, so the same one is written repeatedly.
+    RandomDataGenerator dataGenerator{};
+    m_data.set_data(dataGenerator.Generate(m_configuration.DataBlockSize));
+    *m_data.mutable_properties() = CreateDataStreamProperties();
+}
+
+DataStreamUploader::~DataStreamUploader()
+{
+    CancelAndAwait();
+}
+
+void
+DataStreamUploader::Start()
+{
+    m_isStarted = true;
+    m_timeEnd = std::chrono::steady_clock::now() + m_configuration.Duration;
+
+    m_client->async()->DataStreamUpload(&m_clientContext, &m_uploadResult, this);
+    NextWrite();
+    StartCall();
+}
+
+void
+DataStreamUploader::OnWriteDone(bool isOk)
+{
+    if (!isOk) {
+        // The RPC failed; its status is reported in OnDone().
+        return;
+    }
+
+    RecordSent(std::size(m_data.data()));
+
+    // Properties are only examined in the first message.
+    m_data.clear_properties();
+    NextWrite();
+}
+
+void
+DataStreamUploader::OnDone(const grpc::Status& status)
+{
+    Complete(status);
+}
+
+void
+DataStreamUploader::NextWrite()
+{
+    if (std::chrono::steady_clock::now() >= m_timeEnd) {
+        StartWritesDone();
+        return;
+    }
+
+    m_data.set_sequencenumber(++m_numberOfDataBlocksWritten);
+    StartWrite(&m_data);
+}
+
+DataStreamDownloader::DataStreamDownloader(NetRemoteDataStreaming::Stub* client, DataStreamClientConfiguration configuration) :
+    DataStreamClient(std::move(configuration)),
+    m_client(client)
+{
+    *m_request.mutable_properties() = CreateDataStreamProperties();
+}
+
+DataStreamDownloader::~DataStreamDownloader()
+{
+    CancelAndAwait();
+}
+
+void
+DataStreamDownloader::Start()
+{
+    m_isStarted = true;
+
+    m_client->async()->DataStreamDownload(&m_clientContext, &m_request, this);
+    StartRead(&m_data);
+    StartCall();
+}
+
+void
+DataStreamDownloader::OnReadDone(bool isOk)
+{
+    if (!isOk) {
+        // No more data; the status of the RPC is reported in OnDone().
+        return;
+    }
+
+    if (m_data.status().code() == DataStreamOperationStatusCode::DataStreamOperationStatusCodeFailed) {
+        LOGE << "Server failed data stream: " << m_data.status().message();
+    } else {
+        RecordReceived(std::size(m_data.data()), std::max<std::size_t>(m_data.numberofdatablocks(), 1));
+    }
+
+    StartRead(&m_data);
+}
+
+void
+DataStreamDownloader::OnDone(const grpc::Status& status)
+{
+    Complete(status);
+}
+
+DataStreamTransceiver::DataStreamTransceiver(NetRemoteDataStreaming::Stub* client, DataStreamClientConfiguration configuration) :
+    DataStreamClient(std::move(configuration)),
+    m_client(client)
+{
+    RandomDataGenerator dataGenerator{};
+    m_writeData.set_data(dataGenerator.Generate(m_configuration.DataBlockSize));
+    *m_writeData.mutable_properties() = CreateDataStreamProperties();
+}
+
+DataStreamTransceiver::~DataStreamTransceiver()
+{
+    CancelAndAwait();
+}
+
+void
+DataStreamTransceiver::Start()
+{
+    m_isStarted = true;
+    m_timeEnd = std::chrono::steady_clock::now() + m_configuration.Duration;
+
+    m_client->async()->DataStreamBidirectional(&m_clientContext, this);
+    StartRead(&m_readData);
+    NextWrite();
+    StartCall();
+}
+
+void
+DataStreamTransceiver::OnReadDone(bool isOk)
+{
+    if (!isOk) {
+        // No more data; the status of the RPC is reported in OnDone().
+        return;
+    }
+
+    if (m_readData.status().code() == DataStreamOperationStatusCode::DataStreamOperationStatusCodeFailed) {
+        LOGE << "Server failed data stream: " << m_readData.status().message();
+    } else {
+        RecordReceived(std::size(m_readData.data()), std::max<std::size_t>(m_readData.numberofdatablocks(), 1));
+    }
+
+    StartRead(&m_readData);
+}
+
+void
+DataStreamTransceiver::OnWriteDone(bool isOk)
+{
+    if (!isOk) {
+        // The RPC failed; its status is reported in OnDone().
+        return;
+    }
+
+    RecordSent(std::size(m_writeData.data()));
+
+    // Properties are only examined in the first message.
+    m_writeData.clear_properties();
+    NextWrite();
+}
+
+void
+DataStreamTransceiver::OnDone(const grpc::Status& status)
+{
+    Complete(status);
+}
+
+void
+DataStreamTransceiver::NextWrite()
+{
+    if (std::chrono::steady_clock::now() >= m_timeEnd) {
+        StartWritesDone();
+        return;
+    }
+
+    m_writeData.set_sequencenumber(++m_numberOfDataBlocksWritten);
+    StartWrite(&m_writeData);
+}
+
+DataStreamLatencyProbeClient::DataStreamLatencyProbeClient(NetRemoteDataStreaming::Stub* client, DataStreamClientConfiguration configuration) :
+    DataStreamClient(std::move(configuration)),
+    m_client(client)
+{
+}
+
+DataStreamLatencyProbeClient::~DataStreamLatencyProbeClient()
+{
+    CancelAndAwait();
+}
+
+void
+DataStreamLatencyProbeClient::Start()
+{
+    m_isStarted = true;
+    m_timeEnd = std::chrono::steady_clock::now() + m_configuration.Duration;
+
+    m_client->async()->DataStreamLatencyProbe(&m_clientContext, this);
+    StartRead(&m_response);
+    NextPing();
+    StartCall();
+}
+
+void
+DataStreamLatencyProbeClient::OnReadDone(bool isOk)
+{
+    if (!isOk) {
+        // No more responses; the status of the RPC is reported in OnDone().
+        return;
+    }
+
+    {
+        const std::lock_guard lock(m_latencyStatisticsGate);
+        m_latencyStatistics.Record(detail::ToTimePoint(m_response.requestsendtime()), detail::ToTimePoint(m_response.receivetime()), detail::ToTimePoint(m_response.sendtime()), std::chrono::system_clock::now());
+    }
+    RecordReceived(0);
+
+    StartRead(&m_response);
+    OnPingCompleted();
+}
+
+void
+DataStreamLatencyProbeClient::OnWriteDone(bool isOk)
+{
+    if (!isOk) {
+        // The RPC failed; its status is reported in OnDone().
+        return;
+    }
+
+    RecordSent(0);
+    OnPingCompleted();
+}
+
+void
+DataStreamLatencyProbeClient::OnDone(const grpc::Status& status)
+{
+    Complete(status);
+}
+
+LatencyStatistics
+DataStreamLatencyProbeClient::GetLatencyStatistics() const
+{
+    const std::lock_guard lock(m_latencyStatisticsGate);
+    return m_latencyStatistics;
+}
+
+void
+DataStreamLatencyProbeClient::OnPingCompleted()
+{
+    // The response may be read before the write of the ping is reported complete, and only one write may be pending.
+    if (m_numberOfPingOperationsPending.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+    }
+
+    // Wait for the remainder of the interval, if any, before sending the next ping. The hold prevents the RPC from
+    // completing while the alarm is pending.
+    const auto timeNext = m_timeLastSent + m_configuration.ProbeInterval;
+    const auto timeNow = std::chrono::steady_clock::now();
+    if (timeNext <= timeNow) {
+        NextPing();
+        return;
+    }
+
+    AddHold();
+    m_alarm.emplace();
+    m_alarm->Set(std::chrono::system_clock::now() + (timeNext - timeNow), [this](bool alarmFired) {
+        if (alarmFired) {
+            NextPing();
+        } else {
+            StartWritesDone();
+        }
+        RemoveHold();
+    });
+}
+
+void
+DataStreamLatencyProbeClient::NextPing()
+{
+    m_timeLastSent = std::chrono::steady_clock::now();
+    if (m_timeLastSent >= m_timeEnd) {
+        StartWritesDone();
+        return;
+    }
+
+    m_numberOfPingOperationsPending.store(2, std::memory_order_relaxed);
+    m_request.set_sequencenumber(m_request.sequencenumber() + 1);
+    *m_request.mutable_sendtime() = google::protobuf::util::TimeUtil::GetCurrentTime();
+    StartWrite(&m_request);
+}
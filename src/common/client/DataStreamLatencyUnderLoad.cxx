@@ -0,0 +1,158 @@
+
+#include <chrono>
+#include <cstdint>
+#include <format>
+#include <memory>
+#include <stop_token>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <grpc/grpc.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/security/credentials.h>
+#include <grpcpp/support/channel_arguments.h>
+#include <microsoft/net/remote/DataStreamClient.hxx>
+#include <microsoft/net/remote/DataStreamLatencyUnderLoad.hxx>
+#include <microsoft/net/remote/protocol/NetRemoteDataStreamingService.grpc.pb.h>
+
+using namespace Microsoft::Net::Remote;
+
+using Microsoft::Net::Remote::Service::NetRemoteDataStreaming;
+
+namespace detail
+{
+/**
+ * @brief The longest a test waits before checking whether it should stop.
+ */
+constexpr auto LatencyUnderLoadPollInterval{ std::chrono::milliseconds(100) };
+
+/**
+ * @brief The time allowed for a data stream to complete once its duration elapsed.
+ */
+constexpr auto LatencyUnderLoadCompletionTimeout{ std::chrono::seconds(5) };
+
+/**
+ * @brief Create a channel with a connection of its own, which is not shared with other channels to the same address.
+ *
+ * @param address The address of the server.
+ * @return std::shared_ptr<grpc::Channel>
+ */
+std::shared_ptr<grpc::Channel>
+CreateLatencyUnderLoadChannel(const std::string& address)
+{
+    grpc::ChannelArguments channelArguments{};
+    channelArguments.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+
+    return grpc::CreateCustomChannel(address, grpc::InsecureChannelCredentials(), channelArguments);
+}
+
+/**
+ * @brief Wait for a data stream to complete, canceling it if a stop is requested.
+ *
+ * @param dataStreamClient The data stream to wait for.
+ * @param timeout The maximum time to wait.
+ * @param stopToken Requests the wait to stop early.
+ * @return std::string Describes the error if the data stream failed or did not complete in time, otherwise empty.
+ */
+std::string
+AwaitLatencyUnderLoadClient(DataStreamClient& dataStreamClient, std::chrono::milliseconds timeout, const std::stop_token& stopToken)
+{
+    const auto timeEnd = std::chrono::steady_clock::now() + timeout;
+    while (!dataStreamClient.IsDone()) {
+        if (stopToken.stop_requested()) {
+            dataStreamClient.Cancel();
+            return "Test stopped";
+        }
+        if (std::chrono::steady_clock::now() >= timeEnd) {
+            dataStreamClient.Cancel();
+            return "Timed out waiting for data stream to complete";
+        }
+        dataStreamClient.Await(LatencyUnderLoadPollInterval);
+    }
+
+    const auto status = dataStreamClient.Await(std::chrono::milliseconds(0));
+    if (!status->ok()) {
+        return std::format("Data stream failed ({})", status->error_message());
+    }
+
+    return {};
+}
+} // namespace detail
+
+DataStreamLatencyUnderLoad::DataStreamLatencyUnderLoad(std::string address, DataStreamLatencyUnderLoadConfiguration configuration) :
+    m_address(std::move(address)),
+    m_configuration(std::move(configuration))
+{
+}
+
+DataStreamLatencyUnderLoadMeasurement
+DataStreamLatencyUnderLoad::Run(std::stop_token stopToken)
+{
+    DataStreamLatencyUnderLoadMeasurement measurement{};
+
+    if (m_configuration.NumberOfStreams == 0 || m_configuration.NumberOfStreams > DataStreamLatencyUnderLoadConfiguration::NumberOfStreamsMaximum) {
+        measurement.ErrorMessage = std::format("Invalid number of streams {} (maximum {})", m_configuration.NumberOfStreams, DataStreamLatencyUnderLoadConfiguration::NumberOfStreamsMaximum);
+        return measurement;
+    }
+    if (m_configuration.IdleDuration.count() <= 0 || m_configuration.LoadedDuration.count() <= 0 || m_configuration.ProbeInterval.count() <= 0) {
+        measurement.ErrorMessage = "Durations and probe interval must be positive";
+        return measurement;
+    }
+    if (m_configuration.DataBlockSize == 0 || m_configuration.DataBlockSize > DataStreamClientConfiguration::DataBlockSizeMaximum) {
+        measurement.ErrorMessage = std::format("Invalid data block size {} (maximum {})", m_configuration.DataBlockSize, DataStreamClientConfiguration::DataBlockSizeMaximum);
+        return measurement;
+    }
+
+    auto probeStub = NetRemoteDataStreaming::NewStub(detail::CreateLatencyUnderLoadChannel(m_address));
+    const auto runProbe = [&](std::chrono::milliseconds duration, Microsoft::Net::Remote::DataStream::LatencyStatistics& latencyStatistics) {
+        DataStreamLatencyProbeClient probe{ probeStub.get(), DataStreamClientConfiguration{ .Duration = duration, .ProbeInterval = m_configuration.ProbeInterval } };
+        probe.Start();
+        auto errorMessage = detail::AwaitLatencyUnderLoadClient(probe, duration + detail::LatencyUnderLoadCompletionTimeout, stopToken);
+        latencyStatistics = probe.GetLatencyStatistics();
+        return errorMessage;
+    };
+
+    // Measure the baseline on the idle link.
+    measurement.ErrorMessage = runProbe(m_configuration.IdleDuration, measurement.Idle);
+    if (!std::empty(measurement.ErrorMessage)) {
+        return measurement;
+    }
+
+    // Load the link, with each stream on its own connection so the streams compete for it like independent flows.
+    const DataStreamClientConfiguration loadConfiguration{
+        .Duration = m_configuration.LoadedDuration,
+        .DataBlockSize = m_configuration.DataBlockSize,
+    };
+    std::vector<std::unique_ptr<NetRemoteDataStreaming::Stub>> loadStubs{};
+    std::vector<std::unique_ptr<DataStreamClient>> loadClients{};
+    for (uint32_t i = 0; i < m_configuration.NumberOfStreams; i++) {
+        auto& loadStub = loadStubs.emplace_back(NetRemoteDataStreaming::NewStub(detail::CreateLatencyUnderLoadChannel(m_address)));
+        auto& loadClient = loadClients.emplace_back(DataStreamClient::Create(m_configuration.Direction, loadStub.get(), loadConfiguration));
+        loadClient->Start();
+    }
+
+    const auto timeLoadStart = std::chrono::steady_clock::now();
+    measurement.ErrorMessage = runProbe(m_configuration.LoadedDuration, measurement.Loaded);
+
+    for (auto& loadClient : loadClients) {
+        auto errorMessage = detail::AwaitLatencyUnderLoadClient(*loadClient, m_configuration.LoadedDuration + detail::LatencyUnderLoadCompletionTimeout, stopToken);
+        if (std::empty(measurement.ErrorMessage)) {
+            measurement.ErrorMessage = std::move(errorMessage);
+        }
+
+        const auto progress = loadClient->GetProgress();
+        measurement.NumberOfBytesTransferred += progress.NumberOfBytesSent + progress.NumberOfBytesReceived;
+    }
+
+    const auto loadDuration = std::chrono::duration<double>(std::chrono::steady_clock::now() - timeLoadStart);
+    if (loadDuration.count() > 0) {
+        measurement.GoodputBitsPerSecond = static_cast<uint64_t>(static_cast<double>(measurement.NumberOfBytesTransferred) * 8 / loadDuration.count());
+    }
+
+    // The client destructors wait for their RPCs to complete, which must happen before the stubs are destroyed.
+    loadClients.clear();
+
+    return measurement;
+}
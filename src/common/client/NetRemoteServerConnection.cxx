@@ -8,6 +8,7 @@
 #include <grpcpp/create_channel.h>
 #include <grpcpp/security/credentials.h>
 #include <microsoft/net/remote/NetRemoteServerConnection.hxx>
+#include <microsoft/net/remote/protocol/NetRemoteDataStreamingService.grpc.pb.h>
 #include <microsoft/net/remote/protocol/NetRemoteService.grpc.pb.h>
 #include <plog/Log.h>
 
@@ -16,10 +17,11 @@ using namespace Microsoft::Net::Remote;
 using namespace Microsoft::Net::Remote::Service;
 using namespace Microsoft::Net::Remote::Wifi;
 
-NetRemoteServerConnection::NetRemoteServerConnection(std::string_view address, std::shared_ptr<grpc::Channel> channel, std::unique_ptr<NetRemote::Stub> client) :
+NetRemoteServerConnection::NetRemoteServerConnection(std::string_view address, std::shared_ptr<grpc::Channel> channel, std::unique_ptr<NetRemote::Stub> client, std::unique_ptr<NetRemoteDataStreaming::Stub> dataStreamingClient) :
     Address(address),
     Channel(std::move(channel)),
-    Client(std::move(client))
+    Client(std::move(client)),
+    DataStreamingClient(std::move(dataStreamingClient))
 {
 }
 
@@ -42,7 +44,13 @@ NetRemoteServerConnection::TryEstablishConnection(std::string_view address)
         return nullptr;
     }
 
+    auto dataStreamingClient = NetRemoteDataStreaming::NewStub(channel);
+    if (dataStreamingClient == nullptr) {
+        LOGE << "Failed to create NetRemoteDataStreaming API stub";
+        return nullptr;
+    }
+
     // Return a new connection object.
-    auto netRemoteServerConnection = std::make_shared<NetRemoteServerConnection>(address, channel, std::move(client));
+    auto netRemoteServerConnection = std::make_shared<NetRemoteServerConnection>(address, channel, std::move(client), std::move(dataStreamingClient));
     return netRemoteServerConnection;
 }
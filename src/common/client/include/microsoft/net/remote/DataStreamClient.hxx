@@ -0,0 +1,519 @@
+
+#ifndef DATA_STREAM_CLIENT_HXX
+#define DATA_STREAM_CLIENT_HXX
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include <grpcpp/alarm.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/support/client_callback.h>
+#include <grpcpp/support/status.h>
+#include <microsoft/net/remote/datastream/LatencyStatistics.hxx>
+#include <microsoft/net/remote/protocol/NetRemoteDataStream.pb.h>
+#include <microsoft/net/remote/protocol/NetRemoteDataStreamingService.grpc.pb.h>
+
+namespace Microsoft::Net::Remote
+{
+/**
+ * @brief The direction in which data flows on a data stream, from the perspective of the client.
+ */
+enum class DataStreamDirection {
+    Upload,
+    Download,
+    Bidirectional,
+};
+
+/**
+ * @brief Configuration of a data stream run by a client.
+ */
+struct DataStreamClientConfiguration
+{
+    /**
+     * @brief The data block size used when none is specified.
+     */
+    static constexpr std::size_t DataBlockSizeDefault{ 64 * 1024 };
+
+    /**
+     * @brief The largest data block size supported, which keeps messages below the default gRPC message size limit of
+     * 4 MiB.
+     */
+    static constexpr std::size_t DataBlockSizeMaximum{ 1024 * 1024 };
+
+    /**
+     * @brief The duration of the data stream.
+     */
+    std::chrono::milliseconds Duration{ std::chrono::seconds(10) };
+
+    /**
+     * @brief The size of each data block, in bytes.
+     */
+    std::size_t DataBlockSize{ DataBlockSizeDefault };
+
+    /**
+     * @brief The number of data blocks the server packs into each message it writes.
+     */
+    uint32_t DataBlocksPerMessage{ 1 };
+
+    /**
+     * @brief The identifier of the session to attach the data stream to, if any.
+     */
+    std::string SessionId{};
+
+    /**
+     * @brief For latency probes, the minimum interval between consecutive pings.
+     */
+    std::chrono::milliseconds ProbeInterval{ std::chrono::milliseconds(10) };
+};
+
+/**
+ * @brief Snapshot of the amount of data transferred on a data stream.
+ */
+struct DataStreamClientProgress
+{
+    uint64_t NumberOfDataBlocksSent{};
+    uint64_t NumberOfBytesSent{};
+    uint64_t NumberOfDataBlocksReceived{};
+    uint64_t NumberOfBytesReceived{};
+};
+
+/**
+ * @brief Base class for clients running a data stream against a netremote server.
+ *
+ * Progress is tracked with atomic counters, so it may be sampled from another thread while the stream runs, for
+ * example to report throughput periodically. Derived classes must call CancelAndAwait() in their destructor since gRPC
+ * requires a reactor to outlive its RPC.
+ */
+class DataStreamClient
+{
+public:
+    virtual ~DataStreamClient() = default;
+
+    DataStreamClient(const DataStreamClient&) = delete;
+
+    DataStreamClient(DataStreamClient&&) = delete;
+
+    DataStreamClient&
+    operator=(const DataStreamClient&) = delete;
+
+    DataStreamClient&
+    operator=(DataStreamClient&&) = delete;
+
+    /**
+     * @brief Create a client for a data stream in the specified direction.
+     *
+     * @param direction The direction of the data stream.
+     * @param client The data streaming client stub.
+     * @param configuration The configuration of the data stream.
+     * @return std::unique_ptr<DataStreamClient>
+     */
+    static std::unique_ptr<DataStreamClient>
+    Create(DataStreamDirection direction, Microsoft::Net::Remote::Service::NetRemoteDataStreaming::Stub* client, DataStreamClientConfiguration configuration);
+
+    /**
+     * @brief Start the data stream. This must be called at most once.
+     */
+    virtual void
+    Start() = 0;
+
+    /**
+     * @brief Cancel the data stream. It completes shortly after.
+     */
+    void
+    Cancel();
+
+    /**
+     * @brief Wait for the data stream to complete.
+     *
+     * @param timeout The maximum time to wait.
+     * @return std::optional<grpc::Status> The final status of the RPC, or std::nullopt if it did not complete in time.
+     */
+    std::optional<grpc::Status>
+    Await(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Determine whether the data stream completed.
+     *
+     * @return true If the data stream completed.
+     * @return false Otherwise.
+     */
+    bool
+    IsDone() const noexcept;
+
+    /**
+     * @brief Get the amount of data transferred so far.
+     *
+     * @return DataStreamClientProgress
+     */
+    DataStreamClientProgress
+    GetProgress() const noexcept;
+
+    /**
+     * @brief Get the result reported by the server for an upload, once the data stream completed.
+     *
+     * @return const Microsoft::Net::Remote::DataStream::DataStreamUploadResult&
+     */
+    const Microsoft::Net::Remote::DataStream::DataStreamUploadResult&
+    GetUploadResult() const noexcept;
+
+protected:
+    /**
+     * @brief Construct a new DataStreamClient object.
+     *
+     * @param configuration The configuration of the data stream.
+     */
+    explicit DataStreamClient(DataStreamClientConfiguration configuration);
+
+    /**
+     * @brief Record a data block sent to the server.
+     *
+     * @param numberOfBytes The number of data bytes in the block.
+     */
+    void
+    RecordSent(std::size_t numberOfBytes) noexcept;
+
+    /**
+     * @brief Record a message of data blocks received from the server.
+     *
+     * @param numberOfBytes The number of data bytes in the message.
+     * @param numberOfDataBlocks The number of data blocks packed in the message.
+     */
+    void
+    RecordReceived(std::size_t numberOfBytes, std::size_t numberOfDataBlocks = 1) noexcept;
+
+    /**
+     * @brief Mark the data stream as complete. This must be called from the OnDone() callback of the reactor.
+     *
+     * @param status The final status of the RPC.
+     */
+    void
+    Complete(const grpc::Status& status);
+
+    /**
+     * @brief Cancel the data stream, if it was started, and wait for it to complete.
+     */
+    void
+    CancelAndAwait();
+
+    /**
+     * @brief Create the properties describing the data stream to the server.
+     *
+     * @return Microsoft::Net::Remote::DataStream::DataStreamProperties
+     */
+    Microsoft::Net::Remote::DataStream::DataStreamProperties
+    CreateDataStreamProperties() const;
+
+protected:
+    DataStreamClientConfiguration m_configuration;
+    grpc::ClientContext m_clientContext{};
+    Microsoft::Net::Remote::DataStream::DataStreamUploadResult m_uploadResult{};
+    std::atomic<bool> m_isStarted{};
+
+private:
+    std::atomic<uint64_t> m_numberOfDataBlocksSent{};
+    std::atomic<uint64_t> m_numberOfBytesSent{};
+    std::atomic<uint64_t> m_numberOfDataBlocksReceived{};
+    std::atomic<uint64_t> m_numberOfBytesReceived{};
+    std::optional<grpc::Status> m_status{};
+    mutable std::mutex m_statusGate{};
+    std::condition_variable m_statusAvailable{};
+};
+
+/**
+ * @brief Client that uploads data blocks to the server for the configured duration.
+ */
+class DataStreamUploader final :
+    public DataStreamClient,
+    public grpc::ClientWriteReactor<Microsoft::Net::Remote::DataStream::DataStreamUploadData>
+{
+public:
+    /**
+     * @brief Construct a new DataStreamUploader object.
+     *
+     * @param client The data streaming client stub.
+     * @param configuration The configuration of the data stream.
+     */
+    DataStreamUploader(Microsoft::Net::Remote::Service::NetRemoteDataStreaming::Stub* client, DataStreamClientConfiguration configuration);
+
+    ~DataStreamUploader() override;
+
+    DataStreamUploader(const DataStreamUploader&) = delete;
+
+    DataStreamUploader(DataStreamUploader&&) = delete;
+
+    DataStreamUploader&
+    operator=(const DataStreamUploader&) = delete;
+
+    DataStreamUploader&
+    operator=(DataStreamUploader&&) = delete;
+
+    /**
+     * @brief Start the data stream.
+     */
+    void
+    Start() override;
+
+    /**
+     * @brief Callback that is executed when a write operation is completed.
+     *
+     * @param isOk Indicates whether a write was successfully sent.
+     */
+    void
+    OnWriteDone(bool isOk) override;
+
+    /**
+     * @brief Callback that is executed when all RPC operations are completed.
+     *
+     * @param status The status of the RPC.
+     */
+    void
+    OnDone(const grpc::Status& status) override;
+
+private:
+    /**
+     * @brief Write the next data block, or finish writing once the duration elapsed.
+     */
+    void
+    NextWrite();
+
+private:
+    Microsoft::Net::Remote::Service::NetRemoteDataStreaming::Stub* m_client;
+    Microsoft::Net::Remote::DataStream::DataStreamUploadData m_data{};
+    std::chrono::steady_clock::time_point m_timeEnd{};
+    uint32_t m_numberOfDataBlocksWritten{};
+};
+
+/**
+ * @brief Client that downloads data blocks from the server for the configured duration.
+ */
+class DataStreamDownloader final :
+    public DataStreamClient,
+    public grpc::ClientReadReactor<Microsoft::Net::Remote::DataStream::DataStreamDownloadData>
+{
+public:
+    /**
+     * @brief Construct a new DataStreamDownloader object.
+     *
+     * @param client The data streaming client stub.
+     * @param configuration The configuration of the data stream.
+     */
+    DataStreamDownloader(Microsoft::Net::Remote::Service::NetRemoteDataStreaming::Stub* client, DataStreamClientConfiguration configuration);
+
+    ~DataStreamDownloader() override;
+
+    DataStreamDownloader(const DataStreamDownloader&) = delete;
+
+    DataStreamDownloader(DataStreamDownloader&&) = delete;
+
+    DataStreamDownloader&
+    operator=(const DataStreamDownloader&) = delete;
+
+    DataStreamDownloader&
+    operator=(DataStreamDownloader&&) = delete;
+
+    /**
+     * @brief Start the data stream.
+     */
+    void
+    Start() override;
+
+    /**
+     * @brief Callback that is executed when a read operation is completed.
+     *
+     * @param isOk Indicates whether a message was read as expected.
+     */
+    void
+    OnReadDone(bool isOk) override;
+
+    /**
+     * @brief Callback that is executed when all RPC operations are completed.
+     *
+     * @param status The status of the RPC.
+     */
+    void
+    OnDone(const grpc::Status& status) override;
+
+private:
+    Microsoft::Net::Remote::Service::NetRemoteDataStreaming::Stub* m_client;
+    Microsoft::Net::Remote::DataStream::DataStreamDownloadRequest m_request{};
+    Microsoft::Net::Remote::DataStream::DataStreamDownloadData m_data{};
+};
+
+/**
+ * @brief Client that uploads and downloads data blocks concurrently for the configured duration.
+ */
+class DataStreamTransceiver final :
+    public DataStreamClient,
+    public grpc::ClientBidiReactor<Microsoft::Net::Remote::DataStream::DataStreamUploadData, Microsoft::Net::Remote::DataStream::DataStreamDownloadData>
+{
+public:
+    /**
+     * @brief Construct a new DataStreamTransceiver object.
+     *
+     * @param client The data streaming client stub.
+     * @param configuration The configuration of the data stream.
+     */
+    DataStreamTransceiver(Microsoft::Net::Remote::Service::NetRemoteDataStreaming::Stub* client, DataStreamClientConfiguration configuration);
+
+    ~DataStreamTransceiver() override;
+
+    DataStreamTransceiver(const DataStreamTransceiver&) = delete;
+
+    DataStreamTransceiver(DataStreamTransceiver&&) = delete;
+
+    DataStreamTransceiver&
+    operator=(const DataStreamTransceiver&) = delete;
+
+    DataStreamTransceiver&
+    operator=(DataStreamTransceiver&&) = delete;
+
+    /**
+     * @brief Start the data stream.
+     */
+    void
+    Start() override;
+
+    /**
+     * @brief Callback that is executed when a read operation is completed.
+     *
+     * @param isOk Indicates whether a message was read as expected.
+     */
+    void
+    OnReadDone(bool isOk) override;
+
+    /**
+     * @brief Callback that is executed when a write operation is completed.
+     *
+     * @param isOk Indicates whether a write was successfully sent.
+     */
+    void
+    OnWriteDone(bool isOk) override;
+
+    /**
+     * @brief Callback that is executed when all RPC operations are completed.
+     *
+     * @param status The status of the RPC.
+     */
+    void
+    OnDone(const grpc::Status& status) override;
+
+private:
+    /**
+     * @brief Write the next data block, or finish writing once the duration elapsed.
+     */
+    void
+    NextWrite();
+
+private:
+    Microsoft::Net::Remote::Service::NetRemoteDataStreaming::Stub* m_client;
+    Microsoft::Net::Remote::DataStream::DataStreamUploadData m_writeData{};
+    Microsoft::Net::Remote::DataStream::DataStreamDownloadData m_readData{};
+    std::chrono::steady_clock::time_point m_timeEnd{};
+    uint32_t m_numberOfDataBlocksWritten{};
+};
+
+/**
+ * @brief Client that measures round-trip times to the server with pings for the configured duration.
+ *
+ * Each ping is sent once the response to the previous one is received, and no sooner than the probe interval after the
+ * previous ping was sent. At most one ping is therefore outstanding, so probing adds negligible load. Pings and
+ * responses are counted as data blocks sent and received, carrying no data bytes.
+ */
+class DataStreamLatencyProbeClient final :
+    public DataStreamClient,
+    public grpc::ClientBidiReactor<Microsoft::Net::Remote::DataStream::DataStreamPingRequest, Microsoft::Net::Remote::DataStream::DataStreamPingResponse>
+{
+public:
+    /**
+     * @brief Construct a new DataStreamLatencyProbeClient object.
+     *
+     * @param client The data streaming client stub.
+     * @param configuration The configuration of the data stream.
+     */
+    DataStreamLatencyProbeClient(Microsoft::Net::Remote::Service::NetRemoteDataStreaming::Stub* client, DataStreamClientConfiguration configuration);
+
+    ~DataStreamLatencyProbeClient() override;
+
+    DataStreamLatencyProbeClient(const DataStreamLatencyProbeClient&) = delete;
+
+    DataStreamLatencyProbeClient(DataStreamLatencyProbeClient&&) = delete;
+
+    DataStreamLatencyProbeClient&
+    operator=(const DataStreamLatencyProbeClient&) = delete;
+
+    DataStreamLatencyProbeClient&
+    operator=(DataStreamLatencyProbeClient&&) = delete;
+
+    /**
+     * @brief Start sending pings.
+     */
+    void
+    Start() override;
+
+    /**
+     * @brief Callback that is executed when a read operation is completed.
+     *
+     * @param isOk Indicates whether a message was read as expected.
+     */
+    void
+    OnReadDone(bool isOk) override;
+
+    /**
+     * @brief Callback that is executed when a write operation is completed.
+     *
+     * @param isOk Indicates whether a write was successfully sent.
+     */
+    void
+    OnWriteDone(bool isOk) override;
+
+    /**
+     * @brief Callback that is executed when all RPC operations are completed.
+     *
+     * @param status The status of the RPC.
+     */
+    void
+    OnDone(const grpc::Status& status) override;
+
+    /**
+     * @brief Get a snapshot of the latency statistics of the pings answered so far.
+     *
+     * @return Microsoft::Net::Remote::DataStream::LatencyStatistics
+     */
+    Microsoft::Net::Remote::DataStream::LatencyStatistics
+    GetLatencyStatistics() const;
+
+private:
+    /**
+     * @brief Record the completion of the write of a ping or the read of its response. Once both completed, the next
+     * ping is scheduled.
+     */
+    void
+    OnPingCompleted();
+
+    /**
+     * @brief Send the next ping, or finish once the duration elapsed.
+     */
+    void
+    NextPing();
+
+private:
+    Microsoft::Net::Remote::Service::NetRemoteDataStreaming::Stub* m_client;
+    Microsoft::Net::Remote::DataStream::DataStreamPingRequest m_request{};
+    Microsoft::Net::Remote::DataStream::DataStreamPingResponse m_response{};
+    std::chrono::steady_clock::time_point m_timeEnd{};
+    std::chrono::steady_clock::time_point m_timeLastSent{};
+    std::optional<grpc::Alarm> m_alarm{};
+    std::atomic<uint32_t> m_numberOfPingOperationsPending{};
+    Microsoft::Net::Remote::DataStream::LatencyStatistics m_latencyStatistics{};
+    mutable std::mutex m_latencyStatisticsGate{};
+};
+} // namespace Microsoft::Net::Remote
+
+#endif // DATA_STREAM_CLIENT_HXX
@@ -0,0 +1,112 @@
+
+#ifndef DATA_STREAM_LATENCY_UNDER_LOAD_HXX
+#define DATA_STREAM_LATENCY_UNDER_LOAD_HXX
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <stop_token>
+#include <string>
+
+#include <microsoft/net/remote/DataStreamClient.hxx>
+#include <microsoft/net/remote/datastream/LatencyStatistics.hxx>
+
+namespace Microsoft::Net::Remote
+{
+/**
+ * @brief Configuration of a latency under load test.
+ */
+struct DataStreamLatencyUnderLoadConfiguration
+{
+    /**
+     * @brief The maximum number of data streams that may load the link.
+     */
+    static constexpr uint32_t NumberOfStreamsMaximum{ 16 };
+
+    /**
+     * @brief The direction in which data flows on the streams loading the link, from the perspective of the client.
+     */
+    DataStreamDirection Direction{ DataStreamDirection::Download };
+
+    /**
+     * @brief The number of data streams loading the link, each on its own connection.
+     */
+    uint32_t NumberOfStreams{ 4 };
+
+    /**
+     * @brief How long to probe latency before loading the link.
+     */
+    std::chrono::milliseconds IdleDuration{ std::chrono::seconds(2) };
+
+    /**
+     * @brief How long to probe latency while loading the link.
+     */
+    std::chrono::milliseconds LoadedDuration{ std::chrono::seconds(10) };
+
+    /**
+     * @brief The minimum interval between consecutive pings.
+     */
+    std::chrono::milliseconds ProbeInterval{ std::chrono::milliseconds(10) };
+
+    /**
+     * @brief The size of each data block of the streams loading the link, in bytes.
+     */
+    std::size_t DataBlockSize{ DataStreamClientConfiguration::DataBlockSizeDefault };
+};
+
+/**
+ * @brief The measurement made by a latency under load test.
+ */
+struct DataStreamLatencyUnderLoadMeasurement
+{
+    /**
+     * @brief The round-trip times measured before and while the link was loaded.
+     */
+    Microsoft::Net::Remote::DataStream::LatencyStatistics Idle{};
+    Microsoft::Net::Remote::DataStream::LatencyStatistics Loaded{};
+
+    /**
+     * @brief The data transferred by the streams loading the link, in both directions.
+     */
+    uint64_t NumberOfBytesTransferred{};
+    uint64_t GoodputBitsPerSecond{};
+
+    /**
+     * @brief Describes the error that ended the test, or empty if none occurred.
+     */
+    std::string ErrorMessage{};
+};
+
+/**
+ * @brief Measures the latency a link adds under load, which is dominated by queuing in oversized buffers (bufferbloat).
+ *
+ * Pings are first sent on an idle link, then while bulk data streams saturate it. The pings use a connection of their
+ * own, so they only queue behind bulk data in the network, rather than in the send buffers of the bulk connections.
+ */
+class DataStreamLatencyUnderLoad
+{
+public:
+    /**
+     * @brief Construct a new DataStreamLatencyUnderLoad object.
+     *
+     * @param address The address of the netremote server at the other end of the link.
+     * @param configuration The configuration of the test.
+     */
+    DataStreamLatencyUnderLoad(std::string address, DataStreamLatencyUnderLoadConfiguration configuration);
+
+    /**
+     * @brief Run the test to completion. This blocks for the idle and loaded durations.
+     *
+     * @param stopToken Requests the test to stop early, in which case it fails.
+     * @return DataStreamLatencyUnderLoadMeasurement
+     */
+    DataStreamLatencyUnderLoadMeasurement
+    Run(std::stop_token stopToken = {});
+
+private:
+    std::string m_address;
+    DataStreamLatencyUnderLoadConfiguration m_configuration;
+};
+} // namespace Microsoft::Net::Remote
+
+#endif // DATA_STREAM_LATENCY_UNDER_LOAD_HXX
@@ -7,6 +7,7 @@
 #include <string_view>
 
 #include <grpcpp/channel.h>
+#include <microsoft/net/remote/protocol/NetRemoteDataStreamingService.grpc.pb.h>
 #include <microsoft/net/remote/protocol/NetRemoteService.grpc.pb.h>
 
 namespace Microsoft::Net::Remote
@@ -19,15 +20,17 @@ struct NetRemoteServerConnection
     std::string Address;
     std::shared_ptr<grpc::Channel> Channel;
     std::unique_ptr<Microsoft::Net::Remote::Service::NetRemote::Stub> Client;
+    std::unique_ptr<Microsoft::Net::Remote::Service::NetRemoteDataStreaming::Stub> DataStreamingClient;
 
     /**
-     * @brief Construct a new NetRemoteServerConnection object with the specified address, channel, and client.
+     * @brief Construct a new NetRemoteServerConnection object with the specified address, channel, and clients.
      *
      * @param address The address that was used to connect.
      * @param channel The established channel.
      * @param client The client stub that was obtained from 'channel'.
+     * @param dataStreamingClient The data streaming client stub that was obtained from 'channel'.
      */
-    NetRemoteServerConnection(std::string_view address, std::shared_ptr<grpc::Channel> channel, std::unique_ptr<Microsoft::Net::Remote::Service::NetRemote::Stub> client);
+    NetRemoteServerConnection(std::string_view address, std::shared_ptr<grpc::Channel> channel, std::unique_ptr<Microsoft::Net::Remote::Service::NetRemote::Stub> client, std::unique_ptr<Microsoft::Net::Remote::Service::NetRemoteDataStreaming::Stub> dataStreamingClient);
 
     /**
      * @brief Attempt to establish a basic connection to a remote server.
@@ -0,0 +1,136 @@
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+#include <microsoft/net/remote/datastream/DataPatternGenerator.hxx>
+#include <microsoft/net/remote/datastream/RandomDataGenerator.hxx>
+
+using namespace Microsoft::Net::Remote::DataStream;
+
+namespace detail
+{
+/**
+ * @brief Get the byte of the counter pattern at the specified stream offset.
+ *
+ * @param offset The byte offset in the stream.
+ * @return uint8_t
+ */
+constexpr uint8_t
+CounterPatternByte(uint64_t offset) noexcept
+{
+    return static_cast<uint8_t>((offset / sizeof(uint64_t)) >> (8U * (offset % sizeof(uint64_t))));
+}
+
+/**
+ * @brief Fill a buffer with the counter pattern, starting at the specified stream offset.
+ *
+ * @param data The buffer to fill.
+ * @param offset The byte offset in the stream of the first byte of the buffer.
+ */
+void
+FillCounterPattern(std::span<uint8_t> data, uint64_t offset) noexcept
+{
+    std::size_t index = 0;
+
+    // Fill byte-wise up to the first word boundary in the stream, then word-wise, then any trailing bytes.
+    for (; index < std::size(data) && ((offset + index) % sizeof(uint64_t)) != 0; index++) {
+        data[index] = CounterPatternByte(offset + index);
+    }
+
+    for (uint64_t word = (offset + index) / sizeof(uint64_t); index + sizeof(uint64_t) <= std::size(data); index += sizeof(uint64_t), word++) {
+        const uint64_t value = (std::endian::native == std::endian::little) ? word : std::byteswap(word);
+        std::memcpy(std::data(data) + index, &value, sizeof value);
+    }
+
+    for (; index < std::size(data); index++) {
+        data[index] = CounterPatternByte(offset + index);
+    }
+}
+} // namespace detail
+
+DataPatternGenerator::DataPatternGenerator(DataPattern pattern, uint64_t seed) noexcept :
+    m_pattern(pattern),
+    m_seed(seed),
+    m_randomDataGenerator(seed)
+{
+}
+
+DataPattern
+DataPatternGenerator::GetPattern() const noexcept
+{
+    return m_pattern;
+}
+
+/* static */
+uint64_t
+DataPatternGenerator::DeriveBlockSeed(uint64_t seed, uint64_t sequenceNumber) noexcept
+{
+    // Scramble the sequence number so that seeds of adjacent blocks (and adjacent stream seeds) don't collide, then
+    // apply the SplitMix64 finalizer.
+    uint64_t z = seed ^ (sequenceNumber * 0xD1B54A32D192ED03ULL);
+    z = (z ^ (z >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27U)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31U);
+}
+
+void
+DataPatternGenerator::Fill(std::span<uint8_t> data, uint64_t sequenceNumber, uint64_t offset) noexcept
+{
+    switch (m_pattern) {
+    case DataPattern::PseudoRandom:
+        m_randomDataGenerator.Seed(DeriveBlockSeed(m_seed, sequenceNumber));
+        m_randomDataGenerator.Fill(data);
+        break;
+    case DataPattern::Counter:
+        detail::FillCounterPattern(data, offset);
+        break;
+    case DataPattern::Zeros:
+        std::ranges::fill(data, uint8_t{ 0x00 });
+        break;
+    case DataPattern::Ones:
+        std::ranges::fill(data, uint8_t{ 0xFF });
+        break;
+    }
+}
+
+void
+DataPatternGenerator::Fill(std::span<char> data, uint64_t sequenceNumber, uint64_t offset) noexcept
+{
+    Fill(std::span<uint8_t>(reinterpret_cast<uint8_t*>(std::data(data)), std::size(data)), sequenceNumber, offset);
+}
+
+bool
+DataPatternGenerator::Verify(std::span<const uint8_t> data, uint64_t sequenceNumber, uint64_t offset)
+{
+    switch (m_pattern) {
+    case DataPattern::Zeros:
+        return std::ranges::all_of(data, [](auto value) {
+            return value == 0x00;
+        });
+    case DataPattern::Ones:
+        return std::ranges::all_of(data, [](auto value) {
+            return value == 0xFF;
+        });
+    default:
+        break;
+    }
+
+    if (std::empty(data)) {
+        return true;
+    }
+
+    m_dataExpected.resize(std::size(data));
+    Fill(m_dataExpected, sequenceNumber, offset);
+
+    return std::memcmp(std::data(m_dataExpected), std::data(data), std::size(data)) == 0;
+}
+
+bool
+DataPatternGenerator::Verify(std::span<const char> data, uint64_t sequenceNumber, uint64_t offset)
+{
+    return Verify(std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(std::data(data)), std::size(data)), sequenceNumber, offset);
+}
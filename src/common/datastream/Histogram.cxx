@@ -0,0 +1,145 @@
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <microsoft/net/remote/datastream/Histogram.hxx>
+
+using namespace Microsoft::Net::Remote::DataStream;
+
+/* static */
+std::size_t
+Histogram::GetBucketIndex(uint64_t value) noexcept
+{
+    if (value < SubBucketCount) {
+        return static_cast<std::size_t>(value);
+    }
+
+    // The value is in the power-of-two range [2^exponent, 2^(exponent + 1)). The bits directly below the leading bit
+    // select the sub-bucket within that range.
+    const auto exponent = static_cast<uint32_t>(std::bit_width(value)) - 1;
+    const auto subBucket = static_cast<std::size_t>((value >> (exponent - SubBucketBits)) & (SubBucketCount - 1));
+
+    return ((exponent - SubBucketBits + 1) * SubBucketCount) + subBucket;
+}
+
+/* static */
+HistogramBucket
+Histogram::GetBucketBounds(std::size_t index) noexcept
+{
+    if (index < SubBucketCount) {
+        return HistogramBucket{ .LowerBound = index, .UpperBound = index + 1 };
+    }
+
+    const auto group = index / SubBucketCount;
+    const auto subBucket = index % SubBucketCount;
+    const auto shift = static_cast<uint32_t>(group - 1);
+    const uint64_t lowerBound = (SubBucketCount + subBucket) << shift;
+    const uint64_t width = uint64_t{ 1 } << shift;
+    const uint64_t upperBound = (lowerBound > std::numeric_limits<uint64_t>::max() - width) ? std::numeric_limits<uint64_t>::max() : lowerBound + width;
+
+    return HistogramBucket{ .LowerBound = lowerBound, .UpperBound = upperBound };
+}
+
+void
+Histogram::Record(uint64_t value) noexcept
+{
+    m_counts[GetBucketIndex(value)]++;
+    m_minimum = (m_count == 0) ? value : std::min(m_minimum, value);
+    m_maximum = (m_count == 0) ? value : std::max(m_maximum, value);
+    m_sum += static_cast<double>(value);
+    m_count++;
+}
+
+void
+Histogram::Merge(const Histogram& other) noexcept
+{
+    if (other.m_count == 0) {
+        return;
+    }
+
+    for (std::size_t i = 0; i < NumberOfBuckets; i++) {
+        m_counts[i] += other.m_counts[i];
+    }
+
+    m_minimum = (m_count == 0) ? other.m_minimum : std::min(m_minimum, other.m_minimum);
+    m_maximum = (m_count == 0) ? other.m_maximum : std::max(m_maximum, other.m_maximum);
+    m_sum += other.m_sum;
+    m_count += other.m_count;
+}
+
+void
+Histogram::Reset() noexcept
+{
+    *this = Histogram{};
+}
+
+uint64_t
+Histogram::GetCount() const noexcept
+{
+    return m_count;
+}
+
+uint64_t
+Histogram::GetMinimum() const noexcept
+{
+    return m_minimum;
+}
+
+uint64_t
+Histogram::GetMaximum() const noexcept
+{
+    return m_maximum;
+}
+
+double
+Histogram::GetMean() const noexcept
+{
+    return (m_count == 0) ? 0.0 : m_sum / static_cast<double>(m_count);
+}
+
+uint64_t
+Histogram::GetValueAtPercentile(double percentile) const noexcept
+{
+    if (m_count == 0) {
+        return 0;
+    }
+    if (percentile <= 0.0) {
+        return m_minimum;
+    }
+
+    // Determine the rank of the value at the percentile (1-based), then find the bucket containing it.
+    const double percentileClamped = std::clamp(percentile, 0.0, 100.0);
+    const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil((percentileClamped / 100.0) * static_cast<double>(m_count))));
+
+    uint64_t countCumulative = 0;
+    for (std::size_t i = 0; i < NumberOfBuckets; i++) {
+        countCumulative += m_counts[i];
+        if (countCumulative >= rank) {
+            return std::clamp(GetBucketBounds(i).UpperBound - 1, m_minimum, m_maximum);
+        }
+    }
+
+    return m_maximum;
+}
+
+std::vector<HistogramBucket>
+Histogram::GetBuckets() const
+{
+    std::vector<HistogramBucket> buckets{};
+    for (std::size_t i = 0; i < NumberOfBuckets; i++) {
+        if (m_counts[i] == 0) {
+            continue;
+        }
+
+        auto bucket = GetBucketBounds(i);
+        bucket.Count = m_counts[i];
+        buckets.push_back(bucket);
+    }
+
+    return buckets;
+}
@@ -0,0 +1,260 @@
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <system_error>
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <microsoft/net/remote/datastream/IoUring.hxx>
+
+using namespace Microsoft::Net::Remote::DataStream;
+
+namespace detail
+{
+/**
+ * @brief Get the error described by errno.
+ *
+ * @return std::error_code
+ */
+std::error_code
+GetIoUringLastError() noexcept
+{
+    return { errno, std::system_category() };
+}
+
+/**
+ * @brief Get a pointer to a field of a memory-mapped ring, from its offset.
+ *
+ * @tparam T The type of the field.
+ * @param ring The start of the ring.
+ * @param offset The offset of the field, as reported by the kernel.
+ * @return T*
+ */
+template <typename T>
+T*
+GetIoUringRingField(void* ring, uint32_t offset) noexcept
+{
+    return reinterpret_cast<T*>(static_cast<char*>(ring) + offset); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+}
+} // namespace detail
+
+/* static */
+std::unique_ptr<IoUring>
+IoUring::Create(uint32_t numberOfEntries, std::error_code& error)
+{
+    io_uring_params parameters{};
+    const auto fileDescriptor = static_cast<int>(syscall(SYS_io_uring_setup, numberOfEntries, &parameters));
+    if (fileDescriptor < 0) {
+        error = detail::GetIoUringLastError();
+        return nullptr;
+    }
+
+    // Using new to access private constructor.
+    auto ioUring = std::unique_ptr<IoUring>(new IoUring(fileDescriptor));
+
+    // Submit() waits for completions with a timeout, which needs IORING_ENTER_EXT_ARG; kernels support it since 5.11.
+    if ((parameters.features & IORING_FEAT_EXT_ARG) == 0) {
+        error = std::make_error_code(std::errc::not_supported);
+        return nullptr;
+    }
+
+    error = ioUring->MapRings(parameters);
+    if (error) {
+        return nullptr;
+    }
+
+    return ioUring;
+}
+
+IoUring::IoUring(int fileDescriptor) noexcept :
+    m_fileDescriptor(fileDescriptor)
+{
+}
+
+IoUring::~IoUring()
+{
+    // Closing the instance releases the registered buffers and buffer ring, and cancels outstanding operations.
+    close(m_fileDescriptor);
+
+    if (m_submissionQueueEntries != nullptr) {
+        munmap(m_submissionQueueEntries, m_submissionQueueEntriesSize);
+    }
+    if (m_ringsMemory != nullptr) {
+        munmap(m_ringsMemory, m_ringsMemorySize);
+    }
+    if (m_bufferRingMemory != nullptr) {
+        munmap(m_bufferRingMemory, m_bufferRingMemorySize);
+    }
+}
+
+std::error_code
+IoUring::MapRings(const io_uring_params& parameters) noexcept
+{
+    // Kernels since 5.4 map both rings with a single mapping; older ones are not supported.
+    if ((parameters.features & IORING_FEAT_SINGLE_MMAP) == 0) {
+        return std::make_error_code(std::errc::not_supported);
+    }
+
+    const std::size_t submissionRingSize = parameters.sq_off.array + (parameters.sq_entries * sizeof(uint32_t));
+    const std::size_t completionRingSize = parameters.cq_off.cqes + (parameters.cq_entries * sizeof(io_uring_cqe));
+    m_ringsMemorySize = std::max(submissionRingSize, completionRingSize);
+    m_ringsMemory = mmap(nullptr, m_ringsMemorySize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fileDescriptor, IORING_OFF_SQ_RING);
+    if (m_ringsMemory == MAP_FAILED) {
+        m_ringsMemory = nullptr;
+        return detail::GetIoUringLastError();
+    }
+
+    m_submissionQueueEntriesSize = parameters.sq_entries * sizeof(io_uring_sqe);
+    void* submissionQueueEntries = mmap(nullptr, m_submissionQueueEntriesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fileDescriptor, IORING_OFF_SQES);
+    if (submissionQueueEntries == MAP_FAILED) {
+        return detail::GetIoUringLastError();
+    }
+    m_submissionQueueEntries = static_cast<io_uring_sqe*>(submissionQueueEntries);
+
+    m_submissionQueueHead = detail::GetIoUringRingField<uint32_t>(m_ringsMemory, parameters.sq_off.head);
+    m_submissionQueueTail = detail::GetIoUringRingField<uint32_t>(m_ringsMemory, parameters.sq_off.tail);
+    m_submissionQueueArray = detail::GetIoUringRingField<uint32_t>(m_ringsMemory, parameters.sq_off.array);
+    m_submissionQueueMask = *detail::GetIoUringRingField<uint32_t>(m_ringsMemory, parameters.sq_off.ring_mask);
+    m_submissionQueueNumberOfEntries = parameters.sq_entries;
+    m_submissionQueueTailLocal = *m_submissionQueueTail;
+
+    m_completionQueueHead = detail::GetIoUringRingField<uint32_t>(m_ringsMemory, parameters.cq_off.head);
+    m_completionQueueTail = detail::GetIoUringRingField<uint32_t>(m_ringsMemory, parameters.cq_off.tail);
+    m_completionQueueEntries = detail::GetIoUringRingField<io_uring_cqe>(m_ringsMemory, parameters.cq_off.cqes);
+    m_completionQueueMask = *detail::GetIoUringRingField<uint32_t>(m_ringsMemory, parameters.cq_off.ring_mask);
+
+    // Submission queue entries are always used in ring order, so the indirection array maps each slot to itself.
+    for (uint32_t i = 0; i < parameters.sq_entries; i++) {
+        m_submissionQueueArray[i] = i;
+    }
+
+    return {};
+}
+
+io_uring_sqe*
+IoUring::GetSubmissionQueueEntry() noexcept
+{
+    const uint32_t head = std::atomic_ref(*m_submissionQueueHead).load(std::memory_order_acquire);
+    if (m_submissionQueueTailLocal - head >= m_submissionQueueNumberOfEntries) {
+        return nullptr;
+    }
+
+    auto* entry = &m_submissionQueueEntries[m_submissionQueueTailLocal & m_submissionQueueMask];
+    m_submissionQueueTailLocal++;
+    m_numberOfEntriesPrepared++;
+
+    *entry = io_uring_sqe{};
+    return entry;
+}
+
+std::error_code
+IoUring::Submit(uint32_t minimumNumberOfCompletions, std::chrono::milliseconds timeout) noexcept
+{
+    // Publish the prepared entries before the kernel reads the tail.
+    std::atomic_ref(*m_submissionQueueTail).store(m_submissionQueueTailLocal, std::memory_order_release);
+
+    uint32_t flags{ 0 };
+    io_uring_getevents_arg arguments{};
+    timespec timeoutSpec{};
+    if (minimumNumberOfCompletions > 0) {
+        const auto timeoutSeconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+        timeoutSpec.tv_sec = timeoutSeconds.count();
+        timeoutSpec.tv_nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(timeout - timeoutSeconds).count();
+        arguments.sigmask_sz = _NSIG / 8;
+        arguments.ts = reinterpret_cast<uint64_t>(&timeoutSpec); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        flags = IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+    } else if (m_numberOfEntriesPrepared == 0) {
+        return {};
+    }
+
+    const auto numberOfEntriesSubmitted = syscall(SYS_io_uring_enter, m_fileDescriptor, m_numberOfEntriesPrepared, minimumNumberOfCompletions, flags, &arguments, sizeof(arguments));
+    if (numberOfEntriesSubmitted < 0) {
+        if (errno == ETIME || errno == EINTR) {
+            return {};
+        }
+        return detail::GetIoUringLastError();
+    }
+
+    m_numberOfEntriesPrepared -= static_cast<uint32_t>(numberOfEntriesSubmitted);
+    return {};
+}
+
+std::error_code
+IoUring::RegisterBuffers(std::span<const iovec> buffers) noexcept
+{
+    if (syscall(SYS_io_uring_register, m_fileDescriptor, IORING_REGISTER_BUFFERS, std::data(buffers), std::size(buffers)) < 0) {
+        return detail::GetIoUringLastError();
+    }
+
+    return {};
+}
+
+std::error_code
+IoUring::RegisterBufferRing(uint16_t numberOfBuffers, std::size_t bufferSize)
+{
+    if (m_bufferRingMemory != nullptr || numberOfBuffers == 0 || (numberOfBuffers & (numberOfBuffers - 1)) != 0) {
+        return std::make_error_code(std::errc::invalid_argument);
+    }
+
+    // The ring must be page-aligned, which anonymous mappings are.
+    m_bufferRingMemorySize = numberOfBuffers * sizeof(io_uring_buf);
+    m_bufferRingMemory = mmap(nullptr, m_bufferRingMemorySize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (m_bufferRingMemory == MAP_FAILED) {
+        m_bufferRingMemory = nullptr;
+        return detail::GetIoUringLastError();
+    }
+
+    io_uring_buf_reg registration{};
+    registration.ring_addr = reinterpret_cast<uint64_t>(m_bufferRingMemory); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    registration.ring_entries = numberOfBuffers;
+    registration.bgid = BufferGroupId;
+    if (syscall(SYS_io_uring_register, m_fileDescriptor, IORING_REGISTER_PBUF_RING, &registration, 1) < 0) {
+        const auto error = detail::GetIoUringLastError();
+        munmap(m_bufferRingMemory, m_bufferRingMemorySize);
+        m_bufferRingMemory = nullptr;
+        return error;
+    }
+
+    m_buffers.resize(numberOfBuffers * bufferSize);
+    m_bufferSize = bufferSize;
+    m_numberOfBuffers = numberOfBuffers;
+    for (uint16_t bufferId = 0; bufferId < numberOfBuffers; bufferId++) {
+        RecycleBuffer(bufferId);
+    }
+
+    return {};
+}
+
+std::span<const char>
+IoUring::GetBuffer(uint16_t bufferId, std::size_t size) const noexcept
+{
+    return std::span<const char>(m_buffers).subspan(bufferId * m_bufferSize, std::min(size, m_bufferSize));
+}
+
+void
+IoUring::RecycleBuffer(uint16_t bufferId) noexcept
+{
+    // The ring is indexed as a plain array since the bufs member of io_uring_buf_ring is declared in a way that, in
+    // C++, places it after an empty struct occupying a byte, rather than at the start of the ring.
+    auto* bufferRing = static_cast<io_uring_buf_ring*>(m_bufferRingMemory);
+    auto& buffer = static_cast<io_uring_buf*>(m_bufferRingMemory)[m_bufferRingTailLocal & (m_numberOfBuffers - 1)];
+    buffer.addr = reinterpret_cast<uint64_t>(std::data(m_buffers) + (bufferId * m_bufferSize)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    buffer.len = static_cast<uint32_t>(m_bufferSize);
+    buffer.bid = bufferId;
+
+    // Publish the buffer before the kernel reads the tail.
+    m_bufferRingTailLocal++;
+    std::atomic_ref(bufferRing->tail).store(m_bufferRingTailLocal, std::memory_order_release);
+}
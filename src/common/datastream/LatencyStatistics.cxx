@@ -0,0 +1,52 @@
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+#include <microsoft/net/remote/datastream/Histogram.hxx>
+#include <microsoft/net/remote/datastream/LatencyStatistics.hxx>
+
+using namespace Microsoft::Net::Remote::DataStream;
+
+void
+LatencyStatistics::Record(TimePoint timeClientSent, TimePoint timeServerReceived, TimePoint timeServerSent, TimePoint timeClientReceived) noexcept
+{
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+
+    // The client and server clocks are only compared to each other through the offset; each interval below is measured
+    // entirely by a single clock.
+    const auto timeServer = timeServerSent - timeServerReceived;
+    const auto roundTripTime = std::max(microseconds{ 0 }, duration_cast<microseconds>((timeClientReceived - timeClientSent) - timeServer));
+    const auto clockOffset = duration_cast<microseconds>(((timeServerReceived - timeClientSent) + (timeServerSent - timeClientReceived)) / 2);
+
+    if (m_roundTripTimeHistogram.GetCount() == 0 || roundTripTime < m_roundTripTimeMinimum) {
+        m_roundTripTimeMinimum = roundTripTime;
+        m_clockOffset = clockOffset;
+    }
+
+    m_roundTripTimeHistogram.Record(static_cast<uint64_t>(roundTripTime.count()));
+}
+
+uint64_t
+LatencyStatistics::GetCount() const noexcept
+{
+    return m_roundTripTimeHistogram.GetCount();
+}
+
+const Histogram&
+LatencyStatistics::GetRoundTripTimeHistogram() const noexcept
+{
+    return m_roundTripTimeHistogram;
+}
+
+std::optional<std::chrono::microseconds>
+LatencyStatistics::GetClockOffset() const noexcept
+{
+    if (m_roundTripTimeHistogram.GetCount() == 0) {
+        return std::nullopt;
+    }
+
+    return m_clockOffset;
+}
@@ -0,0 +1,115 @@
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <span>
+#include <string>
+
+#include <microsoft/net/remote/datastream/RandomDataGenerator.hxx>
+
+using namespace Microsoft::Net::Remote::DataStream;
+
+namespace detail
+{
+/**
+ * @brief Advance a SplitMix64 state and return its next output. This is used to expand a single seed into the full
+ * xoshiro256** state, as recommended by its authors.
+ *
+ * @param state The SplitMix64 state.
+ * @return uint64_t
+ */
+constexpr uint64_t
+SplitMix64Next(uint64_t& state) noexcept
+{
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27U)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31U);
+}
+} // namespace detail
+
+RandomDataGenerator::RandomDataGenerator()
+{
+    std::random_device randomDevice{};
+    const uint64_t seed = (static_cast<uint64_t>(randomDevice()) << 32U) | randomDevice();
+    Seed(seed);
+}
+
+RandomDataGenerator::RandomDataGenerator(uint64_t seed) noexcept
+{
+    Seed(seed);
+}
+
+void
+RandomDataGenerator::Seed(uint64_t seed) noexcept
+{
+    uint64_t splitMixState = seed;
+    for (auto& stateWord : m_state) {
+        for (auto& lane : stateWord) {
+            lane = detail::SplitMix64Next(splitMixState);
+        }
+    }
+}
+
+void
+RandomDataGenerator::NextBlock(std::array<uint64_t, NumberOfLanes>& block) noexcept
+{
+    auto& [s0, s1, s2, s3] = m_state;
+
+    // The loop body is the xoshiro256** step. Each lane is independent, so this loop is a candidate for vectorization.
+    for (std::size_t lane = 0; lane < NumberOfLanes; lane++) {
+        block[lane] = std::rotl(s1[lane] * 5, 7) * 9;
+
+        const uint64_t t = s1[lane] << 17U;
+        s2[lane] ^= s0[lane];
+        s3[lane] ^= s1[lane];
+        s1[lane] ^= s2[lane];
+        s0[lane] ^= s3[lane];
+        s2[lane] ^= t;
+        s3[lane] = std::rotl(s3[lane], 45);
+    }
+
+    // Keep the byte sequence independent of the host byte order so that seeded data can be verified by any peer.
+    if constexpr (std::endian::native == std::endian::big) {
+        for (auto& value : block) {
+            value = std::byteswap(value);
+        }
+    }
+}
+
+void
+RandomDataGenerator::Fill(std::span<uint8_t> data) noexcept
+{
+    std::array<uint64_t, NumberOfLanes> block{};
+    auto* destination = std::data(data);
+    std::size_t remaining = std::size(data);
+
+    while (remaining >= BlockSize) {
+        NextBlock(block);
+        std::memcpy(destination, std::data(block), BlockSize);
+        destination += BlockSize;
+        remaining -= BlockSize;
+    }
+
+    if (remaining > 0) {
+        NextBlock(block);
+        std::memcpy(destination, std::data(block), remaining);
+    }
+}
+
+void
+RandomDataGenerator::Fill(std::span<char> data) noexcept
+{
+    Fill(std::span<uint8_t>(reinterpret_cast<uint8_t*>(std::data(data)), std::size(data)));
+}
+
+std::string
+RandomDataGenerator::Generate(std::size_t length)
+{
+    std::string data(length, '\0');
+    Fill(std::span<char>(data));
+    return data;
+}
@@ -0,0 +1,1502 @@
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <csignal>
+#include <cstring>
+#include <format>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <ifaddrs.h>
+#include <linux/errqueue.h>
+#include <linux/io_uring.h>
+#include <linux/perf_event.h>
+#include <net/if.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/sendfile.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <microsoft/net/remote/datastream/IoUring.hxx>
+#include <microsoft/net/remote/datastream/RandomDataGenerator.hxx>
+#include <microsoft/net/remote/datastream/RawStream.hxx>
+#include <microsoft/net/remote/datastream/SequenceTracker.hxx>
+#include <microsoft/net/remote/datastream/TokenBucket.hxx>
+
+using namespace Microsoft::Net::Remote::DataStream;
+
+namespace detail
+{
+/**
+ * @brief The longest a stream thread blocks before checking whether it should stop.
+ */
+constexpr auto RawStreamPollInterval{ std::chrono::milliseconds(100) };
+
+/**
+ * @brief The longest burst a paced sender may send after an idle period.
+ */
+constexpr auto RawStreamBurstDuration{ std::chrono::milliseconds(10) };
+
+/**
+ * @brief The receive buffer size requested for UDP receivers, which absorbs bursts that would otherwise be dropped.
+ */
+constexpr int RawStreamUdpReceiveBufferSize{ 4 * 1024 * 1024 };
+
+/**
+ * @brief The number of datagrams a UDP sender sends to end the stream, since any one of them may be lost.
+ */
+constexpr std::size_t RawStreamUdpNumberOfEndDatagrams{ 3 };
+
+/**
+ * @brief The longest a zero-copy sender waits for the kernel to report it is done with outstanding sends once it stops
+ * sending.
+ */
+constexpr auto RawStreamZeroCopyCompletionTimeout{ std::chrono::seconds(1) };
+
+/**
+ * @brief The number of writes an io_uring sender keeps in flight, which is also the number submitted per system call
+ * when unpaced.
+ */
+constexpr uint32_t RawStreamIoUringQueueDepth{ 32 };
+
+/**
+ * @brief The number of buffers an io_uring receiver provides to the kernel.
+ */
+constexpr uint16_t RawStreamIoUringNumberOfBuffers{ 32 };
+
+/**
+ * @brief The number of submission queue entries of an io_uring receiver, which only has a receive and its cancelation
+ * outstanding.
+ */
+constexpr uint32_t RawStreamIoUringReceiveQueueDepth{ 4 };
+
+/**
+ * @brief The longest an io_uring stream waits for outstanding operations, which reference its buffers, to be canceled.
+ */
+constexpr auto RawStreamIoUringCancelTimeout{ std::chrono::seconds(1) };
+
+/**
+ * @brief The user data identifying the receive of io_uring receivers, and the cancelations of all io_uring streams.
+ */
+constexpr uint64_t RawStreamIoUringReceiveUserData{ 1 };
+constexpr uint64_t RawStreamIoUringCancelUserData{ 2 };
+
+/**
+ * @brief The shift of the write number in the user data of io_uring writes, below which is the index of the buffer the
+ * write is from. Numbering writes gives each its own user data, so each can be canceled on its own.
+ */
+constexpr unsigned RawStreamIoUringWriteNumberShift{ 16 };
+
+/**
+ * @brief Describe the error of a failed socket operation, from errno.
+ *
+ * @param operation The name of the operation that failed.
+ * @return std::string
+ */
+std::string
+DescribeSocketError(std::string_view operation)
+{
+    const auto error = errno;
+    return std::format("{} failed ({})", operation, std::system_category().message(error));
+}
+
+/**
+ * @brief Determine whether a socket operation failed only because it timed out or was interrupted, and may be retried.
+ *
+ * @return true If the operation may be retried.
+ * @return false Otherwise.
+ */
+bool
+IsSocketErrorTransient() noexcept
+{
+    return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+}
+
+/**
+ * @brief Resolve the address of an endpoint of a raw stream.
+ *
+ * @param configuration The configuration of the endpoint.
+ * @param address The resolved address.
+ * @param addressLength The length of the resolved address.
+ * @return std::string Describes the error if the address could not be resolved, otherwise empty.
+ */
+std::string
+ResolveRawStreamAddress(const RawStreamConfiguration& configuration, sockaddr_storage& address, socklen_t& addressLength)
+{
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = (configuration.Protocol == RawStreamProtocol::Tcp) ? SOCK_STREAM : SOCK_DGRAM;
+    hints.ai_flags = (configuration.Role == RawStreamRole::Receiver) ? AI_PASSIVE : 0;
+
+    const auto port = std::to_string(configuration.Port);
+    const char* host = std::empty(configuration.Address) ? nullptr : configuration.Address.c_str();
+
+    addrinfo* addresses{ nullptr };
+    const auto error = getaddrinfo(host, port.c_str(), &hints, &addresses);
+    if (error != 0 || addresses == nullptr) {
+        return std::format("Failed to resolve address '{}' ({})", configuration.Address, gai_strerror(error));
+    }
+
+    std::memcpy(&address, addresses->ai_addr, addresses->ai_addrlen);
+    addressLength = addresses->ai_addrlen;
+    freeaddrinfo(addresses);
+
+    return {};
+}
+
+/**
+ * @brief Determine whether an address is the wildcard address, which matches all local addresses.
+ *
+ * @param address The address.
+ * @return true If the address is the wildcard address.
+ * @return false Otherwise.
+ */
+bool
+IsRawStreamAddressAny(const sockaddr_storage& address) noexcept
+{
+    switch (address.ss_family) {
+    case AF_INET:
+        return reinterpret_cast<const sockaddr_in*>(&address)->sin_addr.s_addr == htonl(INADDR_ANY); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    case AF_INET6:
+        return IN6_IS_ADDR_UNSPECIFIED(&reinterpret_cast<const sockaddr_in6*>(&address)->sin6_addr); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Get an address of a network interface.
+ *
+ * @param interfaceName The name of the interface.
+ * @param family The address family of the address to get.
+ * @param port The port to set in the address.
+ * @param address The address of the interface.
+ * @param addressLength The length of the address of the interface.
+ * @return std::string Describes the error if the interface has no address of the family, otherwise empty.
+ */
+std::string
+GetRawStreamInterfaceAddress(const std::string& interfaceName, sa_family_t family, uint16_t port, sockaddr_storage& address, socklen_t& addressLength)
+{
+    ifaddrs* interfaceAddresses{ nullptr };
+    if (getifaddrs(&interfaceAddresses) != 0) {
+        return DescribeSocketError("getifaddrs");
+    }
+
+    bool isFound{ false };
+    for (const auto* interfaceAddress = interfaceAddresses; interfaceAddress != nullptr && !isFound; interfaceAddress = interfaceAddress->ifa_next) {
+        if (interfaceAddress->ifa_addr == nullptr || interfaceAddress->ifa_addr->sa_family != family || interfaceName != interfaceAddress->ifa_name) {
+            continue;
+        }
+
+        addressLength = (family == AF_INET) ? sizeof(sockaddr_in) : sizeof(sockaddr_in6);
+        std::memcpy(&address, interfaceAddress->ifa_addr, addressLength);
+        isFound = true;
+    }
+    freeifaddrs(interfaceAddresses);
+
+    if (!isFound) {
+        return std::format("Network interface '{}' has no {} address", interfaceName, (family == AF_INET) ? "IPv4" : "IPv6");
+    }
+
+    if (family == AF_INET) {
+        reinterpret_cast<sockaddr_in*>(&address)->sin_port = htons(port); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    } else {
+        reinterpret_cast<sockaddr_in6*>(&address)->sin6_port = htons(port); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    }
+
+    return {};
+}
+
+/**
+ * @brief Restrict the traffic of a raw stream socket to a network interface.
+ *
+ * The socket is bound to the interface with SO_BINDTODEVICE where permitted. Otherwise, which is the case without
+ * CAP_NET_RAW on kernels older than 5.7, the address of the interface is used instead: senders bind to it, so it is the
+ * source address of their traffic, and receivers listening on all addresses listen on it alone.
+ *
+ * @param socket The socket, which must not be bound or connected yet.
+ * @param configuration The configuration of the stream.
+ * @param address The address to be bound to (receivers) or connected to (senders), which may be updated.
+ * @param addressLength The length of the address, which may be updated.
+ * @return std::string Describes the error if the socket could not be restricted to the interface, otherwise empty.
+ */
+std::string
+BindRawStreamSocketToInterface(int socket, const RawStreamConfiguration& configuration, sockaddr_storage& address, socklen_t& addressLength)
+{
+    const auto& interfaceName = configuration.InterfaceName;
+    if (std::size(interfaceName) >= IFNAMSIZ || if_nametoindex(interfaceName.c_str()) == 0) {
+        return std::format("Network interface '{}' not found", interfaceName);
+    }
+
+    if (setsockopt(socket, SOL_SOCKET, SO_BINDTODEVICE, interfaceName.c_str(), static_cast<socklen_t>(std::size(interfaceName))) == 0) {
+        return {};
+    }
+    if (errno != EPERM) {
+        return DescribeSocketError("setsockopt(SO_BINDTODEVICE)");
+    }
+
+    const bool isReceiver = (configuration.Role == RawStreamRole::Receiver);
+    if (isReceiver && !IsRawStreamAddressAny(address)) {
+        // The receiver already listens on a single address, which selects the interface.
+        return {};
+    }
+
+    sockaddr_storage interfaceAddress{};
+    socklen_t interfaceAddressLength{};
+    auto errorMessage = GetRawStreamInterfaceAddress(interfaceName, address.ss_family, isReceiver ? configuration.Port : 0, interfaceAddress, interfaceAddressLength);
+    if (!std::empty(errorMessage)) {
+        return errorMessage;
+    }
+
+    if (isReceiver) {
+        address = interfaceAddress;
+        addressLength = interfaceAddressLength;
+    } else if (bind(socket, reinterpret_cast<const sockaddr*>(&interfaceAddress), interfaceAddressLength) != 0) { // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        return DescribeSocketError("bind");
+    }
+
+    return {};
+}
+
+/**
+ * @brief The marking of the packets of a traffic class.
+ */
+struct RawStreamTrafficClassMarking
+{
+    int Dscp;
+    int Priority;
+};
+
+/**
+ * @brief Get the marking of the packets of a traffic class, as mapped from WMM access categories by RFC 8325.
+ *
+ * @param trafficClass The traffic class.
+ * @return RawStreamTrafficClassMarking
+ */
+constexpr RawStreamTrafficClassMarking
+GetRawStreamTrafficClassMarking(RawStreamTrafficClass trafficClass) noexcept
+{
+    switch (trafficClass) {
+    case RawStreamTrafficClass::Background:
+        return { .Dscp = 8, .Priority = 1 };
+    case RawStreamTrafficClass::Video:
+        return { .Dscp = 34, .Priority = 4 };
+    case RawStreamTrafficClass::Voice:
+        return { .Dscp = 46, .Priority = 6 };
+    case RawStreamTrafficClass::BestEffort:
+    default:
+        return { .Dscp = 0, .Priority = 0 };
+    }
+}
+
+/**
+ * @brief Mark the packets of a raw stream socket for a traffic class.
+ *
+ * @param socket The socket.
+ * @param family The address family of the socket.
+ * @param trafficClass The traffic class.
+ * @return std::string Describes the error if the socket could not be marked, otherwise empty.
+ */
+std::string
+SetRawStreamTrafficClass(int socket, sa_family_t family, RawStreamTrafficClass trafficClass)
+{
+    const auto marking = GetRawStreamTrafficClassMarking(trafficClass);
+
+    // The DSCP occupies the upper 6 bits of the former IPv4 TOS and IPv6 traffic class octets.
+    const int trafficClassOctet = marking.Dscp << 2;
+    if (family == AF_INET6) {
+        if (setsockopt(socket, IPPROTO_IPV6, IPV6_TCLASS, &trafficClassOctet, sizeof(trafficClassOctet)) != 0) {
+            return DescribeSocketError("setsockopt(IPV6_TCLASS)");
+        }
+        // IPv4 packets sent from dual-stack sockets use the IPv4 setting, which IPv6-only sockets reject.
+        setsockopt(socket, IPPROTO_IP, IP_TOS, &trafficClassOctet, sizeof(trafficClassOctet));
+    } else if (setsockopt(socket, IPPROTO_IP, IP_TOS, &trafficClassOctet, sizeof(trafficClassOctet)) != 0) {
+        return DescribeSocketError("setsockopt(IP_TOS)");
+    }
+
+    if (setsockopt(socket, SOL_SOCKET, SO_PRIORITY, &marking.Priority, sizeof(marking.Priority)) != 0) {
+        return DescribeSocketError("setsockopt(SO_PRIORITY)");
+    }
+
+    return {};
+}
+
+/**
+ * @brief Get the local port a socket is bound to.
+ *
+ * @param socket The socket.
+ * @return uint16_t The port, or 0 if it could not be determined.
+ */
+uint16_t
+GetSocketPort(int socket) noexcept
+{
+    sockaddr_storage address{};
+    socklen_t addressLength{ sizeof(address) };
+    if (getsockname(socket, reinterpret_cast<sockaddr*>(&address), &addressLength) != 0) { // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        return 0;
+    }
+
+    switch (address.ss_family) {
+    case AF_INET:
+        return ntohs(reinterpret_cast<const sockaddr_in*>(&address)->sin_port); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    case AF_INET6:
+        return ntohs(reinterpret_cast<const sockaddr_in6*>(&address)->sin6_port); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief Bound the time blocking sends and receives on a socket may take, so stream threads notice stop requests.
+ *
+ * @param socket The socket.
+ */
+void
+SetSocketTimeouts(int socket) noexcept
+{
+    const timeval timeout{
+        .tv_sec = 0,
+        .tv_usec = std::chrono::duration_cast<std::chrono::microseconds>(RawStreamPollInterval).count(),
+    };
+
+    setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(socket, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+}
+
+/**
+ * @brief Write a 64-bit value in network byte order.
+ *
+ * @param data The buffer to write to, which must hold at least 8 bytes.
+ * @param value The value to write.
+ */
+void
+StoreUint64(std::span<char> data, uint64_t value) noexcept
+{
+    for (std::size_t i = 0; i < sizeof(value); i++) {
+        data[i] = static_cast<char>(value >> ((sizeof(value) - 1 - i) * 8));
+    }
+}
+
+/**
+ * @brief Read a 64-bit value in network byte order.
+ *
+ * @param data The buffer to read from, which must hold at least 8 bytes.
+ * @return uint64_t
+ */
+uint64_t
+LoadUint64(std::span<const char> data) noexcept
+{
+    uint64_t value{ 0 };
+    for (std::size_t i = 0; i < sizeof(value); i++) {
+        value = (value << 8) | static_cast<uint8_t>(data[i]);
+    }
+
+    return value;
+}
+
+/**
+ * @brief Get the current wall clock time, which senders and receivers on different hosts share up to a fixed offset.
+ *
+ * @return int64_t The number of nanoseconds since the epoch.
+ */
+int64_t
+GetWallClockNanoseconds() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Block SIGPIPE on the calling thread, for system calls that cannot be asked not to raise it when the peer goes
+ * away, such as sendfile() and io_uring writes. EPIPE is then handled like any other error, and any pending signal is
+ * discarded when the thread exits.
+ */
+void
+BlockBrokenPipeSignal() noexcept
+{
+    sigset_t signals{};
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+}
+
+/**
+ * @brief Create the io_uring instance of a raw stream.
+ *
+ * @param numberOfEntries The number of submission queue entries.
+ * @param receiveBufferSize For a receiver, the size of each buffer provided to the kernel. 0 for a sender.
+ * @return std::unique_ptr<IoUring> The instance, or nullptr if io_uring or buffer rings are unavailable.
+ */
+std::unique_ptr<IoUring>
+CreateRawStreamIoUring(uint32_t numberOfEntries, std::size_t receiveBufferSize)
+{
+    std::error_code error{};
+    auto ioUring = IoUring::Create(numberOfEntries, error);
+    if (ioUring != nullptr && receiveBufferSize > 0) {
+        error = ioUring->RegisterBufferRing(RawStreamIoUringNumberOfBuffers, receiveBufferSize);
+        if (error) {
+            return nullptr;
+        }
+    }
+
+    return ioUring;
+}
+
+/**
+ * @brief Get the CPU time used by the calling thread so far.
+ *
+ * @return std::chrono::nanoseconds
+ */
+std::chrono::nanoseconds
+GetThreadCpuTime() noexcept
+{
+    timespec time{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    return std::chrono::seconds(time.tv_sec) + std::chrono::nanoseconds(time.tv_nsec);
+}
+
+/**
+ * @brief Measures the CPU used by the calling thread from the point it is constructed, which must be on that thread.
+ *
+ * CPU cycles are counted with a perf event, including cycles spent in the kernel on behalf of the thread since that is
+ * where the copies avoided by the zero-copy send modes happen. The counter is left unavailable rather than restricted to
+ * user space when the kernel denies that.
+ */
+class RawStreamCpuMeter
+{
+public:
+    RawStreamCpuMeter() noexcept :
+        m_cpuTimeStart(GetThreadCpuTime())
+    {
+        perf_event_attr attributes{};
+        attributes.type = PERF_TYPE_HARDWARE;
+        attributes.size = sizeof(attributes);
+        attributes.config = PERF_COUNT_HW_CPU_CYCLES;
+        attributes.exclude_hv = 1;
+
+        // Count the calling thread (pid 0) on any CPU (-1).
+        m_cycleCounter = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+    }
+
+    ~RawStreamCpuMeter()
+    {
+        if (m_cycleCounter >= 0) {
+            close(m_cycleCounter);
+        }
+    }
+
+    RawStreamCpuMeter(const RawStreamCpuMeter&) = delete;
+
+    RawStreamCpuMeter(RawStreamCpuMeter&&) = delete;
+
+    RawStreamCpuMeter&
+    operator=(const RawStreamCpuMeter&) = delete;
+
+    RawStreamCpuMeter&
+    operator=(RawStreamCpuMeter&&) = delete;
+
+    /**
+     * @brief Record the CPU used so far in a result, relative to the number of bytes it transferred.
+     *
+     * @param result The result to update.
+     */
+    void
+    Update(RawStreamResult& result) const noexcept
+    {
+        result.CpuTime = GetThreadCpuTime() - m_cpuTimeStart;
+
+        uint64_t numberOfCycles{ 0 };
+        if (m_cycleCounter >= 0 && result.NumberOfBytes > 0 && read(m_cycleCounter, &numberOfCycles, sizeof(numberOfCycles)) == sizeof(numberOfCycles)) {
+            result.CpuCyclesPerByte = static_cast<double>(numberOfCycles) / static_cast<double>(result.NumberOfBytes);
+        }
+    }
+
+private:
+    std::chrono::nanoseconds m_cpuTimeStart;
+    int m_cycleCounter{ -1 };
+};
+
+/**
+ * @brief Create an in-memory file holding data, for use with sendfile().
+ *
+ * @param data The content of the file.
+ * @return int The file descriptor of the file, or -1 if it could not be created, with errno set.
+ */
+int
+CreateRawStreamMemoryFile(std::span<const char> data) noexcept
+{
+    const int memoryFile = memfd_create("netremote-raw-stream", MFD_CLOEXEC);
+    if (memoryFile < 0) {
+        return -1;
+    }
+
+    while (!std::empty(data)) {
+        const auto numberOfBytesWritten = write(memoryFile, std::data(data), std::size(data));
+        if (numberOfBytesWritten < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            const auto error = errno;
+            close(memoryFile);
+            errno = error;
+            return -1;
+        }
+        data = data.subspan(static_cast<std::size_t>(numberOfBytesWritten));
+    }
+
+    return memoryFile;
+}
+
+/**
+ * @brief Collect the notifications of completed zero-copy sends from the error queue of a socket, without blocking.
+ *
+ * Each zero-copy send is assigned the next of a sequence of 32-bit identifiers, and each notification covers an
+ * inclusive range of them.
+ *
+ * @param socket The socket to collect notifications from.
+ * @param result The result in which to count the completed sends.
+ */
+void
+ReapZeroCopyCompletions(int socket, RawStreamResult& result) noexcept
+{
+    // Large enough for the IPv6 variant, which appends the address of the offender.
+    std::array<char, CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6))> control{};
+
+    for (;;) {
+        msghdr message{};
+        message.msg_control = std::data(control);
+        message.msg_controllen = std::size(control);
+        if (recvmsg(socket, &message, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) {
+            return;
+        }
+
+        for (auto* controlMessage = CMSG_FIRSTHDR(&message); controlMessage != nullptr; controlMessage = CMSG_NXTHDR(&message, controlMessage)) {
+            const bool isIpError = (controlMessage->cmsg_level == SOL_IP && controlMessage->cmsg_type == IP_RECVERR) || (controlMessage->cmsg_level == SOL_IPV6 && controlMessage->cmsg_type == IPV6_RECVERR);
+            if (!isIpError) {
+                continue;
+            }
+
+            sock_extended_err error{};
+            std::memcpy(&error, CMSG_DATA(controlMessage), sizeof(error));
+            if (error.ee_origin != SO_EE_ORIGIN_ZEROCOPY || error.ee_errno != 0) {
+                continue;
+            }
+
+            const uint64_t numberOfSendsCompleted = static_cast<uint32_t>(error.ee_data - error.ee_info) + uint64_t{ 1 };
+            result.NumberOfZeroCopySendsCompleted += numberOfSendsCompleted;
+            if ((error.ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0) {
+                result.NumberOfZeroCopySendsCopied += numberOfSendsCompleted;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Wait for the error queue of a socket to hold zero-copy completion notifications.
+ *
+ * @param socket The socket to wait on.
+ * @param timeout The maximum time to wait.
+ */
+void
+AwaitZeroCopyCompletions(int socket, std::chrono::milliseconds timeout) noexcept
+{
+    // Error queue readiness is always reported, as POLLERR, so no events are requested.
+    pollfd pollDescriptor{ .fd = socket, .events = 0, .revents = 0 };
+    poll(&pollDescriptor, 1, static_cast<int>(timeout.count()));
+}
+
+/**
+ * @brief Compute the mean of durations.
+ *
+ * @param totalNanoseconds The sum of the durations, in nanoseconds.
+ * @param count The number of durations.
+ * @return double The mean in microseconds, or 0 if there are no durations.
+ */
+double
+ComputeRawStreamMeanMicroseconds(int64_t totalNanoseconds, uint64_t count) noexcept
+{
+    if (count == 0) {
+        return 0;
+    }
+
+    return static_cast<double>(totalNanoseconds) / static_cast<double>(count) / 1000;
+}
+
+/**
+ * @brief Compute the goodput of a raw stream.
+ *
+ * @param result The result of the stream.
+ * @return uint64_t The goodput in bits per second, or 0 if the duration is not positive.
+ */
+uint64_t
+ComputeRawStreamGoodputBitsPerSecond(const RawStreamResult& result) noexcept
+{
+    const std::chrono::duration<double> durationSeconds = result.Duration;
+    if (durationSeconds.count() <= 0) {
+        return 0;
+    }
+
+    return static_cast<uint64_t>(static_cast<double>(result.NumberOfBytes) * 8 / durationSeconds.count());
+}
+} // namespace detail
+
+RawStream::RawStream(std::string id, RawStreamConfiguration configuration) :
+    m_id(std::move(id)),
+    m_configuration(std::move(configuration))
+{
+}
+
+RawStream::~RawStream()
+{
+    Stop();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    if (m_socket >= 0) {
+        close(m_socket);
+    }
+}
+
+bool
+RawStream::Start()
+{
+    const bool isTcp = (m_configuration.Protocol == RawStreamProtocol::Tcp);
+    const bool isReceiver = (m_configuration.Role == RawStreamRole::Receiver);
+
+    const auto fail = [this](std::string errorMessage) {
+        if (m_socket >= 0) {
+            close(m_socket);
+            m_socket = -1;
+        }
+        Complete({}, std::move(errorMessage));
+        return false;
+    };
+
+    const auto dataBlockSizeMaximum = isTcp ? RawStreamConfiguration::DataBlockSizeMaximumTcp : RawStreamConfiguration::DataBlockSizeMaximumUdp;
+    const auto dataBlockSizeMinimum = isTcp ? std::size_t{ 1 } : UdpHeaderSize;
+    if (m_configuration.DataBlockSize == 0) {
+        m_configuration.DataBlockSize = isTcp ? RawStreamConfiguration::DataBlockSizeDefaultTcp : RawStreamConfiguration::DataBlockSizeDefaultUdp;
+    }
+    if (m_configuration.DataBlockSize < dataBlockSizeMinimum || m_configuration.DataBlockSize > dataBlockSizeMaximum) {
+        return fail(std::format("Invalid data block size {} (minimum {}, maximum {})", m_configuration.DataBlockSize, dataBlockSizeMinimum, dataBlockSizeMaximum));
+    }
+    if (!isReceiver && (std::empty(m_configuration.Address) || m_configuration.Port == 0)) {
+        return fail("A sender requires an address and port to send to");
+    }
+    if (!isTcp && m_configuration.SendMode != RawStreamSendMode::Copy) {
+        return fail("UDP senders only support copying data");
+    }
+
+    sockaddr_storage address{};
+    socklen_t addressLength{};
+    auto errorMessage = detail::ResolveRawStreamAddress(m_configuration, address, addressLength);
+    if (!std::empty(errorMessage)) {
+        return fail(std::move(errorMessage));
+    }
+
+    m_socket = socket(address.ss_family, (isTcp ? SOCK_STREAM : SOCK_DGRAM) | SOCK_CLOEXEC, 0);
+    if (m_socket < 0) {
+        return fail(detail::DescribeSocketError("socket"));
+    }
+
+    if (!std::empty(m_configuration.InterfaceName)) {
+        errorMessage = detail::BindRawStreamSocketToInterface(m_socket, m_configuration, address, addressLength);
+        if (!std::empty(errorMessage)) {
+            return fail(std::move(errorMessage));
+        }
+    }
+    if (m_configuration.TrafficClass != RawStreamTrafficClass::BestEffort) {
+        errorMessage = detail::SetRawStreamTrafficClass(m_socket, address.ss_family, m_configuration.TrafficClass);
+        if (!std::empty(errorMessage)) {
+            return fail(std::move(errorMessage));
+        }
+    }
+
+    auto* socketAddress = reinterpret_cast<sockaddr*>(&address); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    if (isReceiver) {
+        static constexpr int Enable{ 1 };
+        setsockopt(m_socket, SOL_SOCKET, SO_REUSEADDR, &Enable, sizeof(Enable));
+        if (!isTcp) {
+            setsockopt(m_socket, SOL_SOCKET, SO_RCVBUF, &detail::RawStreamUdpReceiveBufferSize, sizeof(detail::RawStreamUdpReceiveBufferSize));
+        }
+        if (bind(m_socket, socketAddress, addressLength) != 0) {
+            return fail(detail::DescribeSocketError("bind"));
+        }
+        if (isTcp && listen(m_socket, 1) != 0) {
+            return fail(detail::DescribeSocketError("listen"));
+        }
+    } else {
+        // TCP connections are established by the sender thread, so a slow or unreachable receiver doesn't block here.
+        if (isTcp && fcntl(m_socket, F_SETFL, fcntl(m_socket, F_GETFL) | O_NONBLOCK) != 0) {
+            return fail(detail::DescribeSocketError("fcntl"));
+        }
+        if (connect(m_socket, socketAddress, addressLength) != 0 && !(isTcp && errno == EINPROGRESS)) {
+            return fail(detail::DescribeSocketError("connect"));
+        }
+    }
+
+    m_port = detail::GetSocketPort(m_socket);
+    detail::SetSocketTimeouts(m_socket);
+
+    m_thread = std::jthread([this, isReceiver] {
+        if (isReceiver) {
+            RunReceiver();
+        } else {
+            RunSender();
+        }
+    });
+
+    return true;
+}
+
+void
+RawStream::Stop() noexcept
+{
+    m_isStopRequested.store(true, std::memory_order_relaxed);
+}
+
+bool
+RawStream::Await(std::chrono::milliseconds timeout)
+{
+    std::unique_lock lock(m_resultGate);
+    return m_resultCompleted.wait_for(lock, timeout, [this] {
+        return m_result.IsCompleted;
+    });
+}
+
+const std::string&
+RawStream::GetId() const noexcept
+{
+    return m_id;
+}
+
+uint16_t
+RawStream::GetPort() const noexcept
+{
+    return m_port;
+}
+
+RawStreamResult
+RawStream::GetResult() const
+{
+    const std::lock_guard lock(m_resultGate);
+    return m_result;
+}
+
+std::optional<RawStream::Clock::time_point>
+RawStream::GetTimeCompleted() const
+{
+    const std::lock_guard lock(m_resultGate);
+    return m_result.IsCompleted ? std::optional{ m_timeCompleted } : std::nullopt;
+}
+
+const RawStreamConfiguration&
+RawStream::GetConfiguration() const noexcept
+{
+    return m_configuration;
+}
+
+/* static */
+std::vector<RawStreamTrafficClassResult>
+RawStream::GetTrafficClassResults(std::span<const std::shared_ptr<RawStream>> rawStreams)
+{
+    // The weights of the means of the jitter and one-way delay, which only UDP receivers measure, are tracked apart.
+    struct TrafficClassAccumulator
+    {
+        RawStreamTrafficClassResult Result{};
+        uint64_t NumberOfDataBlocksTimed{};
+    };
+
+    std::map<std::pair<RawStreamTrafficClass, RawStreamRole>, TrafficClassAccumulator> accumulators{};
+    for (const auto& rawStream : rawStreams) {
+        const auto& configuration = rawStream->GetConfiguration();
+        const auto rawStreamResult = rawStream->GetResult();
+
+        auto& [result, numberOfDataBlocksTimed] = accumulators[{ configuration.TrafficClass, configuration.Role }];
+        result.TrafficClass = configuration.TrafficClass;
+        result.Role = configuration.Role;
+        result.NumberOfStreams++;
+        result.NumberOfDataBlocks += rawStreamResult.NumberOfDataBlocks;
+        result.NumberOfBytes += rawStreamResult.NumberOfBytes;
+        result.GoodputBitsPerSecond += rawStreamResult.GoodputBitsPerSecond;
+        result.NumberOfDataBlocksLost += rawStreamResult.NumberOfDataBlocksLost;
+
+        if (configuration.Protocol == RawStreamProtocol::Udp && configuration.Role == RawStreamRole::Receiver) {
+            const auto weight = static_cast<double>(rawStreamResult.NumberOfDataBlocks);
+            result.JitterMicroseconds += rawStreamResult.JitterMicroseconds * weight;
+            result.OneWayDelayMicroseconds += rawStreamResult.OneWayDelayMicroseconds * weight;
+            numberOfDataBlocksTimed += rawStreamResult.NumberOfDataBlocks;
+        }
+    }
+
+    std::vector<RawStreamTrafficClassResult> results{};
+    results.reserve(std::size(accumulators));
+    for (auto& [key, accumulator] : accumulators) {
+        if (accumulator.NumberOfDataBlocksTimed > 0) {
+            accumulator.Result.JitterMicroseconds /= static_cast<double>(accumulator.NumberOfDataBlocksTimed);
+            accumulator.Result.OneWayDelayMicroseconds /= static_cast<double>(accumulator.NumberOfDataBlocksTimed);
+        }
+        results.push_back(accumulator.Result);
+    }
+
+    return results;
+}
+
+bool
+RawStream::IsStopped(Clock::time_point timeEnd) const noexcept
+{
+    return m_isStopRequested.load(std::memory_order_relaxed) || Clock::now() >= timeEnd;
+}
+
+void
+RawStream::Publish(const RawStreamResult& result)
+{
+    const std::lock_guard lock(m_resultGate);
+    m_result = result;
+}
+
+void
+RawStream::Complete(RawStreamResult result, std::string errorMessage)
+{
+    result.IsCompleted = true;
+    result.ErrorMessage = std::move(errorMessage);
+
+    const std::lock_guard lock(m_resultGate);
+    m_result = std::move(result);
+    m_timeCompleted = Clock::now();
+    m_resultCompleted.notify_all();
+}
+
+void
+RawStream::RunSender()
+{
+    const bool isTcp = (m_configuration.Protocol == RawStreamProtocol::Tcp);
+    const auto timeStart = Clock::now();
+    const auto timeEnd = timeStart + m_configuration.Duration;
+
+    RawStreamResult result{};
+
+    // Wait for the connection to be established, then switch back to blocking writes, which are bounded by the socket
+    // timeouts.
+    if (isTcp) {
+        pollfd pollDescriptor{ .fd = m_socket, .events = POLLOUT, .revents = 0 };
+        while (poll(&pollDescriptor, 1, detail::RawStreamPollInterval.count()) <= 0) {
+            if (IsStopped(timeEnd)) {
+                Complete(result, "Timed out connecting to the receiver");
+                return;
+            }
+        }
+
+        int error{ 0 };
+        socklen_t errorLength{ sizeof(error) };
+        getsockopt(m_socket, SOL_SOCKET, SO_ERROR, &error, &errorLength);
+        if (error != 0) {
+            Complete(result, std::format("connect failed ({})", std::system_category().message(error)));
+            return;
+        }
+
+        fcntl(m_socket, F_SETFL, fcntl(m_socket, F_GETFL) & ~O_NONBLOCK);
+    }
+
+    std::string data(m_configuration.DataBlockSize, '\0');
+    RandomDataGenerator{}.Fill(std::span<char>(data));
+
+    std::string errorMessage{};
+    int memoryFile{ -1 };
+    uint64_t numberOfZeroCopySends{ 0 };
+
+    // The data is never modified while a TCP sender runs, so zero-copy sends don't need to wait for the kernel to be
+    // done with it before sending it again.
+    switch (isTcp ? m_configuration.SendMode : RawStreamSendMode::Copy) {
+    case RawStreamSendMode::ZeroCopy: {
+        static constexpr int Enable{ 1 };
+        if (setsockopt(m_socket, SOL_SOCKET, SO_ZEROCOPY, &Enable, sizeof(Enable)) != 0) {
+            errorMessage = detail::DescribeSocketError("setsockopt(SO_ZEROCOPY)");
+        }
+        break;
+    }
+    case RawStreamSendMode::Sendfile: {
+        memoryFile = detail::CreateRawStreamMemoryFile(data);
+        if (memoryFile < 0) {
+            errorMessage = detail::DescribeSocketError("memfd_create");
+        }
+
+        detail::BlockBrokenPipeSignal();
+        break;
+    }
+    default:
+        break;
+    }
+
+    std::optional<TokenBucket> tokenBucket{};
+    if (m_configuration.TargetBitrate > 0) {
+        const double bytesPerSecond = static_cast<double>(m_configuration.TargetBitrate) / 8;
+        const double capacity = std::max(static_cast<double>(std::size(data)), bytesPerSecond * std::chrono::duration<double>(detail::RawStreamBurstDuration).count());
+        tokenBucket.emplace(bytesPerSecond, capacity, timeStart);
+    }
+
+    const detail::RawStreamCpuMeter cpuMeter{};
+    const auto updateResult = [&](Clock::time_point timeNow) {
+        if (numberOfZeroCopySends > 0) {
+            detail::ReapZeroCopyCompletions(m_socket, result);
+        }
+        result.Duration = timeNow - timeStart;
+        result.GoodputBitsPerSecond = detail::ComputeRawStreamGoodputBitsPerSecond(result);
+        cpuMeter.Update(result);
+    };
+
+    uint64_t sequenceNumber{ 0 };
+    auto timePublish = timeStart;
+
+    std::unique_ptr<IoUring> ioUring{};
+    if (m_configuration.IoEngine == RawStreamIoEngine::IoUring && m_configuration.SendMode == RawStreamSendMode::Copy && std::empty(errorMessage)) {
+        ioUring = detail::CreateRawStreamIoUring(detail::RawStreamIoUringQueueDepth, 0);
+    }
+    result.IoEngine = (ioUring != nullptr) ? RawStreamIoEngine::IoUring : RawStreamIoEngine::Epoll;
+
+    if (ioUring != nullptr) {
+        errorMessage = SendWithIoUring(*ioUring, data, timeEnd, tokenBucket.has_value() ? &tokenBucket.value() : nullptr, result, [&] {
+            const auto timeNow = Clock::now();
+            if (timeNow - timePublish >= detail::RawStreamPollInterval) {
+                updateResult(timeNow);
+                Publish(result);
+                timePublish = timeNow;
+            }
+        });
+    }
+
+    while (ioUring == nullptr && !IsStopped(timeEnd) && std::empty(errorMessage)) {
+        if (tokenBucket.has_value()) {
+            const auto timeSend = tokenBucket->Reserve(static_cast<double>(std::size(data)));
+            while (Clock::now() < timeSend && !IsStopped(timeEnd)) {
+                std::this_thread::sleep_for(std::min<Clock::duration>(timeSend - Clock::now(), detail::RawStreamPollInterval));
+            }
+            if (IsStopped(timeEnd)) {
+                break;
+            }
+        }
+
+        if (isTcp) {
+            std::size_t offset{ 0 };
+            while (offset < std::size(data) && !IsStopped(timeEnd)) {
+                ssize_t numberOfBytesSent{ 0 };
+                switch (m_configuration.SendMode) {
+                case RawStreamSendMode::ZeroCopy:
+                    numberOfBytesSent = send(m_socket, std::data(data) + offset, std::size(data) - offset, MSG_NOSIGNAL | MSG_ZEROCOPY);
+                    if (numberOfBytesSent >= 0) {
+                        numberOfZeroCopySends++;
+                    }
+                    break;
+                case RawStreamSendMode::Sendfile: {
+                    auto fileOffset = static_cast<off_t>(offset);
+                    numberOfBytesSent = sendfile(m_socket, memoryFile, &fileOffset, std::size(data) - offset);
+                    break;
+                }
+                default:
+                    numberOfBytesSent = send(m_socket, std::data(data) + offset, std::size(data) - offset, MSG_NOSIGNAL);
+                    break;
+                }
+
+                if (numberOfBytesSent < 0) {
+                    if (detail::IsSocketErrorTransient()) {
+                        continue;
+                    }
+                    // The memory pinned by zero-copy sends is limited, and released as their completions are collected.
+                    if (errno == ENOBUFS && m_configuration.SendMode == RawStreamSendMode::ZeroCopy) {
+                        detail::AwaitZeroCopyCompletions(m_socket, detail::RawStreamPollInterval);
+                        detail::ReapZeroCopyCompletions(m_socket, result);
+                        continue;
+                    }
+                    errorMessage = detail::DescribeSocketError(m_configuration.SendMode == RawStreamSendMode::Sendfile ? "sendfile" : "send");
+                    break;
+                }
+                offset += static_cast<std::size_t>(numberOfBytesSent);
+                result.NumberOfBytes += static_cast<uint64_t>(numberOfBytesSent);
+            }
+            if (offset == std::size(data)) {
+                result.NumberOfDataBlocks++;
+            }
+        } else {
+            detail::StoreUint64(std::span<char>(data).first(sizeof(uint64_t)), sequenceNumber + 1);
+            detail::StoreUint64(std::span<char>(data).subspan(sizeof(uint64_t), sizeof(uint64_t)), static_cast<uint64_t>(detail::GetWallClockNanoseconds()));
+
+            const auto numberOfBytesSent = send(m_socket, std::data(data), std::size(data), 0);
+            if (numberOfBytesSent < 0) {
+                // Datagrams that cannot be sent right away, or that follow one the receiver refused, are dropped
+                // without consuming a sequence number.
+                if (detail::IsSocketErrorTransient() || errno == ENOBUFS || errno == ECONNREFUSED) {
+                    continue;
+                }
+                errorMessage = detail::DescribeSocketError("send");
+                break;
+            }
+            sequenceNumber++;
+            result.NumberOfDataBlocks++;
+            result.NumberOfBytes += static_cast<uint64_t>(numberOfBytesSent);
+        }
+
+        const auto timeNow = Clock::now();
+        if (timeNow - timePublish >= detail::RawStreamPollInterval) {
+            updateResult(timeNow);
+            Publish(result);
+            timePublish = timeNow;
+        }
+    }
+
+    const auto timeStop = Clock::now();
+
+    // The time spent waiting for the kernel to be done with outstanding zero-copy sends isn't spent sending.
+    const auto timeCompletionsEnd = timeStop + detail::RawStreamZeroCopyCompletionTimeout;
+    while (result.NumberOfZeroCopySendsCompleted < numberOfZeroCopySends && Clock::now() < timeCompletionsEnd) {
+        detail::AwaitZeroCopyCompletions(m_socket, detail::RawStreamPollInterval);
+        detail::ReapZeroCopyCompletions(m_socket, result);
+    }
+
+    updateResult(timeStop);
+
+    if (isTcp) {
+        shutdown(m_socket, SHUT_WR);
+    } else {
+        std::array<char, UdpHeaderSize> endData{};
+        for (std::size_t i = 0; i < detail::RawStreamUdpNumberOfEndDatagrams; i++) {
+            send(m_socket, std::data(endData), std::size(endData), 0);
+        }
+    }
+
+    if (memoryFile >= 0) {
+        close(memoryFile);
+    }
+
+    Complete(std::move(result), std::move(errorMessage));
+}
+
+std::string
+RawStream::SendWithIoUring(IoUring& ioUring, std::span<const char> data, Clock::time_point timeEnd, TokenBucket* tokenBucket, RawStreamResult& result, const std::function<void()>& onProgress)
+{
+    const bool isTcp = (m_configuration.Protocol == RawStreamProtocol::Tcp);
+    const auto dataBlockSize = std::size(data);
+
+    // TCP streams carry the same data in every write, so all writes share one buffer. Each UDP datagram carries its own
+    // header, so needs its own buffer while in flight.
+    const std::size_t numberOfBuffers = isTcp ? 1 : detail::RawStreamIoUringQueueDepth;
+    std::vector<char> buffers(numberOfBuffers * dataBlockSize);
+    std::vector<iovec> bufferRegistrations(numberOfBuffers);
+    std::vector<uint16_t> buffersAvailable(numberOfBuffers);
+    for (std::size_t i = 0; i < numberOfBuffers; i++) {
+        auto buffer = std::span<char>(buffers).subspan(i * dataBlockSize, dataBlockSize);
+        std::ranges::copy(data, std::begin(buffer));
+        bufferRegistrations[i] = iovec{ .iov_base = std::data(buffer), .iov_len = dataBlockSize };
+        buffersAvailable[i] = static_cast<uint16_t>(numberOfBuffers - 1 - i);
+    }
+
+    // Registering buffers may fail where locked memory is limited, in which case regular sends are used.
+    const bool isRegistered = !ioUring.RegisterBuffers(bufferRegistrations);
+    if (isRegistered) {
+        detail::BlockBrokenPipeSignal();
+    }
+
+    std::string errorMessage{};
+    std::vector<uint64_t> writesInFlight{};
+    writesInFlight.reserve(detail::RawStreamIoUringQueueDepth);
+    uint64_t writeNumber{ 0 };
+    uint64_t sequenceNumber{ 0 };
+    bool isDraining{ false };
+
+    const auto onCompletion = [&](const io_uring_cqe& completion) {
+        if (completion.user_data == detail::RawStreamIoUringCancelUserData) {
+            return;
+        }
+
+        const auto bufferIndex = static_cast<uint16_t>(completion.user_data);
+        if (!isTcp) {
+            buffersAvailable.push_back(bufferIndex);
+        }
+        std::erase(writesInFlight, completion.user_data);
+
+        if (completion.res < 0) {
+            // Datagrams that could not be sent are dropped. Their sequence number was already consumed, so the receiver
+            // counts them as lost. Writes failing once the stream stopped were canceled or cut off by it.
+            const int error = -completion.res;
+            if (isDraining || error == EAGAIN || error == EINTR || error == ECANCELED || (!isTcp && (error == ENOBUFS || error == ECONNREFUSED))) {
+                return;
+            }
+            if (std::empty(errorMessage)) {
+                errorMessage = std::format("{} failed ({})", isRegistered ? "write" : "send", std::system_category().message(error));
+            }
+            return;
+        }
+
+        result.NumberOfBytes += static_cast<uint64_t>(completion.res);
+        if (static_cast<std::size_t>(completion.res) == dataBlockSize) {
+            result.NumberOfDataBlocks++;
+        }
+    };
+
+    while (!IsStopped(timeEnd) && std::empty(errorMessage)) {
+        // Queue writes until the queue is full. Paced writes are instead submitted one at a time, once they are due.
+        while (std::size(writesInFlight) < detail::RawStreamIoUringQueueDepth) {
+            if (tokenBucket != nullptr) {
+                const auto timeSend = tokenBucket->Reserve(static_cast<double>(dataBlockSize));
+                while (Clock::now() < timeSend && !IsStopped(timeEnd)) {
+                    std::this_thread::sleep_for(std::min<Clock::duration>(timeSend - Clock::now(), detail::RawStreamPollInterval));
+                }
+            }
+            if (IsStopped(timeEnd)) {
+                break;
+            }
+
+            const uint16_t bufferIndex = isTcp ? 0 : buffersAvailable.back();
+            if (!isTcp) {
+                buffersAvailable.pop_back();
+            }
+
+            auto buffer = std::span<char>(buffers).subspan(bufferIndex * dataBlockSize, dataBlockSize);
+            if (!isTcp) {
+                detail::StoreUint64(buffer.first(sizeof(uint64_t)), ++sequenceNumber);
+                detail::StoreUint64(buffer.subspan(sizeof(uint64_t), sizeof(uint64_t)), static_cast<uint64_t>(detail::GetWallClockNanoseconds()));
+            }
+
+            auto* entry = ioUring.GetSubmissionQueueEntry();
+            if (isRegistered) {
+                entry->opcode = IORING_OP_WRITE_FIXED;
+                entry->buf_index = bufferIndex;
+            } else {
+                entry->opcode = IORING_OP_SEND;
+                entry->msg_flags = MSG_NOSIGNAL;
+            }
+            entry->fd = m_socket;
+            entry->addr = reinterpret_cast<uint64_t>(std::data(buffer)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+            entry->len = static_cast<uint32_t>(dataBlockSize);
+            entry->user_data = (++writeNumber << detail::RawStreamIoUringWriteNumberShift) | bufferIndex;
+            writesInFlight.push_back(entry->user_data);
+
+            if (tokenBucket != nullptr) {
+                break;
+            }
+        }
+
+        // Submit the queued writes and wait for at least one to complete, with a single system call.
+        if (const auto error = ioUring.Submit(1, detail::RawStreamPollInterval); error) {
+            errorMessage = std::format("io_uring_enter failed ({})", error.message());
+            break;
+        }
+        if (ioUring.ForEachCompletion(onCompletion) > 0) {
+            onProgress();
+        }
+    }
+
+    // The writes in flight reference the buffers, so every one must complete before they are released. Each is canceled
+    // by its user data, which kernels support since 5.5. Writes already under way may not be cancelable, so if they
+    // don't complete in time the socket is shut down, which fails them.
+    isDraining = true;
+    for (const auto write : std::vector<uint64_t>(writesInFlight)) {
+        auto* entry = ioUring.GetSubmissionQueueEntry();
+        if (entry == nullptr) {
+            ioUring.Submit(0, detail::RawStreamPollInterval);
+            ioUring.ForEachCompletion(onCompletion);
+            entry = ioUring.GetSubmissionQueueEntry();
+            if (entry == nullptr) {
+                break;
+            }
+        }
+        entry->opcode = IORING_OP_ASYNC_CANCEL;
+        entry->addr = write;
+        entry->user_data = detail::RawStreamIoUringCancelUserData;
+    }
+
+    const auto timeCancelEnd = Clock::now() + detail::RawStreamIoUringCancelTimeout;
+    bool isShutDown{ false };
+    while (!std::empty(writesInFlight)) {
+        if (!isShutDown && Clock::now() >= timeCancelEnd) {
+            shutdown(m_socket, SHUT_RDWR);
+            isShutDown = true;
+        }
+        ioUring.Submit(1, detail::RawStreamPollInterval);
+        ioUring.ForEachCompletion(onCompletion);
+    }
+
+    return errorMessage;
+}
+
+std::string
+RawStream::ReceiveWithEpoll(int dataSocket, Clock::time_point timeEnd, const DataHandler& onData)
+{
+    const bool isTcp = (m_configuration.Protocol == RawStreamProtocol::Tcp);
+    std::vector<char> data(isTcp ? m_configuration.DataBlockSize : RawStreamConfiguration::DataBlockSizeMaximumUdp);
+
+    const int epoll = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll < 0) {
+        return detail::DescribeSocketError("epoll_create1");
+    }
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = dataSocket;
+    if (epoll_ctl(epoll, EPOLL_CTL_ADD, dataSocket, &event) != 0) {
+        auto errorMessage = detail::DescribeSocketError("epoll_ctl");
+        close(epoll);
+        return errorMessage;
+    }
+
+    std::string errorMessage{};
+    bool isReceiving{ true };
+    while (isReceiving && !IsStopped(timeEnd)) {
+        epoll_event eventReady{};
+        const int numberOfEvents = epoll_wait(epoll, &eventReady, 1, static_cast<int>(detail::RawStreamPollInterval.count()));
+        if (numberOfEvents < 0 && errno != EINTR) {
+            errorMessage = detail::DescribeSocketError("epoll_wait");
+            break;
+        }
+        if (numberOfEvents <= 0) {
+            continue;
+        }
+
+        // Drain the socket before waiting again.
+        while (isReceiving && !IsStopped(timeEnd)) {
+            const auto numberOfBytesReceived = recv(dataSocket, std::data(data), std::size(data), MSG_DONTWAIT);
+            if (numberOfBytesReceived < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                    errorMessage = detail::DescribeSocketError("recv");
+                    isReceiving = false;
+                }
+                break;
+            }
+
+            isReceiving = onData(std::span<const char>(data).first(static_cast<std::size_t>(numberOfBytesReceived)));
+        }
+    }
+
+    close(epoll);
+    return errorMessage;
+}
+
+std::string
+RawStream::ReceiveWithIoUring(IoUring& ioUring, int dataSocket, Clock::time_point timeEnd, const DataHandler& onData)
+{
+    std::string errorMessage{};
+    bool isReceiving{ true };
+    bool isArmed{ false };
+
+    // A single multishot receive produces a completion for each data block, in a buffer picked by the kernel, until it
+    // runs out of buffers or fails.
+    const auto arm = [&] {
+        auto* entry = ioUring.GetSubmissionQueueEntry();
+        entry->opcode = IORING_OP_RECV;
+        entry->fd = dataSocket;
+        entry->ioprio = IORING_RECV_MULTISHOT;
+        entry->flags = IOSQE_BUFFER_SELECT;
+        entry->buf_group = IoUring::BufferGroupId;
+        entry->user_data = detail::RawStreamIoUringReceiveUserData;
+        isArmed = true;
+    };
+
+    const auto onCompletion = [&](const io_uring_cqe& completion) {
+        if (completion.user_data != detail::RawStreamIoUringReceiveUserData) {
+            return;
+        }
+        if ((completion.flags & IORING_CQE_F_MORE) == 0) {
+            isArmed = false;
+        }
+
+        if (completion.res < 0) {
+            // Running out of buffers disarms the receive, which is re-armed once they are recycled.
+            const int error = -completion.res;
+            if (error != ENOBUFS && error != ECANCELED && isReceiving) {
+                errorMessage = std::format("recv failed ({})", std::system_category().message(error));
+                isReceiving = false;
+            }
+            return;
+        }
+
+        std::span<const char> data{};
+        std::optional<uint16_t> bufferId{};
+        if ((completion.flags & IORING_CQE_F_BUFFER) != 0) {
+            bufferId = static_cast<uint16_t>(completion.flags >> IORING_CQE_BUFFER_SHIFT);
+            data = ioUring.GetBuffer(bufferId.value(), static_cast<std::size_t>(completion.res));
+        }
+        if (isReceiving) {
+            isReceiving = onData(data);
+        }
+        if (bufferId.has_value()) {
+            ioUring.RecycleBuffer(bufferId.value());
+        }
+    };
+
+    arm();
+    while (isReceiving && !IsStopped(timeEnd)) {
+        if (const auto error = ioUring.Submit(1, detail::RawStreamPollInterval); error) {
+            errorMessage = std::format("io_uring_enter failed ({})", error.message());
+            break;
+        }
+
+        ioUring.ForEachCompletion(onCompletion);
+        if (!isArmed && isReceiving) {
+            arm();
+        }
+    }
+
+    // The receive references the buffers of the instance, so must complete before they are released.
+    if (isArmed) {
+        auto* entry = ioUring.GetSubmissionQueueEntry();
+        entry->opcode = IORING_OP_ASYNC_CANCEL;
+        entry->addr = detail::RawStreamIoUringReceiveUserData;
+        entry->user_data = detail::RawStreamIoUringCancelUserData;
+
+        const auto timeCancelEnd = Clock::now() + detail::RawStreamIoUringCancelTimeout;
+        while (isArmed && Clock::now() < timeCancelEnd) {
+            ioUring.Submit(1, detail::RawStreamPollInterval);
+            ioUring.ForEachCompletion(onCompletion);
+        }
+    }
+
+    return errorMessage;
+}
+
+void
+RawStream::RunReceiver()
+{
+    const bool isTcp = (m_configuration.Protocol == RawStreamProtocol::Tcp);
+    const auto timeStart = Clock::now();
+    const auto timeEnd = timeStart + m_configuration.Duration;
+
+    RawStreamResult result{};
+
+    // TCP receivers accept a single connection, from the sender.
+    int dataSocket = m_socket;
+    if (isTcp) {
+        pollfd pollDescriptor{ .fd = m_socket, .events = POLLIN, .revents = 0 };
+        while (poll(&pollDescriptor, 1, detail::RawStreamPollInterval.count()) <= 0) {
+            if (IsStopped(timeEnd)) {
+                Complete(result);
+                return;
+            }
+        }
+
+        dataSocket = accept4(m_socket, nullptr, nullptr, SOCK_CLOEXEC);
+        if (dataSocket < 0) {
+            Complete(result, detail::DescribeSocketError("accept"));
+            return;
+        }
+        detail::SetSocketTimeouts(dataSocket);
+    }
+
+    SequenceTracker sequenceTracker{};
+    std::optional<int64_t> transitTimePrevious{};
+    double jitterNanoseconds{ 0 };
+    int64_t transitTimeTotal{ 0 };
+    uint64_t numberOfTransitTimes{ 0 };
+    const detail::RawStreamCpuMeter cpuMeter{};
+
+    Clock::time_point timeFirst{};
+    Clock::time_point timeLast{};
+    auto timePublish = timeStart;
+
+    const auto onData = [&](std::span<const char> data) {
+        const auto timeNow = Clock::now();
+        if (isTcp) {
+            // The sender closed the connection.
+            if (std::empty(data)) {
+                return false;
+            }
+        } else {
+            if (std::size(data) < UdpHeaderSize) {
+                return true;
+            }
+
+            const auto sequenceNumber = detail::LoadUint64(data.first(sizeof(uint64_t)));
+            if (sequenceNumber == 0) {
+                // Ignore end datagrams left over from a previous sender.
+                return (result.NumberOfDataBlocks == 0);
+            }
+
+            sequenceTracker.Record(sequenceNumber);
+
+            // Any offset between the clocks of the sender and receiver cancels out in the variation of transit times.
+            const auto timeSent = static_cast<int64_t>(detail::LoadUint64(data.subspan(sizeof(uint64_t), sizeof(uint64_t))));
+            const auto transitTime = detail::GetWallClockNanoseconds() - timeSent;
+            if (transitTimePrevious.has_value()) {
+                const auto transitTimeVariation = static_cast<double>(std::abs(transitTime - transitTimePrevious.value()));
+                jitterNanoseconds += (transitTimeVariation - jitterNanoseconds) / 16;
+            }
+            transitTimePrevious = transitTime;
+            transitTimeTotal += transitTime;
+            numberOfTransitTimes++;
+        }
+
+        if (result.NumberOfDataBlocks == 0) {
+            timeFirst = timeNow;
+        }
+        timeLast = timeNow;
+        result.NumberOfDataBlocks++;
+        result.NumberOfBytes += std::size(data);
+
+        if (timeNow - timePublish >= detail::RawStreamPollInterval) {
+            result.Duration = timeLast - timeFirst;
+            result.GoodputBitsPerSecond = detail::ComputeRawStreamGoodputBitsPerSecond(result);
+            result.NumberOfDataBlocksLost = sequenceTracker.GetNumberOfDataBlocksLost();
+            result.JitterMicroseconds = jitterNanoseconds / 1000;
+            result.OneWayDelayMicroseconds = detail::ComputeRawStreamMeanMicroseconds(transitTimeTotal, numberOfTransitTimes);
+            cpuMeter.Update(result);
+            Publish(result);
+            timePublish = timeNow;
+        }
+
+        return true;
+    };
+
+    // TCP data arrives in chunks of any size, so buffers larger than the default data block size don't reduce the number
+    // of completions much, and would only inflate the memory provided to the kernel.
+    std::unique_ptr<IoUring> ioUring{};
+    if (m_configuration.IoEngine == RawStreamIoEngine::IoUring) {
+        const auto bufferSize = isTcp ? std::min(m_configuration.DataBlockSize, RawStreamConfiguration::DataBlockSizeDefaultTcp) : RawStreamConfiguration::DataBlockSizeMaximumUdp;
+        ioUring = detail::CreateRawStreamIoUring(detail::RawStreamIoUringReceiveQueueDepth, bufferSize);
+    }
+    result.IoEngine = (ioUring != nullptr) ? RawStreamIoEngine::IoUring : RawStreamIoEngine::Epoll;
+
+    auto errorMessage = (ioUring != nullptr) ? ReceiveWithIoUring(*ioUring, dataSocket, timeEnd, onData) : ReceiveWithEpoll(dataSocket, timeEnd, onData);
+
+    if (isTcp) {
+        close(dataSocket);
+    }
+
+    result.Duration = timeLast - timeFirst;
+    result.GoodputBitsPerSecond = detail::ComputeRawStreamGoodputBitsPerSecond(result);
+    cpuMeter.Update(result);
+    if (!isTcp) {
+        result.NumberOfDataBlocksLost = sequenceTracker.GetNumberOfDataBlocksLost();
+        result.NumberOfDataBlocksDuplicated = sequenceTracker.GetNumberOfDataBlocksDuplicated();
+        result.NumberOfDataBlocksOutOfOrder = sequenceTracker.GetNumberOfDataBlocksOutOfOrder();
+        result.JitterMicroseconds = jitterNanoseconds / 1000;
+        result.OneWayDelayMicroseconds = detail::ComputeRawStreamMeanMicroseconds(transitTimeTotal, numberOfTransitTimes);
+    }
+
+    Complete(std::move(result), std::move(errorMessage));
+}
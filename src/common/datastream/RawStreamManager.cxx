@@ -0,0 +1,100 @@
+
+#include <cstddef>
+#include <format>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <microsoft/net/remote/datastream/RawStream.hxx>
+#include <microsoft/net/remote/datastream/RawStreamManager.hxx>
+
+using namespace Microsoft::Net::Remote::DataStream;
+
+RawStreamManager::RawStreamManager(Clock::duration expiryTimeout) noexcept :
+    m_expiryTimeout(expiryTimeout)
+{
+}
+
+std::shared_ptr<RawStream>
+RawStreamManager::Create(RawStreamConfiguration configuration)
+{
+    // Declared before the lock so that expired streams, whose destruction waits for their threads to exit, are
+    // destroyed once it is released.
+    std::vector<std::shared_ptr<RawStream>> rawStreamsExpired{};
+
+    const std::lock_guard lock(m_rawStreamsGate);
+    rawStreamsExpired = RemoveExpiredLocked(Clock::now());
+    if (std::size(m_rawStreams) >= NumberOfRawStreamsMaximum) {
+        return nullptr;
+    }
+
+    // Identifiers are random so that clients cannot guess, and thus control, the streams of other clients.
+    std::string id{};
+    do {
+        id = std::format("{:016x}{:016x}", m_idGenerator(), m_idGenerator());
+    } while (m_rawStreams.contains(id));
+
+    auto rawStream = std::make_shared<RawStream>(id, std::move(configuration));
+    m_rawStreams.emplace(std::move(id), rawStream);
+
+    return rawStream;
+}
+
+std::shared_ptr<RawStream>
+RawStreamManager::Find(const std::string& id) const
+{
+    const std::lock_guard lock(m_rawStreamsGate);
+    const auto rawStream = m_rawStreams.find(id);
+    return (rawStream != std::cend(m_rawStreams)) ? rawStream->second : nullptr;
+}
+
+bool
+RawStreamManager::Remove(const std::string& id)
+{
+    std::shared_ptr<RawStream> rawStream{};
+    {
+        const std::lock_guard lock(m_rawStreamsGate);
+        const auto rawStreamIterator = m_rawStreams.find(id);
+        if (rawStreamIterator == std::end(m_rawStreams)) {
+            return false;
+        }
+
+        rawStream = std::move(rawStreamIterator->second);
+        m_rawStreams.erase(rawStreamIterator);
+    }
+
+    // Stopping the stream waits for its thread to exit, which must not happen while holding the lock.
+    return true;
+}
+
+std::size_t
+RawStreamManager::RemoveExpired(Clock::time_point timeNow)
+{
+    std::vector<std::shared_ptr<RawStream>> rawStreamsExpired{};
+    {
+        const std::lock_guard lock(m_rawStreamsGate);
+        rawStreamsExpired = RemoveExpiredLocked(timeNow);
+    }
+
+    return std::size(rawStreamsExpired);
+}
+
+std::vector<std::shared_ptr<RawStream>>
+RawStreamManager::RemoveExpiredLocked(Clock::time_point timeNow)
+{
+    std::vector<std::shared_ptr<RawStream>> rawStreamsExpired{};
+    for (auto rawStreamIterator = std::begin(m_rawStreams); rawStreamIterator != std::end(m_rawStreams);) {
+        const auto timeCompleted = rawStreamIterator->second->GetTimeCompleted();
+        if (timeCompleted.has_value() && timeNow - timeCompleted.value() >= m_expiryTimeout) {
+            rawStreamsExpired.push_back(std::move(rawStreamIterator->second));
+            rawStreamIterator = m_rawStreams.erase(rawStreamIterator);
+        } else {
+            ++rawStreamIterator;
+        }
+    }
+
+    return rawStreamsExpired;
+}
@@ -0,0 +1,96 @@
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include <microsoft/net/remote/datastream/Histogram.hxx>
+#include <microsoft/net/remote/datastream/ReceiveStatistics.hxx>
+
+using namespace Microsoft::Net::Remote::DataStream;
+
+void
+ReceiveStatistics::Record(std::size_t numberOfBytes, Clock::time_point timeReceived) noexcept
+{
+    if (m_numberOfDataBlocks == 0) {
+        m_timeFirstReceivedSystem = std::chrono::system_clock::now();
+        m_timeFirstReceived = timeReceived;
+        m_numberOfBytesFirstDataBlock = numberOfBytes;
+    } else {
+        const auto interArrivalTime = timeReceived - m_timeLastReceived;
+        m_interArrivalTimeHistogram.Record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(interArrivalTime).count()));
+
+        if (m_interArrivalTimeLast.has_value()) {
+            const auto jitter = (interArrivalTime > *m_interArrivalTimeLast) ? (interArrivalTime - *m_interArrivalTimeLast) : (*m_interArrivalTimeLast - interArrivalTime);
+            m_interArrivalJitterHistogram.Record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(jitter).count()));
+        }
+
+        m_interArrivalTimeLast = interArrivalTime;
+    }
+
+    m_timeLastReceived = timeReceived;
+    m_numberOfBytes += numberOfBytes;
+    m_numberOfDataBlocks++;
+}
+
+uint64_t
+ReceiveStatistics::GetNumberOfDataBlocks() const noexcept
+{
+    return m_numberOfDataBlocks;
+}
+
+uint64_t
+ReceiveStatistics::GetNumberOfBytes() const noexcept
+{
+    return m_numberOfBytes;
+}
+
+std::optional<std::chrono::system_clock::time_point>
+ReceiveStatistics::GetTimeFirstReceived() const noexcept
+{
+    if (m_numberOfDataBlocks == 0) {
+        return std::nullopt;
+    }
+
+    return m_timeFirstReceivedSystem;
+}
+
+std::optional<std::chrono::system_clock::time_point>
+ReceiveStatistics::GetTimeLastReceived() const noexcept
+{
+    if (m_numberOfDataBlocks == 0) {
+        return std::nullopt;
+    }
+
+    return m_timeFirstReceivedSystem + std::chrono::duration_cast<std::chrono::system_clock::duration>(GetDuration());
+}
+
+ReceiveStatistics::Clock::duration
+ReceiveStatistics::GetDuration() const noexcept
+{
+    return m_timeLastReceived - m_timeFirstReceived;
+}
+
+uint64_t
+ReceiveStatistics::GetGoodputBitsPerSecond() const noexcept
+{
+    const std::chrono::duration<double> duration = GetDuration();
+    if (m_numberOfDataBlocks < 2 || duration.count() <= 0) {
+        return 0;
+    }
+
+    const auto numberOfBits = static_cast<double>(m_numberOfBytes - m_numberOfBytesFirstDataBlock) * 8;
+    return static_cast<uint64_t>(numberOfBits / duration.count());
+}
+
+const Histogram&
+ReceiveStatistics::GetInterArrivalTimeHistogram() const noexcept
+{
+    return m_interArrivalTimeHistogram;
+}
+
+const Histogram&
+ReceiveStatistics::GetInterArrivalJitterHistogram() const noexcept
+{
+    return m_interArrivalJitterHistogram;
+}
@@ -0,0 +1,88 @@
+
+#include <algorithm>
+#include <cstdint>
+
+#include <microsoft/net/remote/datastream/SequenceTracker.hxx>
+
+using namespace Microsoft::Net::Remote::DataStream;
+
+void
+SequenceTracker::Record(uint64_t sequenceNumber) noexcept
+{
+    if (sequenceNumber > m_sequenceNumberHighest) {
+        if (sequenceNumber > m_sequenceNumberHighest + 1) {
+            m_numberOfGaps++;
+        }
+
+        // Forget the sequence numbers that slide out of the window, whose positions are reused by the skipped ones.
+        if (sequenceNumber - m_sequenceNumberHighest >= WindowSize) {
+            m_sequenceNumbersReceived.reset();
+        } else {
+            for (uint64_t sequenceNumberSkipped = m_sequenceNumberHighest + 1; sequenceNumberSkipped < sequenceNumber; sequenceNumberSkipped++) {
+                m_sequenceNumbersReceived.reset(sequenceNumberSkipped % WindowSize);
+            }
+        }
+
+        m_sequenceNumbersReceived.set(sequenceNumber % WindowSize);
+        m_sequenceNumberHighest = sequenceNumber;
+        m_numberOfDataBlocksUnique++;
+        return;
+    }
+
+    const uint64_t reorderDistance = m_sequenceNumberHighest - sequenceNumber;
+    if (reorderDistance < WindowSize) {
+        if (m_sequenceNumbersReceived.test(sequenceNumber % WindowSize)) {
+            m_numberOfDataBlocksDuplicated++;
+            return;
+        }
+
+        m_sequenceNumbersReceived.set(sequenceNumber % WindowSize);
+    }
+
+    m_numberOfDataBlocksOutOfOrder++;
+    m_numberOfDataBlocksUnique++;
+    m_reorderDistanceMaximum = std::max(m_reorderDistanceMaximum, reorderDistance);
+}
+
+uint64_t
+SequenceTracker::GetNumberOfDataBlocksUnique() const noexcept
+{
+    return m_numberOfDataBlocksUnique;
+}
+
+uint64_t
+SequenceTracker::GetNumberOfDataBlocksLost() const noexcept
+{
+    // Data blocks arriving too late to be checked for duplication may be counted as unique more than once.
+    return m_sequenceNumberHighest - std::min(m_sequenceNumberHighest, m_numberOfDataBlocksUnique);
+}
+
+uint64_t
+SequenceTracker::GetNumberOfDataBlocksDuplicated() const noexcept
+{
+    return m_numberOfDataBlocksDuplicated;
+}
+
+uint64_t
+SequenceTracker::GetNumberOfDataBlocksOutOfOrder() const noexcept
+{
+    return m_numberOfDataBlocksOutOfOrder;
+}
+
+uint64_t
+SequenceTracker::GetNumberOfGaps() const noexcept
+{
+    return m_numberOfGaps;
+}
+
+uint64_t
+SequenceTracker::GetReorderDistanceMaximum() const noexcept
+{
+    return m_reorderDistanceMaximum;
+}
+
+uint64_t
+SequenceTracker::GetSequenceNumberHighest() const noexcept
+{
+    return m_sequenceNumberHighest;
+}
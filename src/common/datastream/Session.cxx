@@ -0,0 +1,201 @@
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <microsoft/net/remote/datastream/Session.hxx>
+
+using namespace Microsoft::Net::Remote::DataStream;
+
+namespace detail
+{
+/**
+ * @brief Compute the goodput for a number of bytes transferred over a duration.
+ *
+ * @param numberOfBytes The number of bytes transferred.
+ * @param duration The duration over which the bytes were transferred.
+ * @return uint64_t The goodput in bits per second, or 0 if the duration is not positive.
+ */
+uint64_t
+ComputeGoodputBitsPerSecond(uint64_t numberOfBytes, std::chrono::steady_clock::duration duration) noexcept
+{
+    const std::chrono::duration<double> durationSeconds = duration;
+    if (durationSeconds.count() <= 0) {
+        return 0;
+    }
+
+    return static_cast<uint64_t>(static_cast<double>(numberOfBytes) * 8 / durationSeconds.count());
+}
+} // namespace detail
+
+SessionStream::SessionStream(uint32_t id, SessionStreamDirection direction, Clock::time_point timeStart) noexcept :
+    m_id(id),
+    m_direction(direction),
+    m_timeStart(timeStart),
+    m_timeLastActivity(timeStart.time_since_epoch().count())
+{
+}
+
+void
+SessionStream::RecordReceived(std::size_t numberOfBytes, Clock::time_point timeReceived) noexcept
+{
+    if (m_isCompleted.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    m_numberOfDataBlocksReceived.fetch_add(1, std::memory_order_relaxed);
+    m_numberOfBytesReceived.fetch_add(numberOfBytes, std::memory_order_relaxed);
+    m_timeLastActivity.store(timeReceived.time_since_epoch().count(), std::memory_order_relaxed);
+}
+
+void
+SessionStream::RecordSent(std::size_t numberOfBytes, Clock::time_point timeSent) noexcept
+{
+    if (m_isCompleted.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    m_numberOfDataBlocksSent.fetch_add(1, std::memory_order_relaxed);
+    m_numberOfBytesSent.fetch_add(numberOfBytes, std::memory_order_relaxed);
+    m_timeLastActivity.store(timeSent.time_since_epoch().count(), std::memory_order_relaxed);
+}
+
+void
+SessionStream::Complete() noexcept
+{
+    m_isCompleted.store(true, std::memory_order_relaxed);
+}
+
+SessionStreamResult
+SessionStream::GetResult() const noexcept
+{
+    SessionStreamResult result{
+        .Id = m_id,
+        .Direction = m_direction,
+        .NumberOfDataBlocksReceived = m_numberOfDataBlocksReceived.load(std::memory_order_relaxed),
+        .NumberOfBytesReceived = m_numberOfBytesReceived.load(std::memory_order_relaxed),
+        .NumberOfDataBlocksSent = m_numberOfDataBlocksSent.load(std::memory_order_relaxed),
+        .NumberOfBytesSent = m_numberOfBytesSent.load(std::memory_order_relaxed),
+        .Duration = GetTimeLastActivity() - m_timeStart,
+        .IsCompleted = m_isCompleted.load(std::memory_order_relaxed),
+    };
+    result.GoodputBitsPerSecond = detail::ComputeGoodputBitsPerSecond(result.NumberOfBytesReceived + result.NumberOfBytesSent, result.Duration);
+
+    return result;
+}
+
+bool
+SessionStream::IsCompleted() const noexcept
+{
+    return m_isCompleted.load(std::memory_order_relaxed);
+}
+
+SessionStream::Clock::time_point
+SessionStream::GetTimeStart() const noexcept
+{
+    return m_timeStart;
+}
+
+SessionStream::Clock::time_point
+SessionStream::GetTimeLastActivity() const noexcept
+{
+    return Clock::time_point(Clock::duration(m_timeLastActivity.load(std::memory_order_relaxed)));
+}
+
+Session::Session(std::string id, SessionStream::Clock::time_point timeCreated) :
+    m_id(std::move(id)),
+    m_timeCreated(timeCreated)
+{
+}
+
+const std::string&
+Session::GetId() const noexcept
+{
+    return m_id;
+}
+
+std::shared_ptr<SessionStream>
+Session::AddStream(SessionStreamDirection direction)
+{
+    const std::lock_guard lock(m_streamsGate);
+    if (std::size(m_streams) >= NumberOfStreamsMaximum) {
+        return nullptr;
+    }
+
+    const auto id = static_cast<uint32_t>(std::size(m_streams) + 1);
+    return m_streams.emplace_back(std::make_shared<SessionStream>(id, direction));
+}
+
+SessionResult
+Session::GetResult() const
+{
+    SessionResult result{};
+    std::vector<uint64_t> goodputs{};
+    auto timeStart = SessionStream::Clock::time_point::max();
+    auto timeEnd = SessionStream::Clock::time_point::min();
+
+    {
+        const std::lock_guard lock(m_streamsGate);
+        result.Streams.reserve(std::size(m_streams));
+        goodputs.reserve(std::size(m_streams));
+
+        for (const auto& stream : m_streams) {
+            auto& streamResult = result.Streams.emplace_back(stream->GetResult());
+            timeStart = std::min(timeStart, stream->GetTimeStart());
+            timeEnd = std::max(timeEnd, stream->GetTimeStart() + streamResult.Duration);
+        }
+    }
+
+    for (const auto& streamResult : result.Streams) {
+        result.NumberOfBytesReceived += streamResult.NumberOfBytesReceived;
+        result.NumberOfBytesSent += streamResult.NumberOfBytesSent;
+        result.NumberOfStreamsActive += streamResult.IsCompleted ? 0 : 1;
+        goodputs.push_back(streamResult.GoodputBitsPerSecond);
+    }
+
+    if (!std::empty(result.Streams)) {
+        result.Duration = timeEnd - timeStart;
+        result.GoodputBitsPerSecond = detail::ComputeGoodputBitsPerSecond(result.NumberOfBytesReceived + result.NumberOfBytesSent, result.Duration);
+    }
+    result.FairnessIndex = ComputeFairnessIndex(goodputs);
+
+    return result;
+}
+
+bool
+Session::IsIdleSince(SessionStream::Clock::time_point time) const
+{
+    if (m_timeCreated > time) {
+        return false;
+    }
+
+    const std::lock_guard lock(m_streamsGate);
+    return std::ranges::all_of(m_streams, [time](const auto& stream) {
+        return stream->IsCompleted() && stream->GetTimeLastActivity() <= time;
+    });
+}
+
+/* static */
+double
+Session::ComputeFairnessIndex(const std::vector<uint64_t>& values) noexcept
+{
+    double sum = 0;
+    double sumOfSquares = 0;
+    for (const auto value : values) {
+        const auto valueDouble = static_cast<double>(value);
+        sum += valueDouble;
+        sumOfSquares += valueDouble * valueDouble;
+    }
+
+    if (sumOfSquares <= 0) {
+        return 0;
+    }
+
+    return (sum * sum) / (static_cast<double>(std::size(values)) * sumOfSquares);
+}
@@ -0,0 +1,69 @@
+
+#include <chrono>
+#include <cstddef>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <microsoft/net/remote/datastream/Session.hxx>
+#include <microsoft/net/remote/datastream/SessionManager.hxx>
+
+using namespace Microsoft::Net::Remote::DataStream;
+
+SessionManager::SessionManager(Clock::duration idleTimeout) noexcept :
+    m_idleTimeout(idleTimeout)
+{
+}
+
+std::shared_ptr<Session>
+SessionManager::Create()
+{
+    const std::lock_guard lock(m_sessionsGate);
+    RemoveIdleLocked(Clock::now());
+    if (std::size(m_sessions) >= NumberOfSessionsMaximum) {
+        return nullptr;
+    }
+
+    // Identifiers are random so that clients cannot guess, and thus attach streams to, the sessions of other clients.
+    std::string id{};
+    do {
+        id = std::format("{:016x}{:016x}", m_idGenerator(), m_idGenerator());
+    } while (m_sessions.contains(id));
+
+    auto session = std::make_shared<Session>(id);
+    m_sessions.emplace(std::move(id), session);
+
+    return session;
+}
+
+std::shared_ptr<Session>
+SessionManager::Find(const std::string& id) const
+{
+    const std::lock_guard lock(m_sessionsGate);
+    const auto session = m_sessions.find(id);
+    return (session != std::cend(m_sessions)) ? session->second : nullptr;
+}
+
+bool
+SessionManager::Remove(const std::string& id)
+{
+    const std::lock_guard lock(m_sessionsGate);
+    return m_sessions.erase(id) > 0;
+}
+
+std::size_t
+SessionManager::RemoveIdle(Clock::time_point timeNow)
+{
+    const std::lock_guard lock(m_sessionsGate);
+    return RemoveIdleLocked(timeNow);
+}
+
+std::size_t
+SessionManager::RemoveIdleLocked(Clock::time_point timeNow)
+{
+    const auto timeIdleSince = timeNow - m_idleTimeout;
+    return std::erase_if(m_sessions, [timeIdleSince](const auto& entry) {
+        return entry.second->IsIdleSince(timeIdleSince);
+    });
+}
@@ -0,0 +1,125 @@
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include <microsoft/net/remote/datastream/StreamAdmission.hxx>
+
+using namespace Microsoft::Net::Remote::DataStream;
+
+StreamAdmissionTicket::StreamAdmissionTicket(StreamAdmission* streamAdmission) noexcept :
+    m_streamAdmission(streamAdmission)
+{
+}
+
+StreamAdmissionTicket::~StreamAdmissionTicket()
+{
+    Release();
+}
+
+StreamAdmissionTicket::StreamAdmissionTicket(StreamAdmissionTicket&& other) noexcept :
+    m_streamAdmission(std::exchange(other.m_streamAdmission, nullptr)),
+    m_numberOfBytesReserved(std::exchange(other.m_numberOfBytesReserved, 0))
+{
+}
+
+StreamAdmissionTicket&
+StreamAdmissionTicket::operator=(StreamAdmissionTicket&& other) noexcept
+{
+    if (this != &other) {
+        Release();
+        m_streamAdmission = std::exchange(other.m_streamAdmission, nullptr);
+        m_numberOfBytesReserved = std::exchange(other.m_numberOfBytesReserved, 0);
+    }
+
+    return *this;
+}
+
+bool
+StreamAdmissionTicket::TryReserve(std::size_t numberOfBytes)
+{
+    if (m_streamAdmission == nullptr || !m_streamAdmission->TryReserve(numberOfBytes)) {
+        return false;
+    }
+
+    m_numberOfBytesReserved += numberOfBytes;
+    return true;
+}
+
+std::size_t
+StreamAdmissionTicket::GetNumberOfBytesReserved() const noexcept
+{
+    return m_numberOfBytesReserved;
+}
+
+void
+StreamAdmissionTicket::Release() noexcept
+{
+    if (m_streamAdmission != nullptr) {
+        m_streamAdmission->Release(m_numberOfBytesReserved);
+        m_streamAdmission = nullptr;
+        m_numberOfBytesReserved = 0;
+    }
+}
+
+StreamAdmission::StreamAdmission(StreamAdmissionConfiguration configuration) noexcept :
+    m_configuration(configuration)
+{
+}
+
+std::optional<StreamAdmissionTicket>
+StreamAdmission::TryAdmit()
+{
+    const std::lock_guard lock(m_admissionGate);
+    if (m_configuration.NumberOfStreamsMaximum > 0 && m_numberOfStreams >= m_configuration.NumberOfStreamsMaximum) {
+        m_numberOfStreamsRejected++;
+        return std::nullopt;
+    }
+
+    m_numberOfStreams++;
+    return StreamAdmissionTicket{ this };
+}
+
+uint32_t
+StreamAdmission::GetNumberOfStreams() const
+{
+    const std::lock_guard lock(m_admissionGate);
+    return m_numberOfStreams;
+}
+
+std::size_t
+StreamAdmission::GetNumberOfBytesInFlight() const
+{
+    const std::lock_guard lock(m_admissionGate);
+    return m_numberOfBytesInFlight;
+}
+
+uint64_t
+StreamAdmission::GetNumberOfStreamsRejected() const
+{
+    const std::lock_guard lock(m_admissionGate);
+    return m_numberOfStreamsRejected;
+}
+
+bool
+StreamAdmission::TryReserve(std::size_t numberOfBytes)
+{
+    const std::lock_guard lock(m_admissionGate);
+    if (m_configuration.NumberOfBytesInFlightMaximum > 0 && numberOfBytes > m_configuration.NumberOfBytesInFlightMaximum - m_numberOfBytesInFlight) {
+        m_numberOfStreamsRejected++;
+        return false;
+    }
+
+    m_numberOfBytesInFlight += numberOfBytes;
+    return true;
+}
+
+void
+StreamAdmission::Release(std::size_t numberOfBytes) noexcept
+{
+    const std::lock_guard lock(m_admissionGate);
+    m_numberOfStreams--;
+    m_numberOfBytesInFlight -= numberOfBytes;
+}
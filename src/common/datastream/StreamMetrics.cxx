@@ -0,0 +1,30 @@
+
+#include <cstdint>
+#include <mutex>
+
+#include <microsoft/net/remote/datastream/Histogram.hxx>
+#include <microsoft/net/remote/datastream/StreamMetrics.hxx>
+
+using namespace Microsoft::Net::Remote::DataStream;
+
+void
+StreamMetrics::RecordWriteCompletionLatency(const Histogram& writeCompletionLatency)
+{
+    const std::lock_guard lock(m_metricsGate);
+    m_writeCompletionLatency.Merge(writeCompletionLatency);
+    m_numberOfStreams++;
+}
+
+Histogram
+StreamMetrics::GetWriteCompletionLatency() const
+{
+    const std::lock_guard lock(m_metricsGate);
+    return m_writeCompletionLatency;
+}
+
+uint64_t
+StreamMetrics::GetNumberOfStreams() const
+{
+    const std::lock_guard lock(m_metricsGate);
+    return m_numberOfStreams;
+}
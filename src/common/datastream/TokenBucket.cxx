@@ -0,0 +1,40 @@
+
+#include <algorithm>
+#include <chrono>
+
+#include <microsoft/net/remote/datastream/TokenBucket.hxx>
+
+using namespace Microsoft::Net::Remote::DataStream;
+
+TokenBucket::TokenBucket(double tokensPerSecond, double capacity, Clock::time_point timeStart) noexcept :
+    m_tokensPerSecond(tokensPerSecond),
+    m_capacity(capacity),
+    m_tokens(capacity),
+    m_timeLastRefill(timeStart)
+{
+}
+
+TokenBucket::Clock::time_point
+TokenBucket::Reserve(double numberOfTokens, Clock::time_point timeNow) noexcept
+{
+    // Add the tokens accumulated since the last refill.
+    if (timeNow > m_timeLastRefill) {
+        const std::chrono::duration<double> timeElapsed = timeNow - m_timeLastRefill;
+        m_tokens = std::min(m_capacity, m_tokens + (timeElapsed.count() * m_tokensPerSecond));
+        m_timeLastRefill = timeNow;
+    }
+
+    m_tokens -= numberOfTokens;
+    if (m_tokens >= 0) {
+        return timeNow;
+    }
+
+    const std::chrono::duration<double> timeUntilAvailable{ -m_tokens / m_tokensPerSecond };
+    return timeNow + std::chrono::duration_cast<Clock::duration>(timeUntilAvailable);
+}
+
+double
+TokenBucket::GetTokensPerSecond() const noexcept
+{
+    return m_tokensPerSecond;
+}
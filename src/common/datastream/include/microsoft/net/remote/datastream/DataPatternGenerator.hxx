@@ -0,0 +1,117 @@
+
+#ifndef DATA_PATTERN_GENERATOR_HXX
+#define DATA_PATTERN_GENERATOR_HXX
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <microsoft/net/remote/datastream/RandomDataGenerator.hxx>
+
+namespace Microsoft::Net::Remote::DataStream
+{
+/**
+ * @brief Deterministic data patterns. The content of each data block is fully determined by the pattern, its seed (if
+ * any), and the position of the block in the stream, so the receiver can verify it without knowing what was sent.
+ */
+enum class DataPattern {
+    // Pseudo-random data. The generator is re-seeded for each block from the stream seed and the block sequence number.
+    PseudoRandom,
+    // Consecutive little-endian 64-bit integers, where each integer is its own index in the stream (byte offset / 8).
+    Counter,
+    // All bits cleared.
+    Zeros,
+    // All bits set.
+    Ones,
+};
+
+/**
+ * @brief Generates and verifies data blocks for a deterministic data pattern.
+ *
+ * A block is identified by its sequence number and its byte offset in the stream. The pseudo-random pattern derives
+ * its content from the sequence number, while the counter pattern derives its content from the offset, so both
+ * corruption and misplacement of a block are detected.
+ */
+class DataPatternGenerator
+{
+public:
+    /**
+     * @brief Construct a DataPatternGenerator object for the specified pattern.
+     *
+     * @param pattern The pattern to generate.
+     * @param seed The stream seed. Only used by DataPattern::PseudoRandom.
+     */
+    explicit DataPatternGenerator(DataPattern pattern, uint64_t seed = 0) noexcept;
+
+    /**
+     * @brief Get the pattern this generator generates.
+     *
+     * @return DataPattern
+     */
+    DataPattern
+    GetPattern() const noexcept;
+
+    /**
+     * @brief Derive the seed of a block from the stream seed and the block sequence number.
+     *
+     * @param seed The stream seed.
+     * @param sequenceNumber The sequence number of the block.
+     * @return uint64_t
+     */
+    static uint64_t
+    DeriveBlockSeed(uint64_t seed, uint64_t sequenceNumber) noexcept;
+
+    /**
+     * @brief Fill a data block with the pattern.
+     *
+     * @param data The data block to fill.
+     * @param sequenceNumber The sequence number of the block.
+     * @param offset The byte offset of the start of the block in the stream.
+     */
+    void
+    Fill(std::span<uint8_t> data, uint64_t sequenceNumber, uint64_t offset) noexcept;
+
+    /**
+     * @brief Fill a data block with the pattern.
+     *
+     * @param data The data block to fill.
+     * @param sequenceNumber The sequence number of the block.
+     * @param offset The byte offset of the start of the block in the stream.
+     */
+    void
+    Fill(std::span<char> data, uint64_t sequenceNumber, uint64_t offset) noexcept;
+
+    /**
+     * @brief Verify that a data block matches the pattern.
+     *
+     * @param data The data block to verify.
+     * @param sequenceNumber The sequence number the block is expected to have.
+     * @param offset The byte offset the block is expected to start at.
+     * @return true If the content of the block is as expected.
+     * @return false Otherwise.
+     */
+    bool
+    Verify(std::span<const uint8_t> data, uint64_t sequenceNumber, uint64_t offset);
+
+    /**
+     * @brief Verify that a data block matches the pattern.
+     *
+     * @param data The data block to verify.
+     * @param sequenceNumber The sequence number the block is expected to have.
+     * @param offset The byte offset the block is expected to start at.
+     * @return true If the content of the block is as expected.
+     * @return false Otherwise.
+     */
+    bool
+    Verify(std::span<const char> data, uint64_t sequenceNumber, uint64_t offset);
+
+private:
+    DataPattern m_pattern;
+    uint64_t m_seed;
+    RandomDataGenerator m_randomDataGenerator;
+    std::vector<uint8_t> m_dataExpected{};
+};
+} // namespace Microsoft::Net::Remote::DataStream
+
+#endif // DATA_PATTERN_GENERATOR_HXX
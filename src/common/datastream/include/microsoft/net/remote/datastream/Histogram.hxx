@@ -0,0 +1,147 @@
+
+#ifndef DATA_STREAM_HISTOGRAM_HXX
+#define DATA_STREAM_HISTOGRAM_HXX
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Microsoft::Net::Remote::DataStream
+{
+/**
+ * @brief A bucket of a histogram, counting recorded values v where LowerBound <= v < UpperBound.
+ */
+struct HistogramBucket
+{
+    uint64_t LowerBound{};
+    uint64_t UpperBound{};
+    uint64_t Count{};
+};
+
+/**
+ * @brief A fixed-size, log-linear histogram of non-negative integer values, such as durations in microseconds.
+ *
+ * Similar to an HDR histogram, each power-of-two range of values is split into a fixed number of linear sub-buckets,
+ * so the relative error of any recorded value is bounded (1/8, or 12.5%) across the whole 64-bit range. Small values
+ * (less than the number of sub-buckets) are recorded exactly. Recording is constant time and never allocates.
+ */
+class Histogram
+{
+public:
+    /**
+     * @brief The number of bits of each value that select its linear sub-bucket.
+     */
+    static constexpr uint32_t SubBucketBits{ 3 };
+
+    /**
+     * @brief The number of linear sub-buckets per power-of-two range.
+     */
+    static constexpr std::size_t SubBucketCount{ std::size_t{ 1 } << SubBucketBits };
+
+    /**
+     * @brief The total number of buckets needed to cover all 64-bit values.
+     */
+    static constexpr std::size_t NumberOfBuckets{ (64 - SubBucketBits + 1) * SubBucketCount };
+
+    /**
+     * @brief Record a value.
+     *
+     * @param value The value to record.
+     */
+    void
+    Record(uint64_t value) noexcept;
+
+    /**
+     * @brief Add all values recorded by another histogram to this histogram.
+     *
+     * @param other The histogram to add.
+     */
+    void
+    Merge(const Histogram& other) noexcept;
+
+    /**
+     * @brief Remove all recorded values.
+     */
+    void
+    Reset() noexcept;
+
+    /**
+     * @brief Get the number of recorded values.
+     *
+     * @return uint64_t
+     */
+    uint64_t
+    GetCount() const noexcept;
+
+    /**
+     * @brief Get the smallest recorded value, or 0 if no values were recorded.
+     *
+     * @return uint64_t
+     */
+    uint64_t
+    GetMinimum() const noexcept;
+
+    /**
+     * @brief Get the largest recorded value, or 0 if no values were recorded.
+     *
+     * @return uint64_t
+     */
+    uint64_t
+    GetMaximum() const noexcept;
+
+    /**
+     * @brief Get the mean of all recorded values, or 0 if no values were recorded. This is exact.
+     *
+     * @return double
+     */
+    double
+    GetMean() const noexcept;
+
+    /**
+     * @brief Get the value at the specified percentile, or 0 if no values were recorded. The result is the largest
+     * value of the bucket containing the percentile, clamped to the range of recorded values. The 0th percentile is
+     * the exact minimum.
+     *
+     * @param percentile The percentile, in the range [0, 100].
+     * @return uint64_t
+     */
+    uint64_t
+    GetValueAtPercentile(double percentile) const noexcept;
+
+    /**
+     * @brief Get all buckets containing at least one value, in ascending order.
+     *
+     * @return std::vector<HistogramBucket>
+     */
+    std::vector<HistogramBucket>
+    GetBuckets() const;
+
+    /**
+     * @brief Get the index of the bucket that the specified value is recorded in.
+     *
+     * @param value The value to look up.
+     * @return std::size_t
+     */
+    static std::size_t
+    GetBucketIndex(uint64_t value) noexcept;
+
+    /**
+     * @brief Get the bucket bounds for the bucket with the specified index. The count of the returned bucket is 0.
+     *
+     * @param index The index of the bucket.
+     * @return HistogramBucket
+     */
+    static HistogramBucket
+    GetBucketBounds(std::size_t index) noexcept;
+
+private:
+    std::array<uint64_t, NumberOfBuckets> m_counts{};
+    uint64_t m_count{};
+    uint64_t m_minimum{};
+    uint64_t m_maximum{};
+    double m_sum{};
+};
+} // namespace Microsoft::Net::Remote::DataStream
+
+#endif // DATA_STREAM_HISTOGRAM_HXX
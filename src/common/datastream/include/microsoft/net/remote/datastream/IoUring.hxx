@@ -0,0 +1,185 @@
+
+#ifndef IO_URING_HXX
+#define IO_URING_HXX
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <system_error>
+#include <vector>
+
+#include <linux/io_uring.h>
+#include <sys/uio.h>
+
+namespace Microsoft::Net::Remote::DataStream
+{
+/**
+ * @brief A minimal io_uring instance, driven directly through the kernel interface.
+ *
+ * Submissions are prepared in the submission queue and handed to the kernel together by Submit(), which also waits for
+ * completions, so a batch of operations costs a single system call. At most one group of provided buffers may be
+ * registered, from which the kernel picks the buffer of each multishot receive. This class is not thread-safe; it
+ * should be created and used on a single thread.
+ */
+class IoUring
+{
+public:
+    /**
+     * @brief The identifier of the group of provided buffers registered with RegisterBufferRing().
+     */
+    static constexpr uint16_t BufferGroupId{ 0 };
+
+    /**
+     * @brief Create an io_uring instance.
+     *
+     * @param numberOfEntries The number of entries of the submission queue. The completion queue holds twice as many.
+     * @param error Set to the reason the instance could not be created, for example because the kernel does not support
+     * io_uring, is older than 5.11 and so cannot wait for completions with a timeout, or io_uring is disabled.
+     * @return std::unique_ptr<IoUring> The instance, or nullptr if it could not be created.
+     */
+    static std::unique_ptr<IoUring>
+    Create(uint32_t numberOfEntries, std::error_code& error);
+
+    ~IoUring();
+
+    IoUring(const IoUring&) = delete;
+
+    IoUring(IoUring&&) = delete;
+
+    IoUring&
+    operator=(const IoUring&) = delete;
+
+    IoUring&
+    operator=(IoUring&&) = delete;
+
+    /**
+     * @brief Get a cleared submission queue entry to prepare. It is submitted by the next call to Submit().
+     *
+     * @return io_uring_sqe* The entry, or nullptr if the submission queue is full.
+     */
+    io_uring_sqe*
+    GetSubmissionQueueEntry() noexcept;
+
+    /**
+     * @brief Submit all prepared entries, and wait for completions, in a single system call.
+     *
+     * @param minimumNumberOfCompletions The number of completions to wait for. 0 to return without waiting.
+     * @param timeout The maximum time to wait for completions.
+     * @return std::error_code The error that occurred, if any. Timing out or being interrupted is not an error.
+     */
+    std::error_code
+    Submit(uint32_t minimumNumberOfCompletions, std::chrono::milliseconds timeout) noexcept;
+
+    /**
+     * @brief Invoke a function on each available completion, in order, then release them to the kernel.
+     *
+     * @param onCompletion The function to invoke, which takes a const io_uring_cqe&.
+     * @return std::size_t The number of completions processed.
+     */
+    template <typename Function>
+    std::size_t
+    ForEachCompletion(Function&& onCompletion)
+    {
+        uint32_t head = std::atomic_ref(*m_completionQueueHead).load(std::memory_order_relaxed);
+        const uint32_t tail = std::atomic_ref(*m_completionQueueTail).load(std::memory_order_acquire);
+
+        std::size_t numberOfCompletions{ 0 };
+        for (; head != tail; head++, numberOfCompletions++) {
+            onCompletion(m_completionQueueEntries[head & m_completionQueueMask]);
+        }
+
+        std::atomic_ref(*m_completionQueueHead).store(head, std::memory_order_release);
+        return numberOfCompletions;
+    }
+
+    /**
+     * @brief Register buffers with the kernel, which may then be used by fixed operations such as
+     * IORING_OP_WRITE_FIXED by their index. This avoids mapping the buffers on every operation.
+     *
+     * @param buffers The buffers to register.
+     * @return std::error_code The error that occurred, if any.
+     */
+    std::error_code
+    RegisterBuffers(std::span<const iovec> buffers) noexcept;
+
+    /**
+     * @brief Register a group of provided buffers, with identifier BufferGroupId, from which the kernel picks the
+     * buffer of operations submitted with IOSQE_BUFFER_SELECT. Each buffer must be returned with RecycleBuffer() once
+     * its content was consumed.
+     *
+     * @param numberOfBuffers The number of buffers, which must be a power of 2 no larger than 32768.
+     * @param bufferSize The size of each buffer.
+     * @return std::error_code The error that occurred, if any. Kernels older than 5.19 don't support buffer rings.
+     */
+    std::error_code
+    RegisterBufferRing(uint16_t numberOfBuffers, std::size_t bufferSize);
+
+    /**
+     * @brief Get the content of a provided buffer picked by the kernel.
+     *
+     * @param bufferId The identifier of the buffer, from the flags of the completion.
+     * @param size The number of bytes the kernel placed in the buffer.
+     * @return std::span<const char>
+     */
+    std::span<const char>
+    GetBuffer(uint16_t bufferId, std::size_t size) const noexcept;
+
+    /**
+     * @brief Return a provided buffer to the kernel.
+     *
+     * @param bufferId The identifier of the buffer.
+     */
+    void
+    RecycleBuffer(uint16_t bufferId) noexcept;
+
+private:
+    /**
+     * @brief Construct a new IoUring object.
+     *
+     * @param fileDescriptor The file descriptor of the io_uring instance.
+     */
+    explicit IoUring(int fileDescriptor) noexcept;
+
+    /**
+     * @brief Map the rings of the instance into memory.
+     *
+     * @param parameters The parameters reported by the kernel when the instance was set up.
+     * @return std::error_code The error that occurred, if any.
+     */
+    std::error_code
+    MapRings(const io_uring_params& parameters) noexcept;
+
+private:
+    int m_fileDescriptor;
+
+    void* m_ringsMemory{ nullptr };
+    std::size_t m_ringsMemorySize{ 0 };
+    io_uring_sqe* m_submissionQueueEntries{ nullptr };
+    std::size_t m_submissionQueueEntriesSize{ 0 };
+
+    uint32_t* m_submissionQueueTail{ nullptr };
+    uint32_t* m_submissionQueueHead{ nullptr };
+    uint32_t* m_submissionQueueArray{ nullptr };
+    uint32_t m_submissionQueueMask{ 0 };
+    uint32_t m_submissionQueueNumberOfEntries{ 0 };
+    uint32_t m_submissionQueueTailLocal{ 0 };
+    uint32_t m_numberOfEntriesPrepared{ 0 };
+
+    uint32_t* m_completionQueueHead{ nullptr };
+    uint32_t* m_completionQueueTail{ nullptr };
+    io_uring_cqe* m_completionQueueEntries{ nullptr };
+    uint32_t m_completionQueueMask{ 0 };
+
+    void* m_bufferRingMemory{ nullptr };
+    std::size_t m_bufferRingMemorySize{ 0 };
+    std::vector<char> m_buffers{};
+    std::size_t m_bufferSize{ 0 };
+    uint16_t m_numberOfBuffers{ 0 };
+    uint16_t m_bufferRingTailLocal{ 0 };
+};
+} // namespace Microsoft::Net::Remote::DataStream
+
+#endif // IO_URING_HXX
@@ -0,0 +1,71 @@
+
+#ifndef LATENCY_STATISTICS_HXX
+#define LATENCY_STATISTICS_HXX
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+#include <microsoft/net/remote/datastream/Histogram.hxx>
+
+namespace Microsoft::Net::Remote::DataStream
+{
+/**
+ * @brief Round-trip time and clock offset statistics for latency probes exchanged with a server.
+ *
+ * Each probe is described by four wall-clock timestamps, as in NTP: the time the client sent the probe (t0), the time
+ * the server received it (t1), the time the server sent its response (t2), and the time the client received the
+ * response (t3). The round-trip time excludes the time spent in the server, (t3 - t0) - (t2 - t1). The clock offset of
+ * the server relative to the client, ((t1 - t0) + (t2 - t3)) / 2, is taken from the probe with the smallest round-trip
+ * time since it is least affected by queuing delay.
+ */
+class LatencyStatistics
+{
+public:
+    using TimePoint = std::chrono::system_clock::time_point;
+
+    /**
+     * @brief Record the timestamps of a completed probe.
+     *
+     * @param timeClientSent The time the client sent the probe (t0).
+     * @param timeServerReceived The time the server received the probe (t1).
+     * @param timeServerSent The time the server sent the response (t2).
+     * @param timeClientReceived The time the client received the response (t3).
+     */
+    void
+    Record(TimePoint timeClientSent, TimePoint timeServerReceived, TimePoint timeServerSent, TimePoint timeClientReceived) noexcept;
+
+    /**
+     * @brief Get the number of probes recorded.
+     *
+     * @return uint64_t
+     */
+    uint64_t
+    GetCount() const noexcept;
+
+    /**
+     * @brief Get the histogram of round-trip times, in microseconds. This provides the minimum, mean, maximum, and
+     * percentiles of the round-trip time.
+     *
+     * @return const Histogram&
+     */
+    const Histogram&
+    GetRoundTripTimeHistogram() const noexcept;
+
+    /**
+     * @brief Get the estimated offset of the server clock relative to the client clock, if any probes were recorded.
+     * A positive offset means the server clock is ahead of the client clock.
+     *
+     * @return std::optional<std::chrono::microseconds>
+     */
+    std::optional<std::chrono::microseconds>
+    GetClockOffset() const noexcept;
+
+private:
+    Histogram m_roundTripTimeHistogram{};
+    std::chrono::microseconds m_roundTripTimeMinimum{};
+    std::chrono::microseconds m_clockOffset{};
+};
+} // namespace Microsoft::Net::Remote::DataStream
+
+#endif // LATENCY_STATISTICS_HXX
@@ -0,0 +1,96 @@
+
+#ifndef RANDOM_DATA_GENERATOR_HXX
+#define RANDOM_DATA_GENERATOR_HXX
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace Microsoft::Net::Remote::DataStream
+{
+/**
+ * @brief A fast, non-cryptographic generator of random data buffers.
+ *
+ * The generator runs several independent xoshiro256** sequences side by side and fills buffers with their combined
+ * output, one machine word per sequence at a time. Keeping the sequences independent removes the serial dependency
+ * between consecutive outputs, allowing the compiler to vectorize the state update and the CPU to overlap the
+ * multiplications, which yields several GB/s per core. The output is not suitable for any security purpose.
+ */
+class RandomDataGenerator
+{
+public:
+    /**
+     * @brief The number of independent sequences the generator runs side by side.
+     */
+    static constexpr std::size_t NumberOfLanes{ 4 };
+
+    /**
+     * @brief The number of bytes produced by one step of all sequences.
+     */
+    static constexpr std::size_t BlockSize{ NumberOfLanes * sizeof(uint64_t) };
+
+    /**
+     * @brief Construct a RandomDataGenerator object seeded from a non-deterministic source.
+     */
+    RandomDataGenerator();
+
+    /**
+     * @brief Construct a RandomDataGenerator object with the specified seed. Generators constructed with the same
+     * seed produce the same data.
+     *
+     * @param seed The seed to initialize the generator state from.
+     */
+    explicit RandomDataGenerator(uint64_t seed) noexcept;
+
+    /**
+     * @brief Re-initialize the generator state from the specified seed.
+     *
+     * @param seed The seed to initialize the generator state from.
+     */
+    void
+    Seed(uint64_t seed) noexcept;
+
+    /**
+     * @brief Fill the specified buffer with random data.
+     *
+     * @param data The buffer to fill.
+     */
+    void
+    Fill(std::span<uint8_t> data) noexcept;
+
+    /**
+     * @brief Fill the specified buffer with random data.
+     *
+     * @param data The buffer to fill.
+     */
+    void
+    Fill(std::span<char> data) noexcept;
+
+    /**
+     * @brief Generate a random data string of the specified length.
+     *
+     * @param length The length of the random data string.
+     * @return std::string
+     */
+    std::string
+    Generate(std::size_t length);
+
+private:
+    /**
+     * @brief Advance all sequences by one step, writing their output to the specified block.
+     *
+     * @param block The block to write the output to.
+     */
+    void
+    NextBlock(std::array<uint64_t, NumberOfLanes>& block) noexcept;
+
+private:
+    // State is stored word-major (all lanes of state word 0, then all lanes of state word 1, etc.) so that each step
+    // operates on contiguous lanes.
+    std::array<std::array<uint64_t, NumberOfLanes>, 4> m_state{};
+};
+} // namespace Microsoft::Net::Remote::DataStream
+
+#endif // RANDOM_DATA_GENERATOR_HXX
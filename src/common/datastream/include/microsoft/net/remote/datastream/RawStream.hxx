@@ -0,0 +1,499 @@
+
+#ifndef DATA_STREAM_RAW_STREAM_HXX
+#define DATA_STREAM_RAW_STREAM_HXX
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Microsoft::Net::Remote::DataStream
+{
+class IoUring;
+class TokenBucket;
+
+/**
+ * @brief The transport protocol used by a raw stream.
+ */
+enum class RawStreamProtocol {
+    Tcp,
+    Udp,
+};
+
+/**
+ * @brief The role of an endpoint of a raw stream.
+ */
+enum class RawStreamRole {
+    Sender,
+    Receiver,
+};
+
+/**
+ * @brief How a TCP sender hands data to the kernel.
+ */
+enum class RawStreamSendMode {
+    /**
+     * @brief Data is copied from user space into socket buffers by send().
+     */
+    Copy,
+
+    /**
+     * @brief Data pages are pinned and transmitted without copying, using send() with MSG_ZEROCOPY. The kernel reports
+     * when it is done with each send on the socket error queue, and falls back to copying when the device cannot
+     * transmit from user pages, which is always the case on loopback.
+     */
+    ZeroCopy,
+
+    /**
+     * @brief Data is placed in an in-memory file once, and transmitted from the page cache by sendfile(), without any
+     * user space copies.
+     */
+    Sendfile,
+};
+
+/**
+ * @brief The mechanism a raw stream uses to perform socket I/O.
+ */
+enum class RawStreamIoEngine {
+    /**
+     * @brief Receivers wait for data with epoll and drain the socket with non-blocking reads, and senders block in
+     * send(). Every data block costs at least one system call.
+     */
+    Epoll,
+
+    /**
+     * @brief Senders keep a batch of writes from registered buffers in flight, and receivers keep a multishot receive
+     * armed that fills buffers provided to the kernel up front. Many data blocks are transferred per system call.
+     * Streams fall back to RawStreamIoEngine::Epoll when io_uring is unavailable, for example on kernels older than
+     * 5.11 (5.19 for receivers, which need buffer rings) or when it is disabled, and for send modes other than
+     * RawStreamSendMode::Copy.
+     */
+    IoUring,
+};
+
+/**
+ * @brief The WMM access category a raw stream is marked for, which allows validating the QoS of access points by running
+ * streams of each category concurrently. Packets carry the DSCP that RFC 8325 maps to the category, which access points
+ * use to classify downstream traffic, and the socket priority is set to the matching 802.11 user priority, which Linux
+ * Wi-Fi drivers use to classify locally originated traffic.
+ */
+enum class RawStreamTrafficClass {
+    /**
+     * @brief AC_BE: DSCP 0 (DF), user priority 0.
+     */
+    BestEffort,
+
+    /**
+     * @brief AC_BK: DSCP 8 (CS1), user priority 1.
+     */
+    Background,
+
+    /**
+     * @brief AC_VI: DSCP 34 (AF41), user priority 4.
+     */
+    Video,
+
+    /**
+     * @brief AC_VO: DSCP 46 (EF), user priority 6.
+     */
+    Voice,
+};
+
+/**
+ * @brief Configuration of one endpoint of a raw stream.
+ */
+struct RawStreamConfiguration
+{
+    /**
+     * @brief The size of each write when none is specified for TCP, which is large enough to keep syscall overhead low.
+     */
+    static constexpr std::size_t DataBlockSizeDefaultTcp{ 128 * 1024 };
+
+    /**
+     * @brief The size of each datagram when none is specified for UDP, which fits in a standard 1500 byte MTU.
+     */
+    static constexpr std::size_t DataBlockSizeDefaultUdp{ 1400 };
+
+    /**
+     * @brief The largest data block size supported for TCP.
+     */
+    static constexpr std::size_t DataBlockSizeMaximumTcp{ 16 * 1024 * 1024 };
+
+    /**
+     * @brief The largest data block size supported for UDP, which is the largest IPv4 UDP payload.
+     */
+    static constexpr std::size_t DataBlockSizeMaximumUdp{ 65507 };
+
+    RawStreamProtocol Protocol{ RawStreamProtocol::Tcp };
+    RawStreamRole Role{ RawStreamRole::Receiver };
+
+    /**
+     * @brief For a sender, the address to send to. For a receiver, the local address to listen on, or all addresses if
+     * empty.
+     */
+    std::string Address{};
+
+    /**
+     * @brief For a sender, the port to send to. For a receiver, the port to listen on, or an ephemeral port if 0.
+     */
+    uint16_t Port{};
+
+    /**
+     * @brief The network interface the stream is bound to, so its traffic only flows through that interface, for
+     * example the radio or bridge of an access point. Any interface may be used if empty.
+     */
+    std::string InterfaceName{};
+
+    /**
+     * @brief For a sender, how long to send data. For a receiver, the maximum time to wait for and receive data.
+     */
+    std::chrono::milliseconds Duration{ std::chrono::seconds(10) };
+
+    /**
+     * @brief The size of each write (TCP) or datagram payload (UDP), in bytes. A default suited to the protocol is used
+     * if 0.
+     */
+    std::size_t DataBlockSize{};
+
+    /**
+     * @brief For a sender, the rate at which to send data, in bits per second. Data is sent as fast as possible if 0.
+     */
+    uint64_t TargetBitrate{};
+
+    /**
+     * @brief For a TCP sender, how data is handed to the kernel. Only RawStreamSendMode::Copy is supported for UDP.
+     */
+    RawStreamSendMode SendMode{ RawStreamSendMode::Copy };
+
+    /**
+     * @brief The mechanism used to perform socket I/O.
+     */
+    RawStreamIoEngine IoEngine{ RawStreamIoEngine::Epoll };
+
+    /**
+     * @brief The WMM access category the traffic of the stream is marked for.
+     */
+    RawStreamTrafficClass TrafficClass{ RawStreamTrafficClass::BestEffort };
+};
+
+/**
+ * @brief A snapshot of the data transferred by one endpoint of a raw stream.
+ */
+struct RawStreamResult
+{
+    /**
+     * @brief The number of datagrams (UDP) or socket reads and writes (TCP) carrying data.
+     */
+    uint64_t NumberOfDataBlocks{};
+    uint64_t NumberOfBytes{};
+
+    /**
+     * @brief For a sender, the time spent sending. For a receiver, the time from the first to the last data received.
+     */
+    std::chrono::steady_clock::duration Duration{};
+    uint64_t GoodputBitsPerSecond{};
+
+    /**
+     * @brief Statistics only available to UDP receivers, derived from the sequence number and timestamp carried by
+     * each datagram. The jitter is the smoothed variation of the one-way transit time, as defined for RTP in RFC 3550.
+     * The one-way delay is the mean transit time, which includes any offset between the clocks of the sender and
+     * receiver, so it is only comparable between streams with the same endpoints.
+     */
+    uint64_t NumberOfDataBlocksLost{};
+    uint64_t NumberOfDataBlocksDuplicated{};
+    uint64_t NumberOfDataBlocksOutOfOrder{};
+    double JitterMicroseconds{};
+    double OneWayDelayMicroseconds{};
+
+    /**
+     * @brief The CPU time used by the thread transferring the data, in user space and in the kernel on its behalf.
+     */
+    std::chrono::nanoseconds CpuTime{};
+
+    /**
+     * @brief The CPU cycles used by the thread transferring the data per byte transferred, which allows comparing the
+     * cost of send modes across devices clocked differently. 0 if the cycle counter is unavailable, which is common in
+     * virtual machines and when perf events are restricted; CpuTime is always available.
+     */
+    double CpuCyclesPerByte{};
+
+    /**
+     * @brief For a TCP sender using RawStreamSendMode::ZeroCopy, the number of sends the kernel reported done with,
+     * and how many of those it had to copy anyway.
+     */
+    uint64_t NumberOfZeroCopySendsCompleted{};
+    uint64_t NumberOfZeroCopySendsCopied{};
+
+    /**
+     * @brief The mechanism used to perform socket I/O, which differs from the one configured if it fell back.
+     */
+    RawStreamIoEngine IoEngine{ RawStreamIoEngine::Epoll };
+
+    bool IsCompleted{ false };
+
+    /**
+     * @brief Describes the error that ended the stream, or empty if none occurred.
+     */
+    std::string ErrorMessage{};
+};
+
+/**
+ * @brief The aggregated results of the raw streams of one traffic class and role.
+ */
+struct RawStreamTrafficClassResult
+{
+    RawStreamTrafficClass TrafficClass{ RawStreamTrafficClass::BestEffort };
+    RawStreamRole Role{ RawStreamRole::Receiver };
+    uint32_t NumberOfStreams{};
+    uint64_t NumberOfDataBlocks{};
+    uint64_t NumberOfBytes{};
+
+    /**
+     * @brief The sum of the goodput of the streams.
+     */
+    uint64_t GoodputBitsPerSecond{};
+
+    /**
+     * @brief Statistics only available to UDP receivers. The jitter and one-way delay are the means over the streams,
+     * weighted by the number of datagrams each received.
+     */
+    uint64_t NumberOfDataBlocksLost{};
+    double JitterMicroseconds{};
+    double OneWayDelayMicroseconds{};
+};
+
+/**
+ * @brief One endpoint of a stream of data sent directly over a TCP or UDP socket, bypassing gRPC.
+ *
+ * gRPC adds HTTP/2 framing and flow control on top of the transport, which may prevent data streams from reaching the
+ * capacity of the underlying link. Raw streams measure that capacity instead, like iperf does: one endpoint listens as
+ * the receiver, and another connects to it as the sender. Both run on a dedicated thread, and are controlled and
+ * queried from other threads.
+ *
+ * Each UDP datagram starts with a header holding a sequence number and the time it was sent, from which the receiver
+ * derives loss, reordering and jitter. Senders end UDP streams with datagrams carrying sequence number 0, whereas TCP
+ * streams end when the sender closes the connection. In both cases, the receiver also stops once its duration elapses.
+ */
+class RawStream
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Handler invoked by receive loops with each data block received. An empty data block indicates the sender
+     * closed the connection.
+     *
+     * @return true To continue receiving.
+     * @return false To stop receiving.
+     */
+    using DataHandler = std::function<bool(std::span<const char> data)>;
+
+    /**
+     * @brief The size of the header at the start of each UDP datagram.
+     */
+    static constexpr std::size_t UdpHeaderSize{ sizeof(uint64_t) * 2 };
+
+    /**
+     * @brief Construct a new RawStream object.
+     *
+     * @param id The identifier of the stream.
+     * @param configuration The configuration of the stream.
+     */
+    RawStream(std::string id, RawStreamConfiguration configuration);
+
+    /**
+     * @brief Destroy the RawStream object, stopping it if it is running.
+     */
+    ~RawStream();
+
+    RawStream(const RawStream&) = delete;
+
+    RawStream(RawStream&&) = delete;
+
+    RawStream&
+    operator=(const RawStream&) = delete;
+
+    RawStream&
+    operator=(RawStream&&) = delete;
+
+    /**
+     * @brief Open the socket and start sending or receiving. A receiver is listening once this returns, so its port may
+     * be handed to the sender. This must be called at most once.
+     *
+     * @return true If the stream was started.
+     * @return false If the stream could not be started. The reason is reported in the result.
+     */
+    bool
+    Start();
+
+    /**
+     * @brief Request the stream to stop. It completes shortly after.
+     */
+    void
+    Stop() noexcept;
+
+    /**
+     * @brief Wait for the stream to complete.
+     *
+     * @param timeout The maximum time to wait.
+     * @return true If the stream completed.
+     * @return false If the stream did not complete in time.
+     */
+    bool
+    Await(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Get the identifier of the stream.
+     *
+     * @return const std::string&
+     */
+    const std::string&
+    GetId() const noexcept;
+
+    /**
+     * @brief Get the local port of the socket, which is the port a receiver listens on.
+     *
+     * @return uint16_t The local port, or 0 if the stream was not started.
+     */
+    uint16_t
+    GetPort() const noexcept;
+
+    /**
+     * @brief Get a snapshot of the data transferred so far.
+     *
+     * @return RawStreamResult
+     */
+    RawStreamResult
+    GetResult() const;
+
+    /**
+     * @brief Get the time the stream completed.
+     *
+     * @return std::optional<Clock::time_point> The time the stream completed, or std::nullopt if it has not completed.
+     */
+    std::optional<Clock::time_point>
+    GetTimeCompleted() const;
+
+    /**
+     * @brief Get the configuration of the stream.
+     *
+     * @return const RawStreamConfiguration&
+     */
+    const RawStreamConfiguration&
+    GetConfiguration() const noexcept;
+
+    /**
+     * @brief Aggregate the results of raw streams, typically run concurrently, by traffic class and role, so the service
+     * each traffic class gets can be compared.
+     *
+     * @param rawStreams The streams to aggregate the results of.
+     * @return std::vector<RawStreamTrafficClassResult> The results of each traffic class and role with at least one
+     * stream, ordered by traffic class, then role.
+     */
+    static std::vector<RawStreamTrafficClassResult>
+    GetTrafficClassResults(std::span<const std::shared_ptr<RawStream>> rawStreams);
+
+private:
+    /**
+     * @brief Send data until the duration elapses or the stream is stopped.
+     */
+    void
+    RunSender();
+
+    /**
+     * @brief Receive data until the sender ends the stream, the duration elapses, or the stream is stopped.
+     */
+    void
+    RunReceiver();
+
+    /**
+     * @brief Send data with io_uring, keeping a batch of writes in flight, until the duration elapses or the stream is
+     * stopped.
+     *
+     * @param ioUring The io_uring instance to use, with room for the batch of writes.
+     * @param data The data block to send. For UDP, each datagram is sent from its own copy, with its own header.
+     * @param timeEnd The time at which the stream ends.
+     * @param tokenBucket The token bucket pacing writes, or nullptr to send as fast as possible.
+     * @param result The result in which to count the data sent.
+     * @param onProgress Invoked after each batch of completed writes is counted.
+     * @return std::string Describes the error that ended the stream, or empty if none occurred.
+     */
+    std::string
+    SendWithIoUring(Microsoft::Net::Remote::DataStream::IoUring& ioUring, std::span<const char> data, Clock::time_point timeEnd, Microsoft::Net::Remote::DataStream::TokenBucket* tokenBucket, RawStreamResult& result, const std::function<void()>& onProgress);
+
+    /**
+     * @brief Receive data, waiting for it with epoll, until the handler stops, the duration elapses, or the stream is
+     * stopped.
+     *
+     * @param dataSocket The socket to receive from.
+     * @param timeEnd The time at which the stream ends.
+     * @param onData The handler invoked with each data block received.
+     * @return std::string Describes the error that ended the stream, or empty if none occurred.
+     */
+    std::string
+    ReceiveWithEpoll(int dataSocket, Clock::time_point timeEnd, const DataHandler& onData);
+
+    /**
+     * @brief Receive data with an io_uring multishot receive, until the handler stops, the duration elapses, or the
+     * stream is stopped.
+     *
+     * @param ioUring The io_uring instance to use, with a registered buffer ring.
+     * @param dataSocket The socket to receive from.
+     * @param timeEnd The time at which the stream ends.
+     * @param onData The handler invoked with each data block received.
+     * @return std::string Describes the error that ended the stream, or empty if none occurred.
+     */
+    std::string
+    ReceiveWithIoUring(Microsoft::Net::Remote::DataStream::IoUring& ioUring, int dataSocket, Clock::time_point timeEnd, const DataHandler& onData);
+
+    /**
+     * @brief Determine whether the stream should stop.
+     *
+     * @param timeEnd The time at which the stream ends.
+     * @return true If the stream was stopped or its duration elapsed.
+     * @return false Otherwise.
+     */
+    bool
+    IsStopped(Clock::time_point timeEnd) const noexcept;
+
+    /**
+     * @brief Publish the data transferred so far.
+     *
+     * @param result The result to publish.
+     */
+    void
+    Publish(const RawStreamResult& result);
+
+    /**
+     * @brief Publish the final result and mark the stream as complete.
+     *
+     * @param result The final result.
+     * @param errorMessage Describes the error that ended the stream, or empty if none occurred.
+     */
+    void
+    Complete(RawStreamResult result, std::string errorMessage = {});
+
+private:
+    std::string m_id;
+    RawStreamConfiguration m_configuration;
+    int m_socket{ -1 };
+    uint16_t m_port{};
+    std::atomic<bool> m_isStopRequested{ false };
+    RawStreamResult m_result{};
+    Clock::time_point m_timeCompleted{};
+    mutable std::mutex m_resultGate{};
+    std::condition_variable m_resultCompleted{};
+    std::jthread m_thread{};
+};
+} // namespace Microsoft::Net::Remote::DataStream
+
+#endif // DATA_STREAM_RAW_STREAM_HXX
@@ -0,0 +1,104 @@
+
+#ifndef DATA_STREAM_RAW_STREAM_MANAGER_HXX
+#define DATA_STREAM_RAW_STREAM_MANAGER_HXX
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <microsoft/net/remote/datastream/RawStream.hxx>
+
+namespace Microsoft::Net::Remote::DataStream
+{
+/**
+ * @brief Creates and tracks raw streams. This class is thread-safe.
+ *
+ * Raw streams are normally removed by the client that started them. Streams that completed longer ago than the expiry
+ * timeout, eg. because their client exited without removing them, are removed when a new stream is created so that they
+ * cannot exhaust the maximum number of streams.
+ */
+class RawStreamManager
+{
+public:
+    using Clock = RawStream::Clock;
+
+    /**
+     * @brief The maximum number of raw streams that may exist at once, each of which owns a socket and a thread.
+     */
+    static constexpr std::size_t NumberOfRawStreamsMaximum{ 16 };
+
+    /**
+     * @brief The default time after a raw stream completes at which it is removed.
+     */
+    static constexpr std::chrono::seconds ExpiryTimeoutDefault{ 300 };
+
+    /**
+     * @brief Construct a new RawStreamManager object.
+     *
+     * @param expiryTimeout The time after a raw stream completes at which it is removed.
+     */
+    explicit RawStreamManager(Clock::duration expiryTimeout = ExpiryTimeoutDefault) noexcept;
+
+    /**
+     * @brief Create a new raw stream with a unique, unpredictable identifier. The stream is not started. Expired
+     * streams are removed first, which waits for their threads to exit.
+     *
+     * @param configuration The configuration of the stream.
+     * @return std::shared_ptr<RawStream> The stream, or nullptr if the maximum number of streams exist.
+     */
+    std::shared_ptr<RawStream>
+    Create(RawStreamConfiguration configuration);
+
+    /**
+     * @brief Find an existing raw stream.
+     *
+     * @param id The identifier of the stream.
+     * @return std::shared_ptr<RawStream> The stream, or nullptr if no stream with the identifier exists.
+     */
+    std::shared_ptr<RawStream>
+    Find(const std::string& id) const;
+
+    /**
+     * @brief Remove a raw stream. The stream is stopped once the last reference to it is released.
+     *
+     * @param id The identifier of the stream.
+     * @return true If the stream was removed.
+     * @return false If no stream with the identifier exists.
+     */
+    bool
+    Remove(const std::string& id);
+
+    /**
+     * @brief Remove all raw streams that completed longer ago than the expiry timeout.
+     *
+     * @param timeNow The current time.
+     * @return std::size_t The number of raw streams removed.
+     */
+    std::size_t
+    RemoveExpired(Clock::time_point timeNow = Clock::now());
+
+private:
+    /**
+     * @brief Remove all raw streams that completed longer ago than the expiry timeout, with m_rawStreamsGate held. The
+     * removed streams are returned so that they are destroyed once the lock is released.
+     *
+     * @param timeNow The current time.
+     * @return std::vector<std::shared_ptr<RawStream>> The raw streams removed.
+     */
+    std::vector<std::shared_ptr<RawStream>>
+    RemoveExpiredLocked(Clock::time_point timeNow);
+
+private:
+    Clock::duration m_expiryTimeout;
+    mutable std::mutex m_rawStreamsGate{};
+    std::unordered_map<std::string, std::shared_ptr<RawStream>> m_rawStreams{};
+    std::mt19937_64 m_idGenerator{ std::random_device{}() };
+};
+} // namespace Microsoft::Net::Remote::DataStream
+
+#endif // DATA_STREAM_RAW_STREAM_MANAGER_HXX
@@ -0,0 +1,114 @@
+
+#ifndef RECEIVE_STATISTICS_HXX
+#define RECEIVE_STATISTICS_HXX
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include <microsoft/net/remote/datastream/Histogram.hxx>
+
+namespace Microsoft::Net::Remote::DataStream
+{
+/**
+ * @brief Throughput and timing statistics for data blocks received on a data stream.
+ *
+ * Intervals are measured with a monotonic clock. Wall-clock times are derived from the wall-clock time of the first
+ * data block and the monotonic time elapsed since, so they are unaffected by clock adjustments during the stream.
+ */
+class ReceiveStatistics
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Record the arrival of a data block.
+     *
+     * @param numberOfBytes The number of data bytes in the block.
+     * @param timeReceived The time the block was received.
+     */
+    void
+    Record(std::size_t numberOfBytes, Clock::time_point timeReceived = Clock::now()) noexcept;
+
+    /**
+     * @brief Get the number of data blocks received.
+     *
+     * @return uint64_t
+     */
+    uint64_t
+    GetNumberOfDataBlocks() const noexcept;
+
+    /**
+     * @brief Get the total number of data bytes received.
+     *
+     * @return uint64_t
+     */
+    uint64_t
+    GetNumberOfBytes() const noexcept;
+
+    /**
+     * @brief Get the wall-clock time the first data block was received, if any.
+     *
+     * @return std::optional<std::chrono::system_clock::time_point>
+     */
+    std::optional<std::chrono::system_clock::time_point>
+    GetTimeFirstReceived() const noexcept;
+
+    /**
+     * @brief Get the wall-clock time the last data block was received, if any.
+     *
+     * @return std::optional<std::chrono::system_clock::time_point>
+     */
+    std::optional<std::chrono::system_clock::time_point>
+    GetTimeLastReceived() const noexcept;
+
+    /**
+     * @brief Get the time elapsed between receiving the first and the last data blocks.
+     *
+     * @return Clock::duration
+     */
+    Clock::duration
+    GetDuration() const noexcept;
+
+    /**
+     * @brief Get the goodput in bits per second. This is the rate at which data bytes arrived after the first data
+     * block, over the interval between the first and the last data blocks. It is 0 if fewer than two data blocks were
+     * received.
+     *
+     * @return uint64_t
+     */
+    uint64_t
+    GetGoodputBitsPerSecond() const noexcept;
+
+    /**
+     * @brief Get the histogram of times between the arrival of consecutive data blocks, in microseconds.
+     *
+     * @return const Histogram&
+     */
+    const Histogram&
+    GetInterArrivalTimeHistogram() const noexcept;
+
+    /**
+     * @brief Get the histogram of inter-arrival jitter, in microseconds. The jitter of a data block is the absolute
+     * difference between its inter-arrival time and that of the previous data block.
+     *
+     * @return const Histogram&
+     */
+    const Histogram&
+    GetInterArrivalJitterHistogram() const noexcept;
+
+private:
+    uint64_t m_numberOfDataBlocks{};
+    uint64_t m_numberOfBytes{};
+    uint64_t m_numberOfBytesFirstDataBlock{};
+    std::chrono::system_clock::time_point m_timeFirstReceivedSystem{};
+    Clock::time_point m_timeFirstReceived{};
+    Clock::time_point m_timeLastReceived{};
+    std::optional<Clock::duration> m_interArrivalTimeLast{};
+    Histogram m_interArrivalTimeHistogram{};
+    Histogram m_interArrivalJitterHistogram{};
+};
+} // namespace Microsoft::Net::Remote::DataStream
+
+#endif // RECEIVE_STATISTICS_HXX
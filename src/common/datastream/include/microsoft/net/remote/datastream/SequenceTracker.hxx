@@ -0,0 +1,107 @@
+
+#ifndef SEQUENCE_TRACKER_HXX
+#define SEQUENCE_TRACKER_HXX
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+
+namespace Microsoft::Net::Remote::DataStream
+{
+/**
+ * @brief Tracks the sequence numbers of data blocks received on a data stream to detect lost, duplicated and reordered
+ * data blocks.
+ *
+ * Sequence numbers start at 1 and are expected to increase by 1 with each data block sent. Every sequence number up to
+ * the highest one received is expected to be received exactly once; those never received are considered lost.
+ * Sequence numbers within a window below the highest one received are remembered, which allows distinguishing late
+ * data blocks from duplicates. A data block that arrives later than that is counted as out of order, but cannot be
+ * checked for duplication.
+ */
+class SequenceTracker
+{
+public:
+    /**
+     * @brief The number of sequence numbers below the highest one received that are remembered.
+     */
+    static constexpr std::size_t WindowSize{ 4096 };
+
+    /**
+     * @brief Record the arrival of a data block.
+     *
+     * @param sequenceNumber The sequence number of the data block. Must be greater than 0.
+     */
+    void
+    Record(uint64_t sequenceNumber) noexcept;
+
+    /**
+     * @brief Get the number of distinct data blocks received.
+     *
+     * @return uint64_t
+     */
+    uint64_t
+    GetNumberOfDataBlocksUnique() const noexcept;
+
+    /**
+     * @brief Get the number of data blocks not received, up to the highest sequence number received.
+     *
+     * @return uint64_t
+     */
+    uint64_t
+    GetNumberOfDataBlocksLost() const noexcept;
+
+    /**
+     * @brief Get the number of data blocks received more than once, counting each additional copy.
+     *
+     * @return uint64_t
+     */
+    uint64_t
+    GetNumberOfDataBlocksDuplicated() const noexcept;
+
+    /**
+     * @brief Get the number of data blocks received after a data block with a higher sequence number.
+     *
+     * @return uint64_t
+     */
+    uint64_t
+    GetNumberOfDataBlocksOutOfOrder() const noexcept;
+
+    /**
+     * @brief Get the number of gaps, which is the number of times one or more sequence numbers were skipped, whether
+     * or not the skipped data blocks arrived later. Together with the number of data blocks lost, this indicates
+     * whether losses are isolated or occur in bursts.
+     *
+     * @return uint64_t
+     */
+    uint64_t
+    GetNumberOfGaps() const noexcept;
+
+    /**
+     * @brief Get the largest reorder distance, which is the difference between the highest sequence number received
+     * and that of a data block received out of order.
+     *
+     * @return uint64_t
+     */
+    uint64_t
+    GetReorderDistanceMaximum() const noexcept;
+
+    /**
+     * @brief Get the highest sequence number received, or 0 if none was received.
+     *
+     * @return uint64_t
+     */
+    uint64_t
+    GetSequenceNumberHighest() const noexcept;
+
+private:
+    uint64_t m_sequenceNumberHighest{};
+    uint64_t m_numberOfDataBlocksUnique{};
+    uint64_t m_numberOfDataBlocksDuplicated{};
+    uint64_t m_numberOfDataBlocksOutOfOrder{};
+    uint64_t m_numberOfGaps{};
+    uint64_t m_reorderDistanceMaximum{};
+    std::bitset<WindowSize> m_sequenceNumbersReceived{};
+};
+} // namespace Microsoft::Net::Remote::DataStream
+
+#endif // SEQUENCE_TRACKER_HXX
@@ -0,0 +1,223 @@
+
+#ifndef DATA_STREAM_SESSION_HXX
+#define DATA_STREAM_SESSION_HXX
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Microsoft::Net::Remote::DataStream
+{
+/**
+ * @brief The direction in which data flows on a stream attached to a session.
+ */
+enum class SessionStreamDirection {
+    Upload,
+    Download,
+    Bidirectional,
+};
+
+/**
+ * @brief A snapshot of the data transferred on a stream attached to a session.
+ */
+struct SessionStreamResult
+{
+    uint32_t Id{};
+    SessionStreamDirection Direction{ SessionStreamDirection::Upload };
+    uint64_t NumberOfDataBlocksReceived{};
+    uint64_t NumberOfBytesReceived{};
+    uint64_t NumberOfDataBlocksSent{};
+    uint64_t NumberOfBytesSent{};
+    std::chrono::steady_clock::duration Duration{};
+    uint64_t GoodputBitsPerSecond{};
+    bool IsCompleted{ false };
+};
+
+/**
+ * @brief A snapshot of the data transferred on all streams attached to a session.
+ */
+struct SessionResult
+{
+    uint64_t NumberOfBytesReceived{};
+    uint64_t NumberOfBytesSent{};
+    std::chrono::steady_clock::duration Duration{};
+    uint64_t GoodputBitsPerSecond{};
+    double FairnessIndex{};
+    uint32_t NumberOfStreamsActive{};
+    std::vector<SessionStreamResult> Streams{};
+};
+
+/**
+ * @brief Accounting for a single stream attached to a session.
+ *
+ * A stream is updated by the reactor serving it, once per data block, while the session may be queried concurrently.
+ * All state is therefore kept in relaxed atomics, so updates never contend with other streams or with queries. A
+ * snapshot taken while the stream is active is not guaranteed to be consistent across fields, but each field is.
+ */
+class SessionStream
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Construct a new SessionStream object.
+     *
+     * @param id The identifier of the stream within its session.
+     * @param direction The direction in which data flows on the stream.
+     * @param timeStart The time the stream started.
+     */
+    SessionStream(uint32_t id, SessionStreamDirection direction, Clock::time_point timeStart = Clock::now()) noexcept;
+
+    /**
+     * @brief Record a data block received on the stream.
+     *
+     * @param numberOfBytes The number of data bytes in the block.
+     * @param timeReceived The time the block was received.
+     */
+    void
+    RecordReceived(std::size_t numberOfBytes, Clock::time_point timeReceived = Clock::now()) noexcept;
+
+    /**
+     * @brief Record a data block sent on the stream.
+     *
+     * @param numberOfBytes The number of data bytes in the block.
+     * @param timeSent The time the block was sent.
+     */
+    void
+    RecordSent(std::size_t numberOfBytes, Clock::time_point timeSent = Clock::now()) noexcept;
+
+    /**
+     * @brief Mark the stream as completed. No data is recorded afterwards.
+     */
+    void
+    Complete() noexcept;
+
+    /**
+     * @brief Get a snapshot of the data transferred on the stream. The duration spans from the start of the stream to
+     * the last data block transferred.
+     *
+     * @return SessionStreamResult
+     */
+    SessionStreamResult
+    GetResult() const noexcept;
+
+    /**
+     * @brief Determine whether the stream was completed.
+     *
+     * @return true If the stream was completed.
+     * @return false If the stream is still active.
+     */
+    bool
+    IsCompleted() const noexcept;
+
+    /**
+     * @brief Get the time the stream started.
+     *
+     * @return Clock::time_point
+     */
+    Clock::time_point
+    GetTimeStart() const noexcept;
+
+    /**
+     * @brief Get the time data was last transferred on the stream, or the start time if none was.
+     *
+     * @return Clock::time_point
+     */
+    Clock::time_point
+    GetTimeLastActivity() const noexcept;
+
+private:
+    uint32_t m_id;
+    SessionStreamDirection m_direction;
+    Clock::time_point m_timeStart;
+    std::atomic<Clock::rep> m_timeLastActivity;
+    std::atomic<uint64_t> m_numberOfDataBlocksReceived{};
+    std::atomic<uint64_t> m_numberOfBytesReceived{};
+    std::atomic<uint64_t> m_numberOfDataBlocksSent{};
+    std::atomic<uint64_t> m_numberOfBytesSent{};
+    std::atomic<bool> m_isCompleted{};
+};
+
+/**
+ * @brief A group of streams, typically run in parallel, whose results are aggregated.
+ */
+class Session
+{
+public:
+    /**
+     * @brief The maximum number of streams that may be attached to a session.
+     */
+    static constexpr std::size_t NumberOfStreamsMaximum{ 256 };
+
+    /**
+     * @brief Construct a new Session object.
+     *
+     * @param id The identifier of the session.
+     * @param timeCreated The time the session was created.
+     */
+    explicit Session(std::string id, SessionStream::Clock::time_point timeCreated = SessionStream::Clock::now());
+
+    /**
+     * @brief Get the identifier of the session.
+     *
+     * @return const std::string&
+     */
+    const std::string&
+    GetId() const noexcept;
+
+    /**
+     * @brief Attach a new stream to the session.
+     *
+     * @param direction The direction in which data flows on the stream.
+     * @return std::shared_ptr<SessionStream> The stream, or nullptr if the maximum number of streams is attached.
+     */
+    std::shared_ptr<SessionStream>
+    AddStream(SessionStreamDirection direction);
+
+    /**
+     * @brief Get the aggregated results of all streams attached to the session.
+     *
+     * The goodput is the total number of bytes transferred over the interval from the start of the first stream to the
+     * last data block transferred on any stream. The fairness index is Jain's fairness index of the per-stream goodput,
+     * which ranges from 1/n (one stream got everything) to 1 (all streams got the same); it is 0 if no data was
+     * transferred.
+     *
+     * @return SessionResult
+     */
+    SessionResult
+    GetResult() const;
+
+    /**
+     * @brief Determine whether the session has been idle since the specified time, ie. none of its streams is active,
+     * and it was neither created nor had data transferred on any of its streams after that time.
+     *
+     * @param time The time to check from.
+     * @return true If the session has been idle since the specified time.
+     * @return false Otherwise.
+     */
+    bool
+    IsIdleSince(SessionStream::Clock::time_point time) const;
+
+    /**
+     * @brief Compute Jain's fairness index of the specified values.
+     *
+     * @param values The values, such as the goodput of each stream.
+     * @return double The fairness index, or 0 if there are no values or all are 0.
+     */
+    static double
+    ComputeFairnessIndex(const std::vector<uint64_t>& values) noexcept;
+
+private:
+    std::string m_id;
+    SessionStream::Clock::time_point m_timeCreated;
+    mutable std::mutex m_streamsGate{};
+    std::vector<std::shared_ptr<SessionStream>> m_streams{};
+};
+} // namespace Microsoft::Net::Remote::DataStream
+
+#endif // DATA_STREAM_SESSION_HXX
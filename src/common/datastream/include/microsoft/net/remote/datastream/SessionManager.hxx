@@ -0,0 +1,101 @@
+
+#ifndef DATA_STREAM_SESSION_MANAGER_HXX
+#define DATA_STREAM_SESSION_MANAGER_HXX
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+#include <microsoft/net/remote/datastream/Session.hxx>
+
+namespace Microsoft::Net::Remote::DataStream
+{
+/**
+ * @brief Creates and tracks data stream sessions. This class is thread-safe.
+ *
+ * Sessions are normally removed by the client that created them. Sessions that have been idle for longer than the idle
+ * timeout, eg. because their client exited without removing them, are removed when a new session is created so that
+ * they cannot exhaust the maximum number of sessions.
+ */
+class SessionManager
+{
+public:
+    using Clock = SessionStream::Clock;
+
+    /**
+     * @brief The maximum number of sessions that may exist at once.
+     */
+    static constexpr std::size_t NumberOfSessionsMaximum{ 64 };
+
+    /**
+     * @brief The default time after which a session with no active streams is removed.
+     */
+    static constexpr std::chrono::seconds IdleTimeoutDefault{ 300 };
+
+    /**
+     * @brief Construct a new SessionManager object.
+     *
+     * @param idleTimeout The time after which a session with no active streams is removed.
+     */
+    explicit SessionManager(Clock::duration idleTimeout = IdleTimeoutDefault) noexcept;
+
+    /**
+     * @brief Create a new session with a unique, unpredictable identifier. Idle sessions are removed first.
+     *
+     * @return std::shared_ptr<Session> The session, or nullptr if the maximum number of sessions exist.
+     */
+    std::shared_ptr<Session>
+    Create();
+
+    /**
+     * @brief Find an existing session.
+     *
+     * @param id The identifier of the session.
+     * @return std::shared_ptr<Session> The session, or nullptr if no session with the identifier exists.
+     */
+    std::shared_ptr<Session>
+    Find(const std::string& id) const;
+
+    /**
+     * @brief Remove a session. Streams attached to it are unaffected, but no more streams may be attached.
+     *
+     * @param id The identifier of the session.
+     * @return true If the session was removed.
+     * @return false If no session with the identifier exists.
+     */
+    bool
+    Remove(const std::string& id);
+
+    /**
+     * @brief Remove all sessions that have had no active streams for longer than the idle timeout.
+     *
+     * @param timeNow The current time.
+     * @return std::size_t The number of sessions removed.
+     */
+    std::size_t
+    RemoveIdle(Clock::time_point timeNow = Clock::now());
+
+private:
+    /**
+     * @brief Remove all sessions that have had no active streams for longer than the idle timeout, with m_sessionsGate
+     * held.
+     *
+     * @param timeNow The current time.
+     * @return std::size_t The number of sessions removed.
+     */
+    std::size_t
+    RemoveIdleLocked(Clock::time_point timeNow);
+
+private:
+    Clock::duration m_idleTimeout;
+    mutable std::mutex m_sessionsGate{};
+    std::unordered_map<std::string, std::shared_ptr<Session>> m_sessions{};
+    std::mt19937_64 m_idGenerator{ std::random_device{}() };
+};
+} // namespace Microsoft::Net::Remote::DataStream
+
+#endif // DATA_STREAM_SESSION_MANAGER_HXX
@@ -0,0 +1,171 @@
+
+#ifndef DATA_STREAM_STREAM_ADMISSION_HXX
+#define DATA_STREAM_STREAM_ADMISSION_HXX
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+namespace Microsoft::Net::Remote::DataStream
+{
+/**
+ * @brief Limits on the data streams a server runs at once. A limit of 0 disables it.
+ */
+struct StreamAdmissionConfiguration
+{
+    /**
+     * @brief The maximum number of data streams that may run at once.
+     */
+    uint32_t NumberOfStreamsMaximum{ 0 };
+
+    /**
+     * @brief The maximum number of bytes that data streams may have in flight at once, which is the size of the
+     * messages they buffer for writing.
+     */
+    std::size_t NumberOfBytesInFlightMaximum{ 0 };
+};
+
+class StreamAdmission;
+
+/**
+ * @brief Represents the admission of a data stream, and the bytes it reserved. Both are released when the ticket is
+ * destroyed.
+ */
+class StreamAdmissionTicket
+{
+public:
+    /**
+     * @brief Construct an empty ticket, which holds no admission.
+     */
+    StreamAdmissionTicket() = default;
+
+    ~StreamAdmissionTicket();
+
+    StreamAdmissionTicket(const StreamAdmissionTicket&) = delete;
+
+    StreamAdmissionTicket(StreamAdmissionTicket&& other) noexcept;
+
+    StreamAdmissionTicket&
+    operator=(const StreamAdmissionTicket&) = delete;
+
+    StreamAdmissionTicket&
+    operator=(StreamAdmissionTicket&& other) noexcept;
+
+    /**
+     * @brief Reserve bytes in flight for the stream, in addition to those it already reserved.
+     *
+     * @param numberOfBytes The number of bytes to reserve.
+     * @return true If the bytes were reserved.
+     * @return false If reserving them would exceed the budget, or the ticket is empty.
+     */
+    bool
+    TryReserve(std::size_t numberOfBytes);
+
+    /**
+     * @brief Get the number of bytes in flight reserved by the stream.
+     *
+     * @return std::size_t
+     */
+    std::size_t
+    GetNumberOfBytesReserved() const noexcept;
+
+private:
+    friend class StreamAdmission;
+
+    /**
+     * @brief Construct a ticket for a stream admitted by the specified admission controller.
+     *
+     * @param streamAdmission The admission controller that admitted the stream.
+     */
+    explicit StreamAdmissionTicket(StreamAdmission* streamAdmission) noexcept;
+
+    /**
+     * @brief Release the admission and the bytes reserved, leaving the ticket empty.
+     */
+    void
+    Release() noexcept;
+
+private:
+    StreamAdmission* m_streamAdmission{ nullptr };
+    std::size_t m_numberOfBytesReserved{ 0 };
+};
+
+/**
+ * @brief Admits data streams within a limit on their number and on the bytes they have in flight, so that data streams
+ * cannot exhaust the resources of the server. This class is thread-safe, and must outlive the tickets it issues.
+ */
+class StreamAdmission
+{
+public:
+    /**
+     * @brief Construct a new StreamAdmission object with the specified limits.
+     *
+     * @param configuration The limits to enforce.
+     */
+    explicit StreamAdmission(StreamAdmissionConfiguration configuration = {}) noexcept;
+
+    /**
+     * @brief Admit a data stream, if the maximum number of streams are not already running.
+     *
+     * @return std::optional<StreamAdmissionTicket> The ticket of the admitted stream, or std::nullopt if it was
+     * rejected.
+     */
+    std::optional<StreamAdmissionTicket>
+    TryAdmit();
+
+    /**
+     * @brief Get the number of data streams admitted and not yet released.
+     *
+     * @return uint32_t
+     */
+    uint32_t
+    GetNumberOfStreams() const;
+
+    /**
+     * @brief Get the number of bytes in flight reserved by admitted streams.
+     *
+     * @return std::size_t
+     */
+    std::size_t
+    GetNumberOfBytesInFlight() const;
+
+    /**
+     * @brief Get the number of data streams rejected, either on admission or when reserving bytes in flight.
+     *
+     * @return uint64_t
+     */
+    uint64_t
+    GetNumberOfStreamsRejected() const;
+
+private:
+    friend class StreamAdmissionTicket;
+
+    /**
+     * @brief Reserve bytes in flight for an admitted stream.
+     *
+     * @param numberOfBytes The number of bytes to reserve.
+     * @return true If the bytes were reserved.
+     * @return false If reserving them would exceed the budget.
+     */
+    bool
+    TryReserve(std::size_t numberOfBytes);
+
+    /**
+     * @brief Release an admitted stream and the bytes it reserved.
+     *
+     * @param numberOfBytes The number of bytes reserved by the stream.
+     */
+    void
+    Release(std::size_t numberOfBytes) noexcept;
+
+private:
+    const StreamAdmissionConfiguration m_configuration;
+    mutable std::mutex m_admissionGate{};
+    uint32_t m_numberOfStreams{ 0 };
+    std::size_t m_numberOfBytesInFlight{ 0 };
+    uint64_t m_numberOfStreamsRejected{ 0 };
+};
+} // namespace Microsoft::Net::Remote::DataStream
+
+#endif // DATA_STREAM_STREAM_ADMISSION_HXX
@@ -0,0 +1,53 @@
+
+#ifndef DATA_STREAM_STREAM_METRICS_HXX
+#define DATA_STREAM_STREAM_METRICS_HXX
+
+#include <cstdint>
+#include <mutex>
+
+#include <microsoft/net/remote/datastream/Histogram.hxx>
+
+namespace Microsoft::Net::Remote::DataStream
+{
+/**
+ * @brief Metrics aggregated over all data streams of a server. This class is thread-safe.
+ *
+ * Streams record their metrics locally while they run and merge them in once they complete, so the hot path of a stream
+ * never contends for the lock.
+ */
+class StreamMetrics
+{
+public:
+    /**
+     * @brief Add the write completion latencies of a completed stream.
+     *
+     * @param writeCompletionLatency The time between starting each write of the stream and its completion, in
+     * microseconds.
+     */
+    void
+    RecordWriteCompletionLatency(const Histogram& writeCompletionLatency);
+
+    /**
+     * @brief Get the write completion latencies of all streams recorded so far, in microseconds.
+     *
+     * @return Histogram
+     */
+    Histogram
+    GetWriteCompletionLatency() const;
+
+    /**
+     * @brief Get the number of streams whose write completion latencies were recorded.
+     *
+     * @return uint64_t
+     */
+    uint64_t
+    GetNumberOfStreams() const;
+
+private:
+    mutable std::mutex m_metricsGate{};
+    Histogram m_writeCompletionLatency{};
+    uint64_t m_numberOfStreams{};
+};
+} // namespace Microsoft::Net::Remote::DataStream
+
+#endif // DATA_STREAM_STREAM_METRICS_HXX
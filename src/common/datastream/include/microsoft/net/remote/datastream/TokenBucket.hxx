@@ -0,0 +1,57 @@
+
+#ifndef TOKEN_BUCKET_HXX
+#define TOKEN_BUCKET_HXX
+
+#include <chrono>
+#include <cstdint>
+
+namespace Microsoft::Net::Remote::DataStream
+{
+/**
+ * @brief A token bucket used to pace writes to a target rate.
+ *
+ * Tokens accumulate at a fixed rate up to the bucket capacity, which bounds the size of bursts after idle periods.
+ * Reserving tokens always succeeds, but may drive the bucket into debt; the returned time is when the debt is repaid,
+ * and thus when the reserved write may proceed without exceeding the rate.
+ */
+class TokenBucket
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Construct a new TokenBucket object. The bucket starts full.
+     *
+     * @param tokensPerSecond The rate at which tokens accumulate. Must be greater than 0.
+     * @param capacity The maximum number of tokens the bucket holds.
+     * @param timeStart The time the bucket starts accumulating tokens.
+     */
+    TokenBucket(double tokensPerSecond, double capacity, Clock::time_point timeStart = Clock::now()) noexcept;
+
+    /**
+     * @brief Reserve tokens.
+     *
+     * @param numberOfTokens The number of tokens to reserve.
+     * @param timeNow The current time.
+     * @return Clock::time_point The time at which the tokens are available. This is timeNow if they already are.
+     */
+    Clock::time_point
+    Reserve(double numberOfTokens, Clock::time_point timeNow = Clock::now()) noexcept;
+
+    /**
+     * @brief Get the rate at which tokens accumulate, per second.
+     *
+     * @return double
+     */
+    double
+    GetTokensPerSecond() const noexcept;
+
+private:
+    double m_tokensPerSecond;
+    double m_capacity;
+    double m_tokens;
+    Clock::time_point m_timeLastRefill;
+};
+} // namespace Microsoft::Net::Remote::DataStream
+
+#endif // TOKEN_BUCKET_HXX
@@ -16,8 +16,10 @@
 #include <magic_enum.hpp>
 #include <microsoft/net/wifi/AccessPointDiscoveryAgent.hxx>
 #include <microsoft/net/wifi/AccessPointManager.hxx>
+#include <microsoft/net/wifi/AccessPointOperationStatus.hxx>
 #include <microsoft/net/wifi/IAccessPoint.hxx>
 #include <microsoft/net/wifi/IAccessPointDiscoveryAgentOperations.hxx>
+#include <microsoft/net/wifi/Ieee80211.hxx>
 #include <notstd/Memory.hxx>
 #include <plog/Log.h>
 
@@ -55,20 +57,32 @@ AccessPointManager::AddAccessPoint(std::shared_ptr<IAccessPoint> accessPoint)
         }
     }
 
-    const auto accessPointsLock = std::scoped_lock{ m_accessPointGate };
-    const auto accessPointExists = std::ranges::any_of(m_accessPoints, [&](const auto& accessPointExisting) {
-        return (accessPointExisting->GetInterfaceName() == interfaceName);
-    });
+    {
+        const auto accessPointsLock = std::scoped_lock{ m_accessPointGate };
+        const auto accessPointExists = std::ranges::any_of(m_accessPoints, [&](const auto& accessPointExisting) {
+            return (accessPointExisting->GetInterfaceName() == interfaceName);
+        });
 
-    if (accessPointExists) {
-        LOGW << std::format("Access point {} not added (already exists)", interfaceName);
-        return;
-    }
+        if (accessPointExists) {
+            LOGW << std::format("Access point {} not added (already exists)", interfaceName);
+            return;
+        }
+
+        LOGI << std::format("Adding access point {} to manager", interfaceName);
+        AUDITI << std::format("Adding access point {} to manager", interfaceName);
+
+        // Only install the access point callbacks if something is registered to receive the changes they report.
+        if (m_isOperationalStateChangedCallbackInstalled) {
+            SetOperationalStateChangedCallbackLocked(accessPoint, true);
+        }
+        if (m_isStationChangedCallbackInstalled) {
+            SetStationChangedCallbackLocked(accessPoint, true);
+        }
 
-    LOGI << std::format("Adding access point {} to manager", interfaceName);
-    AUDITI << std::format("Adding access point {} to manager", interfaceName);
+        m_accessPoints.push_back(accessPoint);
+    }
 
-    m_accessPoints.push_back(std::move(accessPoint));
+    NotifyAccessPointChanged(AccessPointChange::Added, accessPoint);
 }
 
 void
@@ -78,20 +92,203 @@ AccessPointManager::RemoveAccessPoint(std::shared_ptr<IAccessPoint> accessPoint)
     LOGI << std::format("Attempting to remove access point {} from manager", interfaceName);
     AUDITD << std::format("Attempting to remove access point {} from manager", interfaceName);
 
+    std::shared_ptr<IAccessPoint> accessPointRemoved{};
+    {
+        const auto accessPointsLock = std::scoped_lock{ m_accessPointGate };
+        const auto accessPointToRemove = std::ranges::find_if(m_accessPoints, [&](const auto& accessPointExisting) {
+            return (accessPointExisting->GetInterfaceName() == interfaceName);
+        });
+
+        if (accessPointToRemove == std::cend(m_accessPoints)) {
+            LOGW << std::format("Access point {} not removed (not found in manager)", interfaceName);
+            return;
+        }
+
+        LOGI << std::format("Removing access point {} from manager", interfaceName);
+        AUDITI << std::format("Removing access point {} from manager", interfaceName);
+
+        accessPointRemoved = std::move(*accessPointToRemove);
+        accessPointRemoved->SetOperationalStateChangedCallback(nullptr);
+        accessPointRemoved->SetStationChangedCallback(nullptr);
+        m_accessPoints.erase(accessPointToRemove);
+    }
+
+    NotifyAccessPointChanged(AccessPointChange::Removed, accessPointRemoved);
+}
+
+AccessPointChangedCallbackToken
+AccessPointManager::RegisterAccessPointChangedCallback(AccessPointChangedCallback accessPointChangedCallback)
+{
+    AccessPointChangedCallbackToken accessPointChangedCallbackToken{};
+    bool isFirstCallback{ false };
+    {
+        const std::unique_lock<std::shared_mutex> accessPointChangedCallbacksLock{ m_accessPointChangedCallbacksGate };
+
+        accessPointChangedCallbackToken = m_accessPointChangedCallbackTokenNext++;
+        m_accessPointChangedCallbacks[accessPointChangedCallbackToken] = std::move(accessPointChangedCallback);
+        isFirstCallback = (std::size(m_accessPointChangedCallbacks) == 1);
+    }
+
+    if (isFirstCallback) {
+        UpdateAccessPointCallbacks();
+    }
+
+    return accessPointChangedCallbackToken;
+}
+
+void
+AccessPointManager::UnregisterAccessPointChangedCallback(AccessPointChangedCallbackToken accessPointChangedCallbackToken)
+{
+    bool isLastCallback{ false };
+    {
+        const std::unique_lock<std::shared_mutex> accessPointChangedCallbacksLock{ m_accessPointChangedCallbacksGate };
+
+        const auto numRemoved = m_accessPointChangedCallbacks.erase(accessPointChangedCallbackToken);
+        if (numRemoved == 0) {
+            LOGW << std::format("Attempted to unregister an access point changed callback that was not registered (token {})", accessPointChangedCallbackToken);
+            return;
+        }
+        isLastCallback = std::empty(m_accessPointChangedCallbacks);
+    }
+
+    if (isLastCallback) {
+        UpdateAccessPointCallbacks();
+    }
+}
+
+void
+AccessPointManager::NotifyAccessPointChanged(AccessPointChange change, const std::shared_ptr<IAccessPoint>& accessPoint)
+{
+    LOGD << std::format("Access point {} changed ({})", accessPoint->GetInterfaceName(), magic_enum::enum_name(change));
+
+    const std::shared_lock<std::shared_mutex> accessPointChangedCallbacksLock{ m_accessPointChangedCallbacksGate };
+    for (const auto& [_, accessPointChangedCallback] : m_accessPointChangedCallbacks) {
+        accessPointChangedCallback(change, accessPoint);
+    }
+}
+
+StationChangedCallbackToken
+AccessPointManager::RegisterStationChangedCallback(StationChangedCallback stationChangedCallback)
+{
+    StationChangedCallbackToken stationChangedCallbackToken{};
+    bool isFirstCallback{ false };
+    {
+        const std::unique_lock<std::shared_mutex> stationChangedCallbacksLock{ m_stationChangedCallbacksGate };
+
+        stationChangedCallbackToken = m_stationChangedCallbackTokenNext++;
+        m_stationChangedCallbacks[stationChangedCallbackToken] = std::move(stationChangedCallback);
+        isFirstCallback = (std::size(m_stationChangedCallbacks) == 1);
+    }
+
+    if (isFirstCallback) {
+        UpdateAccessPointCallbacks();
+    }
+
+    return stationChangedCallbackToken;
+}
+
+void
+AccessPointManager::UnregisterStationChangedCallback(StationChangedCallbackToken stationChangedCallbackToken)
+{
+    bool isLastCallback{ false };
+    {
+        const std::unique_lock<std::shared_mutex> stationChangedCallbacksLock{ m_stationChangedCallbacksGate };
+
+        const auto numRemoved = m_stationChangedCallbacks.erase(stationChangedCallbackToken);
+        if (numRemoved == 0) {
+            LOGW << std::format("Attempted to unregister a station changed callback that was not registered (token {})", stationChangedCallbackToken);
+            return;
+        }
+        isLastCallback = std::empty(m_stationChangedCallbacks);
+    }
+
+    if (isLastCallback) {
+        UpdateAccessPointCallbacks();
+    }
+}
+
+void
+AccessPointManager::NotifyStationChanged(AccessPointStationChange change, const Ieee80211MacAddress& stationMacAddress, const std::shared_ptr<IAccessPoint>& accessPoint)
+{
+    LOGD << std::format("Station {} {} access point {}", Ieee80211MacAddressToString(stationMacAddress), (change == AccessPointStationChange::Connected) ? "connected to" : "disconnected from", accessPoint->GetInterfaceName());
+
+    const std::shared_lock<std::shared_mutex> stationChangedCallbacksLock{ m_stationChangedCallbacksGate };
+    for (const auto& [_, stationChangedCallback] : m_stationChangedCallbacks) {
+        stationChangedCallback(change, stationMacAddress, accessPoint);
+    }
+}
+
+void
+AccessPointManager::UpdateAccessPointCallbacks()
+{
+    // Updates are serialized so that the last one to run, which sees the final set of registered callbacks, decides
+    // whether the access point callbacks are installed. The callback gates are not held while the access point
+    // callbacks are updated, since access points invoke their callbacks, which take those gates, with a lock held that
+    // updating them also takes.
+    const auto accessPointCallbacksLock = std::scoped_lock{ m_accessPointCallbacksGate };
+
+    bool isOperationalStateChangedCallbackNeeded{ false };
+    {
+        const std::shared_lock<std::shared_mutex> accessPointChangedCallbacksLock{ m_accessPointChangedCallbacksGate };
+        isOperationalStateChangedCallbackNeeded = !std::empty(m_accessPointChangedCallbacks);
+    }
+
+    bool isStationChangedCallbackNeeded{ false };
+    {
+        const std::shared_lock<std::shared_mutex> stationChangedCallbacksLock{ m_stationChangedCallbacksGate };
+        isStationChangedCallbackNeeded = !std::empty(m_stationChangedCallbacks);
+    }
+
     const auto accessPointsLock = std::scoped_lock{ m_accessPointGate };
-    const auto accessPointToRemove = std::ranges::find_if(m_accessPoints, [&](const auto& accessPointExisting) {
-        return (accessPointExisting->GetInterfaceName() == interfaceName);
-    });
+    if (m_isOperationalStateChangedCallbackInstalled != isOperationalStateChangedCallbackNeeded) {
+        m_isOperationalStateChangedCallbackInstalled = isOperationalStateChangedCallbackNeeded;
+        for (const auto& accessPoint : m_accessPoints) {
+            SetOperationalStateChangedCallbackLocked(accessPoint, isOperationalStateChangedCallbackNeeded);
+        }
+    }
+    if (m_isStationChangedCallbackInstalled != isStationChangedCallbackNeeded) {
+        m_isStationChangedCallbackInstalled = isStationChangedCallbackNeeded;
+        for (const auto& accessPoint : m_accessPoints) {
+            SetStationChangedCallbackLocked(accessPoint, isStationChangedCallbackNeeded);
+        }
+    }
+}
 
-    if (accessPointToRemove == std::cend(m_accessPoints)) {
-        LOGW << std::format("Access point {} not removed (not found in manager)", interfaceName);
+void
+AccessPointManager::SetOperationalStateChangedCallbackLocked(const std::shared_ptr<IAccessPoint>& accessPoint, bool isInstalled)
+{
+    if (!isInstalled) {
+        accessPoint->SetOperationalStateChangedCallback(nullptr);
         return;
     }
 
-    LOGI << std::format("Removing access point {} from manager", interfaceName);
-    AUDITI << std::format("Removing access point {} from manager", interfaceName);
+    // Forward operational state changes of the access point to registered callbacks. Weak pointers are captured since
+    // the access point owns the callback, and may outlive this manager.
+    accessPoint->SetOperationalStateChangedCallback([weakThis = weak_from_this(), weakAccessPoint = std::weak_ptr<IAccessPoint>(accessPoint)](AccessPointOperationalState operationalState) {
+        auto strongThis = weakThis.lock();
+        auto accessPoint = weakAccessPoint.lock();
+        if (strongThis != nullptr && accessPoint != nullptr) {
+            const auto change = (operationalState == AccessPointOperationalState::Enabled) ? AccessPointChange::Enabled : AccessPointChange::Disabled;
+            strongThis->NotifyAccessPointChanged(change, accessPoint);
+        }
+    });
+}
+
+void
+AccessPointManager::SetStationChangedCallbackLocked(const std::shared_ptr<IAccessPoint>& accessPoint, bool isInstalled)
+{
+    if (!isInstalled) {
+        accessPoint->SetStationChangedCallback(nullptr);
+        return;
+    }
 
-    m_accessPoints.erase(accessPointToRemove);
+    accessPoint->SetStationChangedCallback([weakThis = weak_from_this(), weakAccessPoint = std::weak_ptr<IAccessPoint>(accessPoint)](AccessPointStationChange change, const Ieee80211MacAddress& stationMacAddress) {
+        auto strongThis = weakThis.lock();
+        auto accessPoint = weakAccessPoint.lock();
+        if (strongThis != nullptr && accessPoint != nullptr) {
+            strongThis->NotifyStationChanged(change, stationMacAddress, accessPoint);
+        }
+    });
 }
 
 std::optional<std::weak_ptr<IAccessPoint>>
@@ -2,6 +2,8 @@
 #ifndef ACCESS_POINT_MANAGER_HXX
 #define ACCESS_POINT_MANAGER_HXX
 
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -11,6 +13,7 @@
 #include <vector>
 
 #include <microsoft/net/wifi/AccessPointAttributes.hxx>
+#include <microsoft/net/wifi/Ieee80211.hxx>
 
 namespace Microsoft::Net::Wifi
 {
@@ -18,6 +21,38 @@ struct IAccessPoint;
 struct IAccessPointFactory;
 struct AccessPointDiscoveryAgent;
 enum class AccessPointPresenceEvent;
+enum class AccessPointStationChange;
+
+/**
+ * @brief The kinds of changes to the access points tracked by an access point manager.
+ */
+enum class AccessPointChange {
+    Added,
+    Removed,
+    Enabled,
+    Disabled,
+};
+
+/**
+ * @brief Callback invoked when an access point tracked by an access point manager changes.
+ */
+using AccessPointChangedCallback = std::function<void(AccessPointChange change, const std::shared_ptr<IAccessPoint>& accessPoint)>;
+
+/**
+ * @brief Token identifying a registered AccessPointChangedCallback.
+ */
+using AccessPointChangedCallbackToken = uint32_t;
+
+/**
+ * @brief Callback invoked when a station connects to or disconnects from an access point tracked by an access point
+ * manager.
+ */
+using StationChangedCallback = std::function<void(AccessPointStationChange change, const Ieee80211MacAddress& stationMacAddress, const std::shared_ptr<IAccessPoint>& accessPoint)>;
+
+/**
+ * @brief Token identifying a registered StationChangedCallback.
+ */
+using StationChangedCallbackToken = uint32_t;
 
 /**
  * @brief Manages access points which implement the IAccessPoint interface,
@@ -88,6 +123,50 @@ public:
     std::optional<AccessPointAttributes>
     GetAccessPointAttributes(const std::string& interfaceName) const;
 
+    /**
+     * @brief Register a callback to be invoked when an access point is added or removed, or when the operational state
+     * of an access point changes.
+     *
+     * The callback may be invoked on any thread, and must not register or unregister callbacks. Registering a callback
+     * does not replay existing access points; callers that need them should call GetAllAccessPoints() after
+     * registering, and tolerate seeing an access point both there and in a change.
+     *
+     * @param accessPointChangedCallback The callback to invoke.
+     * @return AccessPointChangedCallbackToken A token that can be used to unregister the callback.
+     */
+    AccessPointChangedCallbackToken
+    RegisterAccessPointChangedCallback(AccessPointChangedCallback accessPointChangedCallback);
+
+    /**
+     * @brief Unregister a callback previously registered with RegisterAccessPointChangedCallback(). Once this function
+     * returns, the callback will not be invoked again.
+     *
+     * @param accessPointChangedCallbackToken The token returned by RegisterAccessPointChangedCallback().
+     */
+    void
+    UnregisterAccessPointChangedCallback(AccessPointChangedCallbackToken accessPointChangedCallbackToken);
+
+    /**
+     * @brief Register a callback to be invoked when a station connects to or disconnects from any access point.
+     *
+     * The callback may be invoked on any thread, and must not register or unregister callbacks. It is invoked while the
+     * access point is reporting the change, so it should return quickly.
+     *
+     * @param stationChangedCallback The callback to invoke.
+     * @return StationChangedCallbackToken A token that can be used to unregister the callback.
+     */
+    StationChangedCallbackToken
+    RegisterStationChangedCallback(StationChangedCallback stationChangedCallback);
+
+    /**
+     * @brief Unregister a callback previously registered with RegisterStationChangedCallback(). Once this function
+     * returns, the callback will not be invoked again.
+     *
+     * @param stationChangedCallbackToken The token returned by RegisterStationChangedCallback().
+     */
+    void
+    UnregisterStationChangedCallback(StationChangedCallbackToken stationChangedCallbackToken);
+
     virtual ~AccessPointManager() = default;
     AccessPointManager(const AccessPointManager&) = delete;
     AccessPointManager(AccessPointManager&&) = delete;
@@ -130,15 +209,79 @@ protected:
     virtual void
     RemoveAccessPoint(std::shared_ptr<IAccessPoint> accessPoint);
 
+private:
+    /**
+     * @brief Invoke all registered access point changed callbacks.
+     *
+     * @param change The kind of change.
+     * @param accessPoint The access point that changed.
+     */
+    void
+    NotifyAccessPointChanged(AccessPointChange change, const std::shared_ptr<IAccessPoint>& accessPoint);
+
+    /**
+     * @brief Invoke all registered station changed callbacks.
+     *
+     * @param change The kind of change.
+     * @param stationMacAddress The mac address of the station.
+     * @param accessPoint The access point the station connected to or disconnected from.
+     */
+    void
+    NotifyStationChanged(AccessPointStationChange change, const Ieee80211MacAddress& stationMacAddress, const std::shared_ptr<IAccessPoint>& accessPoint);
+
+    /**
+     * @brief Install the callbacks of all access points if callbacks are registered to receive the changes they
+     * report, or clear them if not. Access points may hold resources while their callbacks are set, such as a
+     * connection to the daemon that reports the changes, so they are only set while needed.
+     */
+    void
+    UpdateAccessPointCallbacks();
+
+    /**
+     * @brief Install or clear the operational state changed callback of an access point. m_accessPointGate must be
+     * held.
+     *
+     * @param accessPoint The access point to update.
+     * @param isInstalled Whether to install the callback, or clear it.
+     */
+    void
+    SetOperationalStateChangedCallbackLocked(const std::shared_ptr<IAccessPoint>& accessPoint, bool isInstalled);
+
+    /**
+     * @brief Install or clear the station changed callback of an access point. m_accessPointGate must be held.
+     *
+     * @param accessPoint The access point to update.
+     * @param isInstalled Whether to install the callback, or clear it.
+     */
+    void
+    SetStationChangedCallbackLocked(const std::shared_ptr<IAccessPoint>& accessPoint, bool isInstalled);
+
 private:
     std::shared_ptr<IAccessPointFactory> m_accessPointFactory;
 
     mutable std::mutex m_accessPointGate;
     std::vector<std::shared_ptr<IAccessPoint>> m_accessPoints{};
+    bool m_isOperationalStateChangedCallbackInstalled{ false };
+    bool m_isStationChangedCallbackInstalled{ false };
+
+    // Serializes updates of the callbacks installed on access points; see UpdateAccessPointCallbacks().
+    std::mutex m_accessPointCallbacksGate;
 
     mutable std::shared_mutex m_discoveryAgentsGate;
     std::vector<std::shared_ptr<AccessPointDiscoveryAgent>> m_discoveryAgents;
     std::unordered_map<std::string, AccessPointAttributes> m_accessPointAttributes{};
+
+    // Callbacks are invoked with m_accessPointChangedCallbacksGate held shared, so unregistration waits for any
+    // invocation in progress.
+    std::shared_mutex m_accessPointChangedCallbacksGate;
+    std::unordered_map<AccessPointChangedCallbackToken, AccessPointChangedCallback> m_accessPointChangedCallbacks{};
+    AccessPointChangedCallbackToken m_accessPointChangedCallbackTokenNext{ 0 };
+
+    // Callbacks are invoked with m_stationChangedCallbacksGate held shared, so unregistration waits for any invocation
+    // in progress.
+    std::shared_mutex m_stationChangedCallbacksGate;
+    std::unordered_map<StationChangedCallbackToken, StationChangedCallback> m_stationChangedCallbacks{};
+    StationChangedCallbackToken m_stationChangedCallbackTokenNext{ 0 };
 };
 
 } // namespace Microsoft::Net::Wifi
@@ -1,10 +1,12 @@
 
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string_view>
 #include <utility>
 
 #include <microsoft/net/wifi/AccessPoint.hxx>
+#include <microsoft/net/wifi/AccessPointOperationStatus.hxx>
 #include <microsoft/net/wifi/IAccessPoint.hxx>
 #include <microsoft/net/wifi/IAccessPointController.hxx>
 #include <microsoft/net/wifi/Ieee80211.hxx>
@@ -44,6 +46,40 @@ AccessPoint::CreateController()
         : nullptr;
 }
 
+void
+AccessPoint::SetOperationalStateChangedCallback(AccessPointOperationalStateChangedCallback operationalStateChangedCallback)
+{
+    const std::scoped_lock operationalStateChangedCallbackLock{ m_operationalStateChangedCallbackGate };
+    m_operationalStateChangedCallback = std::move(operationalStateChangedCallback);
+}
+
+void
+AccessPoint::OnOperationalStateChanged(AccessPointOperationalState operationalState)
+{
+    // Invoke the callback with the lock held so it cannot be invoked once SetOperationalStateChangedCallback() returns.
+    const std::scoped_lock operationalStateChangedCallbackLock{ m_operationalStateChangedCallbackGate };
+    if (m_operationalStateChangedCallback) {
+        m_operationalStateChangedCallback(operationalState);
+    }
+}
+
+void
+AccessPoint::SetStationChangedCallback(AccessPointStationChangedCallback stationChangedCallback)
+{
+    const std::scoped_lock stationChangedCallbackLock{ m_stationChangedCallbackGate };
+    m_stationChangedCallback = std::move(stationChangedCallback);
+}
+
+void
+AccessPoint::OnStationChanged(AccessPointStationChange change, const Ieee80211MacAddress& stationMacAddress)
+{
+    // Invoke the callback with the lock held so it cannot be invoked once SetStationChangedCallback() returns.
+    const std::scoped_lock stationChangedCallbackLock{ m_stationChangedCallbackGate };
+    if (m_stationChangedCallback) {
+        m_stationChangedCallback(change, stationMacAddress);
+    }
+}
+
 AccessPointFactory::AccessPointFactory(std::shared_ptr<IAccessPointControllerFactory> accessPointControllerFactory) :
     m_accessPointControllerFactory(std::move(accessPointControllerFactory))
 {}
@@ -2,10 +2,12 @@
 #ifndef ACCESS_POINT_HXX
 #define ACCESS_POINT_HXX
 
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
 
+#include <microsoft/net/wifi/AccessPointOperationStatus.hxx>
 #include <microsoft/net/wifi/IAccessPoint.hxx>
 #include <microsoft/net/wifi/IAccessPointController.hxx>
 #include <microsoft/net/wifi/Ieee80211.hxx>
@@ -61,11 +63,51 @@ struct AccessPoint :
     std::unique_ptr<Microsoft::Net::Wifi::IAccessPointController>
     CreateController() override final;
 
+    /**
+     * @brief Set the callback to invoke when the operational state of the access point changes.
+     *
+     * @param operationalStateChangedCallback The callback to invoke, or nullptr to stop invoking a callback.
+     */
+    void
+    SetOperationalStateChangedCallback(AccessPointOperationalStateChangedCallback operationalStateChangedCallback) override;
+
+    /**
+     * @brief Set the callback to invoke when a station connects to or disconnects from the access point.
+     *
+     * @param stationChangedCallback The callback to invoke, or nullptr to stop invoking a callback.
+     */
+    void
+    SetStationChangedCallback(AccessPointStationChangedCallback stationChangedCallback) override;
+
+protected:
+    /**
+     * @brief Invoke the operational state changed callback, if one is set. Derived classes call this when they
+     * observe an operational state change.
+     *
+     * @param operationalState The new operational state.
+     */
+    void
+    OnOperationalStateChanged(AccessPointOperationalState operationalState);
+
+    /**
+     * @brief Invoke the station changed callback, if one is set. Derived classes call this when they observe a station
+     * connect or disconnect.
+     *
+     * @param change The kind of change.
+     * @param stationMacAddress The mac address of the station.
+     */
+    void
+    OnStationChanged(AccessPointStationChange change, const Ieee80211MacAddress& stationMacAddress);
+
 private:
     const std::string m_interfaceName;
     std::shared_ptr<IAccessPointControllerFactory> m_accessPointControllerFactory;
     AccessPointAttributes m_attributes{};
     std::optional<Ieee80211MacAddress> m_macAddress;
+    std::mutex m_operationalStateChangedCallbackGate;
+    AccessPointOperationalStateChangedCallback m_operationalStateChangedCallback{ nullptr };
+    std::mutex m_stationChangedCallbackGate;
+    AccessPointStationChangedCallback m_stationChangedCallback{ nullptr };
 };
 
 /**
@@ -2,16 +2,36 @@
 #ifndef I_ACCESS_POINT_HXX
 #define I_ACCESS_POINT_HXX
 
+#include <functional>
 #include <memory>
 #include <string_view>
 #include <unordered_map>
 
 #include <microsoft/net/wifi/AccessPointAttributes.hxx>
+#include <microsoft/net/wifi/AccessPointOperationStatus.hxx>
 #include <microsoft/net/wifi/IAccessPointController.hxx>
 #include <microsoft/net/wifi/Ieee80211.hxx>
 
 namespace Microsoft::Net::Wifi
 {
+/**
+ * @brief Callback invoked when the operational state of an access point changes.
+ */
+using AccessPointOperationalStateChangedCallback = std::function<void(AccessPointOperationalState)>;
+
+/**
+ * @brief The kinds of changes to the stations associated with an access point.
+ */
+enum class AccessPointStationChange {
+    Connected,
+    Disconnected,
+};
+
+/**
+ * @brief Callback invoked when a station connects to or disconnects from an access point.
+ */
+using AccessPointStationChangedCallback = std::function<void(AccessPointStationChange, const Ieee80211MacAddress&)>;
+
 /**
  * @brief Represents a wireless access point.
  */
@@ -68,6 +88,30 @@ struct IAccessPoint
      */
     virtual std::unique_ptr<IAccessPointController>
     CreateController() = 0;
+
+    /**
+     * @brief Set the callback to invoke when the operational state of the access point changes. This replaces any
+     * previously set callback.
+     *
+     * The callback may be invoked on any thread. Once this function returns, the previous callback will not be invoked
+     * again.
+     *
+     * @param operationalStateChangedCallback The callback to invoke, or nullptr to stop invoking a callback.
+     */
+    virtual void
+    SetOperationalStateChangedCallback(AccessPointOperationalStateChangedCallback operationalStateChangedCallback) = 0;
+
+    /**
+     * @brief Set the callback to invoke when a station connects to or disconnects from the access point. This replaces
+     * any previously set callback.
+     *
+     * The callback may be invoked on any thread. Once this function returns, the previous callback will not be invoked
+     * again.
+     *
+     * @param stationChangedCallback The callback to invoke, or nullptr to stop invoking a callback.
+     */
+    virtual void
+    SetStationChangedCallback(AccessPointStationChangedCallback stationChangedCallback) = 0;
 };
 
 /**
@@ -1,7 +1,10 @@
 
+#include <chrono>
 #include <format>
 #include <memory>
 
+#include <grpc/grpc.h>
+#include <grpcpp/resource_quota.h>
 #include <grpcpp/security/server_credentials.h>
 #include <grpcpp/server_builder.h>
 #include <microsoft/net/remote/service/NetRemoteDiscoveryService.hxx>
@@ -12,11 +15,76 @@
 
 using namespace Microsoft::Net::Remote::Service;
 
+namespace detail
+{
+/**
+ * @brief Apply the thread, HTTP/2, message size, keepalive and memory limits of the configuration to a server builder.
+ * Limits that are 0 are left at their gRPC default.
+ *
+ * @param builder The server builder to configure.
+ * @param configuration The server configuration.
+ */
+void
+ConfigureServerBuilderTuning(grpc::ServerBuilder& builder, const NetRemoteServerConfiguration& configuration)
+{
+    if (configuration.CompletionQueues > 0) {
+        builder.SetSyncServerOption(grpc::ServerBuilder::SyncServerOption::NUM_CQS, static_cast<int>(configuration.CompletionQueues));
+    }
+    if (configuration.SyncServerThreadsMinimum > 0) {
+        builder.SetSyncServerOption(grpc::ServerBuilder::SyncServerOption::MIN_POLLERS, static_cast<int>(configuration.SyncServerThreadsMinimum));
+    }
+    if (configuration.SyncServerThreadsMaximum > 0) {
+        builder.SetSyncServerOption(grpc::ServerBuilder::SyncServerOption::MAX_POLLERS, static_cast<int>(configuration.SyncServerThreadsMaximum));
+    }
+    if (configuration.Http2StreamsMaximum > 0) {
+        builder.AddChannelArgument(GRPC_ARG_MAX_CONCURRENT_STREAMS, static_cast<int>(configuration.Http2StreamsMaximum));
+    }
+    if (configuration.MessageSizeReceiveMaximum > 0) {
+        builder.SetMaxReceiveMessageSize(static_cast<int>(configuration.MessageSizeReceiveMaximum));
+    }
+    if (configuration.MessageSizeSendMaximum > 0) {
+        builder.SetMaxSendMessageSize(static_cast<int>(configuration.MessageSizeSendMaximum));
+    }
+    if (configuration.KeepaliveTime.count() > 0) {
+        builder.AddChannelArgument(GRPC_ARG_KEEPALIVE_TIME_MS, static_cast<int>(configuration.KeepaliveTime.count()));
+    }
+    if (configuration.KeepaliveTimeout.count() > 0) {
+        builder.AddChannelArgument(GRPC_ARG_KEEPALIVE_TIMEOUT_MS, static_cast<int>(configuration.KeepaliveTimeout.count()));
+    }
+    if (configuration.KeepalivePingIntervalMinimum.count() > 0) {
+        builder.AddChannelArgument(GRPC_ARG_HTTP2_MIN_RECV_PING_INTERVAL_WITHOUT_DATA_MS, static_cast<int>(configuration.KeepalivePingIntervalMinimum.count()));
+    }
+    if (configuration.KeepalivePermitWithoutCalls) {
+        builder.AddChannelArgument(GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS, 1);
+        builder.AddChannelArgument(GRPC_ARG_HTTP2_MAX_PINGS_WITHOUT_DATA, 0);
+    }
+
+    // Bound the memory gRPC uses for all RPCs. Unless sized explicitly, this leaves room for control-plane RPCs beyond
+    // what data streams may use.
+    auto resourceQuotaBytes = configuration.ResourceQuotaBytes;
+    if (resourceQuotaBytes == 0 && configuration.DataStreamBytesInFlightMaximum > 0) {
+        resourceQuotaBytes = configuration.DataStreamBytesInFlightMaximum + NetRemoteServerConfiguration::ControlPlaneMemoryReserve;
+    }
+    if (resourceQuotaBytes > 0 || configuration.ResourceQuotaThreadsMaximum > 0) {
+        grpc::ResourceQuota resourceQuota{ "netremote" };
+        if (resourceQuotaBytes > 0) {
+            resourceQuota.Resize(resourceQuotaBytes);
+        }
+        if (configuration.ResourceQuotaThreadsMaximum > 0) {
+            resourceQuota.SetMaxThreads(static_cast<int>(configuration.ResourceQuotaThreadsMaximum));
+        }
+        builder.SetResourceQuota(resourceQuota);
+    }
+}
+} // namespace detail
+
 NetRemoteServer::NetRemoteServer(const NetRemoteServerConfiguration& configuration) :
     m_serverAddress(configuration.ServerAddress),
+    m_configuration(configuration),
     m_networkManager(configuration.NetworkManager),
     m_discoveryServiceFactory(std::move(configuration.DiscoveryServiceFactory)),
-    m_service(configuration.NetworkManager)
+    m_service(configuration.NetworkManager, { .NumberOfThreads = configuration.AccessPointOperationThreads, .QueueDepthMaximum = configuration.AccessPointOperationQueueDepthMaximum }),
+    m_dataStreamingService(configuration.NetworkManager->GetAccessPointManager(), { .NumberOfStreamsMaximum = configuration.DataStreamsMaximum, .NumberOfBytesInFlightMaximum = configuration.DataStreamBytesInFlightMaximum })
 {
     InitializeDiscoveryService();
 }
@@ -77,11 +145,24 @@ NetRemoteServer::Run()
 
     grpc::ServerBuilder builder{};
     builder.AddListeningPort(m_serverAddress, grpc::InsecureServerCredentials());
+    for (const auto& serverAddress : m_configuration.AdditionalServerAddresses) {
+        builder.AddListeningPort(serverAddress, grpc::InsecureServerCredentials());
+    }
+    m_service.ResetAccessPointsWatches();
     builder.RegisterService(&m_service);
     builder.RegisterService(&m_dataStreamingService);
+    detail::ConfigureServerBuilderTuning(builder, m_configuration);
 
     m_server = builder.BuildAndStart();
+    if (m_server == nullptr) {
+        LOGE << "Netremote server failed to start; ensure its addresses are valid and not already in use";
+        return;
+    }
+
     LOGI << std::format("Netremote server started listening on {}", m_serverAddress);
+    for (const auto& serverAddress : m_configuration.AdditionalServerAddresses) {
+        LOGI << std::format("Netremote server started listening on {}", serverAddress);
+    }
 
     if (m_discoveryService != nullptr) {
         LOGI << "Starting discovery service";
@@ -103,6 +184,8 @@ NetRemoteServer::Stop()
         return;
     }
 
+    // Watches never end on their own, so they must be finished for the shutdown to complete.
+    m_service.FinishAccessPointsWatches();
     m_server->Shutdown();
     m_server = nullptr;
 }
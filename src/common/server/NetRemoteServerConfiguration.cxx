@@ -1,4 +1,7 @@
 
+#include <chrono>
+#include <cstdint>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -28,6 +31,11 @@ ConfigureCliAppOptions(CLI::App& app, NetRemoteServerConfiguration& config)
         config.ServerAddress,
         "The address to listen on for incoming connections");
 
+    app.add_option(
+        "-l,--listen",
+        config.AdditionalServerAddresses,
+        "An additional address to listen on, such as a Unix domain socket (unix:/path or unix-abstract:name). Supply multiple times to listen on several addresses");
+
     app.add_flag(
         "--enable-file-logging",
         config.EnableFileLogging,
@@ -44,9 +52,151 @@ ConfigureCliAppOptions(CLI::App& app, NetRemoteServerConfiguration& config)
            "The log verbosity level. Supply multiple times to increase verbosity (0=fatal, 1=errors, 2=warnings, 3=info, 4=debug, 5+=verbose)")
         ->default_val(NetRemoteServerConfiguration::LogVerbosityDefault);
 
+    app.add_option(
+        "--data-streams-max",
+        config.DataStreamsMaximum,
+        "The maximum number of data streams that may run at once (0=unlimited)");
+
+    app.add_option(
+        "--data-stream-bytes-in-flight-max",
+        config.DataStreamBytesInFlightMaximum,
+        "The maximum number of bytes data streams may buffer for writing at once (0=unlimited)");
+
+    app.add_option(
+        "--ap-operation-threads",
+        config.AccessPointOperationThreads,
+        "The number of threads running access point operations");
+
+    app.add_option(
+        "--ap-operation-queue-depth",
+        config.AccessPointOperationQueueDepthMaximum,
+        "The maximum number of access point operations waiting for a thread");
+
+    app.add_option(
+        "--completion-queues",
+        config.CompletionQueues,
+        "The number of completion queues for synchronous RPCs (0=gRPC default)")
+        ->check(CLI::Range(0U, NetRemoteServerConfiguration::GrpcOptionValueMaximum));
+
+    app.add_option(
+        "--sync-threads-min",
+        config.SyncServerThreadsMinimum,
+        "The minimum number of threads per completion queue for synchronous RPCs (0=gRPC default)")
+        ->check(CLI::Range(0U, NetRemoteServerConfiguration::GrpcOptionValueMaximum));
+
+    app.add_option(
+        "--sync-threads-max",
+        config.SyncServerThreadsMaximum,
+        "The maximum number of threads per completion queue for synchronous RPCs (0=gRPC default)")
+        ->check(CLI::Range(0U, NetRemoteServerConfiguration::GrpcOptionValueMaximum));
+
+    app.add_option(
+        "--resource-quota-threads-max",
+        config.ResourceQuotaThreadsMaximum,
+        "The maximum number of threads gRPC may create for synchronous RPCs (0=unlimited)")
+        ->check(CLI::Range(0U, NetRemoteServerConfiguration::GrpcOptionValueMaximum));
+
+    app.add_option(
+        "--resource-quota-bytes",
+        config.ResourceQuotaBytes,
+        "The memory available to gRPC transport buffers (0=derived from the data stream bytes in flight)");
+
+    app.add_option(
+        "--http2-streams-max",
+        config.Http2StreamsMaximum,
+        "The maximum number of concurrent RPCs per client connection (0=gRPC default)")
+        ->check(CLI::Range(0U, NetRemoteServerConfiguration::GrpcOptionValueMaximum));
+
+    app.add_option(
+        "--message-size-receive-max",
+        config.MessageSizeReceiveMaximum,
+        "The maximum size of a message received by the server (0=gRPC default)")
+        ->check(CLI::Range(0U, NetRemoteServerConfiguration::GrpcOptionValueMaximum));
+
+    app.add_option(
+        "--message-size-send-max",
+        config.MessageSizeSendMaximum,
+        "The maximum size of a message sent by the server (0=gRPC default)")
+        ->check(CLI::Range(0U, NetRemoteServerConfiguration::GrpcOptionValueMaximum));
+
+    app.add_option_function<uint64_t>(
+        "--keepalive-time-ms",
+        [&config](const uint64_t& keepaliveTime) {
+            config.KeepaliveTime = std::chrono::milliseconds(keepaliveTime);
+        },
+        "The interval between keepalive pings sent on idle connections, in milliseconds (0=gRPC default)")
+        ->check(CLI::Range(uint64_t{ 0 }, uint64_t{ NetRemoteServerConfiguration::GrpcOptionValueMaximum }));
+
+    app.add_option_function<uint64_t>(
+        "--keepalive-timeout-ms",
+        [&config](const uint64_t& keepaliveTimeout) {
+            config.KeepaliveTimeout = std::chrono::milliseconds(keepaliveTimeout);
+        },
+        "The time to wait for a keepalive ping to be acknowledged, in milliseconds (0=gRPC default)")
+        ->check(CLI::Range(uint64_t{ 0 }, uint64_t{ NetRemoteServerConfiguration::GrpcOptionValueMaximum }));
+
+    app.add_option_function<uint64_t>(
+        "--keepalive-ping-interval-min-ms",
+        [&config](const uint64_t& keepalivePingIntervalMinimum) {
+            config.KeepalivePingIntervalMinimum = std::chrono::milliseconds(keepalivePingIntervalMinimum);
+        },
+        "The minimum interval between keepalive pings accepted from clients, in milliseconds (0=gRPC default)")
+        ->check(CLI::Range(uint64_t{ 0 }, uint64_t{ NetRemoteServerConfiguration::GrpcOptionValueMaximum }));
+
+    app.add_flag(
+        "--keepalive-permit-without-calls",
+        config.KeepalivePermitWithoutCalls,
+        "Send and accept keepalive pings on connections without RPCs in progress");
+
     return app;
 }
 
+/**
+ * @brief Clear a server tuning field if its command-line option was specified, so that the command-line value is kept.
+ *
+ * @tparam ValueT The type of the field.
+ * @param app The CLI app the command line was parsed with.
+ * @param optionName The name of the command-line option corresponding to the field.
+ * @param value The field to clear.
+ */
+template <typename ValueT>
+void
+ClearIfSpecifiedOnCommandLine(const CLI::App& app, const std::string& optionName, std::optional<ValueT>& value)
+{
+    if (app.count(optionName) > 0) {
+        value.reset();
+    }
+}
+
+/**
+ * @brief Clear the server tuning fields whose command-line options were specified, since options specified explicitly
+ * on the command line take precedence over the JSON configuration file.
+ *
+ * @param app The CLI app the command line was parsed with.
+ * @param server The server tuning parsed from the JSON configuration file.
+ */
+void
+ClearServerTuningSpecifiedOnCommandLine(const CLI::App& app, NetRemoteServerJsonConfiguration::ServerTuning& server)
+{
+    ClearIfSpecifiedOnCommandLine(app, "--listen", server.AdditionalServerAddresses);
+    ClearIfSpecifiedOnCommandLine(app, "--data-streams-max", server.DataStreamsMaximum);
+    ClearIfSpecifiedOnCommandLine(app, "--data-stream-bytes-in-flight-max", server.DataStreamBytesInFlightMaximum);
+    ClearIfSpecifiedOnCommandLine(app, "--ap-operation-threads", server.AccessPointOperationThreads);
+    ClearIfSpecifiedOnCommandLine(app, "--ap-operation-queue-depth", server.AccessPointOperationQueueDepthMaximum);
+    ClearIfSpecifiedOnCommandLine(app, "--completion-queues", server.CompletionQueues);
+    ClearIfSpecifiedOnCommandLine(app, "--sync-threads-min", server.SyncServerThreadsMinimum);
+    ClearIfSpecifiedOnCommandLine(app, "--sync-threads-max", server.SyncServerThreadsMaximum);
+    ClearIfSpecifiedOnCommandLine(app, "--resource-quota-threads-max", server.ResourceQuotaThreadsMaximum);
+    ClearIfSpecifiedOnCommandLine(app, "--resource-quota-bytes", server.ResourceQuotaBytes);
+    ClearIfSpecifiedOnCommandLine(app, "--http2-streams-max", server.Http2StreamsMaximum);
+    ClearIfSpecifiedOnCommandLine(app, "--message-size-receive-max", server.MessageSizeReceiveMaximum);
+    ClearIfSpecifiedOnCommandLine(app, "--message-size-send-max", server.MessageSizeSendMaximum);
+    ClearIfSpecifiedOnCommandLine(app, "--keepalive-time-ms", server.KeepaliveTime);
+    ClearIfSpecifiedOnCommandLine(app, "--keepalive-timeout-ms", server.KeepaliveTimeout);
+    ClearIfSpecifiedOnCommandLine(app, "--keepalive-ping-interval-min-ms", server.KeepalivePingIntervalMinimum);
+    ClearIfSpecifiedOnCommandLine(app, "--keepalive-permit-without-calls", server.KeepalivePermitWithoutCalls);
+}
+
 template <typename... Args>
 NetRemoteServerConfiguration
 ParseCliAppOptions(bool throwOnParseError, Args&&... args)
@@ -71,8 +221,8 @@ ParseCliAppOptions(bool throwOnParseError, Args&&... args)
             return {};
         }
 
-        const auto configurationJson = NetRemoteServerJsonConfiguration::TryParseFromJson(configurationJsonObject.value());
-        if (!configurationJsonObject.has_value()) {
+        auto configurationJson = NetRemoteServerJsonConfiguration::TryParseFromJson(configurationJsonObject.value());
+        if (!configurationJson.has_value()) {
             LOGF << "Failed to parse JSON configuration";
             return {};
         }
@@ -81,6 +231,10 @@ ParseCliAppOptions(bool throwOnParseError, Args&&... args)
         if (configurationJson->AccessPointAttributes.has_value()) {
             configuration.AccessPointAttributes = std::move(configurationJson->AccessPointAttributes.value());
         }
+        if (configurationJson->Server.has_value()) {
+            ClearServerTuningSpecifiedOnCommandLine(app, configurationJson->Server.value());
+            configurationJson->Server->ApplyTo(configuration);
+        }
     }
 
     return configuration;
@@ -1,8 +1,14 @@
 
+#include <chrono>
+#include <cstdint>
 #include <filesystem>
 #include <format>
 #include <fstream>
+#include <limits>
 #include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 #include <microsoft/net/remote/service/NetRemoteServerJsonConfiguration.hxx>
 #include <microsoft/net/wifi/AccessPointAttributesJsonSerialization.hxx>
@@ -11,6 +17,111 @@
 
 using namespace Microsoft::Net::Remote::Service;
 
+namespace detail
+{
+/**
+ * @brief Parse an optional field of a JSON object, leaving the value empty if the field is not present.
+ *
+ * @tparam ValueT The type of the field.
+ * @param json The JSON object containing the field.
+ * @param key The name of the field.
+ * @param value Output variable to receive the value of the field.
+ * @throws nlohmann::json::exception If the field is present but has the wrong type.
+ */
+template <typename ValueT>
+void
+ParseOptionalJsonField(const nlohmann::json& json, const char* key, std::optional<ValueT>& value)
+{
+    if (json.contains(key)) {
+        value = json.at(key).get<ValueT>();
+    }
+}
+
+/**
+ * @brief Parse an optional unsigned integer field of a JSON object, leaving the value empty if the field is not present.
+ * Unlike ParseOptionalJsonField, values that are negative or too large are rejected rather than converted.
+ *
+ * @tparam ValueT The unsigned integer type of the field.
+ * @param json The JSON object containing the field.
+ * @param key The name of the field.
+ * @param value Output variable to receive the value of the field.
+ * @param valueMaximum The maximum value of the field.
+ * @throws std::out_of_range If the field is present but is not an integer from 0 to valueMaximum.
+ */
+template <typename ValueT>
+void
+ParseOptionalJsonIntegerField(const nlohmann::json& json, const char* key, std::optional<ValueT>& value, uint64_t valueMaximum = std::numeric_limits<ValueT>::max())
+{
+    if (!json.contains(key)) {
+        return;
+    }
+
+    const auto& valueJson = json.at(key);
+    if (!valueJson.is_number_integer() || (!valueJson.is_number_unsigned() && valueJson.get<int64_t>() < 0) || valueJson.get<uint64_t>() > valueMaximum) {
+        throw std::out_of_range(std::format("'{}' must be an integer from 0 to {}", key, valueMaximum));
+    }
+
+    value = static_cast<ValueT>(valueJson.get<uint64_t>());
+}
+
+/**
+ * @brief Parse an optional duration field of a JSON object, specified in milliseconds.
+ *
+ * @param json The JSON object containing the field.
+ * @param key The name of the field.
+ * @param value Output variable to receive the value of the field.
+ * @param valueMaximum The maximum value of the field, in milliseconds.
+ * @throws std::out_of_range If the field is present but is not an integer from 0 to valueMaximum.
+ */
+void
+ParseOptionalJsonDurationField(const nlohmann::json& json, const char* key, std::optional<std::chrono::milliseconds>& value, uint64_t valueMaximum)
+{
+    std::optional<uint64_t> milliseconds{};
+    ParseOptionalJsonIntegerField(json, key, milliseconds, valueMaximum);
+    if (milliseconds.has_value()) {
+        value = std::chrono::milliseconds(milliseconds.value());
+    }
+}
+
+/**
+ * @brief Override a configuration field with an optional value, if the value is present.
+ *
+ * @tparam ValueT The type of the field.
+ * @param field The field to override.
+ * @param value The optional value.
+ */
+template <typename ValueT>
+void
+ApplyOptionalField(ValueT& field, const std::optional<ValueT>& value)
+{
+    if (value.has_value()) {
+        field = value.value();
+    }
+}
+} // namespace detail
+
+void
+NetRemoteServerJsonConfiguration::ServerTuning::ApplyTo(NetRemoteServerConfiguration& configuration) const
+{
+    detail::ApplyOptionalField(configuration.AdditionalServerAddresses, AdditionalServerAddresses);
+    detail::ApplyOptionalField(configuration.DataStreamsMaximum, DataStreamsMaximum);
+    detail::ApplyOptionalField(configuration.DataStreamBytesInFlightMaximum, DataStreamBytesInFlightMaximum);
+    detail::ApplyOptionalField(configuration.AccessPointOperationThreads, AccessPointOperationThreads);
+    detail::ApplyOptionalField(configuration.AccessPointOperationQueueDepthMaximum, AccessPointOperationQueueDepthMaximum);
+    detail::ApplyOptionalField(configuration.CompletionQueues, CompletionQueues);
+    detail::ApplyOptionalField(configuration.SyncServerThreadsMinimum, SyncServerThreadsMinimum);
+    detail::ApplyOptionalField(configuration.SyncServerThreadsMaximum, SyncServerThreadsMaximum);
+    detail::ApplyOptionalField(configuration.ResourceQuotaThreadsMaximum, ResourceQuotaThreadsMaximum);
+    detail::ApplyOptionalField(configuration.ResourceQuotaBytes, ResourceQuotaBytes);
+    detail::ApplyOptionalField(configuration.Http2StreamsMaximum, Http2StreamsMaximum);
+    detail::ApplyOptionalField(configuration.MessageSizeReceiveMaximum, MessageSizeReceiveMaximum);
+    detail::ApplyOptionalField(configuration.MessageSizeSendMaximum, MessageSizeSendMaximum);
+    detail::ApplyOptionalField(configuration.KeepaliveTime, KeepaliveTime);
+    detail::ApplyOptionalField(configuration.KeepaliveTimeout, KeepaliveTimeout);
+    detail::ApplyOptionalField(configuration.KeepalivePingIntervalMinimum, KeepalivePingIntervalMinimum);
+    detail::ApplyOptionalField(configuration.KeepalivePermitWithoutCalls, KeepalivePermitWithoutCalls);
+}
+
 /* static */
 std::optional<nlohmann::json>
 NetRemoteServerJsonConfiguration::ParseFromFile(const std::filesystem::path& configurationFilePath) noexcept
@@ -56,5 +167,43 @@ NetRemoteServerJsonConfiguration::TryParseFromJson(const nlohmann::json& configu
         }
     }
 
+    // Parse server tuning, if specified.
+    if (configurationJson.contains(ServerKey)) {
+        try {
+            const auto& serverJson = configurationJson.at(ServerKey);
+            if (!serverJson.is_object()) {
+                LOGE << std::format("JSON configuration '{}' is not an object", ServerKey);
+                return std::nullopt;
+            }
+
+            ServerTuning server{};
+            constexpr uint64_t GrpcOptionValueMaximum{ NetRemoteServerConfiguration::GrpcOptionValueMaximum };
+            detail::ParseOptionalJsonField(serverJson, "AdditionalServerAddresses", server.AdditionalServerAddresses);
+            detail::ParseOptionalJsonIntegerField(serverJson, "DataStreamsMaximum", server.DataStreamsMaximum);
+            detail::ParseOptionalJsonIntegerField(serverJson, "DataStreamBytesInFlightMaximum", server.DataStreamBytesInFlightMaximum);
+            detail::ParseOptionalJsonIntegerField(serverJson, "AccessPointOperationThreads", server.AccessPointOperationThreads);
+            detail::ParseOptionalJsonIntegerField(serverJson, "AccessPointOperationQueueDepthMaximum", server.AccessPointOperationQueueDepthMaximum);
+            detail::ParseOptionalJsonIntegerField(serverJson, "CompletionQueues", server.CompletionQueues, GrpcOptionValueMaximum);
+            detail::ParseOptionalJsonIntegerField(serverJson, "SyncServerThreadsMinimum", server.SyncServerThreadsMinimum, GrpcOptionValueMaximum);
+            detail::ParseOptionalJsonIntegerField(serverJson, "SyncServerThreadsMaximum", server.SyncServerThreadsMaximum, GrpcOptionValueMaximum);
+            detail::ParseOptionalJsonIntegerField(serverJson, "ResourceQuotaThreadsMaximum", server.ResourceQuotaThreadsMaximum, GrpcOptionValueMaximum);
+            detail::ParseOptionalJsonIntegerField(serverJson, "ResourceQuotaBytes", server.ResourceQuotaBytes);
+            detail::ParseOptionalJsonIntegerField(serverJson, "Http2StreamsMaximum", server.Http2StreamsMaximum, GrpcOptionValueMaximum);
+            detail::ParseOptionalJsonIntegerField(serverJson, "MessageSizeReceiveMaximum", server.MessageSizeReceiveMaximum, GrpcOptionValueMaximum);
+            detail::ParseOptionalJsonIntegerField(serverJson, "MessageSizeSendMaximum", server.MessageSizeSendMaximum, GrpcOptionValueMaximum);
+            detail::ParseOptionalJsonDurationField(serverJson, "KeepaliveTimeMs", server.KeepaliveTime, GrpcOptionValueMaximum);
+            detail::ParseOptionalJsonDurationField(serverJson, "KeepaliveTimeoutMs", server.KeepaliveTimeout, GrpcOptionValueMaximum);
+            detail::ParseOptionalJsonDurationField(serverJson, "KeepalivePingIntervalMinimumMs", server.KeepalivePingIntervalMinimum, GrpcOptionValueMaximum);
+            detail::ParseOptionalJsonField(serverJson, "KeepalivePermitWithoutCalls", server.KeepalivePermitWithoutCalls);
+            configuration.Server = std::move(server);
+        } catch (const nlohmann::json::exception& jsonException) {
+            LOGE << std::format("Failed to parse JSON configuration for '{}' field: {}", ServerKey, jsonException.what());
+            return std::nullopt;
+        } catch (const std::out_of_range& outOfRange) {
+            LOGE << std::format("Invalid JSON configuration for '{}' field: {}", ServerKey, outOfRange.what());
+            return std::nullopt;
+        }
+    }
+
     return configuration;
 }
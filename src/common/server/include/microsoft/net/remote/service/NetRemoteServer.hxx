@@ -87,6 +87,7 @@ protected:
 
 private:
     std::string m_serverAddress;
+    NetRemoteServerConfiguration m_configuration;
     std::shared_ptr<Microsoft::Net::NetworkManager> m_networkManager;
     std::shared_ptr<INetRemoteDiscoveryServiceFactory> m_discoveryServiceFactory;
     std::shared_ptr<NetRemoteDiscoveryService> m_discoveryService;
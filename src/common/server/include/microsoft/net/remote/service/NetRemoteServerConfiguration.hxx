@@ -2,8 +2,11 @@
 #ifndef NET_REMOTE_SERVER_CONFIGURATION_HXX
 #define NET_REMOTE_SERVER_CONFIGURATION_HXX
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
+#include <limits>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -11,6 +14,7 @@
 
 #include <microsoft/net/NetworkManager.hxx>
 #include <microsoft/net/remote/protocol/NetRemoteProtocol.hxx>
+#include <microsoft/net/remote/service/BoundedExecutor.hxx>
 #include <microsoft/net/remote/service/NetRemoteDiscoveryService.hxx>
 #include <microsoft/net/wifi/AccessPointAttributes.hxx>
 
@@ -26,6 +30,28 @@ struct NetRemoteServerConfiguration
      */
     static constexpr auto LogVerbosityDefault = 3;
 
+    /**
+     * @brief Default maximum number of data streams that may run at once.
+     */
+    static constexpr uint32_t DataStreamsMaximumDefault{ 64 };
+
+    /**
+     * @brief Default maximum number of bytes data streams may have in flight at once.
+     */
+    static constexpr std::size_t DataStreamBytesInFlightMaximumDefault{ 64 * 1024 * 1024 };
+
+    /**
+     * @brief Memory of the gRPC resource quota that is reserved for control-plane RPCs, in addition to the bytes in
+     * flight of data streams, so that data streams cannot starve them.
+     */
+    static constexpr std::size_t ControlPlaneMemoryReserve{ 16 * 1024 * 1024 };
+
+    /**
+     * @brief Maximum value of the options that are passed to gRPC as an int, such as thread counts, message sizes and
+     * keepalive durations in milliseconds. Larger values are rejected when parsed.
+     */
+    static constexpr uint32_t GrpcOptionValueMaximum{ std::numeric_limits<int>::max() };
+
     /**
      * @brief Create a NetRemoteServerConfiguration object from command-line
      * arguments.
@@ -54,6 +80,13 @@ struct NetRemoteServerConfiguration
      */
     std::string ServerAddress{ Microsoft::Net::Remote::Protocol::NetRemoteProtocol::AddressDefault };
 
+    /**
+     * @brief Additional addresses for the server to listen on, in any form gRPC accepts. This includes Unix domain
+     * sockets ("unix:/path/to/socket" or "unix-abstract:name"), which let clients on the same host bypass the TCP/IP
+     * stack. Only ServerAddress is advertised by the discovery service.
+     */
+    std::vector<std::string> AdditionalServerAddresses{};
+
     /**
      * @brief Run the service in the background.
      */
@@ -96,6 +129,96 @@ struct NetRemoteServerConfiguration
      */
     std::filesystem::path JsonConfigurationFilePath{};
 
+    /**
+     * @brief Maximum number of upload, download and bidirectional data streams that may run at once, or 0 for no limit.
+     * Streams beyond it fail with grpc::StatusCode::RESOURCE_EXHAUSTED.
+     */
+    uint32_t DataStreamsMaximum{ DataStreamsMaximumDefault };
+
+    /**
+     * @brief Maximum number of bytes data streams may buffer for writing at once, or 0 for no limit. Streams that would
+     * exceed it fail with grpc::StatusCode::RESOURCE_EXHAUSTED. The gRPC resource quota of the server, which bounds the
+     * memory of its transport buffers, is sized to this plus ControlPlaneMemoryReserve.
+     */
+    std::size_t DataStreamBytesInFlightMaximum{ DataStreamBytesInFlightMaximumDefault };
+
+    /**
+     * @brief Number of threads running access point operations, which may block waiting for the access point.
+     */
+    std::size_t AccessPointOperationThreads{ BoundedExecutorConfiguration::NumberOfThreadsDefault };
+
+    /**
+     * @brief Maximum number of access point operations waiting for a thread. Operations beyond it fail with
+     * grpc::StatusCode::RESOURCE_EXHAUSTED.
+     */
+    std::size_t AccessPointOperationQueueDepthMaximum{ BoundedExecutorConfiguration::QueueDepthMaximumDefault };
+
+    /**
+     * @brief Number of completion queues polled for synchronous RPCs, or 0 for the gRPC default. This, and the number of
+     * synchronous RPC threads, only apply to services using the synchronous API; services using the callback API run
+     * on threads managed by gRPC.
+     */
+    uint32_t CompletionQueues{ 0 };
+
+    /**
+     * @brief Minimum number of threads polling each completion queue for synchronous RPCs, or 0 for the gRPC default.
+     */
+    uint32_t SyncServerThreadsMinimum{ 0 };
+
+    /**
+     * @brief Maximum number of threads polling each completion queue for synchronous RPCs, or 0 for the gRPC default.
+     */
+    uint32_t SyncServerThreadsMaximum{ 0 };
+
+    /**
+     * @brief Maximum number of threads gRPC may create for synchronous RPCs across the server, or 0 for no limit.
+     */
+    uint32_t ResourceQuotaThreadsMaximum{ 0 };
+
+    /**
+     * @brief Memory of the gRPC resource quota of the server, which bounds the memory of its transport buffers. If 0,
+     * it is DataStreamBytesInFlightMaximum plus ControlPlaneMemoryReserve, or unlimited when data streams are unlimited.
+     */
+    std::size_t ResourceQuotaBytes{ 0 };
+
+    /**
+     * @brief Maximum number of concurrent HTTP/2 streams (RPCs) per client connection, or 0 for the gRPC default.
+     */
+    uint32_t Http2StreamsMaximum{ 0 };
+
+    /**
+     * @brief Maximum size of a message the server receives, or 0 for the gRPC default (4 MiB).
+     */
+    uint32_t MessageSizeReceiveMaximum{ 0 };
+
+    /**
+     * @brief Maximum size of a message the server sends, or 0 for the gRPC default (unlimited).
+     */
+    uint32_t MessageSizeSendMaximum{ 0 };
+
+    /**
+     * @brief Interval between keepalive pings the server sends on idle connections, or 0 for the gRPC default (2
+     * hours).
+     */
+    std::chrono::milliseconds KeepaliveTime{ 0 };
+
+    /**
+     * @brief Time the server waits for a keepalive ping to be acknowledged before closing the connection, or 0 for the
+     * gRPC default (20 seconds).
+     */
+    std::chrono::milliseconds KeepaliveTimeout{ 0 };
+
+    /**
+     * @brief Minimum interval between keepalive pings the server accepts from clients, or 0 for the gRPC default (5
+     * minutes). Clients pinging more often are disconnected.
+     */
+    std::chrono::milliseconds KeepalivePingIntervalMinimum{ 0 };
+
+    /**
+     * @brief Whether keepalive pings are sent and accepted on connections without RPCs in progress.
+     */
+    bool KeepalivePermitWithoutCalls{ false };
+
     /**
      * @brief Access point attributes.
      */
@@ -2,11 +2,16 @@
 #ifndef NET_REMOTE_SERVER_JSON_CONFIGURATION_HXX
 #define NET_REMOTE_SERVER_JSON_CONFIGURATION_HXX
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <optional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
+#include <microsoft/net/remote/service/NetRemoteServerConfiguration.hxx>
 #include <microsoft/net/wifi/AccessPointAttributes.hxx>
 #include <nlohmann/json.hpp>
 
@@ -17,7 +22,46 @@ namespace Microsoft::Net::Remote::Service
  */
 struct NetRemoteServerJsonConfiguration
 {
+    /**
+     * @brief Additional listen addresses, and thread, HTTP/2, message size, keepalive and memory limits of the server.
+     * Each field corresponds to the NetRemoteServerConfiguration field of the same name, and overrides it when
+     * specified, unless its command-line option is also specified. Durations are specified in milliseconds. Fields that
+     * are passed to gRPC as an int must be at most NetRemoteServerConfiguration::GrpcOptionValueMaximum.
+     */
+    struct ServerTuning
+    {
+        std::optional<std::vector<std::string>> AdditionalServerAddresses{};
+        std::optional<uint32_t> DataStreamsMaximum{};
+        std::optional<std::size_t> DataStreamBytesInFlightMaximum{};
+        std::optional<std::size_t> AccessPointOperationThreads{};
+        std::optional<std::size_t> AccessPointOperationQueueDepthMaximum{};
+        std::optional<uint32_t> CompletionQueues{};
+        std::optional<uint32_t> SyncServerThreadsMinimum{};
+        std::optional<uint32_t> SyncServerThreadsMaximum{};
+        std::optional<uint32_t> ResourceQuotaThreadsMaximum{};
+        std::optional<std::size_t> ResourceQuotaBytes{};
+        std::optional<uint32_t> Http2StreamsMaximum{};
+        std::optional<uint32_t> MessageSizeReceiveMaximum{};
+        std::optional<uint32_t> MessageSizeSendMaximum{};
+        std::optional<std::chrono::milliseconds> KeepaliveTime{};
+        std::optional<std::chrono::milliseconds> KeepaliveTimeout{};
+        std::optional<std::chrono::milliseconds> KeepalivePingIntervalMinimum{};
+        std::optional<bool> KeepalivePermitWithoutCalls{};
+
+        bool
+        operator==(const ServerTuning&) const = default;
+
+        /**
+         * @brief Override the fields of a server configuration with those specified.
+         *
+         * @param configuration The server configuration to update.
+         */
+        void
+        ApplyTo(NetRemoteServerConfiguration& configuration) const;
+    };
+
     std::optional<std::unordered_map<std::string, Microsoft::Net::Wifi::AccessPointAttributes>> AccessPointAttributes{};
+    std::optional<ServerTuning> Server{};
 
     bool
     operator==(const NetRemoteServerJsonConfiguration&) const = default;
@@ -47,6 +91,7 @@ struct NetRemoteServerJsonConfiguration
 
 protected:
     static constexpr auto AccessPointAttributesKey = "WifiAccessPointAttributes";
+    static constexpr auto ServerKey = "Server";
 };
 } // namespace Microsoft::Net::Remote::Service
 
@@ -0,0 +1,85 @@
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <utility>
+
+#include <microsoft/net/remote/service/BoundedExecutor.hxx>
+
+using namespace Microsoft::Net::Remote::Service;
+
+BoundedExecutor::BoundedExecutor(BoundedExecutorConfiguration configuration) :
+    m_queueDepthMaximum(configuration.QueueDepthMaximum)
+{
+    const auto numberOfThreads = std::max<std::size_t>(configuration.NumberOfThreads, 1);
+    m_threads.reserve(numberOfThreads);
+    for (std::size_t i = 0; i < numberOfThreads; i++) {
+        m_threads.emplace_back([this](std::stop_token stopToken) {
+            RunTasks(std::move(stopToken));
+        });
+    }
+}
+
+BoundedExecutor::~BoundedExecutor()
+{
+    // Destroying the threads requests them to stop, and waits for them to drain the queue and exit.
+    m_threads.clear();
+}
+
+bool
+BoundedExecutor::TrySubmit(std::function<void()> task)
+{
+    {
+        const std::lock_guard lock(m_tasksGate);
+        if (std::size(m_tasks) >= m_queueDepthMaximum) {
+            m_numberOfTasksRejected++;
+            return false;
+        }
+
+        m_tasks.push_back(std::move(task));
+    }
+
+    m_tasksAvailable.notify_one();
+    return true;
+}
+
+std::size_t
+BoundedExecutor::GetQueueDepth() const
+{
+    const std::lock_guard lock(m_tasksGate);
+    return std::size(m_tasks);
+}
+
+uint64_t
+BoundedExecutor::GetNumberOfTasksRejected() const
+{
+    const std::lock_guard lock(m_tasksGate);
+    return m_numberOfTasksRejected;
+}
+
+void
+BoundedExecutor::RunTasks(std::stop_token stopToken)
+{
+    for (;;) {
+        std::function<void()> task{};
+        {
+            std::unique_lock lock(m_tasksGate);
+            m_tasksAvailable.wait(lock, stopToken, [this] {
+                return !std::empty(m_tasks);
+            });
+
+            // Queued tasks are run even once a stop is requested, so the thread only exits once the queue is empty.
+            if (std::empty(m_tasks)) {
+                return;
+            }
+
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+
+        task();
+    }
+}
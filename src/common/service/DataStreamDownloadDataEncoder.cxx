@@ -0,0 +1,80 @@
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <vector>
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
+#include <grpc/slice.h>
+#include <grpcpp/support/byte_buffer.h>
+#include <grpcpp/support/slice.h>
+#include <microsoft/net/remote/protocol/NetRemoteDataStream.pb.h>
+#include <microsoft/net/remote/service/DataStreamDownloadDataEncoder.hxx>
+
+using namespace Microsoft::Net::Remote::Service;
+
+using google::protobuf::io::CodedOutputStream;
+using google::protobuf::internal::WireFormatLite;
+using Microsoft::Net::Remote::DataStream::DataStreamDownloadData;
+
+namespace detail
+{
+/**
+ * @brief Encode the fields of the specified header, followed by the key and length of a data field of the specified
+ * size, whose value must immediately follow.
+ *
+ * @param header The message fields other than the data.
+ * @param dataSize The size of the data field value.
+ * @return grpc::Slice
+ */
+grpc::Slice
+EncodeDataStreamDownloadDataHeader(const DataStreamDownloadData& header, std::size_t dataSize)
+{
+    // Empty fields are not serialized by protobuf, so the data field is omitted entirely in that case.
+    const std::size_t headerMessageSize = header.ByteSizeLong();
+    const std::size_t dataFieldPrefixSize = (dataSize > 0) ? WireFormatLite::TagSize(DataStreamDownloadData::kDataFieldNumber, WireFormatLite::TYPE_BYTES) + CodedOutputStream::VarintSize64(dataSize) : 0;
+
+    grpc_slice headerSlice = grpc_slice_malloc(headerMessageSize + dataFieldPrefixSize);
+    uint8_t* target = GRPC_SLICE_START_PTR(headerSlice);
+    target = header.SerializeWithCachedSizesToArray(target);
+    if (dataSize > 0) {
+        target = WireFormatLite::WriteTagToArray(DataStreamDownloadData::kDataFieldNumber, WireFormatLite::WIRETYPE_LENGTH_DELIMITED, target);
+        CodedOutputStream::WriteVarint64ToArray(dataSize, target);
+    }
+
+    return grpc::Slice(headerSlice, grpc::Slice::STEAL_REF);
+}
+} // namespace detail
+
+/* static */
+grpc::ByteBuffer
+DataStreamDownloadDataEncoder::Encode(const DataStreamDownloadData& header, const grpc::Slice& data)
+{
+    const std::size_t dataSize = data.size();
+    const std::array<grpc::Slice, 2> slices{ detail::EncodeDataStreamDownloadDataHeader(header, dataSize), data };
+    return grpc::ByteBuffer(std::data(slices), (dataSize > 0) ? 2 : 1);
+}
+
+/* static */
+grpc::ByteBuffer
+DataStreamDownloadDataEncoder::Encode(const DataStreamDownloadData& header, std::span<const grpc::Slice> data)
+{
+    const std::size_t dataSize = std::accumulate(std::cbegin(data), std::cend(data), std::size_t{ 0 }, [](std::size_t size, const grpc::Slice& slice) {
+        return size + slice.size();
+    });
+
+    // The data slices follow the header, together forming the value of the data field.
+    std::vector<grpc::Slice> slices{};
+    slices.reserve(1 + std::size(data));
+    slices.push_back(detail::EncodeDataStreamDownloadDataHeader(header, dataSize));
+    for (const auto& slice : data) {
+        if (slice.size() > 0) {
+            slices.push_back(slice);
+        }
+    }
+
+    return grpc::ByteBuffer(std::data(slices), std::size(slices));
+}
@@ -1,17 +1,41 @@
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <format>
-#include <limits>
-#include <random>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stop_token>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
+#include <google/protobuf/timestamp.pb.h>
+#include <google/protobuf/util/time_util.h>
+#include <grpc/slice.h>
+#include <grpcpp/impl/codegen/proto_utils.h>
 #include <grpcpp/impl/codegen/status.h>
+#include <grpcpp/support/byte_buffer.h>
+#include <grpcpp/support/slice.h>
 #include <logging/FunctionTracer.hxx>
 #include <magic_enum.hpp>
+#include <microsoft/net/remote/DataStreamLatencyUnderLoad.hxx>
+#include <microsoft/net/remote/datastream/DataPatternGenerator.hxx>
+#include <microsoft/net/remote/datastream/Histogram.hxx>
+#include <microsoft/net/remote/datastream/Session.hxx>
+#include <microsoft/net/remote/datastream/SessionManager.hxx>
+#include <microsoft/net/remote/datastream/StreamAdmission.hxx>
 #include <microsoft/net/remote/protocol/NetRemoteDataStream.pb.h>
+#include <microsoft/net/remote/service/DataStreamDownloadDataEncoder.hxx>
+#include <microsoft/net/remote/service/NetRemoteDataStreamingService.hxx>
 #include <plog/Log.h>
 
 #include "NetRemoteDataStreamingReactors.hxx"
@@ -28,39 +52,465 @@ struct FunctionTracerVerbose :
         FunctionTracer(plog::Severity::verbose, {}, {}, false, location) {}
 };
 
+namespace detail
+{
+using Microsoft::Net::Remote::DataStream::DataPattern;
+using Microsoft::Net::Remote::DataStream::DataStreamPattern;
+using Microsoft::Net::Remote::DataStream::DataStreamProperties;
+using Microsoft::Net::Remote::DataStream::SessionManager;
+using Microsoft::Net::Remote::DataStream::SessionStream;
+using Microsoft::Net::Remote::DataStream::SessionStreamDirection;
+
+/**
+ * @brief Create the status that data streams fail with when their messages would exceed the bytes in flight budget.
+ *
+ * @return grpc::Status
+ */
+grpc::Status
+CreateMemoryBudgetExhaustedStatus()
+{
+    return { grpc::StatusCode::RESOURCE_EXHAUSTED, "Data stream memory budget exhausted" };
+}
+
+/**
+ * @brief Determine the data block size requested by the specified data stream properties.
+ *
+ * @param dataStreamProperties The data stream properties to examine.
+ * @return std::optional<std::size_t> The requested data block size, or the default size if none was requested.
+ * std::nullopt is returned if the requested size is not supported.
+ */
+std::optional<std::size_t>
+GetDataBlockSize(const DataStreamProperties& dataStreamProperties) noexcept
+{
+    using Microsoft::Net::Remote::Service::Reactors::Helpers::DataBlockPool;
+
+    const std::size_t dataBlockSize = dataStreamProperties.datablocksize();
+    if (dataBlockSize == 0) {
+        return DataBlockPool::DataBlockSizeDefault;
+    }
+    if (dataBlockSize > DataBlockPool::DataBlockSizeMaximum) {
+        return std::nullopt;
+    }
+
+    return dataBlockSize;
+}
+
+/**
+ * @brief Determine the number of data blocks to pack into each message requested by the specified data stream
+ * properties.
+ *
+ * @param dataStreamProperties The data stream properties to examine.
+ * @param dataBlockSize The size of each data block, in bytes.
+ * @return std::optional<uint32_t> The requested number of data blocks per message, or 1 if none was requested.
+ * std::nullopt is returned if the requested number is not supported, or the resulting messages would be too large.
+ */
+std::optional<uint32_t>
+GetDataBlocksPerMessage(const DataStreamProperties& dataStreamProperties, std::size_t dataBlockSize) noexcept
+{
+    using Microsoft::Net::Remote::Service::Reactors::Helpers::DataBlockPool;
+    using Microsoft::Net::Remote::Service::Reactors::Helpers::DataBlockSource;
+
+    const uint32_t dataBlocksPerMessage = std::max<uint32_t>(dataStreamProperties.datablockspermessage(), 1);
+    if (dataBlocksPerMessage > DataBlockSource::DataBlocksPerMessageMaximum || dataBlocksPerMessage * dataBlockSize > DataBlockPool::DataBlockSizeMaximum) {
+        return std::nullopt;
+    }
+
+    return dataBlocksPerMessage;
+}
+
+/**
+ * @brief Convert a data stream pattern to the corresponding verifiable data pattern.
+ *
+ * @param pattern The data stream pattern to convert.
+ * @return std::optional<DataPattern> The verifiable data pattern, or std::nullopt if the pattern is not verifiable.
+ */
+std::optional<DataPattern>
+ToDataPattern(DataStreamPattern pattern) noexcept
+{
+    switch (pattern) {
+    case DataStreamPattern::DataStreamPatternPseudoRandom:
+        return DataPattern::PseudoRandom;
+    case DataStreamPattern::DataStreamPatternCounter:
+        return DataPattern::Counter;
+    case DataStreamPattern::DataStreamPatternZeros:
+        return DataPattern::Zeros;
+    case DataStreamPattern::DataStreamPatternOnes:
+        return DataPattern::Ones;
+    default:
+        return std::nullopt;
+    }
+}
+
+/**
+ * @brief Convert a wall-clock time to a protobuf timestamp.
+ *
+ * @param time The time to convert.
+ * @return google::protobuf::Timestamp
+ */
+google::protobuf::Timestamp
+ToTimestamp(std::chrono::system_clock::time_point time) noexcept
+{
+    const auto timeSinceEpoch = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch());
+    const auto seconds = std::chrono::floor<std::chrono::seconds>(timeSinceEpoch);
+
+    google::protobuf::Timestamp timestamp{};
+    timestamp.set_seconds(seconds.count());
+    timestamp.set_nanos(static_cast<int32_t>((timeSinceEpoch - seconds).count()));
+
+    return timestamp;
+}
+
+/**
+ * @brief Determine the duration of a data stream, if it is bounded by one.
+ *
+ * @param dataStreamProperties The data stream properties to examine.
+ * @return std::optional<std::chrono::steady_clock::duration>
+ */
+std::optional<std::chrono::steady_clock::duration>
+GetDataStreamDuration(const DataStreamProperties& dataStreamProperties) noexcept
+{
+    if (dataStreamProperties.type() != Microsoft::Net::Remote::DataStream::DataStreamType::DataStreamTypeTimed || dataStreamProperties.Properties_case() != DataStreamProperties::kTimed) {
+        return std::nullopt;
+    }
+
+    const auto& duration = dataStreamProperties.timed().duration();
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::seconds(duration.seconds()) + std::chrono::nanoseconds(duration.nanos()));
+}
+
+/**
+ * @brief Allocate a slice of the specified size and fill its content using the specified function.
+ *
+ * @tparam FillFunction The type of the function filling the slice, invocable with a std::span<uint8_t>.
+ * @param size The size of the slice, in bytes.
+ * @param fill The function to fill the content of the slice with.
+ * @return grpc::Slice
+ */
+template <typename FillFunction>
+grpc::Slice
+CreateSlice(std::size_t size, FillFunction&& fill)
+{
+    grpc_slice slice = grpc_slice_malloc(size);
+    fill(std::span<uint8_t>(GRPC_SLICE_START_PTR(slice), size));
+
+    return grpc::Slice(slice, grpc::Slice::STEAL_REF);
+}
+
+/**
+ * @brief Attach a stream to the session specified in its properties, if any.
+ *
+ * @param sessionManager The manager of sessions.
+ * @param dataStreamProperties The properties of the stream.
+ * @param direction The direction in which data flows on the stream.
+ * @param sessionStream Receives the stream accounting if the stream was attached to a session.
+ * @return true If the stream was attached, or no session was specified.
+ * @return false If the session does not exist or can accept no more streams.
+ */
+bool
+AttachToSession(SessionManager& sessionManager, const DataStreamProperties& dataStreamProperties, SessionStreamDirection direction, std::shared_ptr<SessionStream>& sessionStream)
+{
+    if (std::empty(dataStreamProperties.sessionid())) {
+        return true;
+    }
+
+    auto session = sessionManager.Find(dataStreamProperties.sessionid());
+    if (session == nullptr) {
+        return false;
+    }
+
+    sessionStream = session->AddStream(direction);
+    return sessionStream != nullptr;
+}
+} // namespace detail
+
 namespace Microsoft::Net::Remote::Service::Reactors::Helpers
 {
-DataGenerator::DataGenerator()
+Microsoft::Net::Remote::DataStream::DataStreamHistogram
+ToDataStreamHistogram(const Microsoft::Net::Remote::DataStream::Histogram& histogram)
 {
-    m_generator.seed(std::random_device{}());
+    Microsoft::Net::Remote::DataStream::DataStreamHistogram dataStreamHistogram{};
+    dataStreamHistogram.set_count(histogram.GetCount());
+    dataStreamHistogram.set_minimum(histogram.GetMinimum());
+    dataStreamHistogram.set_maximum(histogram.GetMaximum());
+    dataStreamHistogram.set_mean(histogram.GetMean());
+
+    for (const auto& bucket : histogram.GetBuckets()) {
+        auto* dataStreamHistogramBucket = dataStreamHistogram.add_buckets();
+        dataStreamHistogramBucket->set_lowerbound(bucket.LowerBound);
+        dataStreamHistogramBucket->set_upperbound(bucket.UpperBound);
+        dataStreamHistogramBucket->set_count(bucket.Count);
+    }
+
+    return dataStreamHistogram;
 }
 
-std::string
-DataGenerator::GenerateRandomData(const std::size_t length)
+void
+DataBlockPool::Generate(Microsoft::Net::Remote::DataStream::RandomDataGenerator& dataGenerator, std::size_t dataBlockSize)
 {
-    std::string result;
-    result.reserve(length);
+    const auto numberOfDataBlocks = std::clamp<std::size_t>(PoolSizeTarget / std::max<std::size_t>(dataBlockSize, 1), 1, NumberOfDataBlocksMaximum);
 
-    for (std::size_t i = 0; i < length; i++) {
-        result.push_back(static_cast<char>(GetRandomByte()));
+    m_dataBlocks.clear();
+    m_dataBlocks.reserve(numberOfDataBlocks);
+    for (std::size_t i = 0; i < numberOfDataBlocks; i++) {
+        m_dataBlocks.push_back(detail::CreateSlice(dataBlockSize, [&](std::span<uint8_t> dataBlock) {
+            dataGenerator.Fill(dataBlock);
+        }));
     }
 
-    return result;
+    m_dataBlockSize = dataBlockSize;
+    m_dataBlockIndexNext = 0;
+}
+
+const grpc::Slice&
+DataBlockPool::Next() noexcept
+{
+    const auto& dataBlock = m_dataBlocks[m_dataBlockIndexNext];
+    m_dataBlockIndexNext = (m_dataBlockIndexNext + 1) % std::size(m_dataBlocks);
+
+    return dataBlock;
+}
+
+std::size_t
+DataBlockPool::GetDataBlockSize() const noexcept
+{
+    return m_dataBlockSize;
 }
 
-uint8_t
-DataGenerator::GetRandomByte()
+/* static */
+bool
+DataBlockSource::IsPatternSupported(Microsoft::Net::Remote::DataStream::DataStreamPattern pattern) noexcept
 {
-    std::uniform_int_distribution<uint32_t> distribution(0, std::numeric_limits<uint8_t>::max());
-    return static_cast<uint8_t>(distribution(m_generator));
+    return pattern == Microsoft::Net::Remote::DataStream::DataStreamPattern::DataStreamPatternConstant || detail::ToDataPattern(pattern).has_value();
+}
+
+void
+DataBlockSource::Initialize(Microsoft::Net::Remote::DataStream::DataStreamPattern pattern, uint64_t seed, std::size_t dataBlockSize)
+{
+    m_dataBlockSize = dataBlockSize;
+
+    const auto dataPattern = detail::ToDataPattern(pattern);
+    if (dataPattern.has_value()) {
+        m_dataPatternGenerator.emplace(dataPattern.value(), seed);
+    } else {
+        m_dataPatternGenerator.reset();
+        m_dataBlockPool.Generate(m_randomDataGenerator, dataBlockSize);
+    }
+}
+
+grpc::Slice
+DataBlockSource::NextSlice(uint64_t sequenceNumber)
+{
+    if (!m_dataPatternGenerator.has_value()) {
+        return m_dataBlockPool.Next();
+    }
+
+    // Data blocks written by the server all have the same size, so the offset follows from the sequence number.
+    const uint64_t offset = (sequenceNumber - 1) * m_dataBlockSize;
+    return detail::CreateSlice(m_dataBlockSize, [&](std::span<uint8_t> data) {
+        m_dataPatternGenerator->Fill(data, sequenceNumber, offset);
+    });
+}
+
+void
+DataBlockSource::Next(std::string& data, uint64_t sequenceNumber)
+{
+    if (!m_dataPatternGenerator.has_value()) {
+        const auto& dataBlock = m_dataBlockPool.Next();
+        data.assign(reinterpret_cast<const char*>(dataBlock.begin()), dataBlock.size());
+        return;
+    }
+
+    // Data blocks written by the server all have the same size, so the offset follows from the sequence number.
+    const uint64_t offset = (sequenceNumber - 1) * m_dataBlockSize;
+    data.resize(m_dataBlockSize);
+    m_dataPatternGenerator->Fill(std::span<char>(data), sequenceNumber, offset);
+}
+
+void
+DataBlockSource::NextSlices(std::vector<grpc::Slice>& slices, uint64_t sequenceNumber, std::size_t numberOfDataBlocks)
+{
+    for (std::size_t i = 0; i < numberOfDataBlocks; i++) {
+        slices.push_back(NextSlice(sequenceNumber + i));
+    }
+}
+
+void
+DataBlockSource::Next(std::string& data, uint64_t sequenceNumber, std::size_t numberOfDataBlocks)
+{
+    data.resize(m_dataBlockSize * numberOfDataBlocks);
+    for (std::size_t i = 0; i < numberOfDataBlocks; i++) {
+        auto dataBlock = std::span<char>(data).subspan(i * m_dataBlockSize, m_dataBlockSize);
+        if (!m_dataPatternGenerator.has_value()) {
+            const auto& dataBlockPooled = m_dataBlockPool.Next();
+            std::memcpy(std::data(dataBlock), dataBlockPooled.begin(), std::size(dataBlock));
+            continue;
+        }
+
+        // Data blocks written by the server all have the same size, so the offset follows from the sequence number.
+        const uint64_t offset = (sequenceNumber + i - 1) * m_dataBlockSize;
+        m_dataPatternGenerator->Fill(dataBlock, sequenceNumber + i, offset);
+    }
+}
+
+WriteScheduler::WriteScheduler(std::function<void()> write, std::function<void(const grpc::Status&)> finish) :
+    m_write(std::move(write)),
+    m_finish(std::move(finish))
+{
+}
+
+void
+WriteScheduler::Configure(uint64_t targetBitrate, std::optional<std::chrono::steady_clock::duration> duration, std::size_t dataBlockSize)
+{
+    const auto timeNow = std::chrono::steady_clock::now();
+
+    if (targetBitrate > 0) {
+        const double bytesPerSecond = static_cast<double>(targetBitrate) / 8;
+        const double capacity = std::max(static_cast<double>(dataBlockSize), bytesPerSecond * std::chrono::duration<double>(BurstDuration).count());
+        m_tokenBucket.emplace(bytesPerSecond, capacity, timeNow);
+    }
+
+    if (duration.has_value()) {
+        m_timeEnd = timeNow + duration.value();
+    }
+}
+
+void
+WriteScheduler::ScheduleWrite(std::size_t numberOfBytes)
+{
+    if (m_isFinished.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    const auto timeNow = std::chrono::steady_clock::now();
+    if (m_timeEnd.has_value() && timeNow >= m_timeEnd.value()) {
+        LOGD << "Data stream duration elapsed, finishing";
+        TryFinish(grpc::Status::OK);
+        return;
+    }
+
+    const auto timeWrite = m_tokenBucket.has_value() ? m_tokenBucket->Reserve(static_cast<double>(numberOfBytes), timeNow) : timeNow;
+    if (timeWrite <= timeNow) {
+        m_write();
+        return;
+    }
+
+    // Don't wait for a write that would happen after the stream duration elapses.
+    if (m_timeEnd.has_value() && timeWrite >= m_timeEnd.value()) {
+        LOGD << "Data stream duration elapses before next write, finishing";
+        TryFinish(grpc::Status::OK);
+        return;
+    }
+
+    const std::lock_guard lock(m_scheduleGate);
+    if (m_isFinished.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    // Alarms only accept wall-clock deadlines, so convert the delay to one.
+    const auto deadline = std::chrono::system_clock::now() + std::chrono::duration_cast<std::chrono::system_clock::duration>(timeWrite - timeNow);
+    m_isWriteScheduled = true;
+    m_alarm.emplace();
+    m_alarm->Set(deadline, [this](bool isOk) {
+        OnAlarm(isOk);
+    });
+}
+
+void
+WriteScheduler::TryFinish(const grpc::Status& status)
+{
+    {
+        const std::lock_guard lock(m_scheduleGate);
+        if (m_isFinished.load(std::memory_order_relaxed) || m_finishStatusDeferred.has_value()) {
+            return;
+        }
+
+        // Defer finishing until the scheduled write's alarm callback runs, since it references the reactor.
+        if (m_isWriteScheduled) {
+            m_finishStatusDeferred = status;
+            m_alarm->Cancel();
+            return;
+        }
+
+        m_isFinished.store(true, std::memory_order_relaxed);
+    }
+
+    m_finish(status);
+}
+
+bool
+WriteScheduler::IsFinished() const noexcept
+{
+    return m_isFinished.load(std::memory_order_relaxed);
+}
+
+void
+WriteScheduler::OnAlarm(bool isOk)
+{
+    std::optional<grpc::Status> finishStatus{};
+
+    {
+        const std::lock_guard lock(m_scheduleGate);
+        m_isWriteScheduled = false;
+
+        if (m_finishStatusDeferred.has_value()) {
+            finishStatus = std::move(m_finishStatusDeferred);
+            m_isFinished.store(true, std::memory_order_relaxed);
+        } else if (isOk) {
+            // Write while holding the lock so that the RPC cannot be finished before the write is started.
+            m_write();
+            return;
+        }
+    }
+
+    if (finishStatus.has_value()) {
+        m_finish(finishStatus.value());
+    }
+}
+
+void
+WriteCompletionLatencyRecorder::OnWriteStarted()
+{
+    const std::lock_guard lock(m_latencyGate);
+    m_timeWriteStarted = std::chrono::steady_clock::now();
+}
+
+void
+WriteCompletionLatencyRecorder::OnWriteCompleted()
+{
+    const auto timeWriteCompleted = std::chrono::steady_clock::now();
+
+    const std::lock_guard lock(m_latencyGate);
+    m_latency.Record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(timeWriteCompleted - m_timeWriteStarted).count()));
+}
+
+void
+WriteCompletionLatencyRecorder::AddToTrailingMetadata(grpc::CallbackServerContext& context) const
+{
+    Microsoft::Net::Remote::DataStream::DataStreamHistogram latency{};
+    {
+        const std::lock_guard lock(m_latencyGate);
+        latency = ToDataStreamHistogram(m_latency);
+    }
+
+    context.AddTrailingMetadata(Microsoft::Net::Remote::Service::NetRemoteDataStreamingService::WriteCompletionLatencyMetadataKey, latency.SerializeAsString());
+}
+
+void
+WriteCompletionLatencyRecorder::AddToStreamMetrics(Microsoft::Net::Remote::DataStream::StreamMetrics& streamMetrics) const
+{
+    const std::lock_guard lock(m_latencyGate);
+    streamMetrics.RecordWriteCompletionLatency(m_latency);
 }
 } // namespace Microsoft::Net::Remote::Service::Reactors::Helpers
 
 using namespace Microsoft::Net::Remote::DataStream;
 using namespace Microsoft::Net::Remote::Service::Reactors;
 
-DataStreamReader::DataStreamReader(DataStreamUploadResult* result) :
-    m_result(result)
+using Microsoft::Net::Remote::Service::DataStreamDownloadDataEncoder;
+
+DataStreamReader::DataStreamReader(DataStreamUploadResult* result, SessionManager& sessionManager, StreamAdmissionTicket admissionTicket) :
+    m_result(result),
+    m_sessionManager(sessionManager),
+    m_admissionTicket(std::move(admissionTicket))
 {
     const FunctionTracer traceMe{};
     StartRead(&m_data);
@@ -72,15 +522,53 @@ DataStreamReader::OnReadDone(bool isOk)
     const FunctionTracerVerbose traceMe{};
 
     if (isOk) {
+        m_receiveStatistics.Record(std::size(m_data.data()));
         m_numberOfDataBlocksReceived++;
+
+        // The first message may announce a verifiable pattern, in which case the content of each data block is checked,
+        // and a session to attach the stream to.
+        if (m_numberOfDataBlocksReceived == 1) {
+            const auto dataPattern = detail::ToDataPattern(m_data.properties().pattern());
+            if (dataPattern.has_value()) {
+                m_dataPatternVerifier.emplace(dataPattern.value(), m_data.properties().seed());
+            }
+
+            if (!detail::AttachToSession(m_sessionManager, m_data.properties(), SessionStreamDirection::Upload, m_sessionStream)) {
+                m_readStatus.set_code(DataStreamOperationStatusCode::DataStreamOperationStatusCodeFailed);
+                m_readStatus.set_message(std::format("Failed to attach to session {}", m_data.properties().sessionid()));
+                UpdateResult();
+                Finish(grpc::Status::OK);
+                return;
+            }
+        }
+        if (m_sessionStream != nullptr) {
+            m_sessionStream->RecordReceived(std::size(m_data.data()));
+        }
+        const uint64_t sequenceNumber = m_data.sequencenumber();
+        bool isDuplicate = false;
+        if (sequenceNumber != 0) {
+            const auto numberOfDataBlocksDuplicated = m_sequenceTracker.GetNumberOfDataBlocksDuplicated();
+            m_sequenceTracker.Record(sequenceNumber);
+            isDuplicate = (m_sequenceTracker.GetNumberOfDataBlocksDuplicated() != numberOfDataBlocksDuplicated);
+        }
+        if (m_dataPatternVerifier.has_value() && !isDuplicate) {
+            // Verify against the sender's sequence number when it is provided so that lost or reordered data blocks
+            // are not reported as corrupted. Otherwise, fall back to the order in which the data blocks were received.
+            const uint64_t dataBlockSize = std::size(m_data.data());
+            const uint64_t dataBlockIndex = (sequenceNumber != 0) ? sequenceNumber : m_numberOfDataBlocksReceived;
+            const uint64_t offset = (sequenceNumber != 0) ? (sequenceNumber - 1) * dataBlockSize : m_receiveStatistics.GetNumberOfBytes() - dataBlockSize;
+            if (!m_dataPatternVerifier->Verify(std::span<const char>(m_data.data()), dataBlockIndex, offset)) {
+                m_numberOfDataBlocksCorrupted++;
+            }
+        }
+
         m_readStatus.set_code(DataStreamOperationStatusCode::DataStreamOperationStatusCodeSucceeded);
         m_readStatus.set_message("Data read successful");
         StartRead(&m_data);
     } else {
         // A false "isOk" value could either mean a failed RPC or that no more data is available.
         // Unfortunately, there is no clear way to tell which situation occurred.
-        m_result->set_numberofdatablocksreceived(m_numberOfDataBlocksReceived);
-        *m_result->mutable_status() = std::move(m_readStatus);
+        UpdateResult();
         Finish(grpc::Status::OK);
     }
 }
@@ -90,10 +578,9 @@ DataStreamReader::OnCancel()
 {
     const FunctionTracer traceMe{};
 
-    m_result->set_numberofdatablocksreceived(m_numberOfDataBlocksReceived);
     m_readStatus.set_code(DataStreamOperationStatusCode::DataStreamOperationStatusCodeCanceled);
     m_readStatus.set_message("RPC canceled");
-    *m_result->mutable_status() = std::move(m_readStatus);
+    UpdateResult();
     Finish(grpc::Status::CANCELLED);
 }
 
@@ -101,14 +588,59 @@ void
 DataStreamReader::OnDone()
 {
     const FunctionTracer traceMe{};
+
+    if (m_sessionStream != nullptr) {
+        m_sessionStream->Complete();
+    }
+
     delete this;
 }
 
-DataStreamWriter::DataStreamWriter(const DataStreamDownloadRequest* request) :
-    m_dataStreamProperties(request->properties())
+void
+DataStreamReader::UpdateResult()
+{
+    m_result->set_numberofdatablocksreceived(m_numberOfDataBlocksReceived);
+    m_result->set_numberofdatablockscorrupted(m_numberOfDataBlocksCorrupted);
+    m_result->set_numberofbytesreceived(m_receiveStatistics.GetNumberOfBytes());
+    m_result->set_goodputbitspersecond(m_receiveStatistics.GetGoodputBitsPerSecond());
+
+    const auto timeFirstReceived = m_receiveStatistics.GetTimeFirstReceived();
+    const auto timeLastReceived = m_receiveStatistics.GetTimeLastReceived();
+    if (timeFirstReceived.has_value() && timeLastReceived.has_value()) {
+        *m_result->mutable_firstdatareceivedtime() = detail::ToTimestamp(timeFirstReceived.value());
+        *m_result->mutable_lastdatareceivedtime() = detail::ToTimestamp(timeLastReceived.value());
+    }
+
+    *m_result->mutable_interarrivaltimemicroseconds() = Helpers::ToDataStreamHistogram(m_receiveStatistics.GetInterArrivalTimeHistogram());
+    *m_result->mutable_interarrivaljittermicroseconds() = Helpers::ToDataStreamHistogram(m_receiveStatistics.GetInterArrivalJitterHistogram());
+    m_result->set_numberofdatablockslost(m_sequenceTracker.GetNumberOfDataBlocksLost());
+    m_result->set_numberofdatablocksduplicated(m_sequenceTracker.GetNumberOfDataBlocksDuplicated());
+    m_result->set_numberofdatablocksoutoforder(m_sequenceTracker.GetNumberOfDataBlocksOutOfOrder());
+    m_result->set_numberofsequencegaps(m_sequenceTracker.GetNumberOfGaps());
+    m_result->set_reorderdistancemaximum(m_sequenceTracker.GetReorderDistanceMaximum());
+    *m_result->mutable_status() = std::move(m_readStatus);
+}
+
+DataStreamWriter::DataStreamWriter(grpc::CallbackServerContext* context, const grpc::ByteBuffer* request, SessionManager& sessionManager, StreamMetrics& streamMetrics, StreamAdmissionTicket admissionTicket) :
+    m_writeScheduler([this]() { Write(); }, [this](const grpc::Status& status) { Complete(status); }),
+    m_context(context),
+    m_streamMetrics(streamMetrics),
+    m_admissionTicket(std::move(admissionTicket))
 {
     const FunctionTracer traceMe{};
 
+    // The request is received serialized since the method is registered as a raw method so that the data written can
+    // be pre-serialized; deserialization consumes the buffer, so do so on a (shallow) copy of it.
+    DataStreamDownloadRequest downloadRequest{};
+    grpc::ByteBuffer requestBuffer{ *request };
+    const auto deserializeStatus = grpc::SerializationTraits<DataStreamDownloadRequest>::Deserialize(&requestBuffer, &downloadRequest);
+    if (!deserializeStatus.ok()) {
+        HandleFailure(std::format("Invalid download request: {}", deserializeStatus.error_message()));
+        return;
+    }
+
+    m_dataStreamProperties = std::move(*downloadRequest.mutable_properties());
+
     switch (m_dataStreamProperties.type()) {
     case DataStreamType::DataStreamTypeFixed: {
         if (m_dataStreamProperties.Properties_case() == DataStreamProperties::kFixed) {
@@ -130,12 +662,58 @@ DataStreamWriter::DataStreamWriter(const DataStreamDownloadRequest* request) :
 
         break;
     }
+    case DataStreamType::DataStreamTypeTimed: {
+        if (m_dataStreamProperties.Properties_case() == DataStreamProperties::kTimed) {
+            m_numberOfDataBlocksToStream = 0;
+        } else {
+            HandleFailure("Invalid properties for this streaming type. Expected Timed for DataStreamTypeTimed");
+            return;
+        }
+
+        break;
+    }
     default: {
         HandleFailure(std::format("Invalid streaming type: {}", magic_enum::enum_name(m_dataStreamProperties.type())));
         return;
     }
     };
 
+    const auto dataBlockSize = detail::GetDataBlockSize(m_dataStreamProperties);
+    if (!dataBlockSize.has_value()) {
+        HandleFailure(std::format("Invalid data block size {} (maximum {})", m_dataStreamProperties.datablocksize(), Helpers::DataBlockPool::DataBlockSizeMaximum));
+        return;
+    }
+
+    const auto dataBlocksPerMessage = detail::GetDataBlocksPerMessage(m_dataStreamProperties, dataBlockSize.value());
+    if (!dataBlocksPerMessage.has_value()) {
+        HandleFailure(std::format("Invalid number of data blocks per message {} (maximum {}, and {} bytes per message)", m_dataStreamProperties.datablockspermessage(), Helpers::DataBlockSource::DataBlocksPerMessageMaximum, Helpers::DataBlockPool::DataBlockSizeMaximum));
+        return;
+    }
+
+    // The message buffered for writing counts toward the bytes the server has in flight. Finish through the write
+    // scheduler so that a later cancelation does not finish the RPC again.
+    if (!m_admissionTicket.TryReserve(dataBlockSize.value() * dataBlocksPerMessage.value())) {
+        m_writeScheduler.TryFinish(detail::CreateMemoryBudgetExhaustedStatus());
+        return;
+    }
+
+    const auto pattern = m_dataStreamProperties.pattern();
+    if (!Helpers::DataBlockSource::IsPatternSupported(pattern)) {
+        HandleFailure(std::format("Unexpected data stream pattern {}", magic_enum::enum_name(pattern)));
+        return;
+    }
+
+    if (!detail::AttachToSession(sessionManager, m_dataStreamProperties, SessionStreamDirection::Download, m_sessionStream)) {
+        HandleFailure(std::format("Failed to attach to session {}", m_dataStreamProperties.sessionid()));
+        return;
+    }
+
+    m_dataBlockSize = dataBlockSize.value();
+    m_dataBlocksPerMessage = dataBlocksPerMessage.value();
+    m_dataSlices.reserve(m_dataBlocksPerMessage);
+    m_dataBlockSource.Initialize(pattern, m_dataStreamProperties.seed(), m_dataBlockSize);
+    m_writeScheduler.Configure(m_dataStreamProperties.targetbitrate(), detail::GetDataStreamDuration(m_dataStreamProperties), m_dataBlockSize * m_dataBlocksPerMessage);
+
     m_writeStatus.set_code(DataStreamOperationStatusCode::DataStreamOperationStatusCodeUnknown);
     m_writeStatus.set_message("No data sent yet");
     NextWrite();
@@ -146,27 +724,31 @@ DataStreamWriter::OnWriteDone(bool isOk)
 {
     const FunctionTracerVerbose traceMe{};
 
+    if (isOk) {
+        m_writeCompletionLatencyRecorder.OnWriteCompleted();
+    }
+
     // Client may have canceled the RPC, so check for cancelation to prevent writing more data
-    // when we shouldn't.
+    // when we shouldn't. OnCancel() may have been unable to finish the RPC if this write was in progress.
     if (m_isCanceled.load(std::memory_order_relaxed)) {
         LOGD << "RPC canceled, returning early";
+        m_writeScheduler.TryFinish(grpc::Status::CANCELLED);
         return;
     }
 
     // Check for a failed status code from HandleWriteFailure since that invoked a final write, thus causing this callback to be invoked.
     if (m_writeStatus.code() == DataStreamOperationStatusCode::DataStreamOperationStatusCodeFailed) {
-        bool isCompletedExpected{ false };
-        if (m_isCompleted.compare_exchange_strong(isCompletedExpected, true, std::memory_order_relaxed, std::memory_order_relaxed)) {
-            Finish(grpc::Status::OK);
-        }
-
+        m_writeScheduler.TryFinish(grpc::Status::OK);
         return;
     }
 
     // Continue writing if previous write was successful, otherwise handle the failure.
     if (isOk) {
         if (m_dataStreamProperties.type() == DataStreamType::DataStreamTypeFixed) {
-            m_numberOfDataBlocksToStream--;
+            m_numberOfDataBlocksToStream -= m_numberOfDataBlocksInMessage;
+        }
+        if (m_sessionStream != nullptr) {
+            m_sessionStream->RecordSent(m_dataBlockSize * m_numberOfDataBlocksInMessage);
         }
         m_writeStatus.set_code(DataStreamOperationStatusCode::DataStreamOperationStatusCodeSucceeded);
         m_writeStatus.set_message("Data write successful");
@@ -184,10 +766,8 @@ DataStreamWriter::OnCancel()
     // The RPC is canceled by the client, so call Finish to complete it from the server perspective.
     bool isCanceledExpected{ false };
     if (m_isCanceled.compare_exchange_strong(isCanceledExpected, true, std::memory_order_relaxed, std::memory_order_relaxed)) {
-        // It's possible that Finish was already called due to a write failure, so don't call Finish again in that case.
-        if (!m_isCompleted.load(std::memory_order_relaxed)) {
-            Finish(grpc::Status::CANCELLED);
-        }
+        // It's possible that Finish was already called due to a write failure, in which case this does nothing.
+        m_writeScheduler.TryFinish(grpc::Status::CANCELLED);
     }
 }
 
@@ -195,6 +775,11 @@ void
 DataStreamWriter::OnDone()
 {
     const FunctionTracer traceMe{};
+
+    if (m_sessionStream != nullptr) {
+        m_sessionStream->Complete();
+    }
+
     delete this;
 }
 
@@ -211,32 +796,60 @@ DataStreamWriter::NextWrite()
     }
 
     if (m_dataStreamProperties.type() == DataStreamType::DataStreamTypeContinuous ||
+        m_dataStreamProperties.type() == DataStreamType::DataStreamTypeTimed ||
         (m_dataStreamProperties.type() == DataStreamType::DataStreamTypeFixed && m_numberOfDataBlocksToStream > 0)) {
-        // Check the requested data streaming pattern.
-        const auto pattern = m_dataStreamProperties.pattern();
-
-        switch (pattern) {
-        // Generate data with the constant default size and write to the client at a constant speed.
-        case DataStreamPattern::DataStreamPatternConstant: {
-            // Create data to write to the client.
-            const auto data = m_dataGenerator.GenerateRandomData();
-            m_numberOfDataBlocksWritten++;
-
-            // Write data to the client.
-            m_data.set_data(data);
-            m_data.set_sequencenumber(m_numberOfDataBlocksWritten);
-            *m_data.mutable_status() = m_writeStatus;
-            StartWrite(&m_data);
-
-            break;
-        }
-        default:
-            HandleFailure(std::format("Unexpected data stream pattern {}", magic_enum::enum_name(pattern)));
-        };
+        // Write now or, if pacing requires it, later. The RPC is finished instead if the stream duration elapsed.
+        m_writeScheduler.ScheduleWrite(m_dataBlockSize * GetNumberOfDataBlocksInNextMessage());
     } else {
         // No more data to write.
-        Finish(::grpc::Status::OK);
+        m_writeScheduler.TryFinish(grpc::Status::OK);
+    }
+}
+
+uint32_t
+DataStreamWriter::GetNumberOfDataBlocksInNextMessage() const noexcept
+{
+    // Fixed streams end with a partial message if the number of data blocks isn't a multiple of the message size.
+    if (m_dataStreamProperties.type() == DataStreamType::DataStreamTypeFixed) {
+        return std::min(m_dataBlocksPerMessage, m_numberOfDataBlocksToStream);
     }
+
+    return m_dataBlocksPerMessage;
+}
+
+void
+DataStreamWriter::Write()
+{
+    const FunctionTracerVerbose traceMe{};
+
+    const uint64_t sequenceNumber = m_numberOfDataBlocksWritten + 1;
+    m_numberOfDataBlocksInMessage = GetNumberOfDataBlocksInNextMessage();
+    m_numberOfDataBlocksWritten += m_numberOfDataBlocksInMessage;
+
+    // Write data to the client. The data blocks are referenced by the message rather than copied into it.
+    m_dataHeader.set_sequencenumber(sequenceNumber);
+    *m_dataHeader.mutable_status() = m_writeStatus;
+    if (m_dataBlocksPerMessage == 1) {
+        m_data = DataStreamDownloadDataEncoder::Encode(m_dataHeader, m_dataBlockSource.NextSlice(sequenceNumber));
+    } else {
+        m_dataHeader.set_numberofdatablocks(m_numberOfDataBlocksInMessage);
+        m_dataSlices.clear();
+        m_dataBlockSource.NextSlices(m_dataSlices, sequenceNumber, m_numberOfDataBlocksInMessage);
+        m_data = DataStreamDownloadDataEncoder::Encode(m_dataHeader, m_dataSlices);
+    }
+    m_writeCompletionLatencyRecorder.OnWriteStarted();
+    StartWrite(&m_data);
+}
+
+void
+DataStreamWriter::Complete(const grpc::Status& status)
+{
+    const FunctionTracer traceMe{};
+
+    // Return the latencies with the status, so the server-wide metrics cover exactly what streams returned.
+    m_writeCompletionLatencyRecorder.AddToTrailingMetadata(*m_context);
+    m_writeCompletionLatencyRecorder.AddToStreamMetrics(m_streamMetrics);
+    Finish(status);
 }
 
 void
@@ -246,21 +859,30 @@ DataStreamWriter::HandleFailure(const std::string& errorMessage)
 
     m_writeStatus.set_code(DataStreamOperationStatusCode::DataStreamOperationStatusCodeFailed);
     m_writeStatus.set_message(errorMessage);
-    *m_data.mutable_status() = m_writeStatus;
+    *m_dataHeader.mutable_status() = m_writeStatus;
+    m_dataHeader.clear_numberofdatablocks();
+    m_data = DataStreamDownloadDataEncoder::Encode(m_dataHeader, grpc::Slice{});
 
     // Write a final message to the client. The OnWriteDone() callback will check for the
     // DataStreamOperationStatusCodeFailed status code set here to know to complete the RPC.
+    m_writeCompletionLatencyRecorder.OnWriteStarted();
     StartWrite(&m_data);
 }
 
-DataStreamReaderWriter::DataStreamReaderWriter()
+DataStreamReaderWriter::DataStreamReaderWriter(grpc::CallbackServerContext* context, SessionManager& sessionManager, StreamMetrics& streamMetrics, StreamAdmissionTicket admissionTicket) :
+    m_sessionManager(sessionManager),
+    m_writeScheduler([this]() { Write(); }, [this](const grpc::Status& status) { Complete(status); }),
+    m_context(context),
+    m_streamMetrics(streamMetrics),
+    m_admissionTicket(std::move(admissionTicket))
 {
     const FunctionTracer traceMe{};
 
     m_status.set_code(DataStreamOperationStatusCode::DataStreamOperationStatusCodeUnknown);
     m_status.set_message("No data sent yet");
+
+    // Writing starts once the first message, which may carry the data stream properties, is received.
     StartRead(&m_readData);
-    NextWrite();
 }
 
 void
@@ -269,16 +891,42 @@ DataStreamReaderWriter::OnReadDone(bool isOk)
     const FunctionTracerVerbose traceMe{};
 
     if (isOk) {
+        const auto timeReceived = std::chrono::system_clock::now();
+
         m_numberOfDataBlocksReceived++;
         m_status.set_code(DataStreamOperationStatusCode::DataStreamOperationStatusCodeSucceeded);
         m_status.set_message("Data read successful");
+
+        // The first message may carry the properties to use for data written to the client, so start writing now.
+        if (m_numberOfDataBlocksReceived == 1) {
+            if (!detail::AttachToSession(m_sessionManager, m_readData.properties(), SessionStreamDirection::Bidirectional, m_sessionStream)) {
+                HandleFailure(std::format("Failed to attach to session {}", m_readData.properties().sessionid()));
+                return;
+            }
+
+            if (m_readData.properties().bidirectionalmode() == DataStreamBidirectionalMode::DataStreamBidirectionalModeEcho) {
+                m_isEchoMode = true;
+            } else if (!StartWrites(m_readData.properties())) {
+                return;
+            }
+        }
+
+        if (m_sessionStream != nullptr) {
+            m_sessionStream->RecordReceived(std::size(m_readData.data()));
+        }
+
+        if (m_isEchoMode) {
+            Echo(timeReceived);
+            return;
+        }
+
         StartRead(&m_readData);
     } else {
         // A false "isOk" value could either mean a failed RPC or that no more data is available.
         // Unfortunately, there is no clear way to tell which situation occurred.
         bool readsDoneExpected{ false };
         if (m_readsDone.compare_exchange_strong(readsDoneExpected, true, std::memory_order_relaxed, std::memory_order_relaxed)) {
-            Finish(grpc::Status::OK);
+            m_writeScheduler.TryFinish(grpc::Status::OK);
         }
     }
 }
@@ -288,16 +936,23 @@ DataStreamReaderWriter::OnWriteDone(bool isOk)
 {
     const FunctionTracerVerbose traceMe{};
 
+    if (isOk) {
+        m_writeCompletionLatencyRecorder.OnWriteCompleted();
+    }
+
     // Client may have canceled the RPC, so check for cancelation to prevent writing more data
-    // when we shouldn't.
+    // when we shouldn't. In echo mode, no read is pending while writing, so the RPC must be finished here.
     if (m_isCanceled.load(std::memory_order_relaxed)) {
         LOGD << "RPC canceled, returning early";
+        if (m_isEchoMode) {
+            m_writeScheduler.TryFinish(grpc::Status::CANCELLED);
+        }
         return;
     }
 
     // Check for a failed status code from HandleWriteFailure since that invoked a final write, thus causing this callback to be invoked.
     if (m_status.code() == DataStreamOperationStatusCode::DataStreamOperationStatusCodeFailed) {
-        Finish(::grpc::Status::OK);
+        m_writeScheduler.TryFinish(grpc::Status::OK);
         return;
     }
 
@@ -305,7 +960,16 @@ DataStreamReaderWriter::OnWriteDone(bool isOk)
     if (isOk) {
         m_status.set_code(DataStreamOperationStatusCode::DataStreamOperationStatusCodeSucceeded);
         m_status.set_message("Data write successful");
-        NextWrite();
+        if (m_sessionStream != nullptr) {
+            m_sessionStream->RecordSent(std::size(m_writeData.data()));
+        }
+        if (m_isEchoMode) {
+            // Only read the next data block once the echo of the previous one is written, which bounds the amount of
+            // data buffered by the server.
+            StartRead(&m_readData);
+        } else {
+            NextWrite();
+        }
     } else {
         // If OnReadDone() failed (due to no more data sent from the client), then Finish() was called and this write will fail.
         // In that case, do not call HandleFailure() because that triggers another write. Otherwise, this is a true write failure.
@@ -330,9 +994,60 @@ void
 DataStreamReaderWriter::OnDone()
 {
     const FunctionTracer traceMe{};
+
+    if (m_sessionStream != nullptr) {
+        m_sessionStream->Complete();
+    }
+
     delete this;
 }
 
+bool
+DataStreamReaderWriter::StartWrites(const DataStreamProperties& dataStreamProperties)
+{
+    const FunctionTracer traceMe{};
+
+    m_dataStreamProperties = dataStreamProperties;
+
+    const auto dataBlockSize = detail::GetDataBlockSize(m_dataStreamProperties);
+    if (!dataBlockSize.has_value()) {
+        HandleFailure(std::format("Invalid data block size {} (maximum {})", m_dataStreamProperties.datablocksize(), Helpers::DataBlockPool::DataBlockSizeMaximum));
+        return false;
+    }
+
+    // Clients that don't specify a pattern get unverifiable random data, as was always sent prior to patterns being
+    // supported by this RPC.
+    auto pattern = m_dataStreamProperties.pattern();
+    if (pattern == DataStreamPattern::DataStreamPatternUnknown) {
+        pattern = DataStreamPattern::DataStreamPatternConstant;
+    }
+    if (!Helpers::DataBlockSource::IsPatternSupported(pattern)) {
+        HandleFailure(std::format("Unexpected data stream pattern {}", magic_enum::enum_name(pattern)));
+        return false;
+    }
+
+    const auto dataBlocksPerMessage = detail::GetDataBlocksPerMessage(m_dataStreamProperties, dataBlockSize.value());
+    if (!dataBlocksPerMessage.has_value()) {
+        HandleFailure(std::format("Invalid number of data blocks per message {} (maximum {}, and {} bytes per message)", m_dataStreamProperties.datablockspermessage(), Helpers::DataBlockSource::DataBlocksPerMessageMaximum, Helpers::DataBlockPool::DataBlockSizeMaximum));
+        return false;
+    }
+
+    // The message buffered for writing counts toward the bytes the server has in flight. No read is pending, so the
+    // RPC may be finished right away.
+    if (!m_admissionTicket.TryReserve(dataBlockSize.value() * dataBlocksPerMessage.value())) {
+        m_writeScheduler.TryFinish(detail::CreateMemoryBudgetExhaustedStatus());
+        return false;
+    }
+
+    m_dataBlockSize = dataBlockSize.value();
+    m_dataBlocksPerMessage = dataBlocksPerMessage.value();
+    m_dataBlockSource.Initialize(pattern, m_dataStreamProperties.seed(), m_dataBlockSize);
+    m_writeScheduler.Configure(m_dataStreamProperties.targetbitrate(), detail::GetDataStreamDuration(m_dataStreamProperties), m_dataBlockSize * m_dataBlocksPerMessage);
+    NextWrite();
+
+    return true;
+}
+
 void
 DataStreamReaderWriter::NextWrite()
 {
@@ -345,17 +1060,75 @@ DataStreamReaderWriter::NextWrite()
         return;
     }
 
-    // Create data to write to the client.
-    const auto data = m_dataGenerator.GenerateRandomData();
-    m_numberOfDataBlocksWritten++;
+    // The RPC may have been completed due to the client finishing its writes, so don't write any more data.
+    if (m_writeScheduler.IsFinished()) {
+        LOGD << "RPC completed, aborting write";
+        return;
+    }
+
+    // Write now or, if pacing requires it, later. The RPC is finished instead if the stream duration elapsed.
+    m_writeScheduler.ScheduleWrite(m_dataBlockSize * m_dataBlocksPerMessage);
+}
+
+void
+DataStreamReaderWriter::Write()
+{
+    const FunctionTracerVerbose traceMe{};
+
+    const uint64_t sequenceNumber = m_numberOfDataBlocksWritten + 1;
+    m_numberOfDataBlocksWritten += m_dataBlocksPerMessage;
 
     // Write data to the client.
-    m_writeData.set_data(data);
+    if (m_dataBlocksPerMessage == 1) {
+        m_dataBlockSource.Next(*m_writeData.mutable_data(), sequenceNumber);
+    } else {
+        m_dataBlockSource.Next(*m_writeData.mutable_data(), sequenceNumber, m_dataBlocksPerMessage);
+        m_writeData.set_numberofdatablocks(m_dataBlocksPerMessage);
+    }
+    m_writeData.set_sequencenumber(sequenceNumber);
+    *m_writeData.mutable_status() = m_status;
+    m_writeCompletionLatencyRecorder.OnWriteStarted();
+    StartWrite(&m_writeData);
+}
+
+void
+DataStreamReaderWriter::Echo(std::chrono::system_clock::time_point timeReceived)
+{
+    const FunctionTracerVerbose traceMe{};
+
+    // The echoed message is buffered until it is written, so counts toward the bytes the server has in flight. The
+    // reservation grows to the largest message echoed. No read is pending, so the RPC may be finished right away.
+    const std::size_t numberOfBytes = std::size(m_readData.data());
+    const std::size_t numberOfBytesReserved = m_admissionTicket.GetNumberOfBytesReserved();
+    if (numberOfBytes > numberOfBytesReserved && !m_admissionTicket.TryReserve(numberOfBytes - numberOfBytesReserved)) {
+        m_writeScheduler.TryFinish(detail::CreateMemoryBudgetExhaustedStatus());
+        return;
+    }
+
+    m_numberOfDataBlocksWritten++;
+
+    // Swap rather than copy the data since the read buffer is not used again until this write completes.
+    m_writeData.mutable_data()->swap(*m_readData.mutable_data());
     m_writeData.set_sequencenumber(m_numberOfDataBlocksWritten);
+    m_writeData.set_echosequencenumber(m_readData.sequencenumber());
+    *m_writeData.mutable_echoreceivetime() = detail::ToTimestamp(timeReceived);
     *m_writeData.mutable_status() = m_status;
+    *m_writeData.mutable_echosendtime() = detail::ToTimestamp(std::chrono::system_clock::now());
+    m_writeCompletionLatencyRecorder.OnWriteStarted();
     StartWrite(&m_writeData);
 }
 
+void
+DataStreamReaderWriter::Complete(const grpc::Status& status)
+{
+    const FunctionTracer traceMe{};
+
+    // Return the latencies with the status, so the server-wide metrics cover exactly what streams returned.
+    m_writeCompletionLatencyRecorder.AddToTrailingMetadata(*m_context);
+    m_writeCompletionLatencyRecorder.AddToStreamMetrics(m_streamMetrics);
+    Finish(status);
+}
+
 void
 DataStreamReaderWriter::HandleFailure(const std::string& errorMessage)
 {
@@ -367,5 +1140,110 @@ DataStreamReaderWriter::HandleFailure(const std::string& errorMessage)
 
     // Write a final message to the client. The OnWriteDone() callback will check for the
     // DataStreamOperationStatusCodeFailed status code set here to know to complete the RPC.
+    m_writeCompletionLatencyRecorder.OnWriteStarted();
     StartWrite(&m_writeData);
 }
+
+DataStreamLatencyProber::DataStreamLatencyProber()
+{
+    const FunctionTracer traceMe{};
+
+    StartRead(&m_request);
+}
+
+void
+DataStreamLatencyProber::OnReadDone(bool isOk)
+{
+    const FunctionTracerVerbose traceMe{};
+
+    if (!isOk) {
+        // The client finished sending pings, or the RPC failed.
+        Finish(grpc::Status::OK);
+        return;
+    }
+
+    *m_response.mutable_receivetime() = google::protobuf::util::TimeUtil::GetCurrentTime();
+    m_response.set_sequencenumber(m_request.sequencenumber());
+    *m_response.mutable_requestsendtime() = m_request.sendtime();
+    *m_response.mutable_sendtime() = google::protobuf::util::TimeUtil::GetCurrentTime();
+    StartWrite(&m_response);
+}
+
+void
+DataStreamLatencyProber::OnWriteDone(bool isOk)
+{
+    const FunctionTracerVerbose traceMe{};
+
+    if (!isOk) {
+        Finish(grpc::Status(grpc::StatusCode::ABORTED, "Failed to write ping response"));
+        return;
+    }
+
+    StartRead(&m_request);
+}
+
+void
+DataStreamLatencyProber::OnDone()
+{
+    const FunctionTracer traceMe{};
+    delete this;
+}
+
+DataStreamLatencyUnderLoadRunner::DataStreamLatencyUnderLoadRunner(std::string address, Microsoft::Net::Remote::DataStreamLatencyUnderLoadConfiguration configuration, DataStreamLatencyUnderLoadResult* result, StreamAdmissionTicket admissionTicket) :
+    m_latencyUnderLoad(std::move(address), std::move(configuration)),
+    m_result(result),
+    m_admissionTicket(std::move(admissionTicket)),
+    m_thread([this](std::stop_token stopToken) {
+        Run(std::move(stopToken));
+    })
+{
+    const FunctionTracer traceMe{};
+}
+
+void
+DataStreamLatencyUnderLoadRunner::Run(std::stop_token stopToken)
+{
+    const FunctionTracer traceMe{};
+
+    const auto measurement = m_latencyUnderLoad.Run(std::move(stopToken));
+
+    const auto& idleRoundTripTimes = measurement.Idle.GetRoundTripTimeHistogram();
+    const auto& loadedRoundTripTimes = measurement.Loaded.GetRoundTripTimeHistogram();
+    *m_result->mutable_idleroundtriptimemicroseconds() = Helpers::ToDataStreamHistogram(idleRoundTripTimes);
+    *m_result->mutable_loadedroundtriptimemicroseconds() = Helpers::ToDataStreamHistogram(loadedRoundTripTimes);
+    m_result->set_latencyincreasemicroseconds(static_cast<int64_t>(loadedRoundTripTimes.GetValueAtPercentile(50)) - static_cast<int64_t>(idleRoundTripTimes.GetValueAtPercentile(50)));
+    m_result->set_numberofbytestransferred(measurement.NumberOfBytesTransferred);
+    m_result->set_goodputbitspersecond(measurement.GoodputBitsPerSecond);
+
+    DataStreamOperationStatus status{};
+    if (std::empty(measurement.ErrorMessage)) {
+        status.set_code(DataStreamOperationStatusCode::DataStreamOperationStatusCodeSucceeded);
+    } else {
+        status.set_code(DataStreamOperationStatusCode::DataStreamOperationStatusCodeFailed);
+        status.set_message(measurement.ErrorMessage);
+    }
+    *m_result->mutable_status() = std::move(status);
+
+    // This may complete the RPC and destroy this object, so nothing may be accessed after it.
+    Finish(grpc::Status::OK);
+}
+
+void
+DataStreamLatencyUnderLoadRunner::OnCancel()
+{
+    const FunctionTracer traceMe{};
+    m_thread.request_stop();
+}
+
+void
+DataStreamLatencyUnderLoadRunner::OnDone()
+{
+    const FunctionTracer traceMe{};
+
+    // The thread cannot join itself, which happens if gRPC completes the RPC inline when the test thread finishes it.
+    if (m_thread.get_id() == std::this_thread::get_id()) {
+        m_thread.detach();
+    }
+
+    delete this;
+}
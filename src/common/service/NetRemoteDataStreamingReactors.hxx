@@ -3,49 +3,355 @@
 #define NET_REMOTE_DATA_STREAMING_REACTORS_HXX
 
 #include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
-#include <random>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
 #include <string>
+#include <thread>
+#include <vector>
 
+#include <grpcpp/alarm.h>
+#include <grpcpp/server_context.h>
+#include <grpcpp/support/byte_buffer.h>
+#include <grpcpp/support/slice.h>
+#include <grpcpp/support/status.h>
+
+#include <microsoft/net/remote/DataStreamLatencyUnderLoad.hxx>
+#include <microsoft/net/remote/datastream/DataPatternGenerator.hxx>
+#include <microsoft/net/remote/datastream/Histogram.hxx>
+#include <microsoft/net/remote/datastream/RandomDataGenerator.hxx>
+#include <microsoft/net/remote/datastream/ReceiveStatistics.hxx>
+#include <microsoft/net/remote/datastream/SequenceTracker.hxx>
+#include <microsoft/net/remote/datastream/Session.hxx>
+#include <microsoft/net/remote/datastream/SessionManager.hxx>
+#include <microsoft/net/remote/datastream/StreamAdmission.hxx>
+#include <microsoft/net/remote/datastream/StreamMetrics.hxx>
+#include <microsoft/net/remote/datastream/TokenBucket.hxx>
 #include <microsoft/net/remote/protocol/NetRemoteDataStream.pb.h>
 #include <microsoft/net/remote/protocol/NetRemoteDataStreamingService.grpc.pb.h>
 
 namespace Microsoft::Net::Remote::Service::Reactors::Helpers
 {
 /**
- * @brief A simple random data generator.
+ * @brief Convert a histogram to its protocol representation.
+ *
+ * @param histogram The histogram to convert.
+ * @return Microsoft::Net::Remote::DataStream::DataStreamHistogram
+ */
+Microsoft::Net::Remote::DataStream::DataStreamHistogram
+ToDataStreamHistogram(const Microsoft::Net::Remote::DataStream::Histogram& histogram);
+
+/**
+ * @brief A pool of pre-generated data blocks that are reused across writes.
+ *
+ * Generating data for each write is costly, and at larger block sizes, dominates the cost of streaming. Instead, a
+ * small number of data blocks are generated once up-front and handed out in round-robin order. The data blocks are
+ * reference-counted slices, so they may be written without being copied.
+ */
+class DataBlockPool
+{
+public:
+    /**
+     * @brief The data block size used when none is specified.
+     */
+    static constexpr std::size_t DataBlockSizeDefault{ 8 };
+
+    /**
+     * @brief The maximum supported data block size. Note that clients must raise their maximum receive message size
+     * from the gRPC default (4 MiB) to receive blocks approaching this size.
+     */
+    static constexpr std::size_t DataBlockSizeMaximum{ 16 * 1024 * 1024 };
+
+    /**
+     * @brief The approximate total size of all data blocks in the pool. This bounds the memory used per stream.
+     */
+    static constexpr std::size_t PoolSizeTarget{ 1024 * 1024 };
+
+    /**
+     * @brief The maximum number of data blocks in the pool.
+     */
+    static constexpr std::size_t NumberOfDataBlocksMaximum{ 8 };
+
+    /**
+     * @brief Construct an empty DataBlockPool object.
+     */
+    DataBlockPool() = default;
+
+    /**
+     * @brief Generate the data blocks in the pool, replacing any existing ones.
+     *
+     * @param dataGenerator The generator to use to create the data blocks.
+     * @param dataBlockSize The size of each data block, in bytes.
+     */
+    void
+    Generate(Microsoft::Net::Remote::DataStream::RandomDataGenerator& dataGenerator, std::size_t dataBlockSize);
+
+    /**
+     * @brief Get the next data block in the pool. The pool must have been generated prior to calling this.
+     *
+     * @return const grpc::Slice&
+     */
+    const grpc::Slice&
+    Next() noexcept;
+
+    /**
+     * @brief Get the size of each data block in the pool.
+     *
+     * @return std::size_t
+     */
+    std::size_t
+    GetDataBlockSize() const noexcept;
+
+private:
+    std::vector<grpc::Slice> m_dataBlocks{};
+    std::size_t m_dataBlockSize{};
+    std::size_t m_dataBlockIndexNext{};
+};
+
+/**
+ * @brief Provides the content of data blocks written to a peer according to the requested data stream pattern.
+ *
+ * Data for the unverifiable DataStreamPatternConstant pattern is taken from a pool of pre-generated blocks. Data for
+ * verifiable patterns depends on the position of each block in the stream, so it is generated for each block.
+ */
+class DataBlockSource
+{
+public:
+    /**
+     * @brief The maximum number of data blocks that may be packed into a single message. Their total size is further
+     * bounded by DataBlockPool::DataBlockSizeMaximum.
+     */
+    static constexpr uint32_t DataBlocksPerMessageMaximum{ 1024 };
+
+    /**
+     * @brief Determine whether the specified data stream pattern is supported.
+     *
+     * @param pattern The data stream pattern to check.
+     * @return true If the pattern is supported.
+     * @return false Otherwise.
+     */
+    static bool
+    IsPatternSupported(Microsoft::Net::Remote::DataStream::DataStreamPattern pattern) noexcept;
+
+    /**
+     * @brief Prepare the source to provide data blocks. This must be called prior to calling Next().
+     *
+     * @param pattern The data stream pattern. Must be supported.
+     * @param seed The stream seed, used by seeded patterns.
+     * @param dataBlockSize The size of each data block, in bytes.
+     */
+    void
+    Initialize(Microsoft::Net::Remote::DataStream::DataStreamPattern pattern, uint64_t seed, std::size_t dataBlockSize);
+
+    /**
+     * @brief Get the data block with the specified sequence number. Data blocks from the pool are shared rather than
+     * copied.
+     *
+     * @param sequenceNumber The sequence number of the data block, starting at 1.
+     * @return grpc::Slice
+     */
+    grpc::Slice
+    NextSlice(uint64_t sequenceNumber);
+
+    /**
+     * @brief Set the content of the specified data to the data block with the specified sequence number.
+     *
+     * @param data The data to set. Its existing storage is reused.
+     * @param sequenceNumber The sequence number of the data block, starting at 1.
+     */
+    void
+    Next(std::string& data, uint64_t sequenceNumber);
+
+    /**
+     * @brief Append the consecutive data blocks starting with the specified sequence number to the specified slices,
+     * to be packed into a single message.
+     *
+     * @param slices The slices to append the data blocks to.
+     * @param sequenceNumber The sequence number of the first data block, starting at 1.
+     * @param numberOfDataBlocks The number of data blocks to append.
+     */
+    void
+    NextSlices(std::vector<grpc::Slice>& slices, uint64_t sequenceNumber, std::size_t numberOfDataBlocks);
+
+    /**
+     * @brief Set the content of the specified data to the consecutive data blocks starting with the specified sequence
+     * number, to be packed into a single message.
+     *
+     * @param data The data to set. Its existing storage is reused.
+     * @param sequenceNumber The sequence number of the first data block, starting at 1.
+     * @param numberOfDataBlocks The number of data blocks to set.
+     */
+    void
+    Next(std::string& data, uint64_t sequenceNumber, std::size_t numberOfDataBlocks);
+
+private:
+    std::size_t m_dataBlockSize{};
+    DataBlockPool m_dataBlockPool{};
+    Microsoft::Net::Remote::DataStream::RandomDataGenerator m_randomDataGenerator{};
+    std::optional<Microsoft::Net::Remote::DataStream::DataPatternGenerator> m_dataPatternGenerator{};
+};
+
+/**
+ * @brief Schedules the writes of a reactor to honor the target bitrate and the duration of a data stream, and
+ * coordinates completion of the RPC with writes scheduled for later.
+ *
+ * Writes that must wait for the target bitrate are deferred using an alarm rather than blocking a gRPC thread. The RPC
+ * must not be finished while an alarm is pending since the reactor may be destroyed before it fires, so requests to
+ * finish the RPC are deferred until the alarm has fired (or has been canceled).
  */
-class DataGenerator
+class WriteScheduler
 {
 public:
-    static constexpr std::size_t DefaultDataLength{ 8 };
+    /**
+     * @brief The maximum duration of data that may be written in a burst when writes are paced.
+     */
+    static constexpr auto BurstDuration{ std::chrono::milliseconds(10) };
+
+    /**
+     * @brief Construct a new WriteScheduler object.
+     *
+     * @param write The function to invoke to write the next data block.
+     * @param finish The function to invoke to finish the RPC. It is invoked at most once.
+     */
+    WriteScheduler(std::function<void()> write, std::function<void(const grpc::Status&)> finish);
+
+    /**
+     * @brief Configure pacing and the stream duration. Both are disabled until this is called.
+     *
+     * @param targetBitrate The target rate of data written, in bits per second, or 0 to write as fast as possible.
+     * @param duration The duration after which to stop writing, if any.
+     * @param dataBlockSize The size of each data block, in bytes.
+     */
+    void
+    Configure(uint64_t targetBitrate, std::optional<std::chrono::steady_clock::duration> duration, std::size_t dataBlockSize);
+
+    /**
+     * @brief Write the next data block now, or later if required by the target bitrate. If the stream duration has
+     * elapsed, the RPC is finished instead.
+     *
+     * @param numberOfBytes The number of bytes to be written.
+     */
+    void
+    ScheduleWrite(std::size_t numberOfBytes);
 
     /**
-     * @brief Construct a DataGenerator object.
+     * @brief Finish the RPC with the specified status, if not already finished. If a write is scheduled, it is
+     * canceled and the RPC is finished once its alarm fires.
      *
+     * @param status The status to finish the RPC with.
      */
-    explicit DataGenerator();
+    void
+    TryFinish(const grpc::Status& status);
 
     /**
-     * @brief Generate a random data string of the specified length.
+     * @brief Determine whether the RPC was finished.
      *
-     * @param length The length of the random data string.
-     * @return std::string
+     * @return true If the RPC was finished.
+     * @return false Otherwise.
      */
-    std::string
-    GenerateRandomData(const std::size_t length = DefaultDataLength);
+    bool
+    IsFinished() const noexcept;
 
 private:
     /**
-     * @brief Generate a random byte of data.
+     * @brief Callback that is executed when the alarm for a scheduled write fires or is canceled.
      *
-     * @return uint8_t
+     * @param isOk Indicates whether the alarm fired (true) or was canceled (false).
      */
-    uint8_t
-    GetRandomByte();
+    void
+    OnAlarm(bool isOk);
 
 private:
-    std::mt19937 m_generator{};
+    std::function<void()> m_write;
+    std::function<void(const grpc::Status&)> m_finish;
+    std::optional<Microsoft::Net::Remote::DataStream::TokenBucket> m_tokenBucket{};
+    std::optional<std::chrono::steady_clock::time_point> m_timeEnd{};
+    std::optional<grpc::Alarm> m_alarm{};
+    std::optional<grpc::Status> m_finishStatusDeferred{};
+    std::atomic<bool> m_isFinished{};
+    bool m_isWriteScheduled{ false };
+    std::mutex m_scheduleGate{};
+};
+
+/**
+ * @brief Records the time gRPC takes to complete each write of a reactor, from StartWrite() to OnWriteDone(). Since a
+ * write only completes once the transport accepts it, this delay is the most direct measure of backpressure.
+ *
+ * Bidirectional reactors may finish the RPC on the read path while a write completes, so this class is thread-safe.
+ */
+class WriteCompletionLatencyRecorder
+{
+public:
+    /**
+     * @brief Record that a write was started.
+     */
+    void
+    OnWriteStarted();
+
+    /**
+     * @brief Record that the write last started completed successfully.
+     */
+    void
+    OnWriteCompleted();
+
+    /**
+     * @brief Add the latencies recorded so far to the trailing metadata of the RPC. This must be called before
+     * finishing the RPC.
+     *
+     * @param context The context of the RPC.
+     */
+    void
+    AddToTrailingMetadata(grpc::CallbackServerContext& context) const;
+
+    /**
+     * @brief Add the latencies recorded so far to the server-wide metrics. This should be called once, when finishing
+     * the RPC.
+     *
+     * @param streamMetrics The server-wide metrics.
+     */
+    void
+    AddToStreamMetrics(Microsoft::Net::Remote::DataStream::StreamMetrics& streamMetrics) const;
+
+private:
+    mutable std::mutex m_latencyGate{};
+    std::chrono::steady_clock::time_point m_timeWriteStarted{};
+    Microsoft::Net::Remote::DataStream::Histogram m_latency{};
+};
+
+/**
+ * @brief Reactor that immediately finishes an RPC with the specified status, used to reject data streams that were not
+ * admitted without allocating any of their resources.
+ *
+ * @tparam ReactorT The type of reactor expected by the RPC.
+ */
+template <typename ReactorT>
+class StreamRejector :
+    public ReactorT
+{
+public:
+    /**
+     * @brief Construct a new StreamRejector object, finishing the RPC with the specified status.
+     *
+     * @param status The status to finish the RPC with.
+     */
+    explicit StreamRejector(const grpc::Status& status)
+    {
+        this->Finish(status);
+    }
+
+    /**
+     * @brief Callback that is executed when all RPC operations are completed for a given RPC.
+     */
+    void
+    OnDone() override
+    {
+        delete this;
+    }
 };
 } // namespace Microsoft::Net::Remote::Service::Reactors::Helpers
 
@@ -62,8 +368,10 @@ public:
      * @brief Construct a new DataStreamReader object with the specified data stream upload result output parameter.
      *
      * @param result The result of the data stream read operation.
+     * @param sessionManager The manager of sessions the stream may be attached to.
+     * @param admissionTicket The admission of the stream, held until the reactor is destroyed.
      */
-    explicit DataStreamReader(Microsoft::Net::Remote::DataStream::DataStreamUploadResult* result);
+    DataStreamReader(Microsoft::Net::Remote::DataStream::DataStreamUploadResult* result, Microsoft::Net::Remote::DataStream::SessionManager& sessionManager, Microsoft::Net::Remote::DataStream::StreamAdmissionTicket admissionTicket);
 
     /**
      * @brief Callback that is executed when a read operation is completed.
@@ -85,26 +393,50 @@ public:
     void
     OnDone() override;
 
+private:
+    /**
+     * @brief Transfer the status and statistics of the data stream to the result.
+     */
+    void
+    UpdateResult();
+
 private:
     Microsoft::Net::Remote::DataStream::DataStreamUploadData m_data{};
     Microsoft::Net::Remote::DataStream::DataStreamUploadResult* m_result{};
     uint32_t m_numberOfDataBlocksReceived{};
+    uint32_t m_numberOfDataBlocksCorrupted{};
+    Microsoft::Net::Remote::DataStream::ReceiveStatistics m_receiveStatistics{};
+    Microsoft::Net::Remote::DataStream::SequenceTracker m_sequenceTracker{};
     Microsoft::Net::Remote::DataStream::DataStreamOperationStatus m_readStatus{};
+    std::optional<Microsoft::Net::Remote::DataStream::DataPatternGenerator> m_dataPatternVerifier{};
+    Microsoft::Net::Remote::DataStream::SessionManager& m_sessionManager;
+    std::shared_ptr<Microsoft::Net::Remote::DataStream::SessionStream> m_sessionStream{};
+    Microsoft::Net::Remote::DataStream::StreamAdmissionTicket m_admissionTicket;
 };
 
 /**
  * @brief Implementation of the gRPC ServerWriteReactor for server-side data stream writing.
+ *
+ * Messages are written pre-serialized: each consists of a small, per-message header slice followed by the data block
+ * slices, which are shared with the data block pool rather than copied. See DataStreamDownloadDataEncoder. Several data
+ * blocks may be packed into each message (see DataStreamProperties.DataBlocksPerMessage), which amortizes the per-message
+ * cost of gRPC over more data when data blocks are small.
  */
 class DataStreamWriter :
-    public grpc::ServerWriteReactor<Microsoft::Net::Remote::DataStream::DataStreamDownloadData>
+    public grpc::ServerWriteReactor<grpc::ByteBuffer>
 {
 public:
     /**
      * @brief Construct a new DataStreamWriter object with the specified download request.
      *
-     * @param request The download request from the client.
+     * @param context The context of the RPC.
+     * @param request The serialized DataStreamDownloadRequest from the client.
+     * @param sessionManager The manager of sessions the stream may be attached to.
+     * @param streamMetrics The server-wide metrics the stream contributes to.
+     * @param admissionTicket The admission of the stream, held until the reactor is destroyed. The message buffered for
+     * writing is reserved with it, and the RPC fails with grpc::StatusCode::RESOURCE_EXHAUSTED if that is not possible.
      */
-    explicit DataStreamWriter(const Microsoft::Net::Remote::DataStream::DataStreamDownloadRequest* request);
+    DataStreamWriter(grpc::CallbackServerContext* context, const grpc::ByteBuffer* request, Microsoft::Net::Remote::DataStream::SessionManager& sessionManager, Microsoft::Net::Remote::DataStream::StreamMetrics& streamMetrics, Microsoft::Net::Remote::DataStream::StreamAdmissionTicket admissionTicket);
 
     /**
      * @brief Callback that is executed when a write operation is completed.
@@ -133,6 +465,28 @@ private:
     void
     NextWrite();
 
+    /**
+     * @brief Determine the number of data blocks to pack into the next message.
+     *
+     * @return uint32_t
+     */
+    uint32_t
+    GetNumberOfDataBlocksInNextMessage() const noexcept;
+
+    /**
+     * @brief Write the next data blocks to the client, packed into a single message.
+     */
+    void
+    Write();
+
+    /**
+     * @brief Finish the RPC, returning the write completion latencies in its trailing metadata.
+     *
+     * @param status The status to finish the RPC with.
+     */
+    void
+    Complete(const grpc::Status& status);
+
     /**
      * @brief Handle a failed operation.
      *
@@ -142,28 +496,48 @@ private:
     HandleFailure(const std::string& errorMessage);
 
 private:
-    Microsoft::Net::Remote::DataStream::DataStreamDownloadData m_data{};
+    Microsoft::Net::Remote::DataStream::DataStreamDownloadData m_dataHeader{};
+    grpc::ByteBuffer m_data{};
+    std::vector<grpc::Slice> m_dataSlices{};
     Microsoft::Net::Remote::DataStream::DataStreamProperties m_dataStreamProperties{};
     uint32_t m_numberOfDataBlocksToStream{};
     uint32_t m_numberOfDataBlocksWritten{};
+    uint32_t m_numberOfDataBlocksInMessage{};
+    uint32_t m_dataBlocksPerMessage{ 1 };
+    std::size_t m_dataBlockSize{};
     Microsoft::Net::Remote::DataStream::DataStreamOperationStatus m_writeStatus{};
     std::atomic<bool> m_isCanceled{};
-    std::atomic<bool> m_isCompleted{};
-    Microsoft::Net::Remote::Service::Reactors::Helpers::DataGenerator m_dataGenerator{};
+    Microsoft::Net::Remote::Service::Reactors::Helpers::DataBlockSource m_dataBlockSource{};
+    Microsoft::Net::Remote::Service::Reactors::Helpers::WriteScheduler m_writeScheduler;
+    Microsoft::Net::Remote::Service::Reactors::Helpers::WriteCompletionLatencyRecorder m_writeCompletionLatencyRecorder{};
+    std::shared_ptr<Microsoft::Net::Remote::DataStream::SessionStream> m_sessionStream{};
+    grpc::CallbackServerContext* m_context;
+    Microsoft::Net::Remote::DataStream::StreamMetrics& m_streamMetrics;
+    Microsoft::Net::Remote::DataStream::StreamAdmissionTicket m_admissionTicket;
 };
 
 /**
  * @brief Implementation of the gRPC ServerBidiReactor for server-side data stream reading and writing.
+ *
+ * By default, data is written independently of the data read. With DataStreamBidirectionalModeEcho, each data block
+ * read is instead written back with its client sequence number and server receive/send timestamps, allowing the client
+ * to measure per-message round-trip and server residence times.
  */
 class DataStreamReaderWriter :
     public grpc::ServerBidiReactor<Microsoft::Net::Remote::DataStream::DataStreamUploadData, Microsoft::Net::Remote::DataStream::DataStreamDownloadData>
 {
 public:
     /**
-     * @brief Construct a new DataStreamReaderWriter object.
+     * @brief Construct a new DataStreamReaderWriter object. Writing data to the client starts once the first message
+     * is received from the client, since it may carry the properties to use for the written data.
      *
+     * @param context The context of the RPC.
+     * @param sessionManager The manager of sessions the stream may be attached to.
+     * @param streamMetrics The server-wide metrics the stream contributes to.
+     * @param admissionTicket The admission of the stream, held until the reactor is destroyed. The message buffered for
+     * writing is reserved with it, and the RPC fails with grpc::StatusCode::RESOURCE_EXHAUSTED if that is not possible.
      */
-    explicit DataStreamReaderWriter();
+    DataStreamReaderWriter(grpc::CallbackServerContext* context, Microsoft::Net::Remote::DataStream::SessionManager& sessionManager, Microsoft::Net::Remote::DataStream::StreamMetrics& streamMetrics, Microsoft::Net::Remote::DataStream::StreamAdmissionTicket admissionTicket);
 
     /**
      * @brief Callback that is executed when a read operation is completed.
@@ -194,12 +568,45 @@ public:
     OnDone() override;
 
 private:
+    /**
+     * @brief Apply the data stream properties sent by the client in the first message and start writing data.
+     *
+     * @param dataStreamProperties The properties sent by the client.
+     * @return true If writing was started.
+     * @return false If the properties were invalid. In this case, a failure has been reported to the client.
+     */
+    bool
+    StartWrites(const Microsoft::Net::Remote::DataStream::DataStreamProperties& dataStreamProperties);
+
     /**
      * @brief Facilitate the next write operation.
      */
     void
     NextWrite();
 
+    /**
+     * @brief Write the next data blocks to the client, packed into a single message.
+     */
+    void
+    Write();
+
+    /**
+     * @brief Write the data block that was just read back to the client, along with its sequence number and the time
+     * it was received. The next read is started once the write completes.
+     *
+     * @param timeReceived The time the data block was received.
+     */
+    void
+    Echo(std::chrono::system_clock::time_point timeReceived);
+
+    /**
+     * @brief Finish the RPC, returning the write completion latencies in its trailing metadata.
+     *
+     * @param status The status to finish the RPC with.
+     */
+    void
+    Complete(const grpc::Status& status);
+
     /**
      * @brief Handle a failed operation.
      *
@@ -211,12 +618,113 @@ private:
 private:
     Microsoft::Net::Remote::DataStream::DataStreamUploadData m_readData{};
     Microsoft::Net::Remote::DataStream::DataStreamDownloadData m_writeData{};
+    Microsoft::Net::Remote::DataStream::DataStreamProperties m_dataStreamProperties{};
     uint32_t m_numberOfDataBlocksReceived{};
     uint32_t m_numberOfDataBlocksWritten{};
+    uint32_t m_dataBlocksPerMessage{ 1 };
+    std::size_t m_dataBlockSize{};
     Microsoft::Net::Remote::DataStream::DataStreamOperationStatus m_status{};
     std::atomic<bool> m_isCanceled{};
     std::atomic<bool> m_readsDone{};
-    Microsoft::Net::Remote::Service::Reactors::Helpers::DataGenerator m_dataGenerator{};
+    bool m_isEchoMode{ false };
+    Microsoft::Net::Remote::DataStream::SessionManager& m_sessionManager;
+    Microsoft::Net::Remote::Service::Reactors::Helpers::DataBlockSource m_dataBlockSource{};
+    Microsoft::Net::Remote::Service::Reactors::Helpers::WriteScheduler m_writeScheduler;
+    Microsoft::Net::Remote::Service::Reactors::Helpers::WriteCompletionLatencyRecorder m_writeCompletionLatencyRecorder{};
+    std::shared_ptr<Microsoft::Net::Remote::DataStream::SessionStream> m_sessionStream{};
+    grpc::CallbackServerContext* m_context;
+    Microsoft::Net::Remote::DataStream::StreamMetrics& m_streamMetrics;
+    Microsoft::Net::Remote::DataStream::StreamAdmissionTicket m_admissionTicket;
+};
+
+/**
+ * @brief Implementation of the gRPC ServerBidiReactor for server-side latency probing.
+ *
+ * Each ping read is answered with the time it was received and the time the response was sent. The next ping is read
+ * once the response is written, so exactly one operation is pending at any time, and its failure completes the RPC.
+ */
+class DataStreamLatencyProber :
+    public grpc::ServerBidiReactor<Microsoft::Net::Remote::DataStream::DataStreamPingRequest, Microsoft::Net::Remote::DataStream::DataStreamPingResponse>
+{
+public:
+    /**
+     * @brief Construct a new DataStreamLatencyProber object and start reading pings.
+     */
+    explicit DataStreamLatencyProber();
+
+    /**
+     * @brief Callback that is executed when a read operation is completed.
+     *
+     * @param isOk Indicates whether a message was read as expected.
+     */
+    void
+    OnReadDone(bool isOk) override;
+
+    /**
+     * @brief Callback that is executed when a write operation is completed.
+     *
+     * @param isOk Indicates whether a write was successfully sent.
+     */
+    void
+    OnWriteDone(bool isOk) override;
+
+    /**
+     * @brief Callback that is executed when all RPC operations are completed for a given RPC.
+     */
+    void
+    OnDone() override;
+
+private:
+    Microsoft::Net::Remote::DataStream::DataStreamPingRequest m_request{};
+    Microsoft::Net::Remote::DataStream::DataStreamPingResponse m_response{};
+};
+
+/**
+ * @brief Implementation of the gRPC ServerUnaryReactor for latency under load tests.
+ *
+ * The test blocks for its whole duration, so it runs on a thread of its own rather than on a gRPC callback thread.
+ * Cancelling the RPC stops the test early.
+ */
+class DataStreamLatencyUnderLoadRunner :
+    public grpc::ServerUnaryReactor
+{
+public:
+    /**
+     * @brief Construct a new DataStreamLatencyUnderLoadRunner object and start the test.
+     *
+     * @param address The address of the netremote server at the other end of the link.
+     * @param configuration The configuration of the test.
+     * @param result The result message to populate once the test completes.
+     * @param admissionTicket The ticket admitting the test, which is held until the RPC is done.
+     */
+    DataStreamLatencyUnderLoadRunner(std::string address, Microsoft::Net::Remote::DataStreamLatencyUnderLoadConfiguration configuration, Microsoft::Net::Remote::DataStream::DataStreamLatencyUnderLoadResult* result, Microsoft::Net::Remote::DataStream::StreamAdmissionTicket admissionTicket);
+
+    /**
+     * @brief Callback that is executed when the RPC is cancelled.
+     */
+    void
+    OnCancel() override;
+
+    /**
+     * @brief Callback that is executed when all RPC operations are completed for a given RPC.
+     */
+    void
+    OnDone() override;
+
+private:
+    /**
+     * @brief Run the test and complete the RPC with its result.
+     *
+     * @param stopToken Requests the test to stop early.
+     */
+    void
+    Run(std::stop_token stopToken);
+
+private:
+    Microsoft::Net::Remote::DataStreamLatencyUnderLoad m_latencyUnderLoad;
+    Microsoft::Net::Remote::DataStream::DataStreamLatencyUnderLoadResult* m_result;
+    Microsoft::Net::Remote::DataStream::StreamAdmissionTicket m_admissionTicket;
+    std::jthread m_thread;
 };
 } // namespace Microsoft::Net::Remote::Service::Reactors
 
@@ -1,11 +1,39 @@
 
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <limits>
 #include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
 
-#include <google/protobuf/empty.pb.h>
+#include <google/protobuf/duration.pb.h>
+#include <google/protobuf/util/time_util.h>
 #include <grpcpp/server_context.h>
+#include <grpcpp/support/byte_buffer.h>
 #include <grpcpp/support/server_callback.h>
+#include <grpcpp/support/status.h>
+#include <microsoft/net/remote/DataStreamLatencyUnderLoad.hxx>
+#ifdef NETREMOTE_DATASTREAM_RAW_STREAMS
+#include <microsoft/net/remote/datastream/RawStream.hxx>
+#include <microsoft/net/remote/datastream/RawStreamManager.hxx>
+#endif // NETREMOTE_DATASTREAM_RAW_STREAMS
+#include <microsoft/net/remote/datastream/Session.hxx>
+#include <microsoft/net/remote/datastream/SessionManager.hxx>
+#include <microsoft/net/remote/datastream/StreamAdmission.hxx>
+#include <microsoft/net/remote/datastream/StreamMetrics.hxx>
 #include <microsoft/net/remote/protocol/NetRemoteDataStream.pb.h>
+#include <microsoft/net/remote/protocol/NetRemoteProtocol.hxx>
 #include <microsoft/net/remote/service/NetRemoteDataStreamingService.hxx>
+#include <microsoft/net/wifi/AccessPointManager.hxx>
+#include <microsoft/net/wifi/IAccessPoint.hxx>
+#include <plog/Log.h>
 
 #include "NetRemoteApiTrace.hxx"
 #include "NetRemoteDataStreamingReactors.hxx"
@@ -14,37 +42,687 @@ using namespace Microsoft::Net::Remote::DataStream;
 using namespace Microsoft::Net::Remote::Service;
 using namespace Microsoft::Net::Remote::Service::Tracing;
 
+namespace detail
+{
+/**
+ * @brief Create the status that data streams rejected by admission control fail with.
+ *
+ * @return grpc::Status
+ */
+grpc::Status
+CreateStreamRejectedStatus()
+{
+    return { grpc::StatusCode::RESOURCE_EXHAUSTED, "Maximum number of data streams running" };
+}
+
+/**
+ * @brief Create the status that latency under load tests fail with when another test is already running.
+ *
+ * @return grpc::Status
+ */
+grpc::Status
+CreateLatencyUnderLoadRejectedStatus()
+{
+    return { grpc::StatusCode::RESOURCE_EXHAUSTED, "Latency under load test already running" };
+}
+
+/**
+ * @brief Convert a session stream direction to its protocol equivalent.
+ *
+ * @param direction The direction to convert.
+ * @return DataStreamSessionStreamDirection
+ */
+DataStreamSessionStreamDirection
+ToDataStreamSessionStreamDirection(SessionStreamDirection direction) noexcept
+{
+    switch (direction) {
+    case SessionStreamDirection::Upload:
+        return DataStreamSessionStreamDirection::DataStreamSessionStreamDirectionUpload;
+    case SessionStreamDirection::Download:
+        return DataStreamSessionStreamDirection::DataStreamSessionStreamDirectionDownload;
+    case SessionStreamDirection::Bidirectional:
+        return DataStreamSessionStreamDirection::DataStreamSessionStreamDirectionBidirectional;
+    default:
+        return DataStreamSessionStreamDirection::DataStreamSessionStreamDirectionUnknown;
+    }
+}
+
+/**
+ * @brief Convert a steady clock duration to a protobuf duration.
+ *
+ * @param duration The duration to convert.
+ * @return google::protobuf::Duration
+ */
+google::protobuf::Duration
+ToDuration(std::chrono::steady_clock::duration duration) noexcept
+{
+    return google::protobuf::util::TimeUtil::NanosecondsToDuration(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+}
+
+/**
+ * @brief Populate a session result message from the result of a session.
+ *
+ * @param sessionResult The result of the session.
+ * @param result The message to populate.
+ */
+void
+ToDataStreamSessionResult(const SessionResult& sessionResult, DataStreamSessionResult& result)
+{
+    result.set_numberofbytesreceived(sessionResult.NumberOfBytesReceived);
+    result.set_numberofbytessent(sessionResult.NumberOfBytesSent);
+    *result.mutable_duration() = ToDuration(sessionResult.Duration);
+    result.set_goodputbitspersecond(sessionResult.GoodputBitsPerSecond);
+    result.set_fairnessindex(sessionResult.FairnessIndex);
+    result.set_numberofstreamsactive(sessionResult.NumberOfStreamsActive);
+
+    for (const auto& streamResult : sessionResult.Streams) {
+        auto& stream = *result.add_streams();
+        stream.set_streamid(streamResult.Id);
+        stream.set_direction(ToDataStreamSessionStreamDirection(streamResult.Direction));
+        stream.set_numberofdatablocksreceived(streamResult.NumberOfDataBlocksReceived);
+        stream.set_numberofbytesreceived(streamResult.NumberOfBytesReceived);
+        stream.set_numberofdatablockssent(streamResult.NumberOfDataBlocksSent);
+        stream.set_numberofbytessent(streamResult.NumberOfBytesSent);
+        *stream.mutable_duration() = ToDuration(streamResult.Duration);
+        stream.set_goodputbitspersecond(streamResult.GoodputBitsPerSecond);
+        stream.set_iscompleted(streamResult.IsCompleted);
+    }
+}
+
+#ifdef NETREMOTE_DATASTREAM_RAW_STREAMS
+/**
+ * @brief Convert a raw stream start request to the configuration of a raw stream.
+ *
+ * @param request The request to convert.
+ * @param errorMessage Describes why the request is invalid, if it is.
+ * @return std::optional<RawStreamConfiguration> The configuration, or std::nullopt if the request is invalid.
+ */
+std::optional<RawStreamConfiguration>
+ToRawStreamConfiguration(const DataStreamRawStartRequest& request, std::string& errorMessage)
+{
+    RawStreamConfiguration configuration{};
+
+    switch (request.protocol()) {
+    case DataStreamRawProtocol::DataStreamRawProtocolTcp:
+        configuration.Protocol = RawStreamProtocol::Tcp;
+        break;
+    case DataStreamRawProtocol::DataStreamRawProtocolUdp:
+        configuration.Protocol = RawStreamProtocol::Udp;
+        break;
+    default:
+        errorMessage = std::format("Invalid raw stream protocol {}", static_cast<int>(request.protocol()));
+        return std::nullopt;
+    }
+
+    switch (request.role()) {
+    case DataStreamRawRole::DataStreamRawRoleSender:
+        configuration.Role = RawStreamRole::Sender;
+        break;
+    case DataStreamRawRole::DataStreamRawRoleReceiver:
+        configuration.Role = RawStreamRole::Receiver;
+        break;
+    default:
+        errorMessage = std::format("Invalid raw stream role {}", static_cast<int>(request.role()));
+        return std::nullopt;
+    }
+
+    switch (request.sendmode()) {
+    case DataStreamRawSendMode::DataStreamRawSendModeCopy:
+        configuration.SendMode = RawStreamSendMode::Copy;
+        break;
+    case DataStreamRawSendMode::DataStreamRawSendModeZeroCopy:
+        configuration.SendMode = RawStreamSendMode::ZeroCopy;
+        break;
+    case DataStreamRawSendMode::DataStreamRawSendModeSendfile:
+        configuration.SendMode = RawStreamSendMode::Sendfile;
+        break;
+    default:
+        errorMessage = std::format("Invalid raw stream send mode {}", static_cast<int>(request.sendmode()));
+        return std::nullopt;
+    }
+
+    switch (request.ioengine()) {
+    case DataStreamRawIoEngine::DataStreamRawIoEngineEpoll:
+        configuration.IoEngine = RawStreamIoEngine::Epoll;
+        break;
+    case DataStreamRawIoEngine::DataStreamRawIoEngineIoUring:
+        configuration.IoEngine = RawStreamIoEngine::IoUring;
+        break;
+    default:
+        errorMessage = std::format("Invalid raw stream I/O engine {}", static_cast<int>(request.ioengine()));
+        return std::nullopt;
+    }
+
+    switch (request.trafficclass()) {
+    case DataStreamRawTrafficClass::DataStreamRawTrafficClassBestEffort:
+        configuration.TrafficClass = RawStreamTrafficClass::BestEffort;
+        break;
+    case DataStreamRawTrafficClass::DataStreamRawTrafficClassBackground:
+        configuration.TrafficClass = RawStreamTrafficClass::Background;
+        break;
+    case DataStreamRawTrafficClass::DataStreamRawTrafficClassVideo:
+        configuration.TrafficClass = RawStreamTrafficClass::Video;
+        break;
+    case DataStreamRawTrafficClass::DataStreamRawTrafficClassVoice:
+        configuration.TrafficClass = RawStreamTrafficClass::Voice;
+        break;
+    default:
+        errorMessage = std::format("Invalid raw stream traffic class {}", static_cast<int>(request.trafficclass()));
+        return std::nullopt;
+    }
+
+    if (request.Binding_case() == DataStreamRawStartRequest::kInterfaceName) {
+        configuration.InterfaceName = request.interfacename();
+    }
+
+    if (request.port() > std::numeric_limits<uint16_t>::max()) {
+        errorMessage = std::format("Invalid raw stream port {}", request.port());
+        return std::nullopt;
+    }
+
+    configuration.Address = request.address();
+    configuration.Port = static_cast<uint16_t>(request.port());
+    configuration.DataBlockSize = request.datablocksize();
+    configuration.TargetBitrate = request.targetbitrate();
+    if (request.has_duration()) {
+        configuration.Duration = std::chrono::milliseconds(google::protobuf::util::TimeUtil::DurationToMilliseconds(request.duration()));
+    }
+
+    return configuration;
+}
+
+/**
+ * @brief Populate a raw stream result message from the result of a raw stream.
+ *
+ * @param rawStreamResult The result of the raw stream.
+ * @param result The message to populate.
+ */
+void
+ToDataStreamRawResult(const RawStreamResult& rawStreamResult, DataStreamRawResult& result)
+{
+    result.set_iscompleted(rawStreamResult.IsCompleted);
+    result.set_numberofdatablocks(rawStreamResult.NumberOfDataBlocks);
+    result.set_numberofbytes(rawStreamResult.NumberOfBytes);
+    *result.mutable_duration() = ToDuration(rawStreamResult.Duration);
+    result.set_goodputbitspersecond(rawStreamResult.GoodputBitsPerSecond);
+    result.set_numberofdatablockslost(rawStreamResult.NumberOfDataBlocksLost);
+    result.set_numberofdatablocksduplicated(rawStreamResult.NumberOfDataBlocksDuplicated);
+    result.set_numberofdatablocksoutoforder(rawStreamResult.NumberOfDataBlocksOutOfOrder);
+    result.set_jittermicroseconds(rawStreamResult.JitterMicroseconds);
+    *result.mutable_cputime() = google::protobuf::util::TimeUtil::NanosecondsToDuration(rawStreamResult.CpuTime.count());
+    result.set_cpucyclesperbyte(rawStreamResult.CpuCyclesPerByte);
+    result.set_numberofzerocopysendscompleted(rawStreamResult.NumberOfZeroCopySendsCompleted);
+    result.set_numberofzerocopysendscopied(rawStreamResult.NumberOfZeroCopySendsCopied);
+    result.set_ioengine(rawStreamResult.IoEngine == RawStreamIoEngine::IoUring ? DataStreamRawIoEngine::DataStreamRawIoEngineIoUring : DataStreamRawIoEngine::DataStreamRawIoEngineEpoll);
+    result.set_onewaydelaymicroseconds(rawStreamResult.OneWayDelayMicroseconds);
+}
+
+/**
+ * @brief Convert a RawStreamTrafficClass to its protocol equivalent.
+ *
+ * @param trafficClass The traffic class to convert.
+ * @return DataStreamRawTrafficClass
+ */
+DataStreamRawTrafficClass
+ToDataStreamRawTrafficClass(RawStreamTrafficClass trafficClass) noexcept
+{
+    switch (trafficClass) {
+    case RawStreamTrafficClass::Background:
+        return DataStreamRawTrafficClass::DataStreamRawTrafficClassBackground;
+    case RawStreamTrafficClass::Video:
+        return DataStreamRawTrafficClass::DataStreamRawTrafficClassVideo;
+    case RawStreamTrafficClass::Voice:
+        return DataStreamRawTrafficClass::DataStreamRawTrafficClassVoice;
+    case RawStreamTrafficClass::BestEffort:
+    default:
+        return DataStreamRawTrafficClass::DataStreamRawTrafficClassBestEffort;
+    }
+}
+
+/**
+ * @brief Convert the aggregated results of the raw streams of one traffic class to their protocol equivalent.
+ *
+ * @param trafficClassResult The aggregated results to convert.
+ * @param result The protocol result to populate.
+ */
+void
+ToDataStreamRawTrafficClassResult(const RawStreamTrafficClassResult& trafficClassResult, DataStreamRawTrafficClassResult& result)
+{
+    result.set_trafficclass(ToDataStreamRawTrafficClass(trafficClassResult.TrafficClass));
+    result.set_role(trafficClassResult.Role == RawStreamRole::Sender ? DataStreamRawRole::DataStreamRawRoleSender : DataStreamRawRole::DataStreamRawRoleReceiver);
+    result.set_numberofstreams(trafficClassResult.NumberOfStreams);
+    result.set_numberofdatablocks(trafficClassResult.NumberOfDataBlocks);
+    result.set_numberofbytes(trafficClassResult.NumberOfBytes);
+    result.set_goodputbitspersecond(trafficClassResult.GoodputBitsPerSecond);
+    result.set_numberofdatablockslost(trafficClassResult.NumberOfDataBlocksLost);
+    result.set_jittermicroseconds(trafficClassResult.JitterMicroseconds);
+    result.set_onewaydelaymicroseconds(trafficClassResult.OneWayDelayMicroseconds);
+}
+#endif // NETREMOTE_DATASTREAM_RAW_STREAMS
+
+/**
+ * @brief Determine the address of the server that a latency under load test connects to.
+ *
+ * The address must be of the form host:port; the default port is used if none is specified. If no address is
+ * specified, the server at the default port on the host of the caller is used.
+ *
+ * @param address The address from the request.
+ * @param peer The address of the caller, as reported by gRPC (eg. "ipv4:192.168.1.2:52314").
+ * @param errorMessage Describes why the address is invalid, if it is.
+ * @return std::optional<std::string> The address to connect to, or std::nullopt if the address is invalid.
+ */
+std::optional<std::string>
+ToDataStreamLatencyUnderLoadAddress(std::string_view address, std::string_view peer, std::string& errorMessage)
+{
+    using Microsoft::Net::Remote::Protocol::NetRemoteProtocol;
+
+    std::string serverAddress{};
+    if (std::empty(address)) {
+        // The caller is usually the other end of the link, so default to the netremote server on its host.
+        static constexpr std::string_view PeerPrefixIpv4{ "ipv4:" };
+        static constexpr std::string_view PeerPrefixIpv6{ "ipv6:" };
+        if (!peer.starts_with(PeerPrefixIpv4) && !peer.starts_with(PeerPrefixIpv6)) {
+            errorMessage = std::format("No server address specified and the caller address '{}' is not an IP address", peer);
+            return std::nullopt;
+        }
+        const auto peerAddress = peer.substr(std::size(PeerPrefixIpv4));
+        std::string peerHost{ peerAddress.substr(0, peerAddress.rfind(NetRemoteProtocol::PortSeparator)) };
+        // Newer gRPC versions percent-encode the brackets around IPv6 addresses.
+        if (peerHost.starts_with("%5B") && peerHost.ends_with("%5D")) {
+            peerHost = std::format("[{}]", std::string_view{ peerHost }.substr(3, std::size(peerHost) - 6));
+        }
+        serverAddress = std::format("{}{}{}", peerHost, NetRemoteProtocol::PortSeparator, NetRemoteProtocol::PortDefault);
+    } else if (address.find(NetRemoteProtocol::PortSeparator) == std::string_view::npos) {
+        serverAddress = std::format("{}{}{}", address, NetRemoteProtocol::PortSeparator, NetRemoteProtocol::PortDefault);
+    } else {
+        serverAddress = address;
+    }
+
+    const auto portSeparatorPosition = serverAddress.rfind(NetRemoteProtocol::PortSeparator);
+    const std::string_view host{ std::data(serverAddress), portSeparatorPosition };
+    const std::string_view port{ std::data(serverAddress) + portSeparatorPosition + 1, std::size(serverAddress) - portSeparatorPosition - 1 };
+
+    uint16_t portNumber{ 0 };
+    const auto [portEnd, portError] = std::from_chars(std::data(port), std::data(port) + std::size(port), portNumber);
+    const bool isHostBracketed = !std::empty(host) && host.front() == '[' && host.back() == ']';
+    const bool isHostValid = !std::empty(host) && (isHostBracketed || host.find_first_of("[]:") == std::string_view::npos);
+    const bool isPortValid = !std::empty(port) && portError == std::errc{} && portEnd == std::data(port) + std::size(port) && portNumber != 0;
+    if (!isHostValid || !isPortValid) {
+        errorMessage = std::format("Invalid server address '{}'; expected host:port", serverAddress);
+        return std::nullopt;
+    }
+
+    return serverAddress;
+}
+
+/**
+ * @brief Convert a latency under load request to the configuration of the test.
+ *
+ * @param request The request to convert.
+ * @param errorMessage Describes why the request is invalid, if it is.
+ * @return std::optional<Microsoft::Net::Remote::DataStreamLatencyUnderLoadConfiguration> The configuration, or std::nullopt if the request is invalid.
+ */
+std::optional<Microsoft::Net::Remote::DataStreamLatencyUnderLoadConfiguration>
+ToDataStreamLatencyUnderLoadConfiguration(const DataStreamLatencyUnderLoadRequest& request, std::string& errorMessage)
+{
+    using Microsoft::Net::Remote::DataStreamDirection;
+
+    Microsoft::Net::Remote::DataStreamLatencyUnderLoadConfiguration configuration{};
+
+    switch (request.direction()) {
+    case DataStreamLoadDirection::DataStreamLoadDirectionUpload:
+        configuration.Direction = DataStreamDirection::Upload;
+        break;
+    case DataStreamLoadDirection::DataStreamLoadDirectionDownload:
+        configuration.Direction = DataStreamDirection::Download;
+        break;
+    case DataStreamLoadDirection::DataStreamLoadDirectionBidirectional:
+        configuration.Direction = DataStreamDirection::Bidirectional;
+        break;
+    default:
+        errorMessage = std::format("Invalid load direction {}", static_cast<int>(request.direction()));
+        return std::nullopt;
+    }
+
+    if (request.numberofstreams() != 0) {
+        configuration.NumberOfStreams = request.numberofstreams();
+    }
+    if (request.datablocksize() != 0) {
+        configuration.DataBlockSize = request.datablocksize();
+    }
+    if (request.has_idleduration()) {
+        configuration.IdleDuration = std::chrono::milliseconds(google::protobuf::util::TimeUtil::DurationToMilliseconds(request.idleduration()));
+    }
+    if (request.has_loadedduration()) {
+        configuration.LoadedDuration = std::chrono::milliseconds(google::protobuf::util::TimeUtil::DurationToMilliseconds(request.loadedduration()));
+    }
+    if (request.has_probeinterval()) {
+        configuration.ProbeInterval = std::chrono::milliseconds(google::protobuf::util::TimeUtil::DurationToMilliseconds(request.probeinterval()));
+    }
+
+    return configuration;
+}
+} // namespace detail
+
+NetRemoteDataStreamingService::NetRemoteDataStreamingService(std::shared_ptr<Microsoft::Net::Wifi::AccessPointManager> accessPointManager, StreamAdmissionConfiguration streamAdmissionConfiguration) :
+    m_accessPointManager(std::move(accessPointManager)),
+    m_streamAdmission(streamAdmissionConfiguration)
+{
+}
+
 grpc::ServerReadReactor<DataStreamUploadData>*
 NetRemoteDataStreamingService::DataStreamUpload([[maybe_unused]] grpc::CallbackServerContext* context, DataStreamUploadResult* result)
 {
     const NetRemoteApiTrace traceMe{};
 
-    return std::make_unique<Reactors::DataStreamReader>(result).release();
+    auto admissionTicket = m_streamAdmission.TryAdmit();
+    if (!admissionTicket.has_value()) {
+        return std::make_unique<Reactors::Helpers::StreamRejector<grpc::ServerReadReactor<DataStreamUploadData>>>(detail::CreateStreamRejectedStatus()).release();
+    }
+
+    return std::make_unique<Reactors::DataStreamReader>(result, m_sessionManager, std::move(admissionTicket.value())).release();
 }
 
-grpc::ServerWriteReactor<DataStreamDownloadData>*
-NetRemoteDataStreamingService::DataStreamDownload([[maybe_unused]] grpc::CallbackServerContext* context, const DataStreamDownloadRequest* request)
+grpc::ServerWriteReactor<grpc::ByteBuffer>*
+NetRemoteDataStreamingService::DataStreamDownload(grpc::CallbackServerContext* context, const grpc::ByteBuffer* request)
 {
     const NetRemoteApiTrace traceMe{};
 
-    return std::make_unique<Reactors::DataStreamWriter>(request).release();
+    auto admissionTicket = m_streamAdmission.TryAdmit();
+    if (!admissionTicket.has_value()) {
+        return std::make_unique<Reactors::Helpers::StreamRejector<grpc::ServerWriteReactor<grpc::ByteBuffer>>>(detail::CreateStreamRejectedStatus()).release();
+    }
+
+    return std::make_unique<Reactors::DataStreamWriter>(context, request, m_sessionManager, m_streamMetrics, std::move(admissionTicket.value())).release();
 }
 
 grpc::ServerBidiReactor<DataStreamUploadData, DataStreamDownloadData>*
-NetRemoteDataStreamingService::DataStreamBidirectional([[maybe_unused]] grpc::CallbackServerContext* context)
+NetRemoteDataStreamingService::DataStreamBidirectional(grpc::CallbackServerContext* context)
+{
+    const NetRemoteApiTrace traceMe{};
+
+    auto admissionTicket = m_streamAdmission.TryAdmit();
+    if (!admissionTicket.has_value()) {
+        return std::make_unique<Reactors::Helpers::StreamRejector<grpc::ServerBidiReactor<DataStreamUploadData, DataStreamDownloadData>>>(detail::CreateStreamRejectedStatus()).release();
+    }
+
+    return std::make_unique<Reactors::DataStreamReaderWriter>(context, m_sessionManager, m_streamMetrics, std::move(admissionTicket.value())).release();
+}
+
+grpc::ServerUnaryReactor*
+NetRemoteDataStreamingService::DataStreamPing(grpc::CallbackServerContext* context, const DataStreamPingRequest* request, DataStreamPingResponse* response)
+{
+    const NetRemoteApiTrace traceMe{};
+
+    *response->mutable_receivetime() = google::protobuf::util::TimeUtil::GetCurrentTime();
+    response->set_sequencenumber(request->sequencenumber());
+    *response->mutable_requestsendtime() = request->sendtime();
+    *response->mutable_sendtime() = google::protobuf::util::TimeUtil::GetCurrentTime();
+
+    auto* reactor = context->DefaultReactor();
+    reactor->Finish(grpc::Status::OK);
+
+    return reactor;
+}
+
+grpc::ServerBidiReactor<DataStreamPingRequest, DataStreamPingResponse>*
+NetRemoteDataStreamingService::DataStreamLatencyProbe([[maybe_unused]] grpc::CallbackServerContext* context)
+{
+    const NetRemoteApiTrace traceMe{};
+
+    return std::make_unique<Reactors::DataStreamLatencyProber>().release();
+}
+
+grpc::ServerUnaryReactor*
+NetRemoteDataStreamingService::DataStreamSessionCreate(grpc::CallbackServerContext* context, [[maybe_unused]] const DataStreamSessionCreateRequest* request, DataStreamSessionCreateResult* result)
+{
+    const NetRemoteApiTrace traceMe{};
+
+    DataStreamOperationStatus status{};
+    const auto session = m_sessionManager.Create();
+    if (session == nullptr) {
+        status.set_code(DataStreamOperationStatusCode::DataStreamOperationStatusCodeFailed);
+        status.set_message(std::format("Maximum number of sessions ({}) reached", SessionManager::NumberOfSessionsMaximum));
+    } else {
+        status.set_code(DataStreamOperationStatusCode::DataStreamOperationStatusCodeSucceeded);
+        result->set_sessionid(session->GetId());
+    }
+
+    *result->mutable_status() = std::move(status);
+
+    auto* reactor = context->DefaultReactor();
+    reactor->Finish(grpc::Status::OK);
+
+    return reactor;
+}
+
+grpc::ServerUnaryReactor*
+NetRemoteDataStreamingService::DataStreamSessionGetResult(grpc::CallbackServerContext* context, const DataStreamSessionResultRequest* request, DataStreamSessionResult* result)
+{
+    const NetRemoteApiTrace traceMe{};
+
+    DataStreamOperationStatus status{};
+    const auto session = m_sessionManager.Find(request->sessionid());
+    if (session == nullptr) {
+        status.set_code(DataStreamOperationStatusCode::DataStreamOperationStatusCodeFailed);
+        status.set_message(std::format("Session {} not found", request->sessionid()));
+    } else {
+        if (request->close()) {
+            m_sessionManager.Remove(request->sessionid());
+        }
+
+        detail::ToDataStreamSessionResult(session->GetResult(), *result);
+        status.set_code(DataStreamOperationStatusCode::DataStreamOperationStatusCodeSucceeded);
+    }
+
+    result->set_sessionid(request->sessionid());
+    *result->mutable_status() = std::move(status);
+
+    auto* reactor = context->DefaultReactor();
+    reactor->Finish(grpc::Status::OK);
+
+    return reactor;
+}
+
+#ifdef NETREMOTE_DATASTREAM_RAW_STREAMS
+grpc::ServerUnaryReactor*
+NetRemoteDataStreamingService::DataStreamRawStart(grpc::CallbackServerContext* context, const DataStreamRawStartRequest* request, DataStreamRawStartResult* result)
+{
+    const NetRemoteApiTrace traceMe{};
+
+    auto* reactor = context->DefaultReactor();
+    const bool submitted = m_rawStreamOperationExecutor.TrySubmit([this, reactor, request, result] {
+        DataStreamOperationStatus status{};
+        std::string errorMessage{};
+        auto configuration = detail::ToRawStreamConfiguration(*request, errorMessage);
+        if (configuration.has_value() && request->Binding_case() == DataStreamRawStartRequest::kAccessPointId) {
+            errorMessage = TryGetAccessPointInterfaceName(request->accesspointid(), configuration->InterfaceName);
+            if (!std::empty(errorMessage)) {
+                configuration.reset();
+            }
+        }
+
+        if (!configuration.has_value()) {
+            status.set_code(DataStreamOperationStatusCode::DataStreamOperationStatusCodeFailed);
+            status.set_message(std::move(errorMessage));
+        } else if (const auto rawStream = m_rawStreamManager.Create(std::move(configuration.value())); rawStream == nullptr) {
+            status.set_code(DataStreamOperationStatusCode::DataStreamOperationStatusCodeFailed);
+            status.set_message(std::format("Maximum number of raw streams ({}) reached", RawStreamManager::NumberOfRawStreamsMaximum));
+        } else if (!rawStream->Start()) {
+            m_rawStreamManager.Remove(rawStream->GetId());
+            status.set_code(DataStreamOperationStatusCode::DataStreamOperationStatusCodeFailed);
+            status.set_message(rawStream->GetResult().ErrorMessage);
+        } else {
+            status.set_code(DataStreamOperationStatusCode::DataStreamOperationStatusCodeSucceeded);
+            result->set_id(rawStream->GetId());
+            result->set_port(rawStream->GetPort());
+        }
+
+        *result->mutable_status() = std::move(status);
+        reactor->Finish(grpc::Status::OK);
+    });
+
+    if (!submitted) {
+        LOGW << "Raw stream operation queue is full; rejecting start request";
+        reactor->Finish(grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED, "Too many raw stream operations pending"));
+    }
+
+    return reactor;
+}
+
+grpc::ServerUnaryReactor*
+NetRemoteDataStreamingService::DataStreamRawGetResult(grpc::CallbackServerContext* context, const DataStreamRawResultRequest* request, DataStreamRawResult* result)
 {
     const NetRemoteApiTrace traceMe{};
 
-    return std::make_unique<Reactors::DataStreamReaderWriter>().release();
+    auto* reactor = context->DefaultReactor();
+    const auto getResult = [this, reactor, request, result] {
+        DataStreamOperationStatus status{};
+        const auto rawStream = m_rawStreamManager.Find(request->id());
+        if (rawStream == nullptr) {
+            status.set_code(DataStreamOperationStatusCode::DataStreamOperationStatusCodeFailed);
+            status.set_message(std::format("Raw stream {} not found", request->id()));
+        } else {
+            if (request->stop()) {
+                rawStream->Stop();
+            }
+
+            const auto rawStreamResult = rawStream->GetResult();
+            detail::ToDataStreamRawResult(rawStreamResult, *result);
+            if (std::empty(rawStreamResult.ErrorMessage)) {
+                status.set_code(DataStreamOperationStatusCode::DataStreamOperationStatusCodeSucceeded);
+            } else {
+                status.set_code(DataStreamOperationStatusCode::DataStreamOperationStatusCodeFailed);
+                status.set_message(rawStreamResult.ErrorMessage);
+            }
+
+            if (request->close()) {
+                m_rawStreamManager.Remove(request->id());
+            }
+        }
+
+        result->set_id(request->id());
+        *result->mutable_status() = std::move(status);
+        reactor->Finish(grpc::Status::OK);
+    };
+
+    // Closing a stream may release the last reference to it, which waits for its thread to exit, so is done on the
+    // executor.
+    if (!request->close()) {
+        getResult();
+    } else if (!m_rawStreamOperationExecutor.TrySubmit(getResult)) {
+        LOGW << "Raw stream operation queue is full; rejecting close request";
+        reactor->Finish(grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED, "Too many raw stream operations pending"));
+    }
+
+    return reactor;
 }
 
 grpc::ServerUnaryReactor*
-NetRemoteDataStreamingService::DataStreamPing(grpc::CallbackServerContext* context, [[maybe_unused]] const google::protobuf::Empty* request, [[maybe_unused]] google::protobuf::Empty* response)
+NetRemoteDataStreamingService::DataStreamRawGetTrafficClassResults(grpc::CallbackServerContext* context, const DataStreamRawTrafficClassResultRequest* request, DataStreamRawTrafficClassResults* result)
 {
     const NetRemoteApiTrace traceMe{};
 
+    DataStreamOperationStatus status{};
+    status.set_code(DataStreamOperationStatusCode::DataStreamOperationStatusCodeSucceeded);
+
+    std::vector<std::shared_ptr<RawStream>> rawStreams{};
+    rawStreams.reserve(static_cast<std::size_t>(request->ids_size()));
+    for (const auto& id : request->ids()) {
+        auto rawStream = m_rawStreamManager.Find(id);
+        if (rawStream == nullptr) {
+            status.set_code(DataStreamOperationStatusCode::DataStreamOperationStatusCodeFailed);
+            status.set_message(std::format("Raw stream {} not found", id));
+            break;
+        }
+        rawStreams.push_back(std::move(rawStream));
+    }
+
+    if (status.code() == DataStreamOperationStatusCode::DataStreamOperationStatusCodeSucceeded) {
+        for (const auto& trafficClassResult : RawStream::GetTrafficClassResults(rawStreams)) {
+            detail::ToDataStreamRawTrafficClassResult(trafficClassResult, *result->add_trafficclasses());
+        }
+    }
+
+    *result->mutable_status() = std::move(status);
+
     auto* reactor = context->DefaultReactor();
     reactor->Finish(grpc::Status::OK);
 
     return reactor;
 }
+#endif // NETREMOTE_DATASTREAM_RAW_STREAMS
+
+grpc::ServerUnaryReactor*
+NetRemoteDataStreamingService::DataStreamLatencyUnderLoad(grpc::CallbackServerContext* context, const DataStreamLatencyUnderLoadRequest* request, DataStreamLatencyUnderLoadResult* result)
+{
+    const NetRemoteApiTrace traceMe{};
+
+    std::string errorMessage{};
+    auto configuration = detail::ToDataStreamLatencyUnderLoadConfiguration(*request, errorMessage);
+    auto address = configuration.has_value() ? detail::ToDataStreamLatencyUnderLoadAddress(request->address(), context->peer(), errorMessage) : std::nullopt;
+    if (!configuration.has_value() || !address.has_value()) {
+        LOGW << std::format("Invalid latency under load request: {}", errorMessage);
+        DataStreamOperationStatus status{};
+        status.set_code(DataStreamOperationStatusCode::DataStreamOperationStatusCodeFailed);
+        status.set_message(std::move(errorMessage));
+        *result->mutable_status() = std::move(status);
+
+        auto* reactor = context->DefaultReactor();
+        reactor->Finish(grpc::Status::OK);
+
+        return reactor;
+    }
+
+    auto admissionTicket = m_latencyUnderLoadAdmission.TryAdmit();
+    if (!admissionTicket.has_value()) {
+        LOGW << "Latency under load test already running; rejecting request";
+        auto* reactor = context->DefaultReactor();
+        reactor->Finish(detail::CreateLatencyUnderLoadRejectedStatus());
+
+        return reactor;
+    }
+
+    return std::make_unique<Reactors::DataStreamLatencyUnderLoadRunner>(std::move(address.value()), std::move(configuration.value()), result, std::move(admissionTicket.value())).release();
+}
+
+grpc::ServerUnaryReactor*
+NetRemoteDataStreamingService::DataStreamGetMetrics(grpc::CallbackServerContext* context, [[maybe_unused]] const DataStreamMetricsRequest* request, DataStreamMetrics* result)
+{
+    const NetRemoteApiTrace traceMe{};
+
+    result->set_numberofstreams(m_streamMetrics.GetNumberOfStreams());
+    *result->mutable_writecompletionlatencymicroseconds() = Reactors::Helpers::ToDataStreamHistogram(m_streamMetrics.GetWriteCompletionLatency());
+    result->set_numberofstreamsactive(m_streamAdmission.GetNumberOfStreams());
+    result->set_numberofstreamsrejected(m_streamAdmission.GetNumberOfStreamsRejected());
+    result->set_numberofbytesinflight(m_streamAdmission.GetNumberOfBytesInFlight());
+    result->mutable_status()->set_code(DataStreamOperationStatusCode::DataStreamOperationStatusCodeSucceeded);
+
+    auto* reactor = context->DefaultReactor();
+    reactor->Finish(grpc::Status::OK);
+
+    return reactor;
+}
+
+#ifdef NETREMOTE_DATASTREAM_RAW_STREAMS
+std::string
+NetRemoteDataStreamingService::TryGetAccessPointInterfaceName(const std::string& accessPointId, std::string& interfaceName) const
+{
+    if (m_accessPointManager == nullptr) {
+        return "Access points are not available";
+    }
+
+    auto accessPointWeak = m_accessPointManager->GetAccessPoint(accessPointId);
+    if (!accessPointWeak.has_value()) {
+        return std::format("Access point {} not found", accessPointId);
+    }
+
+    auto accessPoint = accessPointWeak->lock();
+    if (accessPoint == nullptr) {
+        return std::format("Access point {} is no longer valid", accessPointId);
+    }
+
+    interfaceName = accessPoint->GetInterfaceName();
+    return {};
+}
+#endif // NETREMOTE_DATASTREAM_RAW_STREAMS
@@ -2,9 +2,13 @@
 #include <algorithm>
 #include <cstddef>
 #include <format>
+#include <functional>
 #include <iterator>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <ranges>
+#include <stop_token>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -13,11 +17,13 @@
 #include <google/protobuf/map.h>
 #include <grpcpp/impl/codegen/status.h>
 #include <grpcpp/server_context.h>
+#include <grpcpp/support/server_callback.h>
 #include <magic_enum.hpp>
 #include <microsoft/net/ServiceApiNetworkAdapters.hxx>
 #include <microsoft/net/ServiceApiNetworkDot1xAdapters.hxx>
 #include <microsoft/net/remote/protocol/NetRemoteWifi.pb.h>
 #include <microsoft/net/remote/protocol/WifiCore.pb.h>
+#include <microsoft/net/remote/service/BoundedExecutor.hxx>
 #include <microsoft/net/remote/service/NetRemoteService.hxx>
 #include <microsoft/net/wifi/AccessPointManager.hxx>
 #include <microsoft/net/wifi/AccessPointOperationStatus.hxx>
@@ -30,6 +36,7 @@
 
 #include "NetRemoteApiTrace.hxx"
 #include "NetRemoteWifiApiTrace.hxx"
+#include "NetRemoteWifiReactors.hxx"
 
 using namespace Microsoft::Net::Remote;
 using namespace Microsoft::Net::Remote::Network;
@@ -269,13 +276,65 @@ NetRemoteAccessPointResultItemIsInvalid(const WifiAccessPointsEnumerateResultIte
     return (item.accesspointid() == AccessPointIdInvalid);
 }
 
+std::optional<WifiAccessPointsEnumerateResultItem>
+IAccessPointToNetRemoteAccessPointResultItemOptional(IAccessPoint& accessPoint)
+{
+    auto item = IAccessPointToNetRemoteAccessPointResultItem(accessPoint);
+    if (NetRemoteAccessPointResultItemIsInvalid(item)) {
+        return std::nullopt;
+    }
+
+    return item;
+}
+
+/**
+ * @brief Finish a unary RPC whose result was populated on the calling thread.
+ *
+ * @param context The context of the RPC.
+ * @return grpc::ServerUnaryReactor*
+ */
+grpc::ServerUnaryReactor*
+FinishUnaryOperation(grpc::CallbackServerContext* context)
+{
+    auto* reactor = context->DefaultReactor();
+    reactor->Finish(grpc::Status::OK);
+    return reactor;
+}
+
+/**
+ * @brief Run the operation of a unary RPC on the specified executor, finishing the RPC once the operation populated
+ * its result. The request and result remain valid until the RPC is finished, so the operation may reference them.
+ *
+ * @param executor The executor to run the operation on.
+ * @param context The context of the RPC.
+ * @param operation The operation to run.
+ * @return grpc::ServerUnaryReactor*
+ */
+grpc::ServerUnaryReactor*
+RunUnaryOperation(BoundedExecutor& executor, grpc::CallbackServerContext* context, std::function<void()> operation)
+{
+    auto* reactor = context->DefaultReactor();
+    const bool submitted = executor.TrySubmit([reactor, operation = std::move(operation)] {
+        operation();
+        reactor->Finish(grpc::Status::OK);
+    });
+
+    if (!submitted) {
+        LOGW << "Access point operation queue is full; rejecting request";
+        reactor->Finish(grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED, "Too many access point operations pending"));
+    }
+
+    return reactor;
+}
+
 } // namespace detail
 
 using detail::HandleFailure;
 
-NetRemoteService::NetRemoteService(std::shared_ptr<NetworkManager> networkManager) noexcept :
+NetRemoteService::NetRemoteService(std::shared_ptr<NetworkManager> networkManager, BoundedExecutorConfiguration accessPointOperationExecutorConfiguration) :
     m_networkManager(networkManager),
-    m_accessPointManager(networkManager->GetAccessPointManager())
+    m_accessPointManager(networkManager->GetAccessPointManager()),
+    m_accessPointOperationExecutor(accessPointOperationExecutorConfiguration)
 {
 }
 
@@ -285,8 +344,25 @@ NetRemoteService::GetAccessPointManager() noexcept
     return m_accessPointManager;
 }
 
-grpc::Status
-NetRemoteService::NetworkInterfacesEnumerate([[maybe_unused]] grpc::ServerContext* context, [[maybe_unused]] const NetworkEnumerateInterfacesRequest* request, NetworkEnumerateInterfacesResult* result)
+void
+NetRemoteService::FinishAccessPointsWatches()
+{
+    // The stop source is not replaced, so watches started from now on finish immediately.
+    const std::scoped_lock stopSourceLock{ m_accessPointsWatchStopSourceGate };
+    m_accessPointsWatchStopSource.request_stop();
+}
+
+void
+NetRemoteService::ResetAccessPointsWatches()
+{
+    const std::scoped_lock stopSourceLock{ m_accessPointsWatchStopSourceGate };
+    if (m_accessPointsWatchStopSource.stop_requested()) {
+        m_accessPointsWatchStopSource = std::stop_source{};
+    }
+}
+
+grpc::ServerUnaryReactor*
+NetRemoteService::NetworkInterfacesEnumerate(grpc::CallbackServerContext* context, [[maybe_unused]] const NetworkEnumerateInterfacesRequest* request, NetworkEnumerateInterfacesResult* result)
 {
     const NetRemoteApiTrace traceMe{};
 
@@ -300,139 +376,171 @@ NetRemoteService::NetworkInterfacesEnumerate([[maybe_unused]] grpc::ServerContex
 
     result->mutable_status()->set_code(NetworkOperationStatusCode::NetworkOperationStatusCodeSuccess);
 
-    return grpc::Status::OK;
+    return detail::FinishUnaryOperation(context);
 }
 
-grpc::Status
-NetRemoteService::WifiAccessPointsEnumerate([[maybe_unused]] grpc::ServerContext* context, [[maybe_unused]] const WifiAccessPointsEnumerateRequest* request, WifiAccessPointsEnumerateResult* response)
+grpc::ServerUnaryReactor*
+NetRemoteService::WifiAccessPointsEnumerate(grpc::CallbackServerContext* context, [[maybe_unused]] const WifiAccessPointsEnumerateRequest* request, WifiAccessPointsEnumerateResult* response)
 {
-    const NetRemoteApiTrace traceMe{};
-
-    // List all known access points.
-    auto accessPoints = m_accessPointManager->GetAllAccessPoints();
+    // Obtaining the operational state of each access point queries hostapd, so is done off the gRPC thread.
+    return detail::RunUnaryOperation(m_accessPointOperationExecutor, context, [this, response] {
+        const NetRemoteApiTrace traceMe{};
 
-    // Convert neutral types to dot11 API types.
-    std::vector<WifiAccessPointsEnumerateResultItem> accessPointResultItems(std::size(accessPoints));
-    std::ranges::transform(accessPoints, std::begin(accessPointResultItems), detail::IAccessPointWeakToNetRemoteAccessPointResultItem);
+        // List all known access points.
+        auto accessPoints = m_accessPointManager->GetAllAccessPoints();
 
-    // Remove any invalid items.
-    accessPointResultItems.erase(std::begin(std::ranges::remove_if(accessPointResultItems, detail::NetRemoteAccessPointResultItemIsInvalid)), std::end(accessPointResultItems));
+        // Convert neutral types to dot11 API types.
+        std::vector<WifiAccessPointsEnumerateResultItem> accessPointResultItems(std::size(accessPoints));
+        std::ranges::transform(accessPoints, std::begin(accessPointResultItems), detail::IAccessPointWeakToNetRemoteAccessPointResultItem);
 
-    // Update result.
-    *response->mutable_accesspoints() = {
-        std::make_move_iterator(std::begin(accessPointResultItems)),
-        std::make_move_iterator(std::end(accessPointResultItems))
-    };
+        // Remove any invalid items.
+        accessPointResultItems.erase(std::begin(std::ranges::remove_if(accessPointResultItems, detail::NetRemoteAccessPointResultItemIsInvalid)), std::end(accessPointResultItems));
 
-    response->mutable_status()->set_code(WifiAccessPointOperationStatusCode::WifiAccessPointOperationStatusCodeSucceeded);
+        // Update result.
+        *response->mutable_accesspoints() = {
+            std::make_move_iterator(std::begin(accessPointResultItems)),
+            std::make_move_iterator(std::end(accessPointResultItems))
+        };
 
-    return grpc::Status::OK;
+        response->mutable_status()->set_code(WifiAccessPointOperationStatusCode::WifiAccessPointOperationStatusCodeSucceeded);
+    });
 }
 
-grpc::Status
-NetRemoteService::WifiAccessPointEnable([[maybe_unused]] grpc::ServerContext* context, const WifiAccessPointEnableRequest* request, WifiAccessPointEnableResult* result)
+grpc::ServerUnaryReactor*
+NetRemoteService::WifiAccessPointEnable(grpc::CallbackServerContext* context, const WifiAccessPointEnableRequest* request, WifiAccessPointEnableResult* result)
 {
-    const NetRemoteWifiApiTrace traceMe{ request->accesspointid(), result->mutable_status() };
-
-    const auto* dot11AccessPointConfiguration{ request->has_configuration() ? &request->configuration() : nullptr };
-    auto wifiOperationStatus = WifiAccessPointEnableImpl(request->accesspointid(), dot11AccessPointConfiguration);
-    result->set_accesspointid(request->accesspointid());
-    *result->mutable_status() = std::move(wifiOperationStatus);
-
-    return grpc::Status::OK;
+    return detail::RunUnaryOperation(m_accessPointOperationExecutor, context, [this, request, result] {
+        const NetRemoteWifiApiTrace traceMe{ request->accesspointid(), result->mutable_status() };
+
+        const auto* dot11AccessPointConfiguration{ request->has_configuration() ? &request->configuration() : nullptr };
+        auto wifiOperationStatus = WifiAccessPointEnableImpl(request->accesspointid(), dot11AccessPointConfiguration);
+        result->set_accesspointid(request->accesspointid());
+        *result->mutable_status() = std::move(wifiOperationStatus);
+    });
 }
 
-grpc::Status
-NetRemoteService::WifiAccessPointDisable([[maybe_unused]] grpc::ServerContext* context, const WifiAccessPointDisableRequest* request, WifiAccessPointDisableResult* result)
+grpc::ServerUnaryReactor*
+NetRemoteService::WifiAccessPointDisable(grpc::CallbackServerContext* context, const WifiAccessPointDisableRequest* request, WifiAccessPointDisableResult* result)
 {
-    const NetRemoteWifiApiTrace traceMe{ request->accesspointid(), result->mutable_status() };
-
-    auto wifiOperationStatus = WifiAccessPointDisableImpl(request->accesspointid());
-    result->set_accesspointid(request->accesspointid());
-    *result->mutable_status() = std::move(wifiOperationStatus);
+    return detail::RunUnaryOperation(m_accessPointOperationExecutor, context, [this, request, result] {
+        const NetRemoteWifiApiTrace traceMe{ request->accesspointid(), result->mutable_status() };
 
-    return grpc::Status::OK;
+        auto wifiOperationStatus = WifiAccessPointDisableImpl(request->accesspointid());
+        result->set_accesspointid(request->accesspointid());
+        *result->mutable_status() = std::move(wifiOperationStatus);
+    });
 }
 
-grpc::Status
-NetRemoteService::WifiAccessPointSetPhyType([[maybe_unused]] grpc::ServerContext* context, const WifiAccessPointSetPhyTypeRequest* request, WifiAccessPointSetPhyTypeResult* result)
+grpc::ServerUnaryReactor*
+NetRemoteService::WifiAccessPointSetPhyType(grpc::CallbackServerContext* context, const WifiAccessPointSetPhyTypeRequest* request, WifiAccessPointSetPhyTypeResult* result)
 {
-    const NetRemoteWifiApiTrace traceMe{ request->accesspointid(), result->mutable_status() };
-
-    auto wifiOperationStatus = WifiAccessPointSetPhyTypeImpl(request->accesspointid(), request->phytype());
-    result->set_accesspointid(request->accesspointid());
-    *result->mutable_status() = std::move(wifiOperationStatus);
+    return detail::RunUnaryOperation(m_accessPointOperationExecutor, context, [this, request, result] {
+        const NetRemoteWifiApiTrace traceMe{ request->accesspointid(), result->mutable_status() };
 
-    return grpc::Status::OK;
+        auto wifiOperationStatus = WifiAccessPointSetPhyTypeImpl(request->accesspointid(), request->phytype());
+        result->set_accesspointid(request->accesspointid());
+        *result->mutable_status() = std::move(wifiOperationStatus);
+    });
 }
 
-grpc::Status
-NetRemoteService::WifiAccessPointSetFrequencyBands([[maybe_unused]] grpc::ServerContext* context, const WifiAccessPointSetFrequencyBandsRequest* request, WifiAccessPointSetFrequencyBandsResult* result)
+grpc::ServerUnaryReactor*
+NetRemoteService::WifiAccessPointSetFrequencyBands(grpc::CallbackServerContext* context, const WifiAccessPointSetFrequencyBandsRequest* request, WifiAccessPointSetFrequencyBandsResult* result)
 {
-    const NetRemoteWifiApiTrace traceMe{ request->accesspointid(), result->mutable_status() };
+    return detail::RunUnaryOperation(m_accessPointOperationExecutor, context, [this, request, result] {
+        const NetRemoteWifiApiTrace traceMe{ request->accesspointid(), result->mutable_status() };
+
+        auto dot11FrequencyBands = ToDot11FrequencyBands(*request);
+        auto wifiOperationStatus = WifiAccessPointSetFrequencyBandsImpl(request->accesspointid(), dot11FrequencyBands);
+        result->set_accesspointid(request->accesspointid());
+        *result->mutable_status() = std::move(wifiOperationStatus);
+    });
+}
 
-    auto dot11FrequencyBands = ToDot11FrequencyBands(*request);
-    auto wifiOperationStatus = WifiAccessPointSetFrequencyBandsImpl(request->accesspointid(), dot11FrequencyBands);
-    result->set_accesspointid(request->accesspointid());
-    *result->mutable_status() = std::move(wifiOperationStatus);
+grpc::ServerUnaryReactor*
+NetRemoteService::WifiAccessPointSetSsid(grpc::CallbackServerContext* context, const WifiAccessPointSetSsidRequest* request, WifiAccessPointSetSsidResult* result)
+{
+    return detail::RunUnaryOperation(m_accessPointOperationExecutor, context, [this, request, result] {
+        WifiAccessPointOperationStatus wifiOperationStatus{};
+        const NetRemoteWifiApiTrace traceMe{ request->accesspointid(), result->mutable_status() };
+
+        if (request->has_ssid()) {
+            const auto& ssid = request->ssid();
+            wifiOperationStatus = WifiAccessPointSetSsidImpl(request->accesspointid(), ssid);
+        } else {
+            wifiOperationStatus.set_code(WifiAccessPointOperationStatusCode::WifiAccessPointOperationStatusCodeInvalidParameter);
+            wifiOperationStatus.set_message("No SSID provided");
+        }
 
-    return grpc::Status::OK;
+        result->set_accesspointid(request->accesspointid());
+        *result->mutable_status() = std::move(wifiOperationStatus);
+    });
 }
 
-grpc::Status
-NetRemoteService::WifiAccessPointSetSsid([[maybe_unused]] grpc::ServerContext* context, const WifiAccessPointSetSsidRequest* request, WifiAccessPointSetSsidResult* result)
+grpc::ServerUnaryReactor*
+NetRemoteService::WifiAccessPointSetNetworkBridge(grpc::CallbackServerContext* context, const WifiAccessPointSetNetworkBridgeRequest* request, WifiAccessPointSetNetworkBridgeResult* result)
 {
-    WifiAccessPointOperationStatus wifiOperationStatus{};
-    const NetRemoteWifiApiTrace traceMe{ request->accesspointid(), result->mutable_status() };
+    return detail::RunUnaryOperation(m_accessPointOperationExecutor, context, [this, request, result] {
+        const NetRemoteWifiApiTrace traceMe{ request->accesspointid(), result->mutable_status() };
 
-    if (request->has_ssid()) {
-        const auto& ssid = request->ssid();
-        wifiOperationStatus = WifiAccessPointSetSsidImpl(request->accesspointid(), ssid);
-    } else {
-        wifiOperationStatus.set_code(WifiAccessPointOperationStatusCode::WifiAccessPointOperationStatusCodeInvalidParameter);
-        wifiOperationStatus.set_message("No SSID provided");
-    }
+        auto wifiOperationStatus = WifiAccessPointSetNetworkBridgeImpl(request->accesspointid(), request->networkbridgeid());
+        result->set_accesspointid(request->accesspointid());
+        *result->mutable_status() = std::move(wifiOperationStatus);
+    });
+}
 
-    result->set_accesspointid(request->accesspointid());
-    *result->mutable_status() = std::move(wifiOperationStatus);
+grpc::ServerUnaryReactor*
+NetRemoteService::WifiAccessPointSetAuthenticationDot1x(grpc::CallbackServerContext* context, const WifiAccessPointSetAuthenticationDot1xRequest* request, WifiAccessPointSetAuthenticationDot1xResult* result)
+{
+    return detail::RunUnaryOperation(m_accessPointOperationExecutor, context, [this, request, result] {
+        const NetRemoteWifiApiTrace traceMe{ request->accesspointid(), result->mutable_status() };
 
-    return grpc::Status::OK;
+        auto wifiOperationStatus = WifiAccessPointSetAuthenticationDot1xImpl(request->accesspointid(), request->authenticationdot1x());
+        result->set_accesspointid(request->accesspointid());
+        *result->mutable_status() = std::move(wifiOperationStatus);
+    });
 }
 
-grpc::Status
-NetRemoteService::WifiAccessPointSetNetworkBridge([[maybe_unused]] grpc::ServerContext* context, const WifiAccessPointSetNetworkBridgeRequest* request, WifiAccessPointSetNetworkBridgeResult* result)
+grpc::ServerUnaryReactor*
+NetRemoteService::WifiAccessPointGetAttributes(grpc::CallbackServerContext* context, const WifiAccessPointGetAttributesRequest* request, WifiAccessPointGetAttributesResult* result)
 {
-    const NetRemoteWifiApiTrace traceMe{ request->accesspointid(), result->mutable_status() };
+    // The attributes are static and held in memory, so are obtained directly on the gRPC thread.
+    {
+        const NetRemoteWifiApiTrace traceMe{ request->accesspointid(), result->mutable_status() };
 
-    auto wifiOperationStatus = WifiAccessPointSetNetworkBridgeImpl(request->accesspointid(), request->networkbridgeid());
-    result->set_accesspointid(request->accesspointid());
-    *result->mutable_status() = std::move(wifiOperationStatus);
+        auto wifiOperationStatus = WifiAccessPointGetAttributesImpl(request->accesspointid(), *result->mutable_attributes());
+        result->set_accesspointid(request->accesspointid());
+        *result->mutable_status() = std::move(wifiOperationStatus);
+    }
 
-    return grpc::Status::OK;
+    return detail::FinishUnaryOperation(context);
 }
 
-grpc::Status
-NetRemoteService::WifiAccessPointSetAuthenticationDot1x([[maybe_unused]] grpc::ServerContext* context, const WifiAccessPointSetAuthenticationDot1xRequest* request, WifiAccessPointSetAuthenticationDot1xResult* result)
+grpc::ServerWriteReactor<WifiAccessPointsWatchResult>*
+NetRemoteService::WifiAccessPointsWatch([[maybe_unused]] grpc::CallbackServerContext* context, [[maybe_unused]] const WifiAccessPointsWatchRequest* request)
 {
-    const NetRemoteWifiApiTrace traceMe{ request->accesspointid(), result->mutable_status() };
+    const NetRemoteApiTrace traceMe{};
 
-    auto wifiOperationStatus = WifiAccessPointSetAuthenticationDot1xImpl(request->accesspointid(), request->authenticationdot1x());
-    result->set_accesspointid(request->accesspointid());
-    *result->mutable_status() = std::move(wifiOperationStatus);
+    std::stop_token stopToken{};
+    {
+        const std::scoped_lock stopSourceLock{ m_accessPointsWatchStopSourceGate };
+        stopToken = m_accessPointsWatchStopSource.get_token();
+    }
 
-    return grpc::Status::OK;
+    return std::make_unique<Reactors::WifiAccessPointsWatcher>(m_accessPointManager, m_accessPointOperationExecutor, detail::IAccessPointToNetRemoteAccessPointResultItemOptional, std::move(stopToken)).release();
 }
 
-::grpc::Status
-NetRemoteService::WifiAccessPointGetAttributes([[maybe_unused]] grpc::ServerContext* context, const WifiAccessPointGetAttributesRequest* request, WifiAccessPointGetAttributesResult* result)
+grpc::ServerWriteReactor<WifiAccessPointStationsWatchResult>*
+NetRemoteService::WifiAccessPointStationsWatch([[maybe_unused]] grpc::CallbackServerContext* context, const WifiAccessPointStationsWatchRequest* request)
 {
-    const NetRemoteWifiApiTrace traceMe{ request->accesspointid(), result->mutable_status() };
+    const NetRemoteWifiApiTrace traceMe{ request->accesspointid() };
 
-    auto wifiOperationStatus = WifiAccessPointGetAttributesImpl(request->accesspointid(), *result->mutable_attributes());
-    result->set_accesspointid(request->accesspointid());
-    *result->mutable_status() = std::move(wifiOperationStatus);
+    std::stop_token stopToken{};
+    {
+        const std::scoped_lock stopSourceLock{ m_accessPointsWatchStopSourceGate };
+        stopToken = m_accessPointsWatchStopSource.get_token();
+    }
 
-    return grpc::Status::OK;
+    return std::make_unique<Reactors::WifiAccessPointStationsWatcher>(m_accessPointManager, m_accessPointOperationExecutor, request->accesspointid(), std::move(stopToken)).release();
 }
 
 AccessPointOperationStatus
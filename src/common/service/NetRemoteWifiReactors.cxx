@@ -0,0 +1,532 @@
+
+#include <cstdint>
+#include <format>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <string>
+#include <utility>
+
+#include <grpcpp/support/status.h>
+#include <logging/FunctionTracer.hxx>
+#include <microsoft/net/remote/protocol/NetRemoteWifi.pb.h>
+#include <microsoft/net/remote/service/BoundedExecutor.hxx>
+#include <microsoft/net/wifi/AccessPointManager.hxx>
+#include <microsoft/net/wifi/IAccessPoint.hxx>
+#include <microsoft/net/wifi/Ieee80211.hxx>
+#include <microsoft/net/wifi/Ieee80211Dot11Adapters.hxx>
+#include <plog/Log.h>
+
+#include "NetRemoteWifiReactors.hxx"
+
+using logging::FunctionTracer;
+
+using namespace Microsoft::Net::Remote::Service;
+using namespace Microsoft::Net::Remote::Service::Reactors;
+using namespace Microsoft::Net::Remote::Wifi;
+using namespace Microsoft::Net::Wifi;
+
+namespace detail
+{
+/**
+ * @brief Convert an access point change to the corresponding watch event type.
+ *
+ * @param change The access point change to convert.
+ * @return WifiAccessPointsWatchEventType
+ */
+WifiAccessPointsWatchEventType
+ToWifiAccessPointsWatchEventType(AccessPointChange change) noexcept
+{
+    switch (change) {
+    case AccessPointChange::Added:
+        return WifiAccessPointsWatchEventType::WifiAccessPointsWatchEventTypeAdded;
+    case AccessPointChange::Removed:
+        return WifiAccessPointsWatchEventType::WifiAccessPointsWatchEventTypeRemoved;
+    case AccessPointChange::Enabled:
+        return WifiAccessPointsWatchEventType::WifiAccessPointsWatchEventTypeEnabled;
+    case AccessPointChange::Disabled:
+        return WifiAccessPointsWatchEventType::WifiAccessPointsWatchEventTypeDisabled;
+    default:
+        return WifiAccessPointsWatchEventType::WifiAccessPointsWatchEventTypeUnknown;
+    }
+}
+
+/**
+ * @brief Convert a station change to the corresponding stations watch event type.
+ *
+ * @param change The station change to convert.
+ * @return WifiAccessPointStationsWatchEventType
+ */
+WifiAccessPointStationsWatchEventType
+ToWifiAccessPointStationsWatchEventType(AccessPointStationChange change) noexcept
+{
+    switch (change) {
+    case AccessPointStationChange::Connected:
+        return WifiAccessPointStationsWatchEventType::WifiAccessPointStationsWatchEventTypeConnected;
+    case AccessPointStationChange::Disconnected:
+        return WifiAccessPointStationsWatchEventType::WifiAccessPointStationsWatchEventTypeDisconnected;
+    default:
+        return WifiAccessPointStationsWatchEventType::WifiAccessPointStationsWatchEventTypeUnknown;
+    }
+}
+} // namespace detail
+
+WifiAccessPointsWatcher::WifiAccessPointsWatcher(std::shared_ptr<AccessPointManager> accessPointManager, BoundedExecutor& executor, AccessPointResultItemFactory makeResultItem, std::stop_token stopToken) :
+    m_accessPointManager(std::move(accessPointManager)),
+    m_executor(executor),
+    m_makeResultItem(std::move(makeResultItem))
+{
+    const FunctionTracer traceMe{};
+
+    // Registering for changes may install callbacks on each access point (eg. connect to hostapd), so it is done on the
+    // executor. Until it completes, the watcher is treated as writing so that finishing the RPC is deferred.
+    m_isWriting = true;
+
+    // If a stop was already requested, the RPC is finished once registered, and no snapshot is written.
+    m_stopCallback.emplace(std::move(stopToken), [this] {
+        RequestFinish(grpc::Status(grpc::StatusCode::UNAVAILABLE, "Server is shutting down"));
+    });
+
+    const bool submitted = m_executor.TrySubmit([this] {
+        // Register for changes before the snapshot is built so that no change is missed. A change made while the
+        // snapshot is being built may therefore be reflected in both the snapshot and a subsequent change result.
+        m_accessPointChangedCallbackToken = m_accessPointManager->RegisterAccessPointChangedCallback([this](AccessPointChange change, const std::shared_ptr<IAccessPoint>& accessPoint) {
+            OnAccessPointChanged(change, accessPoint);
+        });
+
+        {
+            std::unique_lock stateLock{ m_stateGate };
+            m_isWriting = false;
+            if (m_isFinishRequested) {
+                const auto finishStatus = m_finishStatus;
+                if (TryMarkFinishedLocked()) {
+                    stateLock.unlock();
+                    Finish(finishStatus);
+                }
+                return;
+            }
+        }
+
+        WriteNext();
+    });
+
+    if (!submitted) {
+        FinishOperationQueueFull();
+    }
+}
+
+void
+WifiAccessPointsWatcher::OnWriteDone(bool isOk)
+{
+    {
+        std::unique_lock stateLock{ m_stateGate };
+        m_isWriting = false;
+
+        // A failed write means the stream is broken, so no further results can be written.
+        if (!isOk || m_isFinishRequested) {
+            const auto finishStatus = m_isFinishRequested ? m_finishStatus : grpc::Status::CANCELLED;
+            if (TryMarkFinishedLocked()) {
+                stateLock.unlock();
+                Finish(finishStatus);
+            }
+            return;
+        }
+    }
+
+    WriteNext();
+}
+
+void
+WifiAccessPointsWatcher::OnCancel()
+{
+    const FunctionTracer traceMe{};
+
+    RequestFinish(grpc::Status::CANCELLED);
+}
+
+void
+WifiAccessPointsWatcher::OnDone()
+{
+    const FunctionTracer traceMe{};
+
+    // Once unregistered, the callback is guaranteed to not be running, so the reactor can be safely deleted.
+    // Unregistering may remove the callbacks from each access point, so it is also done on the executor.
+    auto unregisterAndDelete = [this] {
+        if (m_accessPointChangedCallbackToken.has_value()) {
+            m_accessPointManager->UnregisterAccessPointChangedCallback(m_accessPointChangedCallbackToken.value());
+        }
+
+        delete this;
+    };
+
+    if (!m_executor.TrySubmit(unregisterAndDelete)) {
+        LOGW << "Access point operation queue is full; ending access point watch on the calling thread";
+        unregisterAndDelete();
+    }
+}
+
+void
+WifiAccessPointsWatcher::OnAccessPointChanged(AccessPointChange change, const std::shared_ptr<IAccessPoint>& accessPoint)
+{
+    {
+        const std::scoped_lock stateLock{ m_stateGate };
+
+        // A pending snapshot, not yet built, will reflect this change.
+        if (m_isFinished || m_isSnapshotPending) {
+            return;
+        }
+
+        if (std::size(m_changesPending) >= NumberOfChangesPendingMaximum) {
+            LOGW << std::format("Access point watch has too many changes pending ({}); sending a snapshot instead", std::size(m_changesPending));
+            m_changesPending.clear();
+            m_isSnapshotPending = true;
+        } else {
+            m_changesPending.push_back(AccessPointChangePending{
+                .Change = change,
+                .AccessPoint = accessPoint,
+                .AccessPointId = std::string(accessPoint->GetInterfaceName()),
+            });
+        }
+    }
+
+    WriteNext();
+}
+
+void
+WifiAccessPointsWatcher::RequestFinish(grpc::Status status)
+{
+    std::unique_lock stateLock{ m_stateGate };
+    if (m_isFinishRequested) {
+        return;
+    }
+
+    m_isFinishRequested = true;
+    m_finishStatus = status;
+
+    // If a result is being built or written, its completion finishes the RPC instead.
+    if (!m_isWriting && TryMarkFinishedLocked()) {
+        stateLock.unlock();
+        Finish(status);
+    }
+}
+
+void
+WifiAccessPointsWatcher::WriteNext()
+{
+    std::optional<AccessPointChangePending> changePending{};
+    {
+        const std::scoped_lock stateLock{ m_stateGate };
+        if (m_isWriting || m_isFinishRequested || m_isFinished) {
+            return;
+        }
+
+        // A snapshot supersedes any changes pending before it was built.
+        if (m_isSnapshotPending) {
+            m_isSnapshotPending = false;
+            m_changesPending.clear();
+        } else if (!std::empty(m_changesPending)) {
+            changePending = std::move(m_changesPending.front());
+            m_changesPending.pop_front();
+        } else {
+            return;
+        }
+
+        m_isWriting = true;
+    }
+
+    const bool submitted = m_executor.TrySubmit([this, changePending = std::move(changePending)] {
+        auto result = changePending.has_value() ? MakeChangeResult(changePending.value()) : MakeSnapshotResult();
+
+        std::unique_lock stateLock{ m_stateGate };
+        if (m_isFinishRequested) {
+            m_isWriting = false;
+            const auto finishStatus = m_finishStatus;
+            if (TryMarkFinishedLocked()) {
+                stateLock.unlock();
+                Finish(finishStatus);
+            }
+            return;
+        }
+
+        // m_result is not accessed by anything else until the write completes.
+        m_result = std::move(result);
+        stateLock.unlock();
+        StartWrite(&m_result);
+    });
+
+    if (!submitted) {
+        FinishOperationQueueFull();
+    }
+}
+
+void
+WifiAccessPointsWatcher::FinishOperationQueueFull()
+{
+    LOGW << "Access point operation queue is full; ending access point watch";
+
+    std::unique_lock stateLock{ m_stateGate };
+    m_isWriting = false;
+    if (TryMarkFinishedLocked()) {
+        stateLock.unlock();
+        Finish(grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED, "Too many access point operations pending"));
+    }
+}
+
+WifiAccessPointsWatchResult
+WifiAccessPointsWatcher::MakeSnapshotResult()
+{
+    const FunctionTracer traceMe{};
+
+    WifiAccessPointsWatchResult result{};
+    result.set_eventtype(WifiAccessPointsWatchEventType::WifiAccessPointsWatchEventTypeSnapshot);
+
+    for (const auto& accessPointWeak : m_accessPointManager->GetAllAccessPoints()) {
+        auto accessPoint = accessPointWeak.lock();
+        if (accessPoint == nullptr) {
+            continue;
+        }
+
+        auto item = m_makeResultItem(*accessPoint);
+        if (item.has_value()) {
+            *result.add_accesspoints() = std::move(item.value());
+        }
+    }
+
+    result.mutable_status()->set_code(WifiAccessPointOperationStatusCode::WifiAccessPointOperationStatusCodeSucceeded);
+
+    return result;
+}
+
+WifiAccessPointsWatchResult
+WifiAccessPointsWatcher::MakeChangeResult(const AccessPointChangePending& changePending)
+{
+    WifiAccessPointsWatchResult result{};
+    result.set_eventtype(detail::ToWifiAccessPointsWatchEventType(changePending.Change));
+
+    WifiAccessPointsEnumerateResultItem item{};
+    item.set_accesspointid(changePending.AccessPointId);
+
+    switch (changePending.Change) {
+    case AccessPointChange::Added: {
+        // If the access point was since removed, only its id is reported; the removal follows.
+        auto accessPoint = changePending.AccessPoint.lock();
+        auto itemComplete = (accessPoint != nullptr) ? m_makeResultItem(*accessPoint) : std::nullopt;
+        if (itemComplete.has_value()) {
+            item = std::move(itemComplete.value());
+        }
+        break;
+    }
+    case AccessPointChange::Enabled:
+    case AccessPointChange::Disabled:
+        item.set_isenabled(changePending.Change == AccessPointChange::Enabled);
+        break;
+    default:
+        break;
+    }
+
+    *result.add_accesspoints() = std::move(item);
+    result.mutable_status()->set_code(WifiAccessPointOperationStatusCode::WifiAccessPointOperationStatusCodeSucceeded);
+
+    return result;
+}
+
+bool
+WifiAccessPointsWatcher::TryMarkFinishedLocked() noexcept
+{
+    if (m_isFinished) {
+        return false;
+    }
+
+    m_isFinished = true;
+    return true;
+}
+
+WifiAccessPointStationsWatcher::WifiAccessPointStationsWatcher(std::shared_ptr<AccessPointManager> accessPointManager, BoundedExecutor& executor, std::string accessPointId, std::stop_token stopToken) :
+    m_accessPointManager(std::move(accessPointManager)),
+    m_executor(executor),
+    m_accessPointId(std::move(accessPointId))
+{
+    const FunctionTracer traceMe{};
+
+    // Registering for events may install callbacks on each access point (eg. connect to hostapd), so it is done on the
+    // executor. Until it completes, the watcher is treated as writing so that finishing the RPC is deferred.
+    m_isWriting = true;
+
+    // If a stop was already requested, the RPC is finished once registered.
+    m_stopCallback.emplace(std::move(stopToken), [this] {
+        RequestFinish(grpc::Status(grpc::StatusCode::UNAVAILABLE, "Server is shutting down"));
+    });
+
+    const bool submitted = m_executor.TrySubmit([this] {
+        m_stationChangedCallbackToken = m_accessPointManager->RegisterStationChangedCallback([this](AccessPointStationChange change, const Ieee80211MacAddress& stationMacAddress, const std::shared_ptr<IAccessPoint>& accessPoint) {
+            OnStationChanged(change, stationMacAddress, accessPoint);
+        });
+
+        // The metadata is only sent once the callback is registered, so a client that receives it will observe all
+        // subsequent events.
+        StartSendInitialMetadata();
+
+        {
+            std::unique_lock stateLock{ m_stateGate };
+            m_isWriting = false;
+            if (m_isFinishRequested) {
+                const auto finishStatus = m_finishStatus;
+                if (TryMarkFinishedLocked()) {
+                    stateLock.unlock();
+                    Finish(finishStatus);
+                }
+                return;
+            }
+        }
+
+        WriteNext();
+    });
+
+    if (!submitted) {
+        LOGW << "Access point operation queue is full; ending station watch";
+
+        std::unique_lock stateLock{ m_stateGate };
+        m_isWriting = false;
+        if (TryMarkFinishedLocked()) {
+            stateLock.unlock();
+            Finish(grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED, "Too many access point operations pending"));
+        }
+    }
+}
+
+void
+WifiAccessPointStationsWatcher::OnWriteDone(bool isOk)
+{
+    {
+        std::unique_lock stateLock{ m_stateGate };
+        m_isWriting = false;
+
+        // A failed write means the stream is broken, so no further results can be written.
+        if (!isOk || m_isFinishRequested) {
+            const auto finishStatus = m_isFinishRequested ? m_finishStatus : grpc::Status::CANCELLED;
+            if (TryMarkFinishedLocked()) {
+                stateLock.unlock();
+                Finish(finishStatus);
+            }
+            return;
+        }
+    }
+
+    WriteNext();
+}
+
+void
+WifiAccessPointStationsWatcher::OnCancel()
+{
+    const FunctionTracer traceMe{};
+
+    RequestFinish(grpc::Status::CANCELLED);
+}
+
+void
+WifiAccessPointStationsWatcher::OnDone()
+{
+    const FunctionTracer traceMe{};
+
+    // Once unregistered, the callback is guaranteed to not be running, so the reactor can be safely deleted.
+    // Unregistering may remove the callbacks from each access point, so it is also done on the executor.
+    auto unregisterAndDelete = [this] {
+        if (m_stationChangedCallbackToken.has_value()) {
+            m_accessPointManager->UnregisterStationChangedCallback(m_stationChangedCallbackToken.value());
+        }
+
+        delete this;
+    };
+
+    if (!m_executor.TrySubmit(unregisterAndDelete)) {
+        LOGW << "Access point operation queue is full; ending station watch on the calling thread";
+        unregisterAndDelete();
+    }
+}
+
+void
+WifiAccessPointStationsWatcher::OnStationChanged(AccessPointStationChange change, const Ieee80211MacAddress& stationMacAddress, const std::shared_ptr<IAccessPoint>& accessPoint)
+{
+    const auto accessPointId = accessPoint->GetInterfaceName();
+    if (!std::empty(m_accessPointId) && accessPointId != m_accessPointId) {
+        return;
+    }
+
+    WifiAccessPointStationsWatchResult result{};
+    result.mutable_status()->set_code(WifiAccessPointOperationStatusCode::WifiAccessPointOperationStatusCodeSucceeded);
+    result.set_accesspointid(std::string(accessPointId));
+    result.set_eventtype(detail::ToWifiAccessPointStationsWatchEventType(change));
+    *result.mutable_stationmacaddress() = ToDot11MacAddress(stationMacAddress);
+
+    {
+        const std::scoped_lock stateLock{ m_stateGate };
+        if (m_isFinishRequested || m_isFinished) {
+            return;
+        }
+
+        if (std::size(m_resultsPending) >= NumberOfEventsPendingMaximum) {
+            if (m_numberOfEventsDiscarded == 0) {
+                LOGW << std::format("Station watch has too many events pending ({}); discarding the oldest", std::size(m_resultsPending));
+            }
+            m_resultsPending.pop_front();
+            m_numberOfEventsDiscarded++;
+        }
+
+        m_resultsPending.push_back(std::move(result));
+    }
+
+    WriteNext();
+}
+
+void
+WifiAccessPointStationsWatcher::RequestFinish(grpc::Status status)
+{
+    std::unique_lock stateLock{ m_stateGate };
+    if (m_isFinishRequested) {
+        return;
+    }
+
+    m_isFinishRequested = true;
+    m_finishStatus = status;
+    m_resultsPending.clear();
+
+    // If a result is being written, its completion finishes the RPC instead.
+    if (!m_isWriting && TryMarkFinishedLocked()) {
+        stateLock.unlock();
+        Finish(status);
+    }
+}
+
+void
+WifiAccessPointStationsWatcher::WriteNext()
+{
+    {
+        const std::scoped_lock stateLock{ m_stateGate };
+        if (m_isWriting || m_isFinishRequested || m_isFinished || std::empty(m_resultsPending)) {
+            return;
+        }
+
+        // Events are discarded from the front of the queue, so those discarded all precede this one.
+        m_result = std::move(m_resultsPending.front());
+        m_resultsPending.pop_front();
+        m_result.set_numberofeventsdiscarded(m_numberOfEventsDiscarded);
+        m_numberOfEventsDiscarded = 0;
+        m_isWriting = true;
+    }
+
+    // m_result is not accessed by anything else until the write completes.
+    StartWrite(&m_result);
+}
+
+bool
+WifiAccessPointStationsWatcher::TryMarkFinishedLocked() noexcept
+{
+    if (m_isFinished) {
+        return false;
+    }
+
+    m_isFinished = true;
+    return true;
+}
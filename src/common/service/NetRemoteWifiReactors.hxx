@@ -0,0 +1,279 @@
+
+#ifndef NET_REMOTE_WIFI_REACTORS_HXX
+#define NET_REMOTE_WIFI_REACTORS_HXX
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <string>
+
+#include <grpcpp/support/server_callback.h>
+#include <grpcpp/support/status.h>
+#include <microsoft/net/remote/protocol/NetRemoteWifi.pb.h>
+#include <microsoft/net/remote/service/BoundedExecutor.hxx>
+#include <microsoft/net/wifi/AccessPointManager.hxx>
+#include <microsoft/net/wifi/IAccessPoint.hxx>
+#include <microsoft/net/wifi/Ieee80211.hxx>
+
+namespace Microsoft::Net::Remote::Service::Reactors
+{
+/**
+ * @brief Implementation of the gRPC ServerWriteReactor that streams the access points of an access point manager: a
+ * snapshot of all access points, followed by each change to them.
+ *
+ * Building a result may query the access point (eg. hostapd), so results are built on the access point operation
+ * executor, and only one is built or written at a time. Registering for and unregistering from changes are also done
+ * on the executor, since they may install or remove callbacks on each access point. Changes observed while a result is being built or written are
+ * queued; if more than NumberOfChangesPendingMaximum are queued, they are discarded and a new snapshot is sent instead,
+ * which bounds the memory used by a slow client.
+ *
+ * The RPC only ends when the client cancels it or when a stop is requested, since the server waits for all RPCs to
+ * finish before shutting down.
+ */
+class WifiAccessPointsWatcher :
+    public grpc::ServerWriteReactor<Microsoft::Net::Remote::Wifi::WifiAccessPointsWatchResult>
+{
+public:
+    /**
+     * @brief Function that creates the result item describing an access point, or std::nullopt if it cannot be
+     * described.
+     */
+    using AccessPointResultItemFactory = std::function<std::optional<Microsoft::Net::Remote::Wifi::WifiAccessPointsEnumerateResultItem>(Microsoft::Net::Wifi::IAccessPoint&)>;
+
+    /**
+     * @brief The maximum number of changes queued for writing before they are replaced by a snapshot.
+     */
+    static constexpr std::size_t NumberOfChangesPendingMaximum{ 64 };
+
+    /**
+     * @brief Construct a new WifiAccessPointsWatcher object, and start writing the initial snapshot.
+     *
+     * @param accessPointManager The access point manager whose access points to watch.
+     * @param executor The executor used to build results.
+     * @param makeResultItem The function used to create the result item describing an access point.
+     * @param stopToken The token used to request the RPC to finish, eg. when the server is shutting down.
+     */
+    WifiAccessPointsWatcher(std::shared_ptr<Microsoft::Net::Wifi::AccessPointManager> accessPointManager, BoundedExecutor& executor, AccessPointResultItemFactory makeResultItem, std::stop_token stopToken);
+
+    /**
+     * @brief Callback that is executed when a write operation is completed.
+     *
+     * @param isOk Whether the write operation was successful.
+     */
+    void
+    OnWriteDone(bool isOk) override;
+
+    /**
+     * @brief Callback that is executed when the RPC is canceled.
+     */
+    void
+    OnCancel() override;
+
+    /**
+     * @brief Callback that is executed when all RPC operations are completed for a given RPC.
+     */
+    void
+    OnDone() override;
+
+private:
+    /**
+     * @brief A change to an access point that has not yet been written.
+     */
+    struct AccessPointChangePending
+    {
+        Microsoft::Net::Wifi::AccessPointChange Change;
+        std::weak_ptr<Microsoft::Net::Wifi::IAccessPoint> AccessPoint;
+        std::string AccessPointId;
+    };
+
+    /**
+     * @brief Invoked by the access point manager when an access point changes.
+     *
+     * @param change The kind of change.
+     * @param accessPoint The access point that changed.
+     */
+    void
+    OnAccessPointChanged(Microsoft::Net::Wifi::AccessPointChange change, const std::shared_ptr<Microsoft::Net::Wifi::IAccessPoint>& accessPoint);
+
+    /**
+     * @brief Request the RPC to finish with the specified status. If a result is being built or written, the RPC is
+     * finished once it completes.
+     *
+     * @param status The status to finish the RPC with.
+     */
+    void
+    RequestFinish(grpc::Status status);
+
+    /**
+     * @brief Start building and writing the next result, if one is pending and none is in progress.
+     */
+    void
+    WriteNext();
+
+    /**
+     * @brief Build a result holding a snapshot of all access points.
+     *
+     * @return Microsoft::Net::Remote::Wifi::WifiAccessPointsWatchResult
+     */
+    Microsoft::Net::Remote::Wifi::WifiAccessPointsWatchResult
+    MakeSnapshotResult();
+
+    /**
+     * @brief Build a result describing a single change.
+     *
+     * @param changePending The change to describe.
+     * @return Microsoft::Net::Remote::Wifi::WifiAccessPointsWatchResult
+     */
+    Microsoft::Net::Remote::Wifi::WifiAccessPointsWatchResult
+    MakeChangeResult(const AccessPointChangePending& changePending);
+
+    /**
+     * @brief Finish the RPC because the executor queue is full. Must only be called while a result is being built.
+     */
+    void
+    FinishOperationQueueFull();
+
+    /**
+     * @brief Mark the RPC as finished, with m_stateGate held. If this returns true, the caller must call Finish() once
+     * m_stateGate is released, and must not access any members afterwards since the reactor may then be deleted.
+     *
+     * @return true If the caller must finish the RPC.
+     * @return false If the RPC was already finished.
+     */
+    bool
+    TryMarkFinishedLocked() noexcept;
+
+private:
+    std::shared_ptr<Microsoft::Net::Wifi::AccessPointManager> m_accessPointManager;
+    BoundedExecutor& m_executor;
+    AccessPointResultItemFactory m_makeResultItem;
+    std::optional<Microsoft::Net::Wifi::AccessPointChangedCallbackToken> m_accessPointChangedCallbackToken{};
+
+    // The below m_stateGate mutex protects all of the following members.
+    std::mutex m_stateGate;
+    bool m_isSnapshotPending{ true };
+    std::deque<AccessPointChangePending> m_changesPending{};
+    bool m_isWriting{ false };
+    bool m_isFinishRequested{ false };
+    bool m_isFinished{ false };
+    grpc::Status m_finishStatus{};
+    Microsoft::Net::Remote::Wifi::WifiAccessPointsWatchResult m_result{};
+
+    // This must be destroyed first, since destroying it waits for a stop callback in progress to complete.
+    std::optional<std::stop_callback<std::function<void()>>> m_stopCallback{};
+};
+
+/**
+ * @brief Implementation of the gRPC ServerWriteReactor that streams stations connecting to and disconnecting from the
+ * access points of an access point manager.
+ *
+ * Any number of watchers may be active at once; the access point manager fans each event out to all of them. Each
+ * watcher queues its own events, so a slow client delays neither other watchers nor the access point reporting the
+ * event. If more than NumberOfEventsPendingMaximum events are queued, the oldest are discarded, and the number
+ * discarded is reported in the next result.
+ *
+ * Initial metadata is sent once the watcher is registered for events, so a client that waits for it will observe all
+ * subsequent events. The RPC only ends when the client cancels it or when a stop is requested.
+ */
+class WifiAccessPointStationsWatcher :
+    public grpc::ServerWriteReactor<Microsoft::Net::Remote::Wifi::WifiAccessPointStationsWatchResult>
+{
+public:
+    /**
+     * @brief The maximum number of events queued for writing before the oldest are discarded.
+     */
+    static constexpr std::size_t NumberOfEventsPendingMaximum{ 256 };
+
+    /**
+     * @brief Construct a new WifiAccessPointStationsWatcher object, and start watching for station events.
+     *
+     * @param accessPointManager The access point manager whose access points to watch.
+     * @param executor The executor used to register for and unregister from station events.
+     * @param accessPointId The identifier of the access point to watch, or empty to watch all access points.
+     * @param stopToken The token used to request the RPC to finish, eg. when the server is shutting down.
+     */
+    WifiAccessPointStationsWatcher(std::shared_ptr<Microsoft::Net::Wifi::AccessPointManager> accessPointManager, BoundedExecutor& executor, std::string accessPointId, std::stop_token stopToken);
+
+    /**
+     * @brief Callback that is executed when a write operation is completed.
+     *
+     * @param isOk Whether the write operation was successful.
+     */
+    void
+    OnWriteDone(bool isOk) override;
+
+    /**
+     * @brief Callback that is executed when the RPC is canceled.
+     */
+    void
+    OnCancel() override;
+
+    /**
+     * @brief Callback that is executed when all RPC operations are completed for a given RPC.
+     */
+    void
+    OnDone() override;
+
+private:
+    /**
+     * @brief Invoked by the access point manager when a station connects to or disconnects from an access point.
+     *
+     * @param change The kind of change.
+     * @param stationMacAddress The mac address of the station.
+     * @param accessPoint The access point the station connected to or disconnected from.
+     */
+    void
+    OnStationChanged(Microsoft::Net::Wifi::AccessPointStationChange change, const Microsoft::Net::Wifi::Ieee80211MacAddress& stationMacAddress, const std::shared_ptr<Microsoft::Net::Wifi::IAccessPoint>& accessPoint);
+
+    /**
+     * @brief Request the RPC to finish with the specified status. If a result is being written, the RPC is finished once
+     * it completes.
+     *
+     * @param status The status to finish the RPC with.
+     */
+    void
+    RequestFinish(grpc::Status status);
+
+    /**
+     * @brief Start writing the next result, if one is pending and none is in progress.
+     */
+    void
+    WriteNext();
+
+    /**
+     * @brief Mark the RPC as finished, with m_stateGate held. If this returns true, the caller must call Finish() once
+     * m_stateGate is released, and must not access any members afterwards since the reactor may then be deleted.
+     *
+     * @return true If the caller must finish the RPC.
+     * @return false If the RPC was already finished.
+     */
+    bool
+    TryMarkFinishedLocked() noexcept;
+
+private:
+    std::shared_ptr<Microsoft::Net::Wifi::AccessPointManager> m_accessPointManager;
+    BoundedExecutor& m_executor;
+    const std::string m_accessPointId;
+    std::optional<Microsoft::Net::Wifi::StationChangedCallbackToken> m_stationChangedCallbackToken{};
+
+    // The below m_stateGate mutex protects all of the following members.
+    std::mutex m_stateGate;
+    std::deque<Microsoft::Net::Remote::Wifi::WifiAccessPointStationsWatchResult> m_resultsPending{};
+    uint64_t m_numberOfEventsDiscarded{ 0 };
+    bool m_isWriting{ false };
+    bool m_isFinishRequested{ false };
+    bool m_isFinished{ false };
+    grpc::Status m_finishStatus{};
+    Microsoft::Net::Remote::Wifi::WifiAccessPointStationsWatchResult m_result{};
+
+    // This must be destroyed first, since destroying it waits for a stop callback in progress to complete.
+    std::optional<std::stop_callback<std::function<void()>>> m_stopCallback{};
+};
+} // namespace Microsoft::Net::Remote::Service::Reactors
+
+#endif // NET_REMOTE_WIFI_REACTORS_HXX
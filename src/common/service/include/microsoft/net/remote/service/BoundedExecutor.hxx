@@ -0,0 +1,113 @@
+
+#ifndef BOUNDED_EXECUTOR_HXX
+#define BOUNDED_EXECUTOR_HXX
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace Microsoft::Net::Remote::Service
+{
+/**
+ * @brief The number of threads and the queue depth of a bounded executor.
+ */
+struct BoundedExecutorConfiguration
+{
+    static constexpr std::size_t NumberOfThreadsDefault{ 4 };
+    static constexpr std::size_t QueueDepthMaximumDefault{ 64 };
+
+    /**
+     * @brief The number of threads that run tasks. A value of 0 is treated as 1.
+     */
+    std::size_t NumberOfThreads{ NumberOfThreadsDefault };
+
+    /**
+     * @brief The maximum number of tasks waiting for a thread. Tasks submitted beyond this are rejected.
+     */
+    std::size_t QueueDepthMaximum{ QueueDepthMaximumDefault };
+};
+
+/**
+ * @brief Runs tasks on a fixed set of threads, with a bounded queue of tasks waiting to run. This allows blocking work
+ * to be moved off the threads that must remain responsive, without letting a burst of work grow without bound.
+ *
+ * Tasks still queued when the executor is destroyed are run before it returns, so a task that completes an operation
+ * (eg. finishes an RPC) is never dropped. This class is thread-safe.
+ */
+class BoundedExecutor
+{
+public:
+    /**
+     * @brief Construct a new BoundedExecutor object and start its threads.
+     *
+     * @param configuration The number of threads and queue depth to use.
+     */
+    explicit BoundedExecutor(BoundedExecutorConfiguration configuration = {});
+
+    /**
+     * @brief Destroy the BoundedExecutor object, running any queued tasks and waiting for its threads to exit.
+     */
+    ~BoundedExecutor();
+
+    BoundedExecutor(const BoundedExecutor&) = delete;
+
+    BoundedExecutor(BoundedExecutor&&) = delete;
+
+    BoundedExecutor&
+    operator=(const BoundedExecutor&) = delete;
+
+    BoundedExecutor&
+    operator=(BoundedExecutor&&) = delete;
+
+    /**
+     * @brief Submit a task to run on one of the executor threads.
+     *
+     * @param task The task to run.
+     * @return true If the task was queued.
+     * @return false If the queue is full, in which case the task is not run.
+     */
+    bool
+    TrySubmit(std::function<void()> task);
+
+    /**
+     * @brief Get the number of tasks waiting for a thread.
+     *
+     * @return std::size_t
+     */
+    std::size_t
+    GetQueueDepth() const;
+
+    /**
+     * @brief Get the number of tasks rejected because the queue was full.
+     *
+     * @return uint64_t
+     */
+    uint64_t
+    GetNumberOfTasksRejected() const;
+
+private:
+    /**
+     * @brief Run queued tasks until a stop is requested and the queue is empty.
+     *
+     * @param stopToken The token used to request the thread to stop.
+     */
+    void
+    RunTasks(std::stop_token stopToken);
+
+private:
+    const std::size_t m_queueDepthMaximum;
+    mutable std::mutex m_tasksGate{};
+    std::condition_variable_any m_tasksAvailable{};
+    std::deque<std::function<void()>> m_tasks{};
+    uint64_t m_numberOfTasksRejected{ 0 };
+    std::vector<std::jthread> m_threads{};
+};
+} // namespace Microsoft::Net::Remote::Service
+
+#endif // BOUNDED_EXECUTOR_HXX
@@ -0,0 +1,49 @@
+
+#ifndef DATA_STREAM_DOWNLOAD_DATA_ENCODER_HXX
+#define DATA_STREAM_DOWNLOAD_DATA_ENCODER_HXX
+
+#include <span>
+
+#include <grpcpp/support/byte_buffer.h>
+#include <grpcpp/support/slice.h>
+#include <microsoft/net/remote/protocol/NetRemoteDataStream.pb.h>
+
+namespace Microsoft::Net::Remote::Service
+{
+/**
+ * @brief Encodes DataStreamDownloadData messages without copying their data.
+ *
+ * Serializing a message with the generated protobuf code copies the data field into the message and then again into
+ * the serialized output, which dominates the cost of streaming large data blocks. Instead, only the fields other than
+ * the data are serialized, into a small header slice, followed by the key and length of the data field. The data
+ * itself is added as a second, reference-counted slice, so the same data block can be written any number of times,
+ * concurrently, without being copied. Protobuf parsers accept fields in any order, so peers parse the resulting message
+ * as usual.
+ */
+class DataStreamDownloadDataEncoder
+{
+public:
+    /**
+     * @brief Encode a message with the fields of the specified header and the specified data.
+     *
+     * @param header The message fields other than the data. Its data field must be empty.
+     * @param data The data of the message.
+     * @return grpc::ByteBuffer The serialized message.
+     */
+    static grpc::ByteBuffer
+    Encode(const Microsoft::Net::Remote::DataStream::DataStreamDownloadData& header, const grpc::Slice& data);
+
+    /**
+     * @brief Encode a message with the fields of the specified header and data made up of the specified slices, in
+     * order. This packs several data blocks into a single message without copying them.
+     *
+     * @param header The message fields other than the data. Its data field must be empty.
+     * @param data The slices that, concatenated, make up the data of the message.
+     * @return grpc::ByteBuffer The serialized message.
+     */
+    static grpc::ByteBuffer
+    Encode(const Microsoft::Net::Remote::DataStream::DataStreamDownloadData& header, std::span<const grpc::Slice> data);
+};
+} // namespace Microsoft::Net::Remote::Service
+
+#endif // DATA_STREAM_DOWNLOAD_DATA_ENCODER_HXX
@@ -2,24 +2,50 @@
 #ifndef NET_REMOTE_DATA_STREAMING_SERVICE_HXX
 #define NET_REMOTE_DATA_STREAMING_SERVICE_HXX
 
+#include <memory>
+#include <string>
+
 #include <grpcpp/server_context.h>
+#include <grpcpp/support/byte_buffer.h>
 #include <grpcpp/support/server_callback.h>
+#ifdef NETREMOTE_DATASTREAM_RAW_STREAMS
+#include <microsoft/net/remote/datastream/RawStreamManager.hxx>
+#include <microsoft/net/remote/service/BoundedExecutor.hxx>
+#endif // NETREMOTE_DATASTREAM_RAW_STREAMS
+#include <microsoft/net/remote/datastream/SessionManager.hxx>
+#include <microsoft/net/remote/datastream/StreamAdmission.hxx>
+#include <microsoft/net/remote/datastream/StreamMetrics.hxx>
 #include <microsoft/net/remote/protocol/NetRemoteDataStream.pb.h>
 #include <microsoft/net/remote/protocol/NetRemoteDataStreamingService.grpc.pb.h>
+#include <microsoft/net/wifi/AccessPointManager.hxx>
 
 namespace Microsoft::Net::Remote::Service
 {
 /**
  * @brief Implementation of the NetRemoteDataStreaming::CallbackService gRPC service.
+ *
+ * DataStreamDownload is implemented as a raw method so that the data written to clients can be pre-serialized without
+ * copying it. This is transparent to clients, which use the regular, typed stub.
  */
 class NetRemoteDataStreamingService :
-    public NetRemoteDataStreaming::CallbackService
+    public NetRemoteDataStreaming::WithRawCallbackMethod_DataStreamDownload<NetRemoteDataStreaming::CallbackService>
 {
 public:
+    /**
+     * @brief The key of the trailing metadata in which download and bidirectional streams return the serialized
+     * DataStreamHistogram of their write completion latencies, in microseconds.
+     */
+    static constexpr auto WriteCompletionLatencyMetadataKey{ "netremote-write-completion-latency-us-bin" };
+
     /**
      * @brief Construct a new NetRemoteDataStreamingService object.
+     *
+     * @param accessPointManager The access point manager used to find the access points raw streams are bound to. Raw
+     * streams may not be bound to access points if nullptr.
+     * @param streamAdmissionConfiguration The limits on the upload, download and bidirectional streams that may run at
+     * once. Streams beyond them fail with grpc::StatusCode::RESOURCE_EXHAUSTED.
      */
-    NetRemoteDataStreamingService() = default;
+    explicit NetRemoteDataStreamingService(std::shared_ptr<Microsoft::Net::Wifi::AccessPointManager> accessPointManager = nullptr, Microsoft::Net::Remote::DataStream::StreamAdmissionConfiguration streamAdmissionConfiguration = {});
 
 private:
     /**
@@ -36,11 +62,11 @@ private:
      * @brief Stream data from the server to the client.
      *
      * @param context
-     * @param request
-     * @return grpc::ServerWriteReactor<Microsoft::Net::Remote::DataStream::DataStreamDownloadData>*
+     * @param request The serialized Microsoft::Net::Remote::DataStream::DataStreamDownloadRequest.
+     * @return grpc::ServerWriteReactor<grpc::ByteBuffer>* Writes serialized Microsoft::Net::Remote::DataStream::DataStreamDownloadData messages.
      */
-    grpc::ServerWriteReactor<Microsoft::Net::Remote::DataStream::DataStreamDownloadData>*
-    DataStreamDownload(grpc::CallbackServerContext* context, const Microsoft::Net::Remote::DataStream::DataStreamDownloadRequest* request) override;
+    grpc::ServerWriteReactor<grpc::ByteBuffer>*
+    DataStreamDownload(grpc::CallbackServerContext* context, const grpc::ByteBuffer* request) override;
 
     /**
      * @brief Stream data from the client to the server and from the server to the client.
@@ -52,7 +78,7 @@ private:
     DataStreamBidirectional(grpc::CallbackServerContext* context) override;
 
     /**
-     * @brief Allows the client to ping the server for availability.
+     * @brief Allows the client to ping the server for availability and to measure a single round-trip time.
      *
      * @param context
      * @param request
@@ -60,7 +86,133 @@ private:
      * @return grpc::ServerUnaryReactor*
      */
     grpc::ServerUnaryReactor*
-    DataStreamPing(grpc::CallbackServerContext* context, const google::protobuf::Empty* request, google::protobuf::Empty* response) override;
+    DataStreamPing(grpc::CallbackServerContext* context, const Microsoft::Net::Remote::DataStream::DataStreamPingRequest* request, Microsoft::Net::Remote::DataStream::DataStreamPingResponse* response) override;
+
+    /**
+     * @brief Answer a batch of pings from the client on a single stream, allowing it to measure round-trip time and
+     * clock offset.
+     *
+     * @param context
+     * @return grpc::ServerBidiReactor<Microsoft::Net::Remote::DataStream::DataStreamPingRequest, Microsoft::Net::Remote::DataStream::DataStreamPingResponse>*
+     */
+    grpc::ServerBidiReactor<Microsoft::Net::Remote::DataStream::DataStreamPingRequest, Microsoft::Net::Remote::DataStream::DataStreamPingResponse>*
+    DataStreamLatencyProbe(grpc::CallbackServerContext* context) override;
+
+    /**
+     * @brief Create a session that streams may be attached to.
+     *
+     * @param context
+     * @param request
+     * @param result
+     * @return grpc::ServerUnaryReactor*
+     */
+    grpc::ServerUnaryReactor*
+    DataStreamSessionCreate(grpc::CallbackServerContext* context, const Microsoft::Net::Remote::DataStream::DataStreamSessionCreateRequest* request, Microsoft::Net::Remote::DataStream::DataStreamSessionCreateResult* result) override;
+
+    /**
+     * @brief Get the aggregated results of all streams attached to a session, and optionally close it.
+     *
+     * @param context
+     * @param request
+     * @param result
+     * @return grpc::ServerUnaryReactor*
+     */
+    grpc::ServerUnaryReactor*
+    DataStreamSessionGetResult(grpc::CallbackServerContext* context, const Microsoft::Net::Remote::DataStream::DataStreamSessionResultRequest* request, Microsoft::Net::Remote::DataStream::DataStreamSessionResult* result) override;
+
+#ifdef NETREMOTE_DATASTREAM_RAW_STREAMS
+    // Raw streams are only available on Linux. Elsewhere, the DataStreamRaw* RPCs are left to the generated service,
+    // which fails them with grpc::StatusCode::UNIMPLEMENTED.
+
+    /**
+     * @brief Start one endpoint of a raw stream, which sends or receives data directly over a TCP or UDP socket.
+     *
+     * @param context
+     * @param request
+     * @param result
+     * @return grpc::ServerUnaryReactor*
+     */
+    grpc::ServerUnaryReactor*
+    DataStreamRawStart(grpc::CallbackServerContext* context, const Microsoft::Net::Remote::DataStream::DataStreamRawStartRequest* request, Microsoft::Net::Remote::DataStream::DataStreamRawStartResult* result) override;
+
+    /**
+     * @brief Get the result of a raw stream, optionally stopping and closing it.
+     *
+     * @param context
+     * @param request
+     * @param result
+     * @return grpc::ServerUnaryReactor*
+     */
+    grpc::ServerUnaryReactor*
+    DataStreamRawGetResult(grpc::CallbackServerContext* context, const Microsoft::Net::Remote::DataStream::DataStreamRawResultRequest* request, Microsoft::Net::Remote::DataStream::DataStreamRawResult* result) override;
+
+    /**
+     * @brief Aggregate the results of raw streams by traffic class, to compare the service each class gets when the
+     * streams are run concurrently.
+     *
+     * @param context
+     * @param request
+     * @param result
+     * @return grpc::ServerUnaryReactor*
+     */
+    grpc::ServerUnaryReactor*
+    DataStreamRawGetTrafficClassResults(grpc::CallbackServerContext* context, const Microsoft::Net::Remote::DataStream::DataStreamRawTrafficClassResultRequest* request, Microsoft::Net::Remote::DataStream::DataStreamRawTrafficClassResults* result) override;
+#endif // NETREMOTE_DATASTREAM_RAW_STREAMS
+
+    /**
+     * @brief Measure the latency added under load on the link to another netremote server. The test runs on a thread
+     * of its own and the RPC completes once it finishes. Only one test may run at a time; others are rejected with
+     * RESOURCE_EXHAUSTED.
+     *
+     * @param context
+     * @param request
+     * @param result
+     * @return grpc::ServerUnaryReactor*
+     */
+    grpc::ServerUnaryReactor*
+    DataStreamLatencyUnderLoad(grpc::CallbackServerContext* context, const Microsoft::Net::Remote::DataStream::DataStreamLatencyUnderLoadRequest* request, Microsoft::Net::Remote::DataStream::DataStreamLatencyUnderLoadResult* result) override;
+
+    /**
+     * @brief Get the metrics aggregated over all streams the server wrote data on, such as the latency of write
+     * completions, and the current state of stream admission.
+     *
+     * @param context
+     * @param request
+     * @param result
+     * @return grpc::ServerUnaryReactor*
+     */
+    grpc::ServerUnaryReactor*
+    DataStreamGetMetrics(grpc::CallbackServerContext* context, const Microsoft::Net::Remote::DataStream::DataStreamMetricsRequest* request, Microsoft::Net::Remote::DataStream::DataStreamMetrics* result) override;
+
+#ifdef NETREMOTE_DATASTREAM_RAW_STREAMS
+    /**
+     * @brief Get the name of the network interface of an access point.
+     *
+     * @param accessPointId The identifier of the access point.
+     * @param interfaceName The name of the network interface of the access point.
+     * @return std::string Describes the error if the access point was not found, otherwise empty.
+     */
+    std::string
+    TryGetAccessPointInterfaceName(const std::string& accessPointId, std::string& interfaceName) const;
+#endif // NETREMOTE_DATASTREAM_RAW_STREAMS
+
+private:
+    std::shared_ptr<Microsoft::Net::Wifi::AccessPointManager> m_accessPointManager;
+    Microsoft::Net::Remote::DataStream::SessionManager m_sessionManager{};
+#ifdef NETREMOTE_DATASTREAM_RAW_STREAMS
+    Microsoft::Net::Remote::DataStream::RawStreamManager m_rawStreamManager{};
+#endif // NETREMOTE_DATASTREAM_RAW_STREAMS
+    Microsoft::Net::Remote::DataStream::StreamMetrics m_streamMetrics{};
+    Microsoft::Net::Remote::DataStream::StreamAdmission m_streamAdmission;
+    // Each latency under load test opens several connections to another server and runs on a thread of its own, so
+    // only one may run at a time.
+    Microsoft::Net::Remote::DataStream::StreamAdmission m_latencyUnderLoadAdmission{ Microsoft::Net::Remote::DataStream::StreamAdmissionConfiguration{ .NumberOfStreamsMaximum = 1 } };
+#ifdef NETREMOTE_DATASTREAM_RAW_STREAMS
+    // Starting a raw stream resolves its peer and sets up its socket, and closing one waits for its thread to exit,
+    // all of which may block, so are done here rather than on the gRPC callback threads. This is declared last so that
+    // pending operations complete before the raw stream manager is destroyed.
+    BoundedExecutor m_rawStreamOperationExecutor{ BoundedExecutorConfiguration{ .NumberOfThreads = 2, .QueueDepthMaximum = Microsoft::Net::Remote::DataStream::RawStreamManager::NumberOfRawStreamsMaximum } };
+#endif // NETREMOTE_DATASTREAM_RAW_STREAMS
 };
 } // namespace Microsoft::Net::Remote::Service
 
@@ -3,11 +3,14 @@
 #define NET_REMOTE_SERVICE_HXX
 
 #include <memory>
+#include <mutex>
+#include <stop_token>
 #include <string>
 #include <string_view>
 
 #include <google/protobuf/map.h>
 #include <grpcpp/server_context.h>
+#include <grpcpp/support/server_callback.h>
 #include <grpcpp/support/status.h>
 #include <microsoft/net/NetworkManager.hxx>
 #include <microsoft/net/remote/protocol/NetRemoteService.grpc.pb.h>
@@ -15,6 +18,7 @@
 #include <microsoft/net/remote/protocol/Network8021x.pb.h>
 #include <microsoft/net/remote/protocol/NetworkCore.pb.h>
 #include <microsoft/net/remote/protocol/WifiCore.pb.h>
+#include <microsoft/net/remote/service/BoundedExecutor.hxx>
 #include <microsoft/net/remote/service/NetRemoteService.hxx>
 #include <microsoft/net/wifi/AccessPointManager.hxx>
 #include <microsoft/net/wifi/AccessPointOperationStatus.hxx>
@@ -25,17 +29,22 @@ namespace Microsoft::Net::Remote::Service
 {
 /**
  * @brief Implementation of the NetRemote::Service gRPC service.
+ *
+ * The service uses the gRPC callback API. Operations that may block on the access point (eg. waiting for hostapd to
+ * apply a change) run on a bounded executor rather than on gRPC threads, so a slow access point cannot stall other
+ * RPCs, including those of other services sharing the server.
  */
 class NetRemoteService :
-    public NetRemote::Service
+    public NetRemote::CallbackService
 {
 public:
     /**
      * @brief Construct a new NetRemoteService object with the specified network manager.
      *
      * @param networkManager The network manager to use.
+     * @param accessPointOperationExecutorConfiguration The configuration of the executor running access point operations.
      */
-    explicit NetRemoteService(std::shared_ptr<Microsoft::Net::NetworkManager> networkManager) noexcept;
+    explicit NetRemoteService(std::shared_ptr<Microsoft::Net::NetworkManager> networkManager, BoundedExecutorConfiguration accessPointOperationExecutorConfiguration = {});
 
     /**
      * @brief Get the AccessPointManager object for this service.
@@ -45,6 +54,20 @@ public:
     std::shared_ptr<Microsoft::Net::Wifi::AccessPointManager>
     GetAccessPointManager() noexcept;
 
+    /**
+     * @brief Finish all access point and station watches in progress, and any started until ResetAccessPointsWatches()
+     * is called. Watches only end when their client cancels them, so this must be called before shutting down the
+     * server, which otherwise waits for them indefinitely.
+     */
+    void
+    FinishAccessPointsWatches();
+
+    /**
+     * @brief Allow access point watches to run again after FinishAccessPointsWatches() was called.
+     */
+    void
+    ResetAccessPointsWatches();
+
 private:
     /**
      * @brief Enumerate the available network interfaces.
@@ -52,10 +75,10 @@ private:
      * @param context
      * @param request
      * @param response
-     * @return grpc::Status
+     * @return grpc::ServerUnaryReactor*
      */
-    grpc::Status
-    NetworkInterfacesEnumerate(grpc::ServerContext* context, const Microsoft::Net::Remote::Network::NetworkEnumerateInterfacesRequest* request, Microsoft::Net::Remote::Network::NetworkEnumerateInterfacesResult* response) override;
+    grpc::ServerUnaryReactor*
+    NetworkInterfacesEnumerate(grpc::CallbackServerContext* context, const Microsoft::Net::Remote::Network::NetworkEnumerateInterfacesRequest* request, Microsoft::Net::Remote::Network::NetworkEnumerateInterfacesResult* response) override;
 
 private:
     /**
@@ -64,10 +87,10 @@ private:
      * @param context
      * @param request
      * @param response
-     * @return grpc::Status
+     * @return grpc::ServerUnaryReactor*
      */
-    grpc::Status
-    WifiAccessPointsEnumerate(grpc::ServerContext* context, const Microsoft::Net::Remote::Wifi::WifiAccessPointsEnumerateRequest* request, Microsoft::Net::Remote::Wifi::WifiAccessPointsEnumerateResult* response) override;
+    grpc::ServerUnaryReactor*
+    WifiAccessPointsEnumerate(grpc::CallbackServerContext* context, const Microsoft::Net::Remote::Wifi::WifiAccessPointsEnumerateRequest* request, Microsoft::Net::Remote::Wifi::WifiAccessPointsEnumerateResult* response) override;
 
     /**
      * @brief Enable an access point. This brings the access point online, making it available for use by clients.
@@ -75,10 +98,10 @@ private:
      * @param context
      * @param request
      * @param response
-     * @return grpc::Status
+     * @return grpc::ServerUnaryReactor*
      */
-    grpc::Status
-    WifiAccessPointEnable(grpc::ServerContext* context, const Microsoft::Net::Remote::Wifi::WifiAccessPointEnableRequest* request, Microsoft::Net::Remote::Wifi::WifiAccessPointEnableResult* result) override;
+    grpc::ServerUnaryReactor*
+    WifiAccessPointEnable(grpc::CallbackServerContext* context, const Microsoft::Net::Remote::Wifi::WifiAccessPointEnableRequest* request, Microsoft::Net::Remote::Wifi::WifiAccessPointEnableResult* result) override;
 
     /**
      * @brief Disable an access point. This will take the access point offline, making it unavailable for use by clients.
@@ -86,10 +109,10 @@ private:
      * @param context
      * @param request
      * @param result
-     * @return grpc::Status
+     * @return grpc::ServerUnaryReactor*
      */
-    grpc::Status
-    WifiAccessPointDisable(grpc::ServerContext* context, const Microsoft::Net::Remote::Wifi::WifiAccessPointDisableRequest* request, Microsoft::Net::Remote::Wifi::WifiAccessPointDisableResult* result) override;
+    grpc::ServerUnaryReactor*
+    WifiAccessPointDisable(grpc::CallbackServerContext* context, const Microsoft::Net::Remote::Wifi::WifiAccessPointDisableRequest* request, Microsoft::Net::Remote::Wifi::WifiAccessPointDisableResult* result) override;
 
     /**
      * @brief Set the active PHY type of the access point. The access point must be enabled. This will cause
@@ -98,10 +121,10 @@ private:
      * @param context
      * @param request
      * @param result
-     * @return grpc::Status
+     * @return grpc::ServerUnaryReactor*
      */
-    grpc::Status
-    WifiAccessPointSetPhyType(grpc::ServerContext* context, const Microsoft::Net::Remote::Wifi::WifiAccessPointSetPhyTypeRequest* request, Microsoft::Net::Remote::Wifi::WifiAccessPointSetPhyTypeResult* result) override;
+    grpc::ServerUnaryReactor*
+    WifiAccessPointSetPhyType(grpc::CallbackServerContext* context, const Microsoft::Net::Remote::Wifi::WifiAccessPointSetPhyTypeRequest* request, Microsoft::Net::Remote::Wifi::WifiAccessPointSetPhyTypeResult* result) override;
 
     /**
      * @brief Set the active frequency bands of the access point. The access point must be enabled. This will cause
@@ -110,10 +133,10 @@ private:
      * @param context
      * @param request
      * @param result
-     * @return grpc::Status
+     * @return grpc::ServerUnaryReactor*
      */
-    grpc::Status
-    WifiAccessPointSetFrequencyBands(grpc::ServerContext* context, const Microsoft::Net::Remote::Wifi::WifiAccessPointSetFrequencyBandsRequest* request, Microsoft::Net::Remote::Wifi::WifiAccessPointSetFrequencyBandsResult* result) override;
+    grpc::ServerUnaryReactor*
+    WifiAccessPointSetFrequencyBands(grpc::CallbackServerContext* context, const Microsoft::Net::Remote::Wifi::WifiAccessPointSetFrequencyBandsRequest* request, Microsoft::Net::Remote::Wifi::WifiAccessPointSetFrequencyBandsResult* result) override;
 
     /**
      * @brief Set the SSID of the access point.
@@ -121,10 +144,10 @@ private:
      * @param context
      * @param request
      * @param result
-     * @return grpc::Status
+     * @return grpc::ServerUnaryReactor*
      */
-    grpc::Status
-    WifiAccessPointSetSsid(grpc::ServerContext* context, const Microsoft::Net::Remote::Wifi::WifiAccessPointSetSsidRequest* request, Microsoft::Net::Remote::Wifi::WifiAccessPointSetSsidResult* result) override;
+    grpc::ServerUnaryReactor*
+    WifiAccessPointSetSsid(grpc::CallbackServerContext* context, const Microsoft::Net::Remote::Wifi::WifiAccessPointSetSsidRequest* request, Microsoft::Net::Remote::Wifi::WifiAccessPointSetSsidResult* result) override;
 
     /**
      * @brief Set the network bridge interface the access point interface will be added to.
@@ -132,10 +155,10 @@ private:
      * @param context
      * @param request
      * @param result
-     * @return grpc::Status
+     * @return grpc::ServerUnaryReactor*
      */
-    grpc::Status
-    WifiAccessPointSetNetworkBridge(grpc::ServerContext* context, const Microsoft::Net::Remote::Wifi::WifiAccessPointSetNetworkBridgeRequest* request, Microsoft::Net::Remote::Wifi::WifiAccessPointSetNetworkBridgeResult* result) override;
+    grpc::ServerUnaryReactor*
+    WifiAccessPointSetNetworkBridge(grpc::CallbackServerContext* context, const Microsoft::Net::Remote::Wifi::WifiAccessPointSetNetworkBridgeRequest* request, Microsoft::Net::Remote::Wifi::WifiAccessPointSetNetworkBridgeResult* result) override;
 
     /**
      * @brief Set the IEEE 802.1x configuration for the access point.
@@ -143,10 +166,10 @@ private:
      * @param context
      * @param request
      * @param result
-     * @return grpc::Status
+     * @return grpc::ServerUnaryReactor*
      */
-    grpc::Status
-    WifiAccessPointSetAuthenticationDot1x(grpc::ServerContext* context, const Microsoft::Net::Remote::Wifi::WifiAccessPointSetAuthenticationDot1xRequest* request, Microsoft::Net::Remote::Wifi::WifiAccessPointSetAuthenticationDot1xResult* result) override;
+    grpc::ServerUnaryReactor*
+    WifiAccessPointSetAuthenticationDot1x(grpc::CallbackServerContext* context, const Microsoft::Net::Remote::Wifi::WifiAccessPointSetAuthenticationDot1xRequest* request, Microsoft::Net::Remote::Wifi::WifiAccessPointSetAuthenticationDot1xResult* result) override;
 
     /**
      * @brief Get the properties of the specified access point.
@@ -154,10 +177,32 @@ private:
      * @param context
      * @param request
      * @param result
-     * @return ::grpc::Status
+     * @return grpc::ServerUnaryReactor*
+     */
+    grpc::ServerUnaryReactor*
+    WifiAccessPointGetAttributes(grpc::CallbackServerContext* context, const Microsoft::Net::Remote::Wifi::WifiAccessPointGetAttributesRequest* request, Microsoft::Net::Remote::Wifi::WifiAccessPointGetAttributesResult* result) override;
+
+    /**
+     * @brief Watch the available access points. A snapshot of all access points is written first, followed by each
+     * access point that is added or removed, and each change in the operational state of an access point.
+     *
+     * @param context
+     * @param request
+     * @return grpc::ServerWriteReactor<Microsoft::Net::Remote::Wifi::WifiAccessPointsWatchResult>*
+     */
+    grpc::ServerWriteReactor<Microsoft::Net::Remote::Wifi::WifiAccessPointsWatchResult>*
+    WifiAccessPointsWatch(grpc::CallbackServerContext* context, const Microsoft::Net::Remote::Wifi::WifiAccessPointsWatchRequest* request) override;
+
+    /**
+     * @brief Watch the stations connecting to and disconnecting from one or all access points. Any number of clients
+     * may watch at once.
+     *
+     * @param context
+     * @param request
+     * @return grpc::ServerWriteReactor<Microsoft::Net::Remote::Wifi::WifiAccessPointStationsWatchResult>*
      */
-    ::grpc::Status
-    WifiAccessPointGetAttributes(grpc::ServerContext* context, const Microsoft::Net::Remote::Wifi::WifiAccessPointGetAttributesRequest* request, Microsoft::Net::Remote::Wifi::WifiAccessPointGetAttributesResult* result) override;
+    grpc::ServerWriteReactor<Microsoft::Net::Remote::Wifi::WifiAccessPointStationsWatchResult>*
+    WifiAccessPointStationsWatch(grpc::CallbackServerContext* context, const Microsoft::Net::Remote::Wifi::WifiAccessPointStationsWatchRequest* request) override;
 
 protected:
     /**
@@ -329,6 +374,9 @@ protected:
 private:
     std::shared_ptr<Microsoft::Net::NetworkManager> m_networkManager;
     std::shared_ptr<Microsoft::Net::Wifi::AccessPointManager> m_accessPointManager;
+    BoundedExecutor m_accessPointOperationExecutor;
+    std::mutex m_accessPointsWatchStopSourceGate;
+    std::stop_source m_accessPointsWatchStopSource;
 };
 } // namespace Microsoft::Net::Remote::Service
 
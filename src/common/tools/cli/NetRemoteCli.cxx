@@ -1,4 +1,6 @@
 
+#include <chrono>
+#include <cstdint>
 #include <format>
 #include <iostream>
 #include <istream>
@@ -16,6 +18,7 @@
 #include <CLI/Validators.hpp>
 #include <microsoft/net/Ieee8021xRadiusAuthentication.hxx>
 #include <microsoft/net/NetworkIpAddress.hxx>
+#include <microsoft/net/remote/DataStreamClient.hxx>
 #include <microsoft/net/remote/NetRemoteCli.hxx>
 #include <microsoft/net/remote/NetRemoteCliData.hxx>
 #include <microsoft/net/remote/NetRemoteCliHandler.hxx>
@@ -92,6 +95,7 @@ NetRemoteCli::CreateParser() noexcept
     m_cliAppServerAddress = optionServer;
     m_cliAppNetwork = AddSubcommandNetwork(app.get());
     m_cliAppWifi = AddSubcommandWifi(app.get());
+    m_cliAppDataStream = AddSubcommandDataStream(app.get());
 
     return app;
 }
@@ -595,6 +599,68 @@ NetRemoteCli::AddSubcommandWifiAccessPointSet8021xRadius(CLI::App* parent)
     return cliAppWifiAccessPointSetAuthenticationDot1x;
 }
 
+CLI::App*
+NetRemoteCli::AddSubcommandDataStream(CLI::App* parent)
+{
+    // Top-level command.
+    auto* dataStreamApp = parent->add_subcommand("datastream", "Data stream throughput tests");
+    dataStreamApp->alias("ds");
+    dataStreamApp->needs(m_cliAppServerAddress);
+    dataStreamApp->require_subcommand();
+
+    // Options common to all sub-commands.
+    dataStreamApp->add_option("-t,--time,--duration", m_cliData->DataStreamDurationSeconds, "The duration of the test, in seconds")
+        ->check(CLI::Range(1U, 86400U))
+        ->capture_default_str();
+    dataStreamApp->add_option("-l,--len,--block-size", m_cliData->DataStreamDataBlockSize, "The size of each data block, in bytes")
+        ->check(CLI::Range(std::size_t{ 1 }, DataStreamClientConfiguration::DataBlockSizeMaximum))
+        ->capture_default_str();
+    dataStreamApp->add_option("-P,--parallel", m_cliData->DataStreamNumberOfStreams, "The number of data streams to run in parallel")
+        ->check(CLI::Range(1U, 128U))
+        ->capture_default_str();
+    dataStreamApp->add_option("-i,--interval", m_cliData->DataStreamReportIntervalSeconds, "The interval between throughput reports, in seconds")
+        ->check(CLI::Range(1U, 3600U))
+        ->capture_default_str();
+
+    // Sub-commands.
+    m_cliAppDataStreamUpload = AddSubcommandDataStreamDirection(dataStreamApp, DataStreamDirection::Upload);
+    m_cliAppDataStreamDownload = AddSubcommandDataStreamDirection(dataStreamApp, DataStreamDirection::Download);
+    m_cliAppDataStreamBidirectional = AddSubcommandDataStreamDirection(dataStreamApp, DataStreamDirection::Bidirectional);
+
+    return dataStreamApp;
+}
+
+CLI::App*
+NetRemoteCli::AddSubcommandDataStreamDirection(CLI::App* parent, DataStreamDirection direction)
+{
+    CLI::App* cliAppDataStreamDirection{ nullptr };
+    switch (direction) {
+    case DataStreamDirection::Upload:
+        cliAppDataStreamDirection = parent->add_subcommand("upload", "Send data to the server");
+        cliAppDataStreamDirection->alias("up");
+        break;
+    case DataStreamDirection::Download:
+        cliAppDataStreamDirection = parent->add_subcommand("download", "Receive data from the server");
+        cliAppDataStreamDirection->alias("down");
+        break;
+    case DataStreamDirection::Bidirectional:
+        cliAppDataStreamDirection = parent->add_subcommand("bidi", "Send and receive data concurrently");
+        cliAppDataStreamDirection->alias("bidirectional");
+        break;
+    }
+
+    cliAppDataStreamDirection->callback([this, direction] {
+        DataStreamClientConfiguration configuration{
+            .Duration = std::chrono::seconds(m_cliData->DataStreamDurationSeconds),
+            .DataBlockSize = m_cliData->DataStreamDataBlockSize,
+        };
+
+        OnDataStream(direction, configuration, m_cliData->DataStreamNumberOfStreams, std::chrono::seconds(m_cliData->DataStreamReportIntervalSeconds));
+    });
+
+    return cliAppDataStreamDirection;
+}
+
 void
 NetRemoteCli::OnServerAddressChanged(const std::string& serverAddressArg)
 {
@@ -653,3 +719,9 @@ NetRemoteCli::OnWifiAccessPointSet8021xRadius(std::string_view accessPointId, co
 {
     m_cliHandler->HandleCommandWifiAccessPointSet8021xRadius(accessPointId, ieee8021xRadiusConfiguration);
 }
+
+void
+NetRemoteCli::OnDataStream(DataStreamDirection direction, const DataStreamClientConfiguration& configuration, uint32_t numberOfStreams, std::chrono::milliseconds reportInterval)
+{
+    m_cliHandler->HandleCommandDataStream(direction, configuration, numberOfStreams, reportInterval);
+}
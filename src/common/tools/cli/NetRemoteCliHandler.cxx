@@ -1,8 +1,11 @@
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string_view>
 #include <utility>
 
+#include <microsoft/net/remote/DataStreamClient.hxx>
 #include <microsoft/net/remote/INetRemoteCliHandlerOperations.hxx>
 #include <microsoft/net/remote/NetRemoteCli.hxx>
 #include <microsoft/net/remote/NetRemoteCliHandler.hxx>
@@ -127,3 +130,15 @@ NetRemoteCliHandler::HandleCommandWifiAccessPointSet8021xRadius(std::string_view
     LOGD << "Executing command WifiAccessPointSet8021xRadius";
     operations->WifiAccessPointSet8021xRadius(accessPointId, ieee8021xRadiusConfiguration);
 }
+
+void
+NetRemoteCliHandler::HandleCommandDataStream(DataStreamDirection direction, const DataStreamClientConfiguration& configuration, uint32_t numberOfStreams, std::chrono::milliseconds reportInterval)
+{
+    auto [parentStrong, operations] = GetOperationsAndParentStrongRef();
+    if (!parentStrong || !operations) {
+        return;
+    }
+
+    LOGD << "Executing command DataStream";
+    operations->DataStream(direction, configuration, numberOfStreams, reportInterval);
+}
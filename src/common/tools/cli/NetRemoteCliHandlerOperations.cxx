@@ -1,6 +1,8 @@
 
 #include <algorithm>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <format>
 #include <iostream>
 #include <iterator>
@@ -9,13 +11,17 @@
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include <grpcpp/client_context.h>
 #include <magic_enum.hpp>
 #include <microsoft/net/ServiceApiNetworkDot1xAdapters.hxx>
+#include <microsoft/net/remote/DataStreamClient.hxx>
 #include <microsoft/net/remote/INetRemoteCliHandlerOperations.hxx>
 #include <microsoft/net/remote/NetRemoteCliHandlerOperations.hxx>
 #include <microsoft/net/remote/NetRemoteServerConnection.hxx>
+#include <microsoft/net/remote/protocol/NetRemoteDataStream.pb.h>
+#include <microsoft/net/remote/protocol/NetRemoteDataStreamingService.grpc.pb.h>
 #include <microsoft/net/remote/protocol/NetRemoteNetwork.grpc.pb.h>
 #include <microsoft/net/remote/protocol/NetRemoteNetwork.pb.h>
 #include <microsoft/net/remote/protocol/NetRemoteService.grpc.pb.h>
@@ -27,6 +33,7 @@
 
 using namespace Microsoft::Net;
 using namespace Microsoft::Net::Remote;
+using namespace Microsoft::Net::Remote::DataStream;
 using namespace Microsoft::Net::Remote::Network;
 using namespace Microsoft::Net::Remote::Service;
 using namespace Microsoft::Net::Remote::Wifi;
@@ -515,6 +522,215 @@ NetRemoteCliHandlerOperations::WifiAccessPointSet8021xRadius(std::string_view ac
     std::cout << std::format("Successfully set RADIUS configuration for wifi access point '{}'\n", accessPointId);
 }
 
+namespace detail
+{
+/**
+ * @brief The time data streams are given to complete after their configured duration before they are canceled.
+ */
+constexpr auto DataStreamCompletionGracePeriod{ std::chrono::seconds(5) };
+
+/**
+ * @brief Sum the progress of all data stream clients.
+ *
+ * @param dataStreamClients The data stream clients to sum the progress of.
+ * @return DataStreamClientProgress
+ */
+DataStreamClientProgress
+SumProgress(const std::vector<std::unique_ptr<DataStreamClient>>& dataStreamClients)
+{
+    DataStreamClientProgress progressTotal{};
+    for (const auto& dataStreamClient : dataStreamClients) {
+        const auto progress = dataStreamClient->GetProgress();
+        progressTotal.NumberOfDataBlocksSent += progress.NumberOfDataBlocksSent;
+        progressTotal.NumberOfBytesSent += progress.NumberOfBytesSent;
+        progressTotal.NumberOfDataBlocksReceived += progress.NumberOfDataBlocksReceived;
+        progressTotal.NumberOfBytesReceived += progress.NumberOfBytesReceived;
+    }
+
+    return progressTotal;
+}
+
+/**
+ * @brief Format an amount of data transferred over a period of time, along with the corresponding throughput.
+ *
+ * @param numberOfBytes The number of bytes transferred.
+ * @param duration The period of time over which the data was transferred.
+ * @return std::string
+ */
+std::string
+FormatTransfer(uint64_t numberOfBytes, std::chrono::duration<double> duration)
+{
+    const auto megabytes = static_cast<double>(numberOfBytes) / 1e6;
+    const auto megabitsPerSecond = duration.count() > 0 ? (megabytes * 8) / duration.count() : 0.0;
+    return std::format("{:10.2f} MB {:10.2f} Mbit/s", megabytes, megabitsPerSecond);
+}
+
+/**
+ * @brief Format a report of the data transferred over an interval of a data stream run.
+ *
+ * @param direction The direction of the data streams.
+ * @param intervalStart The start of the interval, relative to the start of the run.
+ * @param intervalEnd The end of the interval, relative to the start of the run.
+ * @param progressStart The progress at the start of the interval.
+ * @param progressEnd The progress at the end of the interval.
+ * @return std::string
+ */
+std::string
+FormatDataStreamInterval(DataStreamDirection direction, std::chrono::duration<double> intervalStart, std::chrono::duration<double> intervalEnd, const DataStreamClientProgress& progressStart, const DataStreamClientProgress& progressEnd)
+{
+    const auto intervalDuration = intervalEnd - intervalStart;
+
+    std::string report = std::format("[{:7.1f}-{:7.1f} s]", intervalStart.count(), intervalEnd.count());
+    if (direction != DataStreamDirection::Download) {
+        report += std::format(" sent {}", FormatTransfer(progressEnd.NumberOfBytesSent - progressStart.NumberOfBytesSent, intervalDuration));
+    }
+    if (direction != DataStreamDirection::Upload) {
+        report += std::format(" received {}", FormatTransfer(progressEnd.NumberOfBytesReceived - progressStart.NumberOfBytesReceived, intervalDuration));
+    }
+
+    return report;
+}
+} // namespace detail
+
+void
+NetRemoteCliHandlerOperations::DataStream(DataStreamDirection direction, const DataStreamClientConfiguration& configuration, uint32_t numberOfStreams, std::chrono::milliseconds reportInterval)
+{
+    auto* dataStreamingClient = m_connection->DataStreamingClient.get();
+    auto dataStreamClientConfiguration = configuration;
+
+    // Parallel data streams are attached to a session so the server reports their aggregate goodput and fairness.
+    if (numberOfStreams > 1) {
+        DataStreamSessionCreateRequest request{};
+        DataStreamSessionCreateResult result{};
+        grpc::ClientContext clientContext{};
+
+        auto status = dataStreamingClient->DataStreamSessionCreate(&clientContext, request, &result);
+        if (!status.ok()) {
+            std::cerr << std::format("Failed to create data stream session ({})\n{}\n", magic_enum::enum_name(status.error_code()), status.error_message());
+            return;
+        }
+        if (result.status().code() != DataStreamOperationStatusCode::DataStreamOperationStatusCodeSucceeded) {
+            std::cerr << std::format("Failed to create data stream session ({})\n{}\n", magic_enum::enum_name(result.status().code()), result.status().message());
+            return;
+        }
+
+        dataStreamClientConfiguration.SessionId = result.sessionid();
+    }
+
+    std::vector<std::unique_ptr<DataStreamClient>> dataStreamClients{};
+    dataStreamClients.reserve(numberOfStreams);
+    for (uint32_t i = 0; i < numberOfStreams; i++) {
+        dataStreamClients.push_back(DataStreamClient::Create(direction, dataStreamingClient, dataStreamClientConfiguration));
+    }
+
+    std::cout << std::format("Running {} {} data stream(s) for {}s with {} byte data blocks\n", numberOfStreams, magic_enum::enum_name(direction), std::chrono::duration_cast<std::chrono::seconds>(configuration.Duration).count(), configuration.DataBlockSize);
+
+    const auto timeStart = std::chrono::steady_clock::now();
+    for (auto& dataStreamClient : dataStreamClients) {
+        dataStreamClient->Start();
+    }
+
+    // Report the progress at each interval until all data streams complete, canceling those that overrun.
+    const auto timeDeadline = timeStart + configuration.Duration + detail::DataStreamCompletionGracePeriod;
+    auto timeReportPrevious = timeStart;
+    DataStreamClientProgress progressPrevious{};
+    bool isCanceled{ false };
+
+    for (auto timeReport = timeStart + reportInterval;; timeReport += reportInterval) {
+        for (auto& dataStreamClient : dataStreamClients) {
+            const auto timeNow = std::chrono::steady_clock::now();
+            if (timeNow >= timeReport) {
+                break;
+            }
+            dataStreamClient->Await(std::chrono::duration_cast<std::chrono::milliseconds>(timeReport - timeNow));
+        }
+
+        const bool isDone = std::ranges::all_of(dataStreamClients, [](const auto& dataStreamClient) {
+            return dataStreamClient->IsDone();
+        });
+
+        const auto timeNow = std::chrono::steady_clock::now();
+        const auto progress = detail::SumProgress(dataStreamClients);
+        std::cout << detail::FormatDataStreamInterval(direction, timeReportPrevious - timeStart, timeNow - timeStart, progressPrevious, progress) << std::endl;
+        timeReportPrevious = timeNow;
+        progressPrevious = progress;
+
+        if (isDone) {
+            break;
+        }
+        if (timeNow >= timeDeadline && !isCanceled) {
+            std::cerr << "Data streams did not complete in time, canceling\n";
+            for (auto& dataStreamClient : dataStreamClients) {
+                dataStreamClient->Cancel();
+            }
+            isCanceled = true;
+        }
+    }
+
+    const std::chrono::duration<double> durationTotal = timeReportPrevious - timeStart;
+    std::cout << std::format("{:-<80}\n", "")
+              << detail::FormatDataStreamInterval(direction, std::chrono::duration<double>::zero(), durationTotal, DataStreamClientProgress{}, progressPrevious) << " (total)\n";
+
+    uint64_t goodputBitsPerSecondTotal{ 0 };
+    uint64_t numberOfDataBlocksReceivedTotal{ 0 };
+    uint64_t numberOfDataBlocksLostTotal{ 0 };
+    uint64_t numberOfDataBlocksDuplicatedTotal{ 0 };
+    uint64_t numberOfDataBlocksOutOfOrderTotal{ 0 };
+    for (std::size_t i = 0; i < std::size(dataStreamClients); i++) {
+        const auto& dataStreamClient = dataStreamClients[i];
+        const auto status = dataStreamClient->Await(std::chrono::milliseconds::zero());
+        if (status.has_value() && !status->ok()) {
+            std::cerr << std::format("Data stream {} failed ({})\n{}\n", i, magic_enum::enum_name(status->error_code()), status->error_message());
+            continue;
+        }
+
+        if (direction == DataStreamDirection::Upload) {
+            const auto& uploadResult = dataStreamClient->GetUploadResult();
+            goodputBitsPerSecondTotal += uploadResult.goodputbitspersecond();
+            numberOfDataBlocksReceivedTotal += uploadResult.numberofdatablocksreceived();
+            numberOfDataBlocksLostTotal += uploadResult.numberofdatablockslost();
+            numberOfDataBlocksDuplicatedTotal += uploadResult.numberofdatablocksduplicated();
+            numberOfDataBlocksOutOfOrderTotal += uploadResult.numberofdatablocksoutoforder();
+        }
+    }
+
+    if (direction == DataStreamDirection::Upload) {
+        std::cout << std::format("Server received {} data blocks ({} lost, {} duplicated, {} out of order), goodput {:.2f} Mbit/s\n",
+            numberOfDataBlocksReceivedTotal,
+            numberOfDataBlocksLostTotal,
+            numberOfDataBlocksDuplicatedTotal,
+            numberOfDataBlocksOutOfOrderTotal,
+            static_cast<double>(goodputBitsPerSecondTotal) / 1e6);
+    }
+
+    if (std::empty(dataStreamClientConfiguration.SessionId)) {
+        return;
+    }
+
+    DataStreamSessionResultRequest request{};
+    DataStreamSessionResult result{};
+    grpc::ClientContext clientContext{};
+
+    request.set_sessionid(dataStreamClientConfiguration.SessionId);
+    request.set_close(true);
+
+    auto status = dataStreamingClient->DataStreamSessionGetResult(&clientContext, request, &result);
+    if (!status.ok()) {
+        std::cerr << std::format("Failed to get data stream session result ({})\n{}\n", magic_enum::enum_name(status.error_code()), status.error_message());
+        return;
+    }
+    if (result.status().code() != DataStreamOperationStatusCode::DataStreamOperationStatusCodeSucceeded) {
+        std::cerr << std::format("Failed to get data stream session result ({})\n{}\n", magic_enum::enum_name(result.status().code()), result.status().message());
+        return;
+    }
+
+    std::cout << std::format("Session {}: {} streams, server goodput {:.2f} Mbit/s, fairness index {:.3f}\n",
+        result.sessionid(),
+        result.streams_size(),
+        static_cast<double>(result.goodputbitspersecond()) / 1e6,
+        result.fairnessindex());
+}
+
 std::unique_ptr<INetRemoteCliHandlerOperations>
 NetRemoteCliHandlerOperationsFactory::Create(std::shared_ptr<NetRemoteServerConnection> connection)
 {
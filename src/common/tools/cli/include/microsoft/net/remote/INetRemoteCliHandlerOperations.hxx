@@ -2,10 +2,13 @@
 #ifndef I_NET_REMOTE_CLI_HANDLER_OPERATIONS_HXX
 #define I_NET_REMOTE_CLI_HANDLER_OPERATIONS_HXX
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string_view>
 
 #include <microsoft/net/Ieee8021xRadiusAuthentication.hxx>
+#include <microsoft/net/remote/DataStreamClient.hxx>
 #include <microsoft/net/remote/NetRemoteServerConnection.hxx>
 #include <microsoft/net/wifi/Ieee80211AccessPointConfiguration.hxx>
 
@@ -81,6 +84,17 @@ struct INetRemoteCliHandlerOperations
      */
     virtual void
     WifiAccessPointSet8021xRadius(std::string_view accessPointId, const Microsoft::Net::Ieee8021xRadiusConfiguration* ieee8021xRadiusConfiguration) = 0;
+
+    /**
+     * @brief Run data streams against the server, periodically reporting their throughput.
+     *
+     * @param direction The direction of the data streams to run.
+     * @param configuration The configuration of each data stream.
+     * @param numberOfStreams The number of data streams to run in parallel, which are aggregated in a session.
+     * @param reportInterval The interval at which to report progress.
+     */
+    virtual void
+    DataStream(DataStreamDirection direction, const DataStreamClientConfiguration& configuration, uint32_t numberOfStreams, std::chrono::milliseconds reportInterval) = 0;
 };
 
 /**
@@ -2,10 +2,13 @@
 #ifndef NET_REMOTE_CLI_HXX
 #define NET_REMOTE_CLI_HXX
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
 
 #include <CLI/CLI.hpp>
 #include <microsoft/net/Ieee8021xRadiusAuthentication.hxx>
+#include <microsoft/net/remote/DataStreamClient.hxx>
 #include <microsoft/net/remote/NetRemoteCliData.hxx>
 #include <microsoft/net/remote/NetRemoteCliHandler.hxx>
 #include <microsoft/net/remote/NetRemoteServerConnection.hxx>
@@ -150,6 +153,25 @@ private:
     CLI::App*
     AddSubcommandWifiAccessPointSet8021xRadius(CLI::App* parent);
 
+    /**
+     * @brief Add the 'datastream' sub-command.
+     *
+     * @param parent The parent app to add the sub-command to.
+     * @return CLI::App*
+     */
+    CLI::App*
+    AddSubcommandDataStream(CLI::App* parent);
+
+    /**
+     * @brief Add a 'datastream' sub-command running data streams in the specified direction.
+     *
+     * @param parent The parent app to add the sub-command to.
+     * @param direction The direction of the data streams run by the sub-command.
+     * @return CLI::App*
+     */
+    CLI::App*
+    AddSubcommandDataStreamDirection(CLI::App* parent, DataStreamDirection direction);
+
     /**
      * @brief Handle the 'server' option.
      *
@@ -213,6 +235,17 @@ private:
     void
     OnWifiAccessPointDisable(std::string_view accessPointId);
 
+    /**
+     * @brief Handle the 'datastream upload|download|bidi' commands.
+     *
+     * @param direction The direction of the data streams to run.
+     * @param configuration The configuration of each data stream.
+     * @param numberOfStreams The number of data streams to run in parallel.
+     * @param reportInterval The interval at which to report progress.
+     */
+    void
+    OnDataStream(DataStreamDirection direction, const DataStreamClientConfiguration& configuration, uint32_t numberOfStreams, std::chrono::milliseconds reportInterval);
+
 private:
     std::shared_ptr<NetRemoteCliData> m_cliData;
     std::shared_ptr<NetRemoteCliHandler> m_cliHandler;
@@ -229,6 +262,10 @@ private:
     CLI::App* m_cliAppWifiAccessPointDisable{ nullptr };
     CLI::App* m_cliAppWifiAccessPointSetSsid{ nullptr };
     CLI::App* m_cliAppWifiAccessPointSetAuthenticationDot1x{ nullptr };
+    CLI::App* m_cliAppDataStream{ nullptr };
+    CLI::App* m_cliAppDataStreamUpload{ nullptr };
+    CLI::App* m_cliAppDataStreamDownload{ nullptr };
+    CLI::App* m_cliAppDataStreamBidirectional{ nullptr };
 };
 } // namespace Microsoft::Net::Remote
 
@@ -2,11 +2,15 @@
 #ifndef NET_REMOTE_CLI_DATA_HXX
 #define NET_REMOTE_CLI_DATA_HXX
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <tuple>
 #include <vector>
 
+#include <microsoft/net/remote/DataStreamClient.hxx>
 #include <microsoft/net/remote/protocol/NetRemoteProtocol.hxx>
 #include <microsoft/net/wifi/Ieee80211.hxx>
 #include <microsoft/net/wifi/Ieee80211Authentication.hxx>
@@ -34,6 +38,11 @@ struct NetRemoteCliData
     std::vector<Microsoft::Net::Wifi::Ieee80211AkmSuite> WifiAccessPointAkmSuites{};
     Microsoft::Net::Wifi::Ieee80211PhyType WifiAccessPointPhyType{ Microsoft::Net::Wifi::Ieee80211PhyType::Unknown };
     Microsoft::Net::Wifi::Ieee80211Authentication8021x WifiAccessPointAuthentication8021x{};
+
+    uint32_t DataStreamDurationSeconds{ 10 };
+    std::size_t DataStreamDataBlockSize{ DataStreamClientConfiguration::DataBlockSizeDefault };
+    uint32_t DataStreamNumberOfStreams{ 1 };
+    uint32_t DataStreamReportIntervalSeconds{ 1 };
 };
 } // namespace Microsoft::Net::Remote
 
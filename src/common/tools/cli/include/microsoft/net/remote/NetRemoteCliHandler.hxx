@@ -2,11 +2,14 @@
 #ifndef NET_REMOTE_CLI_HANDLER_HXX
 #define NET_REMOTE_CLI_HANDLER_HXX
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string_view>
 #include <tuple>
 
 #include <microsoft/net/Ieee8021xRadiusAuthentication.hxx>
+#include <microsoft/net/remote/DataStreamClient.hxx>
 #include <microsoft/net/remote/NetRemoteServerConnection.hxx>
 #include <microsoft/net/wifi/Ieee80211AccessPointConfiguration.hxx>
 
@@ -110,6 +113,17 @@ struct NetRemoteCliHandler
     void
     HandleCommandWifiAccessPointSet8021xRadius(std::string_view accessPointId, const Microsoft::Net::Ieee8021xRadiusConfiguration* ieee8021xRadiusConfiguration);
 
+    /**
+     * @brief Handle a command to run data streams against the server and report their throughput.
+     *
+     * @param direction The direction of the data streams to run.
+     * @param configuration The configuration of each data stream.
+     * @param numberOfStreams The number of data streams to run in parallel.
+     * @param reportInterval The interval at which to report progress.
+     */
+    void
+    HandleCommandDataStream(DataStreamDirection direction, const DataStreamClientConfiguration& configuration, uint32_t numberOfStreams, std::chrono::milliseconds reportInterval);
+
 private:
     /**
      * @brief Obtain a strong reference to the parent NetRemoteCli object. This is used to ensure that the parent object
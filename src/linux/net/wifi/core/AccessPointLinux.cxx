@@ -1,16 +1,25 @@
 
+#include <format>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <string>
 #include <string_view>
 #include <utility>
 
+#include <Wpa/Hostapd.hxx>
+#include <Wpa/HostapdEvent.hxx>
+#include <Wpa/IHostapd.hxx>
 #include <microsoft/net/netlink/nl80211/Netlink80211Interface.hxx>
 #include <microsoft/net/wifi/AccessPoint.hxx>
+#include <microsoft/net/wifi/AccessPointOperationStatus.hxx>
 #include <microsoft/net/wifi/IAccessPoint.hxx>
 #include <microsoft/net/wifi/IAccessPointController.hxx>
+#include <microsoft/net/wifi/Ieee80211.hxx>
 
 #include <microsoft/net/wifi/AccessPointControllerLinux.hxx>
 #include <microsoft/net/wifi/AccessPointLinux.hxx>
+#include <plog/Log.h>
 
 using Microsoft::Net::Netlink::Nl80211::Nl80211Interface;
 
@@ -28,6 +37,77 @@ AccessPointLinux::GetMacAddress() const noexcept
     return m_nl80211Interface.MacAddress;
 }
 
+void
+AccessPointLinux::SetOperationalStateChangedCallback(AccessPointOperationalStateChangedCallback operationalStateChangedCallback)
+{
+    const bool isCallbackSet{ operationalStateChangedCallback != nullptr };
+    AccessPoint::SetOperationalStateChangedCallback(std::move(operationalStateChangedCallback));
+
+    const std::scoped_lock hostapdLock{ m_hostapdGate };
+    m_isOperationalStateChangedCallbackSet = isCallbackSet;
+    UpdateHostapdConnectionLocked();
+}
+
+void
+AccessPointLinux::SetStationChangedCallback(AccessPointStationChangedCallback stationChangedCallback)
+{
+    const bool isCallbackSet{ stationChangedCallback != nullptr };
+    AccessPoint::SetStationChangedCallback(std::move(stationChangedCallback));
+
+    const std::scoped_lock hostapdLock{ m_hostapdGate };
+    m_isStationChangedCallbackSet = isCallbackSet;
+    UpdateHostapdConnectionLocked();
+}
+
+void
+AccessPointLinux::UpdateHostapdConnectionLocked()
+{
+    if (!m_isOperationalStateChangedCallbackSet && !m_isStationChangedCallbackSet) {
+        m_hostapd.reset();
+        return;
+    }
+
+    if (m_hostapd != nullptr) {
+        return;
+    }
+
+    try {
+        m_hostapd = std::make_unique<Wpa::Hostapd>(GetInterfaceName());
+        m_hostapd->SetEventCallback([this](const Wpa::HostapdEvent& hostapdEvent) {
+            OnHostapdEvent(hostapdEvent);
+        });
+    } catch (const Wpa::HostapdException& ex) {
+        LOGW << std::format("Failed to connect to hostapd for interface {}; access point events will not be reported ({})", GetInterfaceName(), ex.what());
+    }
+}
+
+void
+AccessPointLinux::OnHostapdEvent(const Wpa::HostapdEvent& hostapdEvent)
+{
+    switch (hostapdEvent.Type) {
+    case Wpa::HostapdEventType::ApEnabled:
+        OnOperationalStateChanged(AccessPointOperationalState::Enabled);
+        break;
+    case Wpa::HostapdEventType::ApDisabled:
+        OnOperationalStateChanged(AccessPointOperationalState::Disabled);
+        break;
+    case Wpa::HostapdEventType::StationConnected:
+    case Wpa::HostapdEventType::StationDisconnected: {
+        const auto stationMacAddress = Ieee80211MacAddressFromString(hostapdEvent.StationMacAddress);
+        if (!stationMacAddress.has_value()) {
+            LOGW << std::format("Ignoring hostapd station event for interface {} with invalid station mac address '{}'", GetInterfaceName(), hostapdEvent.StationMacAddress);
+            break;
+        }
+
+        const auto change = (hostapdEvent.Type == Wpa::HostapdEventType::StationConnected) ? AccessPointStationChange::Connected : AccessPointStationChange::Disconnected;
+        OnStationChanged(change, stationMacAddress.value());
+        break;
+    }
+    default:
+        break;
+    }
+}
+
 std::shared_ptr<IAccessPoint>
 AccessPointFactoryLinux::Create(std::string_view interfaceName, std::unique_ptr<IAccessPointCreateArgs> createArgs)
 {
@@ -3,8 +3,11 @@
 #define ACCESS_POINT_LINUX_HXX
 
 #include <memory>
+#include <mutex>
 #include <string_view>
 
+#include <Wpa/Hostapd.hxx>
+#include <Wpa/HostapdEvent.hxx>
 #include <microsoft/net/netlink/nl80211/Netlink80211Interface.hxx>
 #include <microsoft/net/wifi/AccessPoint.hxx>
 #include <microsoft/net/wifi/IAccessPoint.hxx>
@@ -38,8 +41,49 @@ struct AccessPointLinux :
     Ieee80211MacAddress
     GetMacAddress() const noexcept override;
 
+    /**
+     * @brief Set the callback to invoke when the operational state of the access point changes.
+     *
+     * Operational state changes are observed through the AP-ENABLED and AP-DISABLED events from hostapd, so a
+     * connection to hostapd is kept open while a callback is set.
+     *
+     * @param operationalStateChangedCallback The callback to invoke, or nullptr to stop invoking a callback.
+     */
+    void
+    SetOperationalStateChangedCallback(AccessPointOperationalStateChangedCallback operationalStateChangedCallback) override;
+
+    /**
+     * @brief Set the callback to invoke when a station connects to or disconnects from the access point.
+     *
+     * Stations are observed through the AP-STA-CONNECTED and AP-STA-DISCONNECTED events from hostapd, so a connection
+     * to hostapd is kept open while a callback is set.
+     *
+     * @param stationChangedCallback The callback to invoke, or nullptr to stop invoking a callback.
+     */
+    void
+    SetStationChangedCallback(AccessPointStationChangedCallback stationChangedCallback) override;
+
+private:
+    /**
+     * @brief Open the connection to hostapd if any callback is set, or close it otherwise. m_hostapdGate must be held.
+     */
+    void
+    UpdateHostapdConnectionLocked();
+
+    /**
+     * @brief Invoked when an interpreted event is received from hostapd.
+     *
+     * @param hostapdEvent The event received.
+     */
+    void
+    OnHostapdEvent(const Wpa::HostapdEvent& hostapdEvent);
+
 private:
     Microsoft::Net::Netlink::Nl80211::Nl80211Interface m_nl80211Interface;
+    std::mutex m_hostapdGate;
+    bool m_isOperationalStateChangedCallbackSet{ false };
+    bool m_isStationChangedCallbackSet{ false };
+    std::unique_ptr<Wpa::Hostapd> m_hostapd{ nullptr };
 };
 
 /**
@@ -1,6 +1,7 @@
 
 #include <cstdint>
 #include <format>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <string_view>
@@ -9,6 +10,7 @@
 #include <vector>
 
 #include <Wpa/Hostapd.hxx>
+#include <Wpa/HostapdEvent.hxx>
 #include <Wpa/IHostapd.hxx>
 #include <Wpa/ProtocolHostapd.hxx>
 #include <Wpa/WpaCommand.hxx>
@@ -58,6 +60,7 @@ Hostapd::Hostapd(std::string_view interfaceName) :
 
 Hostapd::~Hostapd()
 {
+    SetEventCallback(nullptr);
     m_eventHandler->UnregisterEventListener(m_eventHandlerRegistrationToken);
 }
 
@@ -555,4 +558,22 @@ Hostapd::OnWpaEvent(WpaEventSender* sender, const WpaEventArgs* eventArgs)
     const auto& event{ eventArgs->Event };
     LOGD << std::format("> [{}-Event|{}|{}|Sender={:#08x}] {}", magic_enum::enum_name(event.Source), magic_enum::enum_name(event.LogLevel), eventArgs->Timestamp, reinterpret_cast<uintptr_t>(sender), event.Payload);
     AUDITI << std::format("> [{}-Event|{}|{}|Sender={:#08x}] {}", magic_enum::enum_name(event.Source), magic_enum::enum_name(event.LogLevel), eventArgs->Timestamp, reinterpret_cast<uintptr_t>(sender), event.Payload);
+
+    auto hostapdEvent = HostapdEvent::Parse(event.Payload);
+    if (!hostapdEvent.has_value()) {
+        return;
+    }
+
+    // Invoke the callback with the lock held so it cannot be invoked once SetEventCallback() returns.
+    const std::scoped_lock eventCallbackLock{ m_eventCallbackGate };
+    if (m_eventCallback) {
+        m_eventCallback(hostapdEvent.value());
+    }
+}
+
+void
+Hostapd::SetEventCallback(HostapdEventCallback eventCallback)
+{
+    const std::scoped_lock eventCallbackLock{ m_eventCallbackGate };
+    m_eventCallback = std::move(eventCallback);
 }
@@ -0,0 +1,86 @@
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <Wpa/HostapdEvent.hxx>
+#include <Wpa/ProtocolHostapd.hxx>
+
+using namespace Wpa;
+
+namespace detail
+{
+/**
+ * @brief Determine whether an event payload is for the specified event.
+ *
+ * Event payloads start with the event name, optionally followed by a space and event-specific arguments.
+ *
+ * @param eventPayload The event payload.
+ * @param eventName The name of the event.
+ * @return true If the payload is for the specified event.
+ * @return false Otherwise.
+ */
+bool
+IsEvent(std::string_view eventPayload, std::string_view eventName) noexcept
+{
+    return eventPayload.starts_with(eventName) && (std::size(eventPayload) == std::size(eventName) || eventPayload[std::size(eventName)] == ' ');
+}
+
+/**
+ * @brief Get the first argument of an event payload, which is delimited by a space or the end of the payload.
+ *
+ * @param eventPayload The event payload.
+ * @param eventName The name of the event, which the payload must be for.
+ * @return std::string_view The first argument, or an empty view if the event has no arguments.
+ */
+std::string_view
+GetEventArgumentFirst(std::string_view eventPayload, std::string_view eventName) noexcept
+{
+    if (std::size(eventPayload) <= std::size(eventName)) {
+        return {};
+    }
+
+    auto eventArguments = eventPayload.substr(std::size(eventName) + 1);
+    return eventArguments.substr(0, eventArguments.find(' '));
+}
+
+/**
+ * @brief Parse a station event, whose first argument is the mac address of the station (eg. 'AP-STA-CONNECTED
+ * 00:11:22:33:44:55 keyid=1').
+ *
+ * @param eventPayload The event payload.
+ * @param eventName The name of the event, which the payload must be for.
+ * @param eventType The type of the event.
+ * @return std::optional<HostapdEvent> The parsed event, or std::nullopt if the payload has no station mac address.
+ */
+std::optional<HostapdEvent>
+ParseStationEvent(std::string_view eventPayload, std::string_view eventName, HostapdEventType eventType)
+{
+    const auto stationMacAddress = GetEventArgumentFirst(eventPayload, eventName);
+    if (std::empty(stationMacAddress)) {
+        return std::nullopt;
+    }
+
+    return HostapdEvent{ .Type = eventType, .StationMacAddress = std::string(stationMacAddress) };
+}
+} // namespace detail
+
+/* static */
+std::optional<HostapdEvent>
+HostapdEvent::Parse(std::string_view eventPayload)
+{
+    if (detail::IsEvent(eventPayload, ProtocolHostapd::EventPayloadApEnabled)) {
+        return HostapdEvent{ .Type = HostapdEventType::ApEnabled };
+    }
+    if (detail::IsEvent(eventPayload, ProtocolHostapd::EventPayloadApDisabled)) {
+        return HostapdEvent{ .Type = HostapdEventType::ApDisabled };
+    }
+    if (detail::IsEvent(eventPayload, ProtocolHostapd::EventPayloadStationConnected)) {
+        return detail::ParseStationEvent(eventPayload, ProtocolHostapd::EventPayloadStationConnected, HostapdEventType::StationConnected);
+    }
+    if (detail::IsEvent(eventPayload, ProtocolHostapd::EventPayloadStationDisconnected)) {
+        return detail::ParseStationEvent(eventPayload, ProtocolHostapd::EventPayloadStationDisconnected, HostapdEventType::StationDisconnected);
+    }
+
+    return std::nullopt;
+}
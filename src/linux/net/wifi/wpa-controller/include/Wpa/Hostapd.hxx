@@ -2,10 +2,13 @@
 #ifndef HOSTAPD_HXX
 #define HOSTAPD_HXX
 
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
 
+#include <Wpa/HostapdEvent.hxx>
 #include <Wpa/IHostapd.hxx>
 #include <Wpa/IWpaEventListener.hxx>
 #include <Wpa/ProtocolHostapd.hxx>
@@ -17,6 +20,11 @@
 
 namespace Wpa
 {
+/**
+ * @brief Callback invoked when an interpreted hostapd event is received.
+ */
+using HostapdEventCallback = std::function<void(const HostapdEvent&)>;
+
 /**
  * @brief Concrete implementation of the IHostapd interface.
  */
@@ -271,6 +279,18 @@ struct Hostapd :
     std::string_view
     GetIpAddress() const noexcept;
 
+    /**
+     * @brief Set the callback to invoke when an interpreted event is received from hostapd. This replaces any
+     * previously set callback.
+     *
+     * The callback is invoked on the event handler thread and must not call this function. Once this function returns,
+     * the previous callback will not be invoked again.
+     *
+     * @param eventCallback The callback to invoke, or nullptr to stop invoking a callback.
+     */
+    void
+    SetEventCallback(HostapdEventCallback eventCallback);
+
 private:
     /**
      * @brief Invoked when a WPA event is received.
@@ -289,6 +309,8 @@ private:
     std::shared_ptr<WpaEventListenerProxy> m_eventListenerProxy;
     std::shared_ptr<WpaEventHandler> m_eventHandler{ nullptr };
     WpaEventListenerRegistrationToken m_eventHandlerRegistrationToken{};
+    std::mutex m_eventCallbackGate;
+    HostapdEventCallback m_eventCallback{ nullptr };
 };
 } // namespace Wpa
 
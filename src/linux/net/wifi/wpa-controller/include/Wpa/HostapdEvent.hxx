@@ -0,0 +1,43 @@
+
+#ifndef HOSTAPD_EVENT_HXX
+#define HOSTAPD_EVENT_HXX
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace Wpa
+{
+/**
+ * @brief The types of hostapd events that are interpreted.
+ */
+enum class HostapdEventType {
+    Unknown,
+    ApEnabled,
+    ApDisabled,
+    StationConnected,
+    StationDisconnected,
+};
+
+/**
+ * @brief Represents an unsolicited event from hostapd whose payload has been interpreted.
+ */
+struct HostapdEvent
+{
+    HostapdEventType Type{ HostapdEventType::Unknown };
+
+    // The mac address of the station, for station events. Colon separated hex string with 6 bytes, eg. '%02x:%02x:%02x:%02x:%02x:%02x'.
+    std::string StationMacAddress{};
+
+    /**
+     * @brief Parse the payload of a WPA event into a HostapdEvent.
+     *
+     * @param eventPayload The event payload to parse, excluding the log level and interface name prefix.
+     * @return std::optional<HostapdEvent> The parsed event, or std::nullopt if the payload is not an interpreted event.
+     */
+    static std::optional<HostapdEvent>
+    Parse(std::string_view eventPayload);
+};
+} // namespace Wpa
+
+#endif // HOSTAPD_EVENT_HXX
@@ -709,6 +709,12 @@ struct ProtocolHostapd :
     static constexpr auto ResponseGetConfigPropertyKeyGroupCipher = PropertyNameGroupCipher;
     static constexpr auto ResponseGetConfigPropertyKeyRsnPairwiseCipher = PropertyNameRsnPairwiseCipher;
     static constexpr auto ResponseGetConfigPropertyKeyWpaPairwiseCipher = PropertyNameWpaPairwiseCipher;
+
+    // Payload prefixes of unsolicited events.
+    static constexpr auto EventPayloadApEnabled = "AP-ENABLED";
+    static constexpr auto EventPayloadApDisabled = "AP-DISABLED";
+    static constexpr auto EventPayloadStationConnected = "AP-STA-CONNECTED";
+    static constexpr auto EventPayloadStationDisconnected = "AP-STA-DISCONNECTED";
 };
 
 /**
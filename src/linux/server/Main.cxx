@@ -186,10 +186,10 @@ main(int argc, char *argv[])
             });
         }
 
+        // Stop the server through NetRemoteServer so that open watches are finished; otherwise the shutdown would
+        // wait for clients to cancel them.
         LOGN << "Netremote server stopping";
-        auto &grpcServer = server.GetGrpcServer();
-        grpcServer->Shutdown();
-        grpcServer->Wait();
+        server.Stop();
     }
 
     LOGN << "Netremote server stopped";
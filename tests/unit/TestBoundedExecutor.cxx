@@ -0,0 +1,113 @@
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <latch>
+#include <thread>
+
+#include <catch2/catch_test_macros.hpp>
+#include <microsoft/net/remote/service/BoundedExecutor.hxx>
+
+TEST_CASE("BoundedExecutor runs submitted tasks", "[service][executor]")
+{
+    using namespace Microsoft::Net::Remote::Service;
+
+    SECTION("Tasks run on an executor thread")
+    {
+        BoundedExecutor executor{};
+
+        std::promise<std::thread::id> threadIdPromise{};
+        auto threadIdFuture = threadIdPromise.get_future();
+        REQUIRE(executor.TrySubmit([&] {
+            threadIdPromise.set_value(std::this_thread::get_id());
+        }));
+
+        REQUIRE(threadIdFuture.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+        REQUIRE(threadIdFuture.get() != std::this_thread::get_id());
+    }
+
+    SECTION("Tasks run concurrently up to the number of threads")
+    {
+        static constexpr std::size_t NumberOfThreads{ 3 };
+
+        BoundedExecutor executor{ BoundedExecutorConfiguration{ .NumberOfThreads = NumberOfThreads } };
+
+        // Each task waits for all the others to start, which only completes if they run at the same time.
+        std::latch tasksStarted{ NumberOfThreads };
+        std::atomic<std::size_t> numberOfTasksCompleted{ 0 };
+        for (std::size_t i = 0; i < NumberOfThreads; i++) {
+            REQUIRE(executor.TrySubmit([&] {
+                tasksStarted.arrive_and_wait();
+                numberOfTasksCompleted++;
+            }));
+        }
+
+        const auto timeEnd = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (numberOfTasksCompleted < NumberOfThreads && std::chrono::steady_clock::now() < timeEnd) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        REQUIRE(numberOfTasksCompleted == NumberOfThreads);
+    }
+
+    SECTION("Queued tasks run when the executor is destroyed")
+    {
+        static constexpr std::size_t NumberOfTasks{ 10 };
+
+        std::atomic<std::size_t> numberOfTasksCompleted{ 0 };
+        {
+            BoundedExecutor executor{ BoundedExecutorConfiguration{ .NumberOfThreads = 1, .QueueDepthMaximum = NumberOfTasks } };
+            for (std::size_t i = 0; i < NumberOfTasks; i++) {
+                REQUIRE(executor.TrySubmit([&] {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    numberOfTasksCompleted++;
+                }));
+            }
+        }
+
+        REQUIRE(numberOfTasksCompleted == NumberOfTasks);
+    }
+}
+
+TEST_CASE("BoundedExecutor rejects tasks beyond its queue depth", "[service][executor]")
+{
+    using namespace Microsoft::Net::Remote::Service;
+
+    static constexpr std::size_t QueueDepthMaximum{ 2 };
+
+    BoundedExecutor executor{ BoundedExecutorConfiguration{ .NumberOfThreads = 1, .QueueDepthMaximum = QueueDepthMaximum } };
+
+    // Occupy the only thread so that further tasks remain queued.
+    std::promise<void> blockingTaskStarted{};
+    std::promise<void> blockingTaskRelease{};
+    auto blockingTaskReleaseFuture = blockingTaskRelease.get_future();
+    REQUIRE(executor.TrySubmit([&] {
+        blockingTaskStarted.set_value();
+        blockingTaskReleaseFuture.wait();
+    }));
+    REQUIRE(blockingTaskStarted.get_future().wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+
+    std::atomic<std::size_t> numberOfTasksCompleted{ 0 };
+    for (std::size_t i = 0; i < QueueDepthMaximum; i++) {
+        REQUIRE(executor.TrySubmit([&] {
+            numberOfTasksCompleted++;
+        }));
+    }
+
+    REQUIRE(executor.GetQueueDepth() == QueueDepthMaximum);
+    REQUIRE_FALSE(executor.TrySubmit([&] {
+        numberOfTasksCompleted++;
+    }));
+    REQUIRE(executor.GetNumberOfTasksRejected() == 1);
+
+    blockingTaskRelease.set_value();
+
+    const auto timeEnd = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (numberOfTasksCompleted < QueueDepthMaximum && std::chrono::steady_clock::now() < timeEnd) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    REQUIRE(numberOfTasksCompleted == QueueDepthMaximum);
+    REQUIRE(executor.GetQueueDepth() == 0);
+}
@@ -0,0 +1,111 @@
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+
+#include <catch2/catch_test_macros.hpp>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/security/credentials.h>
+#include <grpcpp/support/status.h>
+#include <microsoft/net/remote/DataStreamClient.hxx>
+#include <microsoft/net/remote/protocol/NetRemoteDataStream.pb.h>
+#include <microsoft/net/remote/protocol/NetRemoteDataStreamingService.grpc.pb.h>
+#include <microsoft/net/remote/service/NetRemoteServer.hxx>
+#include <microsoft/net/remote/service/NetRemoteServerConfiguration.hxx>
+
+#include "TestNetRemoteCommon.hxx"
+
+using namespace Microsoft::Net::Remote::Test;
+
+TEST_CASE("DataStreamClient runs timed data streams", "[basic][rpc][client][remote][stream]")
+{
+    using namespace Microsoft::Net::Remote;
+    using namespace Microsoft::Net::Remote::DataStream;
+    using namespace Microsoft::Net::Remote::Service;
+
+    static constexpr std::size_t DataBlockSize{ 1024 };
+    static constexpr auto Duration{ std::chrono::milliseconds(200) };
+    static constexpr auto AwaitTimeout{ std::chrono::seconds(10) };
+
+    const auto serverConfiguration = CreateServerConfiguration();
+    NetRemoteServer server{ serverConfiguration };
+    server.Run();
+
+    auto channel = grpc::CreateChannel(RemoteServiceAddressHttp, grpc::InsecureChannelCredentials());
+    auto client = NetRemoteDataStreaming::NewStub(channel);
+
+    const DataStreamClientConfiguration configuration{
+        .Duration = Duration,
+        .DataBlockSize = DataBlockSize,
+    };
+
+    SECTION("Upload sends data for the configured duration")
+    {
+        auto dataStreamClient = DataStreamClient::Create(DataStreamDirection::Upload, client.get(), configuration);
+        dataStreamClient->Start();
+
+        const auto status = dataStreamClient->Await(AwaitTimeout);
+        REQUIRE(status.has_value());
+        REQUIRE(status->ok());
+        REQUIRE(dataStreamClient->IsDone());
+
+        const auto progress = dataStreamClient->GetProgress();
+        REQUIRE(progress.NumberOfDataBlocksSent > 0);
+        REQUIRE(progress.NumberOfBytesSent == progress.NumberOfDataBlocksSent * DataBlockSize);
+        REQUIRE(progress.NumberOfDataBlocksReceived == 0);
+
+        const auto& uploadResult = dataStreamClient->GetUploadResult();
+        REQUIRE(uploadResult.status().code() == DataStreamOperationStatusCodeSucceeded);
+        REQUIRE(uploadResult.numberofdatablocksreceived() == progress.NumberOfDataBlocksSent);
+        REQUIRE(uploadResult.numberofdatablockslost() == 0);
+    }
+
+    SECTION("Download receives data for the configured duration")
+    {
+        auto dataStreamClient = DataStreamClient::Create(DataStreamDirection::Download, client.get(), configuration);
+        dataStreamClient->Start();
+
+        const auto status = dataStreamClient->Await(AwaitTimeout);
+        REQUIRE(status.has_value());
+        REQUIRE(status->ok());
+
+        const auto progress = dataStreamClient->GetProgress();
+        REQUIRE(progress.NumberOfDataBlocksReceived > 0);
+        REQUIRE(progress.NumberOfBytesReceived == progress.NumberOfDataBlocksReceived * DataBlockSize);
+        REQUIRE(progress.NumberOfDataBlocksSent == 0);
+    }
+
+    SECTION("Bidirectional sends and receives data concurrently")
+    {
+        auto dataStreamClient = DataStreamClient::Create(DataStreamDirection::Bidirectional, client.get(), configuration);
+        dataStreamClient->Start();
+
+        const auto status = dataStreamClient->Await(AwaitTimeout);
+        REQUIRE(status.has_value());
+        REQUIRE(status->ok());
+
+        const auto progress = dataStreamClient->GetProgress();
+        REQUIRE(progress.NumberOfDataBlocksSent > 0);
+        REQUIRE(progress.NumberOfDataBlocksReceived > 0);
+    }
+
+    SECTION("Cancelation completes the data stream early")
+    {
+        auto dataStreamClient = DataStreamClient::Create(DataStreamDirection::Download, client.get(), DataStreamClientConfiguration{ .Duration = std::chrono::seconds(60) });
+        dataStreamClient->Start();
+        REQUIRE_FALSE(dataStreamClient->Await(std::chrono::milliseconds(100)).has_value());
+
+        dataStreamClient->Cancel();
+        const auto status = dataStreamClient->Await(AwaitTimeout);
+        REQUIRE(status.has_value());
+        REQUIRE(status->error_code() == grpc::StatusCode::CANCELLED);
+    }
+
+    SECTION("Destroying a running data stream cancels it")
+    {
+        auto dataStreamClient = DataStreamClient::Create(DataStreamDirection::Upload, client.get(), DataStreamClientConfiguration{ .Duration = std::chrono::seconds(60) });
+        dataStreamClient->Start();
+        REQUIRE_NOTHROW(dataStreamClient.reset());
+    }
+}
@@ -0,0 +1,180 @@
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <format>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <grpcpp/impl/codegen/proto_utils.h>
+#include <grpcpp/support/byte_buffer.h>
+#include <grpcpp/support/slice.h>
+#include <microsoft/net/remote/protocol/NetRemoteDataStream.pb.h>
+#include <microsoft/net/remote/service/DataStreamDownloadDataEncoder.hxx>
+#include <plog/Log.h>
+
+namespace detail
+{
+/**
+ * @brief Deserialize a DataStreamDownloadData message.
+ *
+ * @param buffer The serialized message.
+ * @param data Receives the message.
+ * @return true If the message was deserialized successfully.
+ * @return false Otherwise.
+ */
+bool
+Deserialize(grpc::ByteBuffer buffer, Microsoft::Net::Remote::DataStream::DataStreamDownloadData& data)
+{
+    return grpc::SerializationTraits<Microsoft::Net::Remote::DataStream::DataStreamDownloadData>::Deserialize(&buffer, &data).ok();
+}
+} // namespace detail
+
+TEST_CASE("DataStreamDownloadDataEncoder encodes messages", "[service][datastream]")
+{
+    using namespace Microsoft::Net::Remote::DataStream;
+    using Microsoft::Net::Remote::Service::DataStreamDownloadDataEncoder;
+
+    DataStreamDownloadData header{};
+    header.set_sequencenumber(42);
+    header.mutable_status()->set_code(DataStreamOperationStatusCode::DataStreamOperationStatusCodeSucceeded);
+    header.mutable_status()->set_message("Data write successful");
+
+    SECTION("Encoded message is parsed as a regular message")
+    {
+        for (const std::size_t dataSize : { 1, 127, 128, 16384, 1024 * 1024 }) {
+            const std::string content(dataSize, 'x');
+
+            DataStreamDownloadData data{};
+            REQUIRE(detail::Deserialize(DataStreamDownloadDataEncoder::Encode(header, grpc::Slice(content)), data));
+            REQUIRE(data.sequencenumber() == header.sequencenumber());
+            REQUIRE(data.status().code() == header.status().code());
+            REQUIRE(data.status().message() == header.status().message());
+            REQUIRE(data.data() == content);
+        }
+    }
+
+    SECTION("Encoded message without data is parsed as a regular message")
+    {
+        DataStreamDownloadData data{};
+        REQUIRE(detail::Deserialize(DataStreamDownloadDataEncoder::Encode(header, grpc::Slice{}), data));
+        REQUIRE(data.sequencenumber() == header.sequencenumber());
+        REQUIRE(data.status().message() == header.status().message());
+        REQUIRE(std::empty(data.data()));
+    }
+
+    SECTION("Encoded message matches the message serialized by protobuf")
+    {
+        const std::string content(1000, 'y');
+
+        DataStreamDownloadData messageExpected{ header };
+        messageExpected.set_data(content);
+
+        DataStreamDownloadData data{};
+        REQUIRE(detail::Deserialize(DataStreamDownloadDataEncoder::Encode(header, grpc::Slice(content)), data));
+        REQUIRE(data.SerializeAsString() == messageExpected.SerializeAsString());
+    }
+
+    SECTION("Data is not copied")
+    {
+        const auto dataSlice = grpc::Slice(std::string(4096, 'z'));
+        const auto buffer = DataStreamDownloadDataEncoder::Encode(header, dataSlice);
+
+        std::vector<grpc::Slice> slices{};
+        REQUIRE(buffer.Dump(&slices).ok());
+        REQUIRE(std::size(slices) == 2);
+        REQUIRE(slices[1].begin() == dataSlice.begin());
+        REQUIRE(buffer.Length() == slices[0].size() + dataSlice.size());
+    }
+
+    SECTION("Multiple data slices are packed into a single data field without being copied")
+    {
+        const std::string content(1000, 'w');
+        const std::array<grpc::Slice, 3> dataSlices{ grpc::Slice(content.substr(0, 300)), grpc::Slice{}, grpc::Slice(content.substr(300)) };
+        const auto buffer = DataStreamDownloadDataEncoder::Encode(header, dataSlices);
+
+        DataStreamDownloadData messageExpected{ header };
+        messageExpected.set_data(content);
+
+        DataStreamDownloadData data{};
+        REQUIRE(detail::Deserialize(buffer, data));
+        REQUIRE(data.SerializeAsString() == messageExpected.SerializeAsString());
+
+        // Empty slices are skipped.
+        std::vector<grpc::Slice> slices{};
+        REQUIRE(buffer.Dump(&slices).ok());
+        REQUIRE(std::size(slices) == 3);
+        REQUIRE(slices[1].begin() == dataSlices[0].begin());
+        REQUIRE(slices[2].begin() == dataSlices[2].begin());
+    }
+}
+
+TEST_CASE("DataStreamDownloadDataEncoder performance", "[service][datastream][benchmark][.]")
+{
+    using namespace Microsoft::Net::Remote::DataStream;
+    using Microsoft::Net::Remote::Service::DataStreamDownloadDataEncoder;
+
+    DataStreamDownloadData header{};
+    header.set_sequencenumber(1);
+    header.mutable_status()->set_code(DataStreamOperationStatusCode::DataStreamOperationStatusCodeSucceeded);
+    header.mutable_status()->set_message("Data write successful");
+
+    SECTION("CPU time per GB")
+    {
+        static constexpr std::size_t NumberOfBytesToEncode{ 4ULL * 1024 * 1024 * 1024 };
+
+        for (const std::size_t dataBlockSize : { 1024, 64 * 1024, 1024 * 1024 }) {
+            const std::string dataBlock(dataBlockSize, 'x');
+            const auto dataBlockSlice = grpc::Slice(dataBlock);
+            const std::size_t numberOfDataBlocks = NumberOfBytesToEncode / dataBlockSize;
+
+            // Serialize the complete message each time, copying the data block into it first, as a typed writer does.
+            std::size_t numberOfBytesSerialized{ 0 };
+            const auto cpuTimeSerializeStart = std::clock();
+            for (std::size_t i = 0; i < numberOfDataBlocks; i++) {
+                DataStreamDownloadData data{ header };
+                data.set_data(dataBlock);
+                grpc::ByteBuffer buffer{};
+                bool ownsBuffer{ false };
+                grpc::SerializationTraits<DataStreamDownloadData>::Serialize(data, &buffer, &ownsBuffer);
+                numberOfBytesSerialized += buffer.Length();
+            }
+            const auto cpuTimeSerializeEnd = std::clock();
+
+            std::size_t numberOfBytesEncoded{ 0 };
+            const auto cpuTimeEncodeStart = std::clock();
+            for (std::size_t i = 0; i < numberOfDataBlocks; i++) {
+                numberOfBytesEncoded += DataStreamDownloadDataEncoder::Encode(header, dataBlockSlice).Length();
+            }
+            const auto cpuTimeEncodeEnd = std::clock();
+
+            REQUIRE(numberOfBytesEncoded == numberOfBytesSerialized);
+
+            const double gigabytes = static_cast<double>(numberOfDataBlocks * dataBlockSize) / 1e9;
+            const double cpuMillisecondsPerGigabyteSerialize = (1000.0 * static_cast<double>(cpuTimeSerializeEnd - cpuTimeSerializeStart) / CLOCKS_PER_SEC) / gigabytes;
+            const double cpuMillisecondsPerGigabyteEncode = (1000.0 * static_cast<double>(cpuTimeEncodeEnd - cpuTimeEncodeStart) / CLOCKS_PER_SEC) / gigabytes;
+            LOGI << std::format("DataStreamDownloadData {} byte blocks: serialize {:.2f} CPU ms/GB, encode {:.2f} CPU ms/GB", dataBlockSize, cpuMillisecondsPerGigabyteSerialize, cpuMillisecondsPerGigabyteEncode);
+        }
+    }
+
+    const std::string dataBlock(64 * 1024, 'x');
+    const auto dataBlockSlice = grpc::Slice(dataBlock);
+
+    BENCHMARK("Serialize DataStreamDownloadData 64 KiB (reference)")
+    {
+        DataStreamDownloadData data{ header };
+        data.set_data(dataBlock);
+        grpc::ByteBuffer buffer{};
+        bool ownsBuffer{ false };
+        grpc::SerializationTraits<DataStreamDownloadData>::Serialize(data, &buffer, &ownsBuffer);
+        return buffer.Length();
+    };
+
+    BENCHMARK("DataStreamDownloadDataEncoder::Encode 64 KiB")
+    {
+        return DataStreamDownloadDataEncoder::Encode(header, dataBlockSlice).Length();
+    };
+}
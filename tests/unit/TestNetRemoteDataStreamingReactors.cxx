@@ -1,15 +1,25 @@
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <format>
 #include <mutex>
+#include <optional>
 #include <span>
 #include <utility>
 
+#include <google/protobuf/util/time_util.h>
+#include <grpcpp/client_context.h>
 #include <grpcpp/impl/codegen/status.h>
 #include <magic_enum.hpp>
+#include <microsoft/net/remote/datastream/DataPatternGenerator.hxx>
+#include <microsoft/net/remote/datastream/Histogram.hxx>
+#include <microsoft/net/remote/datastream/LatencyStatistics.hxx>
 #include <microsoft/net/remote/protocol/NetRemoteDataStream.pb.h>
 #include <microsoft/net/remote/protocol/NetRemoteDataStreamingService.grpc.pb.h>
+#include <microsoft/net/remote/service/NetRemoteDataStreamingService.hxx>
 #include <plog/Log.h>
 
 #include "TestNetRemoteDataStreamingReactors.hxx"
@@ -18,6 +28,90 @@ using namespace Microsoft::Net::Remote::DataStream;
 using namespace Microsoft::Net::Remote::Service;
 using namespace Microsoft::Net::Remote::Test;
 
+namespace detail
+{
+/**
+ * @brief Convert a data stream pattern to the corresponding verifiable data pattern.
+ *
+ * @param pattern The data stream pattern to convert.
+ * @return std::optional<DataPattern>
+ */
+std::optional<DataPattern>
+ToExpectedDataPattern(DataStreamPattern pattern) noexcept
+{
+    switch (pattern) {
+    case DataStreamPattern::DataStreamPatternPseudoRandom:
+        return DataPattern::PseudoRandom;
+    case DataStreamPattern::DataStreamPatternCounter:
+        return DataPattern::Counter;
+    case DataStreamPattern::DataStreamPatternZeros:
+        return DataPattern::Zeros;
+    case DataStreamPattern::DataStreamPatternOnes:
+        return DataPattern::Ones;
+    default:
+        return std::nullopt;
+    }
+}
+
+/**
+ * @brief Convert a verifiable data pattern to the corresponding data stream pattern.
+ *
+ * @param dataPattern The verifiable data pattern to convert.
+ * @return DataStreamPattern
+ */
+DataStreamPattern
+ToDataStreamPattern(DataPattern dataPattern) noexcept
+{
+    switch (dataPattern) {
+    case DataPattern::PseudoRandom:
+        return DataStreamPattern::DataStreamPatternPseudoRandom;
+    case DataPattern::Counter:
+        return DataStreamPattern::DataStreamPatternCounter;
+    case DataPattern::Zeros:
+        return DataStreamPattern::DataStreamPatternZeros;
+    case DataPattern::Ones:
+        return DataStreamPattern::DataStreamPatternOnes;
+    default:
+        return DataStreamPattern::DataStreamPatternUnknown;
+    }
+}
+
+/**
+ * @brief Convert a protobuf timestamp to a system clock time point.
+ *
+ * @param timestamp The timestamp to convert.
+ * @return std::chrono::system_clock::time_point
+ */
+std::chrono::system_clock::time_point
+ToSystemTimePoint(const google::protobuf::Timestamp& timestamp) noexcept
+{
+    const auto timeSinceEpoch = std::chrono::nanoseconds(google::protobuf::util::TimeUtil::TimestampToNanoseconds(timestamp));
+    return std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(timeSinceEpoch));
+}
+/**
+ * @brief Get the write completion latencies the server returned in the trailing metadata of a data stream.
+ *
+ * @param clientContext The context of the completed RPC.
+ * @return std::optional<DataStreamHistogram> The latencies, or std::nullopt if the server did not return them.
+ */
+std::optional<DataStreamHistogram>
+GetWriteCompletionLatencyHistogram(const grpc::ClientContext& clientContext)
+{
+    const auto& trailingMetadata = clientContext.GetServerTrailingMetadata();
+    const auto metadata = trailingMetadata.find(NetRemoteDataStreamingService::WriteCompletionLatencyMetadataKey);
+    if (metadata == std::cend(trailingMetadata)) {
+        return std::nullopt;
+    }
+
+    DataStreamHistogram writeCompletionLatency{};
+    if (!writeCompletionLatency.ParseFromArray(std::data(metadata->second), static_cast<int>(std::size(metadata->second)))) {
+        return std::nullopt;
+    }
+
+    return writeCompletionLatency;
+}
+} // namespace detail
+
 DataStreamWriter::DataStreamWriter(NetRemoteDataStreaming::Stub* client, uint32_t numberOfDataBlocksToWrite) :
     m_numberOfDataBlocksToWrite(numberOfDataBlocksToWrite)
 {
@@ -26,10 +120,49 @@ DataStreamWriter::DataStreamWriter(NetRemoteDataStreaming::Stub* client, uint32_
     NextWrite();
 }
 
+DataStreamWriter::DataStreamWriter(NetRemoteDataStreaming::Stub* client, uint32_t numberOfDataBlocksToWrite, DataPattern dataPattern, uint64_t seed, std::size_t dataBlockSize, uint32_t sequenceNumberToCorrupt) :
+    m_numberOfDataBlocksToWrite(numberOfDataBlocksToWrite),
+    m_dataBlockSize(dataBlockSize),
+    m_sequenceNumberToCorrupt(sequenceNumberToCorrupt),
+    m_dataPatternGenerator(std::in_place, dataPattern, seed)
+{
+    // Announce the pattern in the first message so the server can verify the data.
+    m_data.mutable_properties()->set_pattern(detail::ToDataStreamPattern(dataPattern));
+    m_data.mutable_properties()->set_seed(seed);
+
+    client->async()->DataStreamUpload(&m_clientContext, &m_result, this);
+    StartCall();
+    NextWrite();
+}
+
+DataStreamWriter::DataStreamWriter(NetRemoteDataStreaming::Stub* client, std::vector<uint32_t> sequenceNumbers) :
+    m_numberOfDataBlocksToWrite(static_cast<uint32_t>(std::size(sequenceNumbers))),
+    m_sequenceNumbers(std::move(sequenceNumbers))
+{
+    client->async()->DataStreamUpload(&m_clientContext, &m_result, this);
+    StartCall();
+    NextWrite();
+}
+
+DataStreamWriter::DataStreamWriter(NetRemoteDataStreaming::Stub* client, std::vector<uint32_t> sequenceNumbers, DataPattern dataPattern, uint64_t seed, std::size_t dataBlockSize) :
+    m_numberOfDataBlocksToWrite(static_cast<uint32_t>(std::size(sequenceNumbers))),
+    m_dataBlockSize(dataBlockSize),
+    m_sequenceNumbers(std::move(sequenceNumbers)),
+    m_dataPatternGenerator(std::in_place, dataPattern, seed)
+{
+    m_data.mutable_properties()->set_pattern(detail::ToDataStreamPattern(dataPattern));
+    m_data.mutable_properties()->set_seed(seed);
+
+    client->async()->DataStreamUpload(&m_clientContext, &m_result, this);
+    StartCall();
+    NextWrite();
+}
+
 void
 DataStreamWriter::OnWriteDone(bool isOk)
 {
     if (isOk) {
+        m_data.clear_properties();
         NextWrite();
     } else {
         StartWritesDone();
@@ -70,7 +203,19 @@ void
 DataStreamWriter::NextWrite()
 {
     if (m_numberOfDataBlocksToWrite > 0) {
-        m_data.set_data(std::format("Data #{}", ++m_numberOfDataBlocksWritten));
+        ++m_numberOfDataBlocksWritten;
+        const uint32_t sequenceNumber = std::empty(m_sequenceNumbers) ? m_numberOfDataBlocksWritten : m_sequenceNumbers[m_numberOfDataBlocksWritten - 1];
+        if (m_dataPatternGenerator.has_value()) {
+            auto& data = *m_data.mutable_data();
+            data.resize(m_dataBlockSize);
+            m_dataPatternGenerator->Fill(std::span<char>(data), sequenceNumber, static_cast<uint64_t>(sequenceNumber - 1) * m_dataBlockSize);
+            if (sequenceNumber == m_sequenceNumberToCorrupt && !std::empty(data)) {
+                data[0] = static_cast<char>(~data[0]);
+            }
+        } else {
+            m_data.set_data(std::format("Data #{}", m_numberOfDataBlocksWritten));
+        }
+        m_data.set_sequencenumber(sequenceNumber);
         m_numberOfDataBlocksToWrite--;
         StartWrite(&m_data);
     } else {
@@ -80,6 +225,12 @@ DataStreamWriter::NextWrite()
 
 DataStreamReader::DataStreamReader(NetRemoteDataStreaming::Stub* client, DataStreamDownloadRequest* request)
 {
+    // Verify the content of the received data if a verifiable pattern was requested.
+    const auto dataPattern = detail::ToExpectedDataPattern(request->properties().pattern());
+    if (dataPattern.has_value()) {
+        m_dataPatternVerifier.emplace(dataPattern.value(), request->properties().seed());
+    }
+
     client->async()->DataStreamDownload(&m_clientContext, request, this);
     StartCall();
     StartRead(&m_data);
@@ -89,11 +240,27 @@ void
 DataStreamReader::OnReadDone(bool isOk)
 {
     if (isOk) {
-        m_numberOfDataBlocksReceived++;
+        // The message may pack several consecutive data blocks, the first of which has the message sequence number.
+        const uint32_t numberOfDataBlocks = std::max<uint32_t>(m_data.numberofdatablocks(), 1);
+        const uint32_t sequenceNumberExpected = m_numberOfDataBlocksReceived + 1;
+        m_numberOfDataBlocksReceived += numberOfDataBlocks;
+
+        // The server writes data blocks of equal size, so the offset of each block follows from its sequence number.
+        const std::size_t dataBlockSize = std::size(m_data.data()) / numberOfDataBlocks;
+        for (uint32_t i = 0; i < numberOfDataBlocks; i++) {
+            const uint64_t sequenceNumber = m_data.sequencenumber() + i;
+            const uint64_t offset = (sequenceNumber - 1) * dataBlockSize;
+            const auto dataBlock = std::span<const char>(m_data.data()).subspan(i * dataBlockSize, dataBlockSize);
+            if (m_dataPatternVerifier.has_value() && !m_dataPatternVerifier->Verify(dataBlock, sequenceNumber, offset)) {
+                m_numberOfDataBlocksCorrupted++;
+            }
+        }
+        m_numberOfBytesReceived += std::size(m_data.data());
 
-        // Keep track of the sequence numbers of data blocks that were not received.
-        if (m_data.sequencenumber() != m_numberOfDataBlocksReceived) {
-            auto numberOfLostDataBlocks = m_data.sequencenumber() - m_numberOfDataBlocksReceived;
+        // Keep track of the sequence numbers of data blocks that were not received. The final message of a failed
+        // stream carries no new data blocks, so its sequence number is not past the expected one.
+        if (m_data.sequencenumber() > sequenceNumberExpected) {
+            auto numberOfLostDataBlocks = m_data.sequencenumber() - sequenceNumberExpected;
             for (uint32_t i = numberOfLostDataBlocks; i > 0; i--) {
                 m_lostDataBlockSequenceNumbers.push_back(m_data.sequencenumber() - i);
             }
@@ -144,6 +311,24 @@ DataStreamReader::Cancel()
     m_clientContext.TryCancel();
 }
 
+uint64_t
+DataStreamReader::GetNumberOfBytesReceived() const noexcept
+{
+    return m_numberOfBytesReceived;
+}
+
+uint32_t
+DataStreamReader::GetNumberOfDataBlocksCorrupted() const noexcept
+{
+    return m_numberOfDataBlocksCorrupted;
+}
+
+std::optional<DataStreamHistogram>
+DataStreamReader::GetWriteCompletionLatencyHistogram() const
+{
+    return detail::GetWriteCompletionLatencyHistogram(m_clientContext);
+}
+
 DataStreamReaderWriter::DataStreamReaderWriter(NetRemoteDataStreaming::Stub* client, DataStreamProperties dataStreamProperties) :
     m_dataStreamProperties(std::move(dataStreamProperties))
 {
@@ -168,12 +353,26 @@ DataStreamReaderWriter::DataStreamReaderWriter(NetRemoteDataStreaming::Stub* cli
 
         break;
     }
+    case DataStreamType::DataStreamTypeTimed: {
+        // The server finishes the RPC once the duration elapses, so write until it does.
+        if (m_dataStreamProperties.Properties_case() == DataStreamProperties::kTimed) {
+            m_numberOfDataBlocksToWrite = 0;
+        } else {
+            LOGE << "Invalid properties for this streaming type. Expected Timed for DataStreamTypeTimed";
+            return;
+        }
+
+        break;
+    }
     default: {
         LOGE << std::format("Invalid streaming type: {}", magic_enum::enum_name(m_dataStreamProperties.type()));
         return;
     }
     };
 
+    // Send the data stream properties with the first message so the server can apply them to the data it writes.
+    *m_writeData.mutable_properties() = m_dataStreamProperties;
+
     client->async()->DataStreamBidirectional(&m_clientContext, this);
     StartCall();
     StartRead(&m_readData);
@@ -184,15 +383,24 @@ void
 DataStreamReaderWriter::OnReadDone(bool isOk)
 {
     if (isOk) {
-        m_numberOfDataBlocksReceived++;
-
-        // Keep track of the sequence numbers of data blocks that were not received.
-        if (m_readData.sequencenumber() != m_numberOfDataBlocksReceived) {
-            auto numberOfLostDataBlocks = m_readData.sequencenumber() - m_numberOfDataBlocksReceived;
+        // The message may pack several consecutive data blocks, the first of which has the message sequence number.
+        const uint32_t sequenceNumberExpected = m_numberOfDataBlocksReceived + 1;
+        m_numberOfDataBlocksReceived += std::max<uint32_t>(m_readData.numberofdatablocks(), 1);
+        m_numberOfBytesReceived += std::size(m_readData.data());
+
+        // Keep track of the sequence numbers of data blocks that were not received. The final message of a failed
+        // stream carries no new data blocks, so its sequence number is not past the expected one.
+        if (m_readData.sequencenumber() > sequenceNumberExpected) {
+            auto numberOfLostDataBlocks = m_readData.sequencenumber() - sequenceNumberExpected;
             for (uint32_t i = numberOfLostDataBlocks; i > 0; i--) {
                 m_lostDataBlockSequenceNumbers.push_back(m_readData.sequencenumber() - i);
             }
         }
+
+        if (m_dataStreamProperties.bidirectionalmode() == DataStreamBidirectionalMode::DataStreamBidirectionalModeEcho) {
+            ProcessEcho();
+        }
+
         StartRead(&m_readData);
     }
 }
@@ -204,6 +412,7 @@ DataStreamReaderWriter::OnWriteDone(bool isOk)
         if (m_dataStreamProperties.type() == DataStreamType::DataStreamTypeFixed) {
             m_numberOfDataBlocksToWrite--;
         }
+        m_writeData.clear_properties();
         NextWrite();
     } else {
         // If StopWrites() was called and continuous data streaming is used, then StartWritesDone()
@@ -264,10 +473,160 @@ void
 DataStreamReaderWriter::NextWrite()
 {
     if (m_dataStreamProperties.type() == DataStreamType::DataStreamTypeContinuous ||
+        m_dataStreamProperties.type() == DataStreamType::DataStreamTypeTimed ||
         (m_dataStreamProperties.type() == DataStreamType::DataStreamTypeFixed && m_numberOfDataBlocksToWrite > 0)) {
         m_writeData.set_data(std::format("Data #{}", ++m_numberOfDataBlocksWritten));
+        m_writeData.set_sequencenumber(m_numberOfDataBlocksWritten);
+        if (m_dataStreamProperties.bidirectionalmode() == DataStreamBidirectionalMode::DataStreamBidirectionalModeEcho) {
+            const std::lock_guard lock(m_timesSentGate);
+            m_timesSent.push_back(std::chrono::steady_clock::now());
+        }
         StartWrite(&m_writeData);
     } else {
         StartWritesDone();
     }
 }
+
+void
+DataStreamReaderWriter::ProcessEcho()
+{
+    const auto timeReceived = std::chrono::steady_clock::now();
+    const auto sequenceNumber = m_readData.echosequencenumber();
+
+    std::optional<std::chrono::steady_clock::time_point> timeSent{};
+    {
+        const std::lock_guard lock(m_timesSentGate);
+        if (sequenceNumber > 0 && sequenceNumber <= std::size(m_timesSent)) {
+            timeSent = m_timesSent[sequenceNumber - 1];
+        }
+    }
+
+    if (!timeSent.has_value() || m_readData.data() != std::format("Data #{}", sequenceNumber)) {
+        LOGE << std::format("Echoed data block with sequence number {} does not match the data block sent", sequenceNumber);
+        m_numberOfDataBlocksEchoMismatched++;
+        return;
+    }
+
+    const auto roundTripTime = std::chrono::duration_cast<std::chrono::microseconds>(timeReceived - timeSent.value());
+    const auto serverResidenceTime = google::protobuf::util::TimeUtil::DurationToMicroseconds(m_readData.echosendtime() - m_readData.echoreceivetime());
+    m_roundTripTimeHistogram.Record(static_cast<uint64_t>(roundTripTime.count()));
+    m_serverResidenceTimeHistogram.Record(static_cast<uint64_t>(std::max<int64_t>(0, serverResidenceTime)));
+}
+
+const Histogram&
+DataStreamReaderWriter::GetRoundTripTimeHistogram() const noexcept
+{
+    return m_roundTripTimeHistogram;
+}
+
+const Histogram&
+DataStreamReaderWriter::GetServerResidenceTimeHistogram() const noexcept
+{
+    return m_serverResidenceTimeHistogram;
+}
+
+uint64_t
+DataStreamReaderWriter::GetNumberOfBytesReceived() const noexcept
+{
+    return m_numberOfBytesReceived;
+}
+
+uint32_t
+DataStreamReaderWriter::GetNumberOfDataBlocksEchoMismatched() const noexcept
+{
+    return m_numberOfDataBlocksEchoMismatched;
+}
+
+std::optional<DataStreamHistogram>
+DataStreamReaderWriter::GetWriteCompletionLatencyHistogram() const
+{
+    return detail::GetWriteCompletionLatencyHistogram(m_clientContext);
+}
+
+DataStreamLatencyProber::DataStreamLatencyProber(NetRemoteDataStreaming::Stub* client, uint32_t numberOfPings, std::chrono::milliseconds interval) :
+    m_numberOfPings(numberOfPings),
+    m_interval(interval)
+{
+    client->async()->DataStreamLatencyProbe(&m_clientContext, this);
+    StartCall();
+    StartRead(&m_response);
+    NextPing();
+}
+
+void
+DataStreamLatencyProber::OnReadDone(bool isOk)
+{
+    if (!isOk) {
+        return;
+    }
+
+    m_statistics.Record(detail::ToSystemTimePoint(m_response.requestsendtime()), detail::ToSystemTimePoint(m_response.receivetime()), detail::ToSystemTimePoint(m_response.sendtime()), std::chrono::system_clock::now());
+
+    if (m_response.sequencenumber() >= m_numberOfPings) {
+        StartWritesDone();
+        return;
+    }
+
+    StartRead(&m_response);
+
+    // Wait for the remainder of the interval, if any, before sending the next ping. The hold prevents the RPC from
+    // completing while the alarm is pending.
+    const auto timeNext = m_timeLastSent + m_interval;
+    const auto timeNow = std::chrono::steady_clock::now();
+    if (timeNext <= timeNow) {
+        NextPing();
+        return;
+    }
+
+    AddHold();
+    m_alarm.emplace();
+    m_alarm->Set(std::chrono::system_clock::now() + (timeNext - timeNow), [this](bool alarmFired) {
+        if (alarmFired) {
+            NextPing();
+        } else {
+            StartWritesDone();
+        }
+        RemoveHold();
+    });
+}
+
+void
+DataStreamLatencyProber::OnDone(const grpc::Status& status)
+{
+    const std::unique_lock lock(m_statusGate);
+
+    m_status = status;
+    m_done = true;
+    m_pingsDone.notify_one();
+}
+
+grpc::Status
+DataStreamLatencyProber::Await()
+{
+    std::unique_lock lock(m_statusGate);
+
+    const auto isDone = m_pingsDone.wait_for(lock, DefaultTimeoutValue, [this] {
+        return m_done;
+    });
+
+    if (!isDone) {
+        return grpc::Status(grpc::StatusCode::DEADLINE_EXCEEDED, "Timeout occurred while waiting for all pings to be completed");
+    }
+
+    return m_status;
+}
+
+const LatencyStatistics&
+DataStreamLatencyProber::GetStatistics() const noexcept
+{
+    return m_statistics;
+}
+
+void
+DataStreamLatencyProber::NextPing()
+{
+    m_timeLastSent = std::chrono::steady_clock::now();
+    m_request.set_sequencenumber(m_request.sequencenumber() + 1);
+    *m_request.mutable_sendtime() = google::protobuf::util::TimeUtil::GetCurrentTime();
+    StartWrite(&m_request);
+}
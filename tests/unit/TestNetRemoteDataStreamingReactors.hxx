@@ -4,11 +4,17 @@
 
 #include <chrono>
 #include <condition_variable>
+#include <cstddef>
 #include <cstdint>
 #include <mutex>
+#include <optional>
 #include <span>
 #include <vector>
 
+#include <grpcpp/alarm.h>
+#include <microsoft/net/remote/datastream/DataPatternGenerator.hxx>
+#include <microsoft/net/remote/datastream/Histogram.hxx>
+#include <microsoft/net/remote/datastream/LatencyStatistics.hxx>
 #include <microsoft/net/remote/protocol/NetRemoteDataStream.pb.h>
 #include <microsoft/net/remote/protocol/NetRemoteDataStreamingService.grpc.pb.h>
 
@@ -31,6 +37,39 @@ public:
      */
     explicit DataStreamWriter(Microsoft::Net::Remote::Service::NetRemoteDataStreaming::Stub* client, uint32_t numberOfDataBlocksToWrite);
 
+    /**
+     * @brief Construct a new DataStreamWriter object that writes data blocks with a verifiable pattern.
+     *
+     * @param client The data streaming client stub.
+     * @param numberOfDataBlocksToWrite The number of data blocks to write.
+     * @param dataPattern The pattern of the data blocks to write.
+     * @param seed The stream seed for the pattern.
+     * @param dataBlockSize The size of each data block, in bytes.
+     * @param sequenceNumberToCorrupt The sequence number of a data block to corrupt, or 0 to not corrupt any data block.
+     */
+    explicit DataStreamWriter(Microsoft::Net::Remote::Service::NetRemoteDataStreaming::Stub* client, uint32_t numberOfDataBlocksToWrite, Microsoft::Net::Remote::DataStream::DataPattern dataPattern, uint64_t seed, std::size_t dataBlockSize, uint32_t sequenceNumberToCorrupt = 0);
+
+    /**
+     * @brief Construct a new DataStreamWriter object that writes one data block with each of the specified sequence
+     * numbers, in order. This allows simulating lost, duplicated and reordered data blocks.
+     *
+     * @param client The data streaming client stub.
+     * @param sequenceNumbers The sequence numbers of the data blocks to write.
+     */
+    explicit DataStreamWriter(Microsoft::Net::Remote::Service::NetRemoteDataStreaming::Stub* client, std::vector<uint32_t> sequenceNumbers);
+
+    /**
+     * @brief Construct a new DataStreamWriter object that writes one data block with each of the specified sequence
+     * numbers, in order, filling each data block with the specified pattern for its sequence number.
+     *
+     * @param client The data streaming client stub.
+     * @param sequenceNumbers The sequence numbers of the data blocks to write.
+     * @param dataPattern The pattern of the data blocks to write.
+     * @param seed The stream seed for the pattern.
+     * @param dataBlockSize The size of each data block, in bytes.
+     */
+    explicit DataStreamWriter(Microsoft::Net::Remote::Service::NetRemoteDataStreaming::Stub* client, std::vector<uint32_t> sequenceNumbers, Microsoft::Net::Remote::DataStream::DataPattern dataPattern, uint64_t seed, std::size_t dataBlockSize);
+
     /**
      * @brief Callback that is executed when a write operation is completed.
      *
@@ -71,6 +110,10 @@ private:
     Microsoft::Net::Remote::DataStream::DataStreamUploadResult m_result{};
     uint32_t m_numberOfDataBlocksToWrite{};
     uint32_t m_numberOfDataBlocksWritten{};
+    std::size_t m_dataBlockSize{};
+    uint32_t m_sequenceNumberToCorrupt{};
+    std::vector<uint32_t> m_sequenceNumbers{};
+    std::optional<Microsoft::Net::Remote::DataStream::DataPatternGenerator> m_dataPatternGenerator{};
     grpc::Status m_status{};
     std::mutex m_writeStatusGate{};
     std::condition_variable m_writesDone{};
@@ -126,12 +169,41 @@ public:
     void
     Cancel();
 
+    /**
+     * @brief Get the total number of data bytes received by the client. Should only be called after Await().
+     *
+     * @return uint64_t
+     */
+    uint64_t
+    GetNumberOfBytesReceived() const noexcept;
+
+    /**
+     * @brief Get the number of data blocks received whose content did not match the requested verifiable pattern.
+     * Should only be called after Await().
+     *
+     * @return uint32_t
+     */
+    uint32_t
+    GetNumberOfDataBlocksCorrupted() const noexcept;
+
+    /**
+     * @brief Get the write completion latencies the server returned when it finished the RPC. Should only be called
+     * after Await().
+     *
+     * @return std::optional<Microsoft::Net::Remote::DataStream::DataStreamHistogram>
+     */
+    std::optional<Microsoft::Net::Remote::DataStream::DataStreamHistogram>
+    GetWriteCompletionLatencyHistogram() const;
+
 private:
     static inline constexpr auto DefaultTimeoutValue{ 10s };
 
     grpc::ClientContext m_clientContext{};
     Microsoft::Net::Remote::DataStream::DataStreamDownloadData m_data{};
     uint32_t m_numberOfDataBlocksReceived{};
+    uint64_t m_numberOfBytesReceived{};
+    uint32_t m_numberOfDataBlocksCorrupted{};
+    std::optional<Microsoft::Net::Remote::DataStream::DataPatternGenerator> m_dataPatternVerifier{};
     grpc::Status m_status{};
     std::mutex m_readStatusGate{};
     std::condition_variable m_readsDone{};
@@ -196,6 +268,50 @@ public:
     void
     StopWrites();
 
+    /**
+     * @brief Get the round-trip time of each echoed data block, in microseconds. Should only be called after Await()
+     * with DataStreamBidirectionalModeEcho.
+     *
+     * @return const Microsoft::Net::Remote::DataStream::Histogram&
+     */
+    const Microsoft::Net::Remote::DataStream::Histogram&
+    GetRoundTripTimeHistogram() const noexcept;
+
+    /**
+     * @brief Get the time each echoed data block spent in the server, in microseconds. Should only be called after
+     * Await() with DataStreamBidirectionalModeEcho.
+     *
+     * @return const Microsoft::Net::Remote::DataStream::Histogram&
+     */
+    const Microsoft::Net::Remote::DataStream::Histogram&
+    GetServerResidenceTimeHistogram() const noexcept;
+
+    /**
+     * @brief Get the total number of data bytes received by the client. Should only be called after Await().
+     *
+     * @return uint64_t
+     */
+    uint64_t
+    GetNumberOfBytesReceived() const noexcept;
+
+    /**
+     * @brief Get the number of echoed data blocks whose content did not match the data block sent. Should only be
+     * called after Await() with DataStreamBidirectionalModeEcho.
+     *
+     * @return uint32_t
+     */
+    uint32_t
+    GetNumberOfDataBlocksEchoMismatched() const noexcept;
+
+    /**
+     * @brief Get the write completion latencies the server returned when it finished the RPC. Should only be called
+     * after Await().
+     *
+     * @return std::optional<Microsoft::Net::Remote::DataStream::DataStreamHistogram>
+     */
+    std::optional<Microsoft::Net::Remote::DataStream::DataStreamHistogram>
+    GetWriteCompletionLatencyHistogram() const;
+
 private:
     /**
      * @brief Facilitate the next write operation.
@@ -203,6 +319,12 @@ private:
     void
     NextWrite();
 
+    /**
+     * @brief Record the timing of a data block echoed by the server and check its content.
+     */
+    void
+    ProcessEcho();
+
 private:
     static inline constexpr auto DefaultTimeoutValue{ 10s };
 
@@ -213,12 +335,91 @@ private:
     uint32_t m_numberOfDataBlocksToWrite{};
     uint32_t m_numberOfDataBlocksWritten{};
     uint32_t m_numberOfDataBlocksReceived{};
+    uint64_t m_numberOfBytesReceived{};
     grpc::Status m_operationStatus{};
     std::mutex m_operationStatusGate{};
     std::condition_variable m_operationsDone{};
     bool m_done{ false };
     std::vector<uint32_t> m_lostDataBlockSequenceNumbers{};
     std::atomic<bool> m_writesStopped{};
+    std::vector<std::chrono::steady_clock::time_point> m_timesSent{};
+    std::mutex m_timesSentGate{};
+    Microsoft::Net::Remote::DataStream::Histogram m_roundTripTimeHistogram{};
+    Microsoft::Net::Remote::DataStream::Histogram m_serverResidenceTimeHistogram{};
+    uint32_t m_numberOfDataBlocksEchoMismatched{};
+};
+
+/**
+ * @brief Implementation of the gRPC ClientBidiReactor for client-side latency probing.
+ */
+class DataStreamLatencyProber :
+    public grpc::ClientBidiReactor<Microsoft::Net::Remote::DataStream::DataStreamPingRequest, Microsoft::Net::Remote::DataStream::DataStreamPingResponse>
+{
+public:
+    /**
+     * @brief Construct a new DataStreamLatencyProber object and start sending pings. Each ping is sent once the response
+     * to the previous one is received, and no sooner than the specified interval after the previous ping was sent.
+     *
+     * @param client The data streaming client stub.
+     * @param numberOfPings The number of pings to send.
+     * @param interval The interval between pings.
+     */
+    explicit DataStreamLatencyProber(Microsoft::Net::Remote::Service::NetRemoteDataStreaming::Stub* client, uint32_t numberOfPings, std::chrono::milliseconds interval);
+
+    /**
+     * @brief Callback that is executed when a read operation is completed.
+     *
+     * @param isOk Indicates whether a message was read as expected.
+     */
+    void
+    OnReadDone(bool isOk) override;
+
+    /**
+     * @brief Callback that is executed when all RPC operations are completed for a given RPC.
+     *
+     * @param status The status of the RPC sent by the server or provided by the library to indicate a failure.
+     */
+    void
+    OnDone(const grpc::Status& status) override;
+
+    /**
+     * @brief Wait for all pings to complete.
+     *
+     * @return grpc::Status
+     */
+    grpc::Status
+    Await();
+
+    /**
+     * @brief Get the latency statistics of the pings. Should only be called after Await().
+     *
+     * @return const Microsoft::Net::Remote::DataStream::LatencyStatistics&
+     */
+    const Microsoft::Net::Remote::DataStream::LatencyStatistics&
+    GetStatistics() const noexcept;
+
+private:
+    /**
+     * @brief Send the next ping.
+     */
+    void
+    NextPing();
+
+private:
+    static inline constexpr auto DefaultTimeoutValue{ 10s };
+
+    grpc::ClientContext m_clientContext{};
+    Microsoft::Net::Remote::DataStream::DataStreamPingRequest m_request{};
+    Microsoft::Net::Remote::DataStream::DataStreamPingResponse m_response{};
+    uint32_t m_numberOfPings{};
+    std::chrono::milliseconds m_interval{};
+    std::chrono::steady_clock::time_point m_timeLastSent{};
+    std::optional<grpc::Alarm> m_alarm{};
+    Microsoft::Net::Remote::DataStream::LatencyStatistics m_statistics{};
+    grpc::Status m_status{};
+    std::mutex m_statusGate{};
+    std::condition_variable m_pingsDone{};
+    bool m_done{ false };
 };
 
 } // namespace Microsoft::Net::Remote::Test
@@ -2,23 +2,35 @@
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <cstdlib>
+#include <format>
+#include <limits>
 #include <memory>
 #include <span>
+#include <string>
 #include <thread>
 #include <utility>
 #include <vector>
 
 #include <catch2/catch_test_macros.hpp>
-#include <google/protobuf/empty.pb.h>
+#include <catch2/generators/catch_generators.hpp>
+#include <google/protobuf/util/time_util.h>
 #include <grpcpp/client_context.h>
 #include <grpcpp/create_channel.h>
 #include <grpcpp/impl/codegen/status.h>
 #include <grpcpp/impl/codegen/status_code_enum.h>
 #include <grpcpp/security/credentials.h>
+#include <microsoft/net/remote/DataStreamLatencyUnderLoad.hxx>
+#include <microsoft/net/remote/datastream/DataPatternGenerator.hxx>
 #include <microsoft/net/remote/protocol/NetRemoteDataStream.pb.h>
 #include <microsoft/net/remote/protocol/NetRemoteDataStreamingService.grpc.pb.h>
+#include <microsoft/net/remote/protocol/NetRemoteService.grpc.pb.h>
+#include <microsoft/net/remote/protocol/NetRemoteWifi.pb.h>
 #include <microsoft/net/remote/service/NetRemoteServer.hxx>
 #include <microsoft/net/remote/service/NetRemoteServerConfiguration.hxx>
+#include <microsoft/net/wifi/test/AccessPointManagerTest.hxx>
+#include <microsoft/net/wifi/test/AccessPointTest.hxx>
+#include <plog/Log.h>
 
 #include "TestNetRemoteCommon.hxx"
 #include "TestNetRemoteDataStreamingReactors.hxx"
@@ -53,6 +65,102 @@ TEST_CASE("DataStreamUpload API", "[basic][rpc][client][remote][stream]")
         REQUIRE(result.status().code() == DataStreamOperationStatusCodeSucceeded);
     }
 
+    SECTION("Reports throughput and timing statistics")
+    {
+        static constexpr std::size_t DataBlockSize{ 4096 };
+
+        auto dataStreamWriter = std::make_unique<DataStreamWriter>(client.get(), numberOfDataBlocksToWrite, DataPattern::Zeros, 0, DataBlockSize);
+
+        DataStreamUploadResult result{};
+        const grpc::Status status = dataStreamWriter->Await(&result);
+        REQUIRE(status.ok());
+        REQUIRE(result.status().code() == DataStreamOperationStatusCodeSucceeded);
+        REQUIRE(result.numberofbytesreceived() == numberOfDataBlocksToWrite * DataBlockSize);
+        REQUIRE(result.has_firstdatareceivedtime());
+        REQUIRE(result.has_lastdatareceivedtime());
+        REQUIRE(google::protobuf::util::TimeUtil::TimestampToNanoseconds(result.lastdatareceivedtime()) >= google::protobuf::util::TimeUtil::TimestampToNanoseconds(result.firstdatareceivedtime()));
+        REQUIRE(result.interarrivaltimemicroseconds().count() == numberOfDataBlocksToWrite - 1);
+        REQUIRE(result.interarrivaljittermicroseconds().count() == numberOfDataBlocksToWrite - 2);
+    }
+
+    SECTION("Verifies data written with a verifiable pattern")
+    {
+        static constexpr uint64_t Seed{ 0x1234 };
+        static constexpr std::size_t DataBlockSize{ 1024 };
+
+        const auto dataPattern = GENERATE(DataPattern::PseudoRandom, DataPattern::Counter, DataPattern::Zeros, DataPattern::Ones);
+        auto dataStreamWriter = std::make_unique<DataStreamWriter>(client.get(), numberOfDataBlocksToWrite, dataPattern, Seed, DataBlockSize);
+
+        DataStreamUploadResult result{};
+        const grpc::Status status = dataStreamWriter->Await(&result);
+        REQUIRE(status.ok());
+        REQUIRE(result.numberofdatablocksreceived() == numberOfDataBlocksToWrite);
+        REQUIRE(result.numberofdatablockscorrupted() == 0);
+        REQUIRE(result.status().code() == DataStreamOperationStatusCodeSucceeded);
+    }
+
+    SECTION("Detects corrupted data written with a verifiable pattern")
+    {
+        static constexpr uint64_t Seed{ 0x1234 };
+        static constexpr std::size_t DataBlockSize{ 1024 };
+        static constexpr uint32_t SequenceNumberToCorrupt{ 3 };
+
+        const auto dataPattern = GENERATE(DataPattern::PseudoRandom, DataPattern::Counter, DataPattern::Zeros, DataPattern::Ones);
+        auto dataStreamWriter = std::make_unique<DataStreamWriter>(client.get(), numberOfDataBlocksToWrite, dataPattern, Seed, DataBlockSize, SequenceNumberToCorrupt);
+
+        DataStreamUploadResult result{};
+        const grpc::Status status = dataStreamWriter->Await(&result);
+        REQUIRE(status.ok());
+        REQUIRE(result.numberofdatablocksreceived() == numberOfDataBlocksToWrite);
+        REQUIRE(result.numberofdatablockscorrupted() == 1);
+    }
+
+    SECTION("Reports no sequence anomalies for data blocks written in order")
+    {
+        auto dataStreamWriter = std::make_unique<DataStreamWriter>(client.get(), numberOfDataBlocksToWrite);
+
+        DataStreamUploadResult result{};
+        const grpc::Status status = dataStreamWriter->Await(&result);
+        REQUIRE(status.ok());
+        REQUIRE(result.numberofdatablockslost() == 0);
+        REQUIRE(result.numberofdatablocksduplicated() == 0);
+        REQUIRE(result.numberofdatablocksoutoforder() == 0);
+        REQUIRE(result.numberofsequencegaps() == 0);
+    }
+
+    SECTION("Detects lost, duplicated and reordered data blocks")
+    {
+        // 3 and 9 are lost, 5 is duplicated, and 7 arrives after 8.
+        auto dataStreamWriter = std::make_unique<DataStreamWriter>(client.get(), std::vector<uint32_t>{ 1, 2, 4, 5, 5, 6, 8, 7, 10 });
+
+        DataStreamUploadResult result{};
+        const grpc::Status status = dataStreamWriter->Await(&result);
+        REQUIRE(status.ok());
+        REQUIRE(result.status().code() == DataStreamOperationStatusCodeSucceeded);
+        REQUIRE(result.numberofdatablocksreceived() == 9);
+        REQUIRE(result.numberofdatablockslost() == 2);
+        REQUIRE(result.numberofdatablocksduplicated() == 1);
+        REQUIRE(result.numberofdatablocksoutoforder() == 1);
+        REQUIRE(result.numberofsequencegaps() == 3);
+        REQUIRE(result.reorderdistancemaximum() == 1);
+    }
+
+    SECTION("Verifies lost, duplicated and reordered data written with a verifiable pattern")
+    {
+        static constexpr uint64_t Seed{ 0x1234 };
+        static constexpr std::size_t DataBlockSize{ 1024 };
+
+        const auto dataPattern = GENERATE(DataPattern::PseudoRandom, DataPattern::Counter);
+        auto dataStreamWriter = std::make_unique<DataStreamWriter>(client.get(), std::vector<uint32_t>{ 1, 2, 4, 5, 5, 6, 8, 7, 10 }, dataPattern, Seed, DataBlockSize);
+
+        DataStreamUploadResult result{};
+        const grpc::Status status = dataStreamWriter->Await(&result);
+        REQUIRE(status.ok());
+        REQUIRE(result.numberofdatablocksreceived() == 9);
+        REQUIRE(result.numberofdatablocksoutoforder() == 1);
+        REQUIRE(result.numberofdatablockscorrupted() == 0);
+    }
+
     SECTION("Can be called with multiple parallel clients")
     {
         static constexpr auto numberOfClients = 5;
@@ -119,131 +227,1225 @@ TEST_CASE("DataStreamDownload API", "[basic][rpc][client][remote][stream]")
         REQUIRE(lostDataBlockSequenceNumbers.empty());
     }
 
-    SECTION("Can be called with DataStreamTypeContinuous and DataStreamPatternConstant")
+    SECTION("Can be called with a custom data block size")
     {
-        static constexpr auto StreamingDelayTime = 5s;
+        static constexpr auto DataBlockSize = 64 * 1024;
 
-        DataStreamContinuousTypeProperties continuousTypeProperties{};
+        DataStreamFixedTypeProperties fixedTypeProperties{};
+        fixedTypeProperties.set_numberofdatablockstostream(fixedNumberOfDataBlocksToStream);
 
         DataStreamProperties properties{};
-        properties.set_type(DataStreamType::DataStreamTypeContinuous);
+        properties.set_type(DataStreamType::DataStreamTypeFixed);
         properties.set_pattern(DataStreamPattern::DataStreamPatternConstant);
-        *properties.mutable_continuous() = std::move(continuousTypeProperties);
+        properties.set_datablocksize(DataBlockSize);
+        *properties.mutable_fixed() = std::move(fixedTypeProperties);
 
         DataStreamDownloadRequest request{};
         *request.mutable_properties() = std::move(properties);
 
         DataStreamReader dataStreamReader{ client.get(), &request };
 
-        // Allow some time of continuous streaming by the server, then cancel the RPC.
-        std::this_thread::sleep_for(StreamingDelayTime);
-        dataStreamReader.Cancel();
-
         uint32_t numberOfDataBlocksReceived{};
         DataStreamOperationStatus operationStatus{};
         std::span<uint32_t> lostDataBlockSequenceNumbers{};
         const grpc::Status status = dataStreamReader.Await(&numberOfDataBlocksReceived, &operationStatus, lostDataBlockSequenceNumbers);
+        REQUIRE(status.ok());
+        REQUIRE(numberOfDataBlocksReceived == fixedNumberOfDataBlocksToStream);
+        REQUIRE(operationStatus.code() == DataStreamOperationStatusCodeSucceeded);
+        REQUIRE(lostDataBlockSequenceNumbers.empty());
+        REQUIRE(dataStreamReader.GetNumberOfBytesReceived() == static_cast<uint64_t>(DataBlockSize) * fixedNumberOfDataBlocksToStream);
+    }
 
-        REQUIRE((status.error_code() == grpc::StatusCode::CANCELLED || status.error_code() == grpc::StatusCode::OK));
+    SECTION("Can be called with verifiable patterns")
+    {
+        static constexpr auto DataBlockSize = 4 * 1024;
 
-        if (status.error_code() == grpc::StatusCode::CANCELLED) {
-            REQUIRE(operationStatus.code() == DataStreamOperationStatusCodeSucceeded);
-            REQUIRE(lostDataBlockSequenceNumbers.empty());
-            // The cancelation may cause a write failure before the server's OnCancel callback is invoked
-        } else if (status.error_code() == grpc::StatusCode::OK) {
-            REQUIRE(operationStatus.code() == DataStreamOperationStatusCodeFailed);
-        }
+        const auto pattern = GENERATE(DataStreamPattern::DataStreamPatternPseudoRandom, DataStreamPattern::DataStreamPatternCounter, DataStreamPattern::DataStreamPatternZeros, DataStreamPattern::DataStreamPatternOnes);
+
+        DataStreamFixedTypeProperties fixedTypeProperties{};
+        fixedTypeProperties.set_numberofdatablockstostream(fixedNumberOfDataBlocksToStream);
+
+        DataStreamProperties properties{};
+        properties.set_type(DataStreamType::DataStreamTypeFixed);
+        properties.set_pattern(pattern);
+        properties.set_seed(0xC0FFEE);
+        properties.set_datablocksize(DataBlockSize);
+        *properties.mutable_fixed() = std::move(fixedTypeProperties);
+
+        DataStreamDownloadRequest request{};
+        *request.mutable_properties() = std::move(properties);
+
+        DataStreamReader dataStreamReader{ client.get(), &request };
+
+        uint32_t numberOfDataBlocksReceived{};
+        DataStreamOperationStatus operationStatus{};
+        std::span<uint32_t> lostDataBlockSequenceNumbers{};
+        const grpc::Status status = dataStreamReader.Await(&numberOfDataBlocksReceived, &operationStatus, lostDataBlockSequenceNumbers);
+        REQUIRE(status.ok());
+        REQUIRE(numberOfDataBlocksReceived == fixedNumberOfDataBlocksToStream);
+        REQUIRE(operationStatus.code() == DataStreamOperationStatusCodeSucceeded);
+        REQUIRE(lostDataBlockSequenceNumbers.empty());
+        REQUIRE(dataStreamReader.GetNumberOfDataBlocksCorrupted() == 0);
     }
-}
 
-TEST_CASE("DataStreamBidirectional API", "[basic][rpc][client][remote][stream]")
-{
-    using namespace Microsoft::Net::Remote;
-    using namespace Microsoft::Net::Remote::DataStream;
-    using namespace Microsoft::Net::Remote::Service;
+    SECTION("Fails with a data block size that is too large")
+    {
+        static constexpr auto DataBlockSizeTooLarge = std::numeric_limits<uint32_t>::max();
 
-    using Microsoft::Net::Remote::Test::DataStreamReaderWriter;
+        DataStreamFixedTypeProperties fixedTypeProperties{};
+        fixedTypeProperties.set_numberofdatablockstostream(fixedNumberOfDataBlocksToStream);
 
-    const auto serverConfiguration = CreateServerConfiguration();
-    NetRemoteServer server{ serverConfiguration };
-    server.Run();
+        DataStreamProperties properties{};
+        properties.set_type(DataStreamType::DataStreamTypeFixed);
+        properties.set_pattern(DataStreamPattern::DataStreamPatternConstant);
+        properties.set_datablocksize(DataBlockSizeTooLarge);
+        *properties.mutable_fixed() = std::move(fixedTypeProperties);
 
-    auto channel = grpc::CreateChannel(RemoteServiceAddressHttp, grpc::InsecureChannelCredentials());
-    auto client = NetRemoteDataStreaming::NewStub(channel);
+        DataStreamDownloadRequest request{};
+        *request.mutable_properties() = std::move(properties);
 
-    static constexpr auto fixedNumberOfDataBlocksToStream = 10;
+        DataStreamReader dataStreamReader{ client.get(), &request };
 
-    SECTION("Can be called with DataStreamTypeFixed")
+        uint32_t numberOfDataBlocksReceived{};
+        DataStreamOperationStatus operationStatus{};
+        std::span<uint32_t> lostDataBlockSequenceNumbers{};
+        const grpc::Status status = dataStreamReader.Await(&numberOfDataBlocksReceived, &operationStatus, lostDataBlockSequenceNumbers);
+        REQUIRE(status.ok());
+        REQUIRE(operationStatus.code() == DataStreamOperationStatusCodeFailed);
+    }
+
+    SECTION("Packs several data blocks into each message")
     {
+        // 10 blocks at 4 per message are written in 3 messages, the last of which is partial.
+        static constexpr auto DataBlockSize = 1024;
+        static constexpr uint32_t DataBlocksPerMessage = 4;
+        static constexpr uint32_t NumberOfMessagesExpected = 3;
+
         DataStreamFixedTypeProperties fixedTypeProperties{};
         fixedTypeProperties.set_numberofdatablockstostream(fixedNumberOfDataBlocksToStream);
 
         DataStreamProperties properties{};
         properties.set_type(DataStreamType::DataStreamTypeFixed);
+        properties.set_pattern(DataStreamPattern::DataStreamPatternCounter);
+        properties.set_datablocksize(DataBlockSize);
+        properties.set_datablockspermessage(DataBlocksPerMessage);
         *properties.mutable_fixed() = std::move(fixedTypeProperties);
 
-        DataStreamReaderWriter dataStreamReaderWriter{ client.get(), std::move(properties) };
+        DataStreamDownloadRequest request{};
+        *request.mutable_properties() = std::move(properties);
+
+        DataStreamReader dataStreamReader{ client.get(), &request };
 
         uint32_t numberOfDataBlocksReceived{};
         DataStreamOperationStatus operationStatus{};
         std::span<uint32_t> lostDataBlockSequenceNumbers{};
-        const grpc::Status status = dataStreamReaderWriter.Await(&numberOfDataBlocksReceived, &operationStatus, lostDataBlockSequenceNumbers);
+        const grpc::Status status = dataStreamReader.Await(&numberOfDataBlocksReceived, &operationStatus, lostDataBlockSequenceNumbers);
         REQUIRE(status.ok());
-        REQUIRE(numberOfDataBlocksReceived > 0);
+        REQUIRE(numberOfDataBlocksReceived == fixedNumberOfDataBlocksToStream);
         REQUIRE(operationStatus.code() == DataStreamOperationStatusCodeSucceeded);
         REQUIRE(lostDataBlockSequenceNumbers.empty());
+        REQUIRE(dataStreamReader.GetNumberOfDataBlocksCorrupted() == 0);
+        REQUIRE(dataStreamReader.GetNumberOfBytesReceived() == static_cast<uint64_t>(DataBlockSize) * fixedNumberOfDataBlocksToStream);
+
+        const auto writeCompletionLatency = dataStreamReader.GetWriteCompletionLatencyHistogram();
+        REQUIRE(writeCompletionLatency.has_value());
+        REQUIRE(writeCompletionLatency->count() == NumberOfMessagesExpected);
     }
 
-    SECTION("Can be called with DataStreamTypeContinuous")
+    SECTION("Fails with messages that are too large")
     {
-        static constexpr auto StreamingDelayTime = 5s;
+        DataStreamFixedTypeProperties fixedTypeProperties{};
+        fixedTypeProperties.set_numberofdatablockstostream(fixedNumberOfDataBlocksToStream);
 
-        DataStreamContinuousTypeProperties continuousTypeProperties{};
+        DataStreamProperties properties{};
+        properties.set_type(DataStreamType::DataStreamTypeFixed);
+        properties.set_pattern(DataStreamPattern::DataStreamPatternConstant);
+        properties.set_datablocksize(1024 * 1024);
+        properties.set_datablockspermessage(64);
+        *properties.mutable_fixed() = std::move(fixedTypeProperties);
+
+        DataStreamDownloadRequest request{};
+        *request.mutable_properties() = std::move(properties);
+
+        DataStreamReader dataStreamReader{ client.get(), &request };
+
+        uint32_t numberOfDataBlocksReceived{};
+        DataStreamOperationStatus operationStatus{};
+        std::span<uint32_t> lostDataBlockSequenceNumbers{};
+        const grpc::Status status = dataStreamReader.Await(&numberOfDataBlocksReceived, &operationStatus, lostDataBlockSequenceNumbers);
+        REQUIRE(status.ok());
+        REQUIRE(operationStatus.code() == DataStreamOperationStatusCodeFailed);
+    }
+
+    SECTION("Can be called with DataStreamTypeTimed")
+    {
+        static constexpr auto StreamingDuration = 2s;
+
+        DataStreamTimedTypeProperties timedTypeProperties{};
+        *timedTypeProperties.mutable_duration() = google::protobuf::util::TimeUtil::SecondsToDuration(std::chrono::duration_cast<std::chrono::seconds>(StreamingDuration).count());
 
         DataStreamProperties properties{};
-        properties.set_type(DataStreamType::DataStreamTypeContinuous);
-        *properties.mutable_continuous() = std::move(continuousTypeProperties);
+        properties.set_type(DataStreamType::DataStreamTypeTimed);
+        properties.set_pattern(DataStreamPattern::DataStreamPatternCounter);
+        *properties.mutable_timed() = std::move(timedTypeProperties);
 
-        DataStreamReaderWriter dataStreamReaderWriter{ client.get(), std::move(properties) };
+        DataStreamDownloadRequest request{};
+        *request.mutable_properties() = std::move(properties);
 
-        // Allow some time of continuous streaming, then stop writing data. This will prompt the
-        // server to stop writing too, eliminating the need to cancel the RPC.
-        std::this_thread::sleep_for(StreamingDelayTime);
-        dataStreamReaderWriter.StopWrites();
+        const auto timeStart = std::chrono::steady_clock::now();
+        DataStreamReader dataStreamReader{ client.get(), &request };
 
         uint32_t numberOfDataBlocksReceived{};
         DataStreamOperationStatus operationStatus{};
         std::span<uint32_t> lostDataBlockSequenceNumbers{};
-        const grpc::Status status = dataStreamReaderWriter.Await(&numberOfDataBlocksReceived, &operationStatus, lostDataBlockSequenceNumbers);
+        const grpc::Status status = dataStreamReader.Await(&numberOfDataBlocksReceived, &operationStatus, lostDataBlockSequenceNumbers);
+        const auto timeElapsed = std::chrono::steady_clock::now() - timeStart;
+
         REQUIRE(status.ok());
         REQUIRE(numberOfDataBlocksReceived > 0);
         REQUIRE(operationStatus.code() == DataStreamOperationStatusCodeSucceeded);
         REQUIRE(lostDataBlockSequenceNumbers.empty());
+        REQUIRE(dataStreamReader.GetNumberOfDataBlocksCorrupted() == 0);
+        REQUIRE(timeElapsed >= StreamingDuration);
     }
-}
 
-TEST_CASE("DataStreamPing API", "[basic][rpc][client][remote][stream]")
-{
-    using namespace Microsoft::Net::Remote;
-    using namespace Microsoft::Net::Remote::DataStream;
-    using namespace Microsoft::Net::Remote::Service;
+    SECTION("Returns the write completion latencies of the stream and aggregates them server-wide")
+    {
+        static constexpr uint32_t NumberOfDataBlocksToStream{ 50 };
 
-    using Microsoft::Net::Remote::Test::DataStreamReaderWriter;
+        DataStreamFixedTypeProperties fixedTypeProperties{};
+        fixedTypeProperties.set_numberofdatablockstostream(NumberOfDataBlocksToStream);
 
-    const auto serverConfiguration = CreateServerConfiguration();
-    NetRemoteServer server{ serverConfiguration };
-    server.Run();
+        DataStreamProperties properties{};
+        properties.set_type(DataStreamType::DataStreamTypeFixed);
+        properties.set_pattern(DataStreamPattern::DataStreamPatternConstant);
+        *properties.mutable_fixed() = std::move(fixedTypeProperties);
 
-    auto channel = grpc::CreateChannel(RemoteServiceAddressHttp, grpc::InsecureChannelCredentials());
-    auto client = NetRemoteDataStreaming::NewStub(channel);
+        DataStreamDownloadRequest request{};
+        *request.mutable_properties() = std::move(properties);
+
+        DataStreamReader dataStreamReader{ client.get(), &request };
+
+        uint32_t numberOfDataBlocksReceived{};
+        DataStreamOperationStatus operationStatus{};
+        std::span<uint32_t> lostDataBlockSequenceNumbers{};
+        const grpc::Status status = dataStreamReader.Await(&numberOfDataBlocksReceived, &operationStatus, lostDataBlockSequenceNumbers);
+        REQUIRE(status.ok());
+        REQUIRE(numberOfDataBlocksReceived == NumberOfDataBlocksToStream);
+
+        const auto writeCompletionLatency = dataStreamReader.GetWriteCompletionLatencyHistogram();
+        REQUIRE(writeCompletionLatency.has_value());
+        REQUIRE(writeCompletionLatency->count() == NumberOfDataBlocksToStream);
+        REQUIRE(writeCompletionLatency->minimum() <= writeCompletionLatency->maximum());
+        REQUIRE_FALSE(writeCompletionLatency->buckets().empty());
 
-    SECTION("Can be called")
-    {
         grpc::ClientContext clientContext{};
-        const google::protobuf::Empty request{};
-        google::protobuf::Empty response{};
+        DataStreamMetrics metrics{};
+        REQUIRE(client->DataStreamGetMetrics(&clientContext, DataStreamMetricsRequest{}, &metrics).ok());
+        REQUIRE(metrics.status().code() == DataStreamOperationStatusCodeSucceeded);
+        REQUIRE(metrics.numberofstreams() == 1);
+        REQUIRE(metrics.writecompletionlatencymicroseconds().count() == NumberOfDataBlocksToStream);
+        REQUIRE(metrics.writecompletionlatencymicroseconds().maximum() == writeCompletionLatency->maximum());
+    }
+
+    SECTION("Fails with DataStreamTypeTimed and no duration")
+    {
+        DataStreamProperties properties{};
+        properties.set_type(DataStreamType::DataStreamTypeTimed);
+        properties.set_pattern(DataStreamPattern::DataStreamPatternConstant);
+
+        DataStreamDownloadRequest request{};
+        *request.mutable_properties() = std::move(properties);
+
+        DataStreamReader dataStreamReader{ client.get(), &request };
+
+        uint32_t numberOfDataBlocksReceived{};
+        DataStreamOperationStatus operationStatus{};
+        std::span<uint32_t> lostDataBlockSequenceNumbers{};
+        const grpc::Status status = dataStreamReader.Await(&numberOfDataBlocksReceived, &operationStatus, lostDataBlockSequenceNumbers);
+        REQUIRE(status.ok());
+        REQUIRE(operationStatus.code() == DataStreamOperationStatusCodeFailed);
+    }
+
+    SECTION("Paces writes to the target bitrate")
+    {
+        // 20 blocks of 1KiB at 80kbit/s (10000 bytes/s): the first block is sent immediately and each of the
+        // remaining 19 blocks takes ~102ms, so the stream should take just under 2s.
+        static constexpr auto DataBlockSize = 1024;
+        static constexpr auto NumberOfDataBlocksToStream = 20;
+        static constexpr auto TargetBitrate = 80'000;
+        static constexpr auto StreamingDurationMinimum = 1800ms;
+
+        DataStreamFixedTypeProperties fixedTypeProperties{};
+        fixedTypeProperties.set_numberofdatablockstostream(NumberOfDataBlocksToStream);
+
+        DataStreamProperties properties{};
+        properties.set_type(DataStreamType::DataStreamTypeFixed);
+        properties.set_pattern(DataStreamPattern::DataStreamPatternPseudoRandom);
+        properties.set_datablocksize(DataBlockSize);
+        properties.set_targetbitrate(TargetBitrate);
+        *properties.mutable_fixed() = std::move(fixedTypeProperties);
+
+        DataStreamDownloadRequest request{};
+        *request.mutable_properties() = std::move(properties);
+
+        const auto timeStart = std::chrono::steady_clock::now();
+        DataStreamReader dataStreamReader{ client.get(), &request };
+
+        uint32_t numberOfDataBlocksReceived{};
+        DataStreamOperationStatus operationStatus{};
+        std::span<uint32_t> lostDataBlockSequenceNumbers{};
+        const grpc::Status status = dataStreamReader.Await(&numberOfDataBlocksReceived, &operationStatus, lostDataBlockSequenceNumbers);
+        const auto timeElapsed = std::chrono::steady_clock::now() - timeStart;
 
-        const grpc::Status status = client->DataStreamPing(&clientContext, request, &response);
         REQUIRE(status.ok());
+        REQUIRE(numberOfDataBlocksReceived == NumberOfDataBlocksToStream);
+        REQUIRE(operationStatus.code() == DataStreamOperationStatusCodeSucceeded);
+        REQUIRE(dataStreamReader.GetNumberOfDataBlocksCorrupted() == 0);
+        REQUIRE(timeElapsed >= StreamingDurationMinimum);
+    }
+
+    SECTION("Can be called with DataStreamTypeContinuous and DataStreamPatternConstant")
+    {
+        static constexpr auto StreamingDelayTime = 5s;
+
+        DataStreamContinuousTypeProperties continuousTypeProperties{};
+
+        DataStreamProperties properties{};
+        properties.set_type(DataStreamType::DataStreamTypeContinuous);
+        properties.set_pattern(DataStreamPattern::DataStreamPatternConstant);
+        *properties.mutable_continuous() = std::move(continuousTypeProperties);
+
+        DataStreamDownloadRequest request{};
+        *request.mutable_properties() = std::move(properties);
+
+        DataStreamReader dataStreamReader{ client.get(), &request };
+
+        // Allow some time of continuous streaming by the server, then cancel the RPC.
+        std::this_thread::sleep_for(StreamingDelayTime);
+        dataStreamReader.Cancel();
+
+        uint32_t numberOfDataBlocksReceived{};
+        DataStreamOperationStatus operationStatus{};
+        std::span<uint32_t> lostDataBlockSequenceNumbers{};
+        const grpc::Status status = dataStreamReader.Await(&numberOfDataBlocksReceived, &operationStatus, lostDataBlockSequenceNumbers);
+
+        REQUIRE((status.error_code() == grpc::StatusCode::CANCELLED || status.error_code() == grpc::StatusCode::OK));
+
+        if (status.error_code() == grpc::StatusCode::CANCELLED) {
+            REQUIRE(operationStatus.code() == DataStreamOperationStatusCodeSucceeded);
+            REQUIRE(lostDataBlockSequenceNumbers.empty());
+            // The cancelation may cause a write failure before the server's OnCancel callback is invoked
+        } else if (status.error_code() == grpc::StatusCode::OK) {
+            REQUIRE(operationStatus.code() == DataStreamOperationStatusCodeFailed);
+        }
+    }
+}
+
+TEST_CASE("DataStreamDownload write coalescing performance", "[rpc][client][remote][stream][benchmark][.]")
+{
+    using namespace Microsoft::Net::Remote;
+    using namespace Microsoft::Net::Remote::DataStream;
+    using namespace Microsoft::Net::Remote::Service;
+
+    using Microsoft::Net::Remote::Test::DataStreamReader;
+
+    // Messages are kept well below the default gRPC maximum receive message size (4 MiB).
+    static constexpr std::size_t MessageSizeMaximum{ 1024 * 1024 };
+    static constexpr auto StreamingDuration = 2s;
+
+    const auto serverConfiguration = CreateServerConfiguration();
+    NetRemoteServer server{ serverConfiguration };
+    server.Run();
+
+    auto channel = grpc::CreateChannel(RemoteServiceAddressHttp, grpc::InsecureChannelCredentials());
+    auto client = NetRemoteDataStreaming::NewStub(channel);
+
+    for (const std::size_t dataBlockSize : { 64, 1024, 64 * 1024 }) {
+        for (const uint32_t dataBlocksPerMessage : { 1, 4, 16, 64 }) {
+            if (dataBlockSize * dataBlocksPerMessage > MessageSizeMaximum) {
+                continue;
+            }
+
+            DataStreamTimedTypeProperties timedTypeProperties{};
+            *timedTypeProperties.mutable_duration() = google::protobuf::util::TimeUtil::SecondsToDuration(std::chrono::duration_cast<std::chrono::seconds>(StreamingDuration).count());
+
+            DataStreamProperties properties{};
+            properties.set_type(DataStreamType::DataStreamTypeTimed);
+            properties.set_pattern(DataStreamPattern::DataStreamPatternConstant);
+            properties.set_datablocksize(static_cast<uint32_t>(dataBlockSize));
+            properties.set_datablockspermessage(dataBlocksPerMessage);
+            *properties.mutable_timed() = std::move(timedTypeProperties);
+
+            DataStreamDownloadRequest request{};
+            *request.mutable_properties() = std::move(properties);
+
+            DataStreamReader dataStreamReader{ client.get(), &request };
+
+            uint32_t numberOfDataBlocksReceived{};
+            DataStreamOperationStatus operationStatus{};
+            std::span<uint32_t> lostDataBlockSequenceNumbers{};
+            const grpc::Status status = dataStreamReader.Await(&numberOfDataBlocksReceived, &operationStatus, lostDataBlockSequenceNumbers);
+            REQUIRE(status.ok());
+            REQUIRE(operationStatus.code() == DataStreamOperationStatusCodeSucceeded);
+
+            const auto writeCompletionLatency = dataStreamReader.GetWriteCompletionLatencyHistogram();
+            REQUIRE(writeCompletionLatency.has_value());
+
+            const double seconds = std::chrono::duration<double>(StreamingDuration).count();
+            LOGI << std::format("DataStreamDownload {} byte blocks, {} per message: {:.0f} messages/s, {:.0f} blocks/s, {:.1f} Mbit/s, write completion mean {:.1f} us (max {} us)",
+                dataBlockSize,
+                dataBlocksPerMessage,
+                static_cast<double>(writeCompletionLatency->count()) / seconds,
+                static_cast<double>(numberOfDataBlocksReceived) / seconds,
+                static_cast<double>(dataStreamReader.GetNumberOfBytesReceived()) * 8 / seconds / 1e6,
+                writeCompletionLatency->mean(),
+                writeCompletionLatency->maximum());
+        }
+    }
+}
+
+TEST_CASE("DataStreamBidirectional API", "[basic][rpc][client][remote][stream]")
+{
+    using namespace Microsoft::Net::Remote;
+    using namespace Microsoft::Net::Remote::DataStream;
+    using namespace Microsoft::Net::Remote::Service;
+
+    using Microsoft::Net::Remote::Test::DataStreamReaderWriter;
+
+    const auto serverConfiguration = CreateServerConfiguration();
+    NetRemoteServer server{ serverConfiguration };
+    server.Run();
+
+    auto channel = grpc::CreateChannel(RemoteServiceAddressHttp, grpc::InsecureChannelCredentials());
+    auto client = NetRemoteDataStreaming::NewStub(channel);
+
+    static constexpr auto fixedNumberOfDataBlocksToStream = 10;
+
+    SECTION("Can be called with DataStreamTypeFixed")
+    {
+        DataStreamFixedTypeProperties fixedTypeProperties{};
+        fixedTypeProperties.set_numberofdatablockstostream(fixedNumberOfDataBlocksToStream);
+
+        DataStreamProperties properties{};
+        properties.set_type(DataStreamType::DataStreamTypeFixed);
+        *properties.mutable_fixed() = std::move(fixedTypeProperties);
+
+        DataStreamReaderWriter dataStreamReaderWriter{ client.get(), std::move(properties) };
+
+        uint32_t numberOfDataBlocksReceived{};
+        DataStreamOperationStatus operationStatus{};
+        std::span<uint32_t> lostDataBlockSequenceNumbers{};
+        const grpc::Status status = dataStreamReaderWriter.Await(&numberOfDataBlocksReceived, &operationStatus, lostDataBlockSequenceNumbers);
+        REQUIRE(status.ok());
+        REQUIRE(numberOfDataBlocksReceived > 0);
+        REQUIRE(operationStatus.code() == DataStreamOperationStatusCodeSucceeded);
+        REQUIRE(lostDataBlockSequenceNumbers.empty());
+    }
+
+    SECTION("Can be called with a custom data block size")
+    {
+        static constexpr auto DataBlockSize = 4 * 1024;
+
+        DataStreamFixedTypeProperties fixedTypeProperties{};
+        fixedTypeProperties.set_numberofdatablockstostream(fixedNumberOfDataBlocksToStream);
+
+        DataStreamProperties properties{};
+        properties.set_type(DataStreamType::DataStreamTypeFixed);
+        properties.set_datablocksize(DataBlockSize);
+        *properties.mutable_fixed() = std::move(fixedTypeProperties);
+
+        DataStreamReaderWriter dataStreamReaderWriter{ client.get(), std::move(properties) };
+
+        uint32_t numberOfDataBlocksReceived{};
+        DataStreamOperationStatus operationStatus{};
+        std::span<uint32_t> lostDataBlockSequenceNumbers{};
+        const grpc::Status status = dataStreamReaderWriter.Await(&numberOfDataBlocksReceived, &operationStatus, lostDataBlockSequenceNumbers);
+        REQUIRE(status.ok());
+        REQUIRE(numberOfDataBlocksReceived > 0);
+        REQUIRE(operationStatus.code() == DataStreamOperationStatusCodeSucceeded);
+        REQUIRE(lostDataBlockSequenceNumbers.empty());
+        REQUIRE(dataStreamReaderWriter.GetNumberOfBytesReceived() == static_cast<uint64_t>(DataBlockSize) * numberOfDataBlocksReceived);
+    }
+
+    SECTION("Packs several data blocks into each message")
+    {
+        DataStreamFixedTypeProperties fixedTypeProperties{};
+        fixedTypeProperties.set_numberofdatablockstostream(fixedNumberOfDataBlocksToStream);
+
+        DataStreamProperties properties{};
+        properties.set_type(DataStreamType::DataStreamTypeFixed);
+        properties.set_datablocksize(256);
+        properties.set_datablockspermessage(8);
+        *properties.mutable_fixed() = std::move(fixedTypeProperties);
+
+        DataStreamReaderWriter dataStreamReaderWriter{ client.get(), std::move(properties) };
+
+        uint32_t numberOfDataBlocksReceived{};
+        DataStreamOperationStatus operationStatus{};
+        std::span<uint32_t> lostDataBlockSequenceNumbers{};
+        const grpc::Status status = dataStreamReaderWriter.Await(&numberOfDataBlocksReceived, &operationStatus, lostDataBlockSequenceNumbers);
+        REQUIRE(status.ok());
+        REQUIRE(numberOfDataBlocksReceived > 0);
+        REQUIRE(numberOfDataBlocksReceived % 8 == 0);
+        REQUIRE(operationStatus.code() == DataStreamOperationStatusCodeSucceeded);
+        REQUIRE(lostDataBlockSequenceNumbers.empty());
+    }
+
+    SECTION("Echoes data blocks with timestamps")
+    {
+        DataStreamFixedTypeProperties fixedTypeProperties{};
+        fixedTypeProperties.set_numberofdatablockstostream(fixedNumberOfDataBlocksToStream);
+
+        DataStreamProperties properties{};
+        properties.set_type(DataStreamType::DataStreamTypeFixed);
+        properties.set_bidirectionalmode(DataStreamBidirectionalMode::DataStreamBidirectionalModeEcho);
+        *properties.mutable_fixed() = std::move(fixedTypeProperties);
+
+        DataStreamReaderWriter dataStreamReaderWriter{ client.get(), std::move(properties) };
+
+        uint32_t numberOfDataBlocksReceived{};
+        DataStreamOperationStatus operationStatus{};
+        std::span<uint32_t> lostDataBlockSequenceNumbers{};
+        const grpc::Status status = dataStreamReaderWriter.Await(&numberOfDataBlocksReceived, &operationStatus, lostDataBlockSequenceNumbers);
+        REQUIRE(status.ok());
+        REQUIRE(numberOfDataBlocksReceived == fixedNumberOfDataBlocksToStream);
+        REQUIRE(operationStatus.code() == DataStreamOperationStatusCodeSucceeded);
+        REQUIRE(lostDataBlockSequenceNumbers.empty());
+        REQUIRE(dataStreamReaderWriter.GetNumberOfDataBlocksEchoMismatched() == 0);
+        REQUIRE(dataStreamReaderWriter.GetRoundTripTimeHistogram().GetCount() == fixedNumberOfDataBlocksToStream);
+        REQUIRE(dataStreamReaderWriter.GetServerResidenceTimeHistogram().GetCount() == fixedNumberOfDataBlocksToStream);
+    }
+
+    SECTION("Can be called with DataStreamTypeContinuous")
+    {
+        static constexpr auto StreamingDelayTime = 5s;
+
+        DataStreamContinuousTypeProperties continuousTypeProperties{};
+
+        DataStreamProperties properties{};
+        properties.set_type(DataStreamType::DataStreamTypeContinuous);
+        *properties.mutable_continuous() = std::move(continuousTypeProperties);
+
+        DataStreamReaderWriter dataStreamReaderWriter{ client.get(), std::move(properties) };
+
+        // Allow some time of continuous streaming, then stop writing data. This will prompt the
+        // server to stop writing too, eliminating the need to cancel the RPC.
+        std::this_thread::sleep_for(StreamingDelayTime);
+        dataStreamReaderWriter.StopWrites();
+
+        uint32_t numberOfDataBlocksReceived{};
+        DataStreamOperationStatus operationStatus{};
+        std::span<uint32_t> lostDataBlockSequenceNumbers{};
+        const grpc::Status status = dataStreamReaderWriter.Await(&numberOfDataBlocksReceived, &operationStatus, lostDataBlockSequenceNumbers);
+        REQUIRE(status.ok());
+        REQUIRE(numberOfDataBlocksReceived > 0);
+        REQUIRE(operationStatus.code() == DataStreamOperationStatusCodeSucceeded);
+        REQUIRE(lostDataBlockSequenceNumbers.empty());
+    }
+
+    SECTION("Can be called with DataStreamTypeTimed and a target bitrate")
+    {
+        // 1KiB blocks at 80kbit/s (10000 bytes/s) for 2s allows ~20 blocks from the server, plus a small initial burst.
+        static constexpr auto StreamingDuration = 2s;
+        static constexpr auto DataBlockSize = 1024;
+        static constexpr auto TargetBitrate = 80'000;
+        static constexpr auto NumberOfDataBlocksMaximum = 25;
+
+        DataStreamTimedTypeProperties timedTypeProperties{};
+        *timedTypeProperties.mutable_duration() = google::protobuf::util::TimeUtil::SecondsToDuration(std::chrono::duration_cast<std::chrono::seconds>(StreamingDuration).count());
+
+        DataStreamProperties properties{};
+        properties.set_type(DataStreamType::DataStreamTypeTimed);
+        properties.set_datablocksize(DataBlockSize);
+        properties.set_targetbitrate(TargetBitrate);
+        *properties.mutable_timed() = std::move(timedTypeProperties);
+
+        DataStreamReaderWriter dataStreamReaderWriter{ client.get(), std::move(properties) };
+
+        // The server finishes the RPC once the duration elapses, so there is no need to stop writes.
+        uint32_t numberOfDataBlocksReceived{};
+        DataStreamOperationStatus operationStatus{};
+        std::span<uint32_t> lostDataBlockSequenceNumbers{};
+        const grpc::Status status = dataStreamReaderWriter.Await(&numberOfDataBlocksReceived, &operationStatus, lostDataBlockSequenceNumbers);
+        REQUIRE(status.ok());
+        REQUIRE(numberOfDataBlocksReceived > 0);
+        REQUIRE(numberOfDataBlocksReceived <= NumberOfDataBlocksMaximum);
+        REQUIRE(operationStatus.code() == DataStreamOperationStatusCodeSucceeded);
+        REQUIRE(lostDataBlockSequenceNumbers.empty());
+    }
+}
+
+TEST_CASE("DataStream admission control", "[basic][rpc][client][remote][stream]")
+{
+    using namespace Microsoft::Net::Remote;
+    using namespace Microsoft::Net::Remote::DataStream;
+    using namespace Microsoft::Net::Remote::Service;
+    using namespace Microsoft::Net::Remote::Wifi;
+
+    using Microsoft::Net::Remote::Test::DataStreamReader;
+    using Microsoft::Net::Remote::Test::DataStreamReaderWriter;
+
+    static constexpr auto AdmissionTimeout = 5s;
+
+    auto serverConfiguration = CreateServerConfiguration();
+
+    auto channel = grpc::CreateChannel(RemoteServiceAddressHttp, grpc::InsecureChannelCredentials());
+    auto client = NetRemoteDataStreaming::NewStub(channel);
+
+    const auto getMetrics = [&]() {
+        grpc::ClientContext clientContext{};
+        DataStreamMetrics metrics{};
+        REQUIRE(client->DataStreamGetMetrics(&clientContext, DataStreamMetricsRequest{}, &metrics).ok());
+        return metrics;
+    };
+    const auto awaitNumberOfStreamsActive = [&](uint32_t numberOfStreamsActive) {
+        const auto timeEnd = std::chrono::steady_clock::now() + AdmissionTimeout;
+        while (getMetrics().numberofstreamsactive() != numberOfStreamsActive && std::chrono::steady_clock::now() < timeEnd) {
+            std::this_thread::sleep_for(10ms);
+        }
+        return getMetrics().numberofstreamsactive() == numberOfStreamsActive;
+    };
+    const auto createFixedRequest = [](uint32_t dataBlockSize) {
+        DataStreamDownloadRequest request{};
+        request.mutable_properties()->set_type(DataStreamType::DataStreamTypeFixed);
+        request.mutable_properties()->set_pattern(DataStreamPattern::DataStreamPatternConstant);
+        request.mutable_properties()->set_datablocksize(dataBlockSize);
+        request.mutable_properties()->mutable_fixed()->set_numberofdatablockstostream(10);
+        return request;
+    };
+
+    SECTION("Rejects streams beyond the maximum while control-plane RPCs proceed")
+    {
+        serverConfiguration.DataStreamsMaximum = 1;
+        NetRemoteServer server{ serverConfiguration };
+        server.Run();
+
+        DataStreamDownloadRequest requestContinuous{};
+        requestContinuous.mutable_properties()->set_type(DataStreamType::DataStreamTypeContinuous);
+        requestContinuous.mutable_properties()->set_pattern(DataStreamPattern::DataStreamPatternConstant);
+        requestContinuous.mutable_properties()->mutable_continuous();
+
+        DataStreamReader dataStreamReaderAdmitted{ client.get(), &requestContinuous };
+        REQUIRE(awaitNumberOfStreamsActive(1));
+
+        auto requestFixed = createFixedRequest(1024);
+        {
+            DataStreamReader dataStreamReaderRejected{ client.get(), &requestFixed };
+
+            uint32_t numberOfDataBlocksReceived{};
+            DataStreamOperationStatus operationStatus{};
+            std::span<uint32_t> lostDataBlockSequenceNumbers{};
+            const grpc::Status status = dataStreamReaderRejected.Await(&numberOfDataBlocksReceived, &operationStatus, lostDataBlockSequenceNumbers);
+            REQUIRE(status.error_code() == grpc::StatusCode::RESOURCE_EXHAUSTED);
+            REQUIRE(numberOfDataBlocksReceived == 0);
+        }
+
+        // Control-plane RPCs are not subject to data stream admission.
+        {
+            auto controlPlaneClient = NetRemote::NewStub(channel);
+            WifiAccessPointsEnumerateResult result{};
+            grpc::ClientContext clientContext{};
+            REQUIRE(controlPlaneClient->WifiAccessPointsEnumerate(&clientContext, WifiAccessPointsEnumerateRequest{}, &result).ok());
+        }
+
+        dataStreamReaderAdmitted.Cancel();
+        uint32_t numberOfDataBlocksReceived{};
+        DataStreamOperationStatus operationStatus{};
+        std::span<uint32_t> lostDataBlockSequenceNumbers{};
+        dataStreamReaderAdmitted.Await(&numberOfDataBlocksReceived, &operationStatus, lostDataBlockSequenceNumbers);
+        REQUIRE(awaitNumberOfStreamsActive(0));
+
+        // The stream is admitted once the running one completed.
+        DataStreamReader dataStreamReader{ client.get(), &requestFixed };
+        const grpc::Status status = dataStreamReader.Await(&numberOfDataBlocksReceived, &operationStatus, lostDataBlockSequenceNumbers);
+        REQUIRE(status.ok());
+        REQUIRE(numberOfDataBlocksReceived == 10);
+        REQUIRE(getMetrics().numberofstreamsrejected() == 1);
+    }
+
+    SECTION("Rejects streams whose messages exceed the memory budget")
+    {
+        serverConfiguration.DataStreamBytesInFlightMaximum = 2048;
+        NetRemoteServer server{ serverConfiguration };
+        server.Run();
+
+        auto requestTooLarge = createFixedRequest(4096);
+        DataStreamReader dataStreamReaderRejected{ client.get(), &requestTooLarge };
+
+        uint32_t numberOfDataBlocksReceived{};
+        DataStreamOperationStatus operationStatus{};
+        std::span<uint32_t> lostDataBlockSequenceNumbers{};
+        grpc::Status status = dataStreamReaderRejected.Await(&numberOfDataBlocksReceived, &operationStatus, lostDataBlockSequenceNumbers);
+        REQUIRE(status.error_code() == grpc::StatusCode::RESOURCE_EXHAUSTED);
+
+        auto requestWithinBudget = createFixedRequest(1024);
+        DataStreamReader dataStreamReader{ client.get(), &requestWithinBudget };
+        status = dataStreamReader.Await(&numberOfDataBlocksReceived, &operationStatus, lostDataBlockSequenceNumbers);
+        REQUIRE(status.ok());
+        REQUIRE(numberOfDataBlocksReceived == 10);
+
+        const auto metrics = getMetrics();
+        REQUIRE(metrics.numberofstreamsrejected() == 1);
+        REQUIRE(metrics.numberofbytesinflight() == 0);
+    }
+
+    SECTION("Rejects echoed messages that exceed the memory budget")
+    {
+        // The client writes messages larger than this, each of which the server buffers to echo it.
+        serverConfiguration.DataStreamBytesInFlightMaximum = 4;
+        NetRemoteServer server{ serverConfiguration };
+        server.Run();
+
+        DataStreamProperties properties{};
+        properties.set_type(DataStreamType::DataStreamTypeFixed);
+        properties.set_bidirectionalmode(DataStreamBidirectionalMode::DataStreamBidirectionalModeEcho);
+        properties.mutable_fixed()->set_numberofdatablockstostream(10);
+
+        DataStreamReaderWriter dataStreamReaderWriter{ client.get(), std::move(properties) };
+
+        uint32_t numberOfDataBlocksReceived{};
+        DataStreamOperationStatus operationStatus{};
+        std::span<uint32_t> lostDataBlockSequenceNumbers{};
+        const grpc::Status status = dataStreamReaderWriter.Await(&numberOfDataBlocksReceived, &operationStatus, lostDataBlockSequenceNumbers);
+        REQUIRE(status.error_code() == grpc::StatusCode::RESOURCE_EXHAUSTED);
+        REQUIRE(numberOfDataBlocksReceived == 0);
+        REQUIRE(awaitNumberOfStreamsActive(0));
+
+        const auto metrics = getMetrics();
+        REQUIRE(metrics.numberofstreamsrejected() == 1);
+        REQUIRE(metrics.numberofbytesinflight() == 0);
+    }
+}
+
+TEST_CASE("DataStreamPing API", "[basic][rpc][client][remote][stream]")
+{
+    using namespace Microsoft::Net::Remote;
+    using namespace Microsoft::Net::Remote::DataStream;
+    using namespace Microsoft::Net::Remote::Service;
+
+    const auto serverConfiguration = CreateServerConfiguration();
+    NetRemoteServer server{ serverConfiguration };
+    server.Run();
+
+    auto channel = grpc::CreateChannel(RemoteServiceAddressHttp, grpc::InsecureChannelCredentials());
+    auto client = NetRemoteDataStreaming::NewStub(channel);
+
+    SECTION("Can be called")
+    {
+        grpc::ClientContext clientContext{};
+        DataStreamPingRequest request{};
+        request.set_sequencenumber(1);
+        *request.mutable_sendtime() = google::protobuf::util::TimeUtil::GetCurrentTime();
+        DataStreamPingResponse response{};
+
+        const grpc::Status status = client->DataStreamPing(&clientContext, request, &response);
+        REQUIRE(status.ok());
+        REQUIRE(response.sequencenumber() == request.sequencenumber());
+        REQUIRE(response.requestsendtime() == request.sendtime());
+        REQUIRE(response.receivetime() <= response.sendtime());
+    }
+
+    SECTION("Can be called with an empty request")
+    {
+        grpc::ClientContext clientContext{};
+        const DataStreamPingRequest request{};
+        DataStreamPingResponse response{};
+
+        const grpc::Status status = client->DataStreamPing(&clientContext, request, &response);
+        REQUIRE(status.ok());
+    }
+}
+
+TEST_CASE("DataStreamLatencyProbe API", "[basic][rpc][client][remote][stream]")
+{
+    using namespace Microsoft::Net::Remote;
+    using namespace Microsoft::Net::Remote::DataStream;
+    using namespace Microsoft::Net::Remote::Service;
+
+    using Microsoft::Net::Remote::Test::DataStreamLatencyProber;
+
+    const auto serverConfiguration = CreateServerConfiguration();
+    NetRemoteServer server{ serverConfiguration };
+    server.Run();
+
+    auto channel = grpc::CreateChannel(RemoteServiceAddressHttp, grpc::InsecureChannelCredentials());
+    auto client = NetRemoteDataStreaming::NewStub(channel);
+
+    SECTION("Reports round-trip time and clock offset statistics")
+    {
+        static constexpr auto NumberOfPings = 20;
+        static constexpr auto Interval = 10ms;
+
+        const auto timeStart = std::chrono::steady_clock::now();
+        DataStreamLatencyProber latencyProber{ client.get(), NumberOfPings, Interval };
+
+        const grpc::Status status = latencyProber.Await();
+        const auto timeElapsed = std::chrono::steady_clock::now() - timeStart;
+        REQUIRE(status.ok());
+        REQUIRE(timeElapsed >= (NumberOfPings - 1) * Interval);
+
+        const auto& statistics = latencyProber.GetStatistics();
+        REQUIRE(statistics.GetCount() == NumberOfPings);
+
+        const auto& roundTripTimeHistogram = statistics.GetRoundTripTimeHistogram();
+        REQUIRE(roundTripTimeHistogram.GetMinimum() <= roundTripTimeHistogram.GetValueAtPercentile(50));
+        REQUIRE(roundTripTimeHistogram.GetValueAtPercentile(50) <= roundTripTimeHistogram.GetValueAtPercentile(99));
+        REQUIRE(roundTripTimeHistogram.GetValueAtPercentile(99) <= roundTripTimeHistogram.GetMaximum());
+
+        // The client and server share a clock, so the offset is bounded by the round-trip time.
+        REQUIRE(statistics.GetClockOffset().has_value());
+        REQUIRE(static_cast<uint64_t>(std::abs(statistics.GetClockOffset()->count())) <= roundTripTimeHistogram.GetMaximum());
+    }
+}
+
+TEST_CASE("DataStreamLatencyUnderLoad API", "[basic][rpc][client][remote][stream]")
+{
+    using namespace Microsoft::Net::Remote;
+    using namespace Microsoft::Net::Remote::DataStream;
+    using namespace Microsoft::Net::Remote::Service;
+
+    const auto serverConfiguration = CreateServerConfiguration();
+    NetRemoteServer server{ serverConfiguration };
+    server.Run();
+
+    auto channel = grpc::CreateChannel(RemoteServiceAddressHttp, grpc::InsecureChannelCredentials());
+    auto client = NetRemoteDataStreaming::NewStub(channel);
+
+    // The server runs the test against itself, so the link is loopback.
+    DataStreamLatencyUnderLoadRequest request{};
+    request.set_address(RemoteServiceAddressHttp);
+    request.set_numberofstreams(2);
+    *request.mutable_idleduration() = google::protobuf::util::TimeUtil::MillisecondsToDuration(300);
+    *request.mutable_loadedduration() = google::protobuf::util::TimeUtil::MillisecondsToDuration(500);
+
+    SECTION("Reports idle and loaded round-trip times")
+    {
+        const auto direction = GENERATE(DataStreamLoadDirectionUpload, DataStreamLoadDirectionDownload, DataStreamLoadDirectionBidirectional);
+        request.set_direction(direction);
+
+        grpc::ClientContext clientContext{};
+        DataStreamLatencyUnderLoadResult result{};
+        const grpc::Status status = client->DataStreamLatencyUnderLoad(&clientContext, request, &result);
+        REQUIRE(status.ok());
+        REQUIRE(result.status().code() == DataStreamOperationStatusCodeSucceeded);
+        REQUIRE(result.idleroundtriptimemicroseconds().count() > 0);
+        REQUIRE(result.loadedroundtriptimemicroseconds().count() > 0);
+        REQUIRE(result.numberofbytestransferred() > 0);
+        REQUIRE(result.goodputbitspersecond() > 0);
+    }
+
+    SECTION("Fails with an invalid request")
+    {
+        grpc::ClientContext clientContext{};
+        DataStreamLatencyUnderLoadResult result{};
+        request.set_direction(DataStreamLoadDirectionUnknown);
+        REQUIRE(client->DataStreamLatencyUnderLoad(&clientContext, request, &result).ok());
+        REQUIRE(result.status().code() == DataStreamOperationStatusCodeFailed);
+
+        grpc::ClientContext clientContextTooManyStreams{};
+        request.set_direction(DataStreamLoadDirectionDownload);
+        request.set_numberofstreams(DataStreamLatencyUnderLoadConfiguration::NumberOfStreamsMaximum + 1);
+        REQUIRE(client->DataStreamLatencyUnderLoad(&clientContextTooManyStreams, request, &result).ok());
+        REQUIRE(result.status().code() == DataStreamOperationStatusCodeFailed);
+    }
+
+    SECTION("Fails with an invalid address")
+    {
+        const auto address = GENERATE(":5047", "localhost:", "localhost:0", "localhost:65536", "localhost:port", "::1:5047", "[::1:5047");
+        request.set_direction(DataStreamLoadDirectionDownload);
+        request.set_address(address);
+
+        grpc::ClientContext clientContext{};
+        DataStreamLatencyUnderLoadResult result{};
+        REQUIRE(client->DataStreamLatencyUnderLoad(&clientContext, request, &result).ok());
+        REQUIRE(result.status().code() == DataStreamOperationStatusCodeFailed);
+        REQUIRE_FALSE(std::empty(result.status().message()));
+    }
+
+    SECTION("Defaults to the server on the host of the caller")
+    {
+        request.set_direction(DataStreamLoadDirectionDownload);
+        request.clear_address();
+
+        grpc::ClientContext clientContext{};
+        DataStreamLatencyUnderLoadResult result{};
+        REQUIRE(client->DataStreamLatencyUnderLoad(&clientContext, request, &result).ok());
+        REQUIRE(result.status().code() == DataStreamOperationStatusCodeSucceeded);
+        REQUIRE(result.numberofbytestransferred() > 0);
+    }
+
+    SECTION("Rejects a test while another is running")
+    {
+        request.set_direction(DataStreamLoadDirectionDownload);
+
+        grpc::Status statusRunning{};
+        DataStreamLatencyUnderLoadResult resultRunning{};
+        std::jthread testRunning([&] {
+            grpc::ClientContext clientContext{};
+            statusRunning = client->DataStreamLatencyUnderLoad(&clientContext, request, &resultRunning);
+        });
+
+        // Give the first test time to start; it runs for longer than this.
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        grpc::ClientContext clientContext{};
+        DataStreamLatencyUnderLoadResult result{};
+        const grpc::Status status = client->DataStreamLatencyUnderLoad(&clientContext, request, &result);
+        REQUIRE(status.error_code() == grpc::StatusCode::RESOURCE_EXHAUSTED);
+
+        testRunning.join();
+        REQUIRE(statusRunning.ok());
+        REQUIRE(resultRunning.status().code() == DataStreamOperationStatusCodeSucceeded);
+    }
+}
+
+TEST_CASE("DataStreamSession API", "[basic][rpc][client][remote][stream]")
+{
+    using namespace Microsoft::Net::Remote;
+    using namespace Microsoft::Net::Remote::DataStream;
+    using namespace Microsoft::Net::Remote::Service;
+
+    using Microsoft::Net::Remote::Test::DataStreamReader;
+    using Microsoft::Net::Remote::Test::DataStreamReaderWriter;
+
+    const auto serverConfiguration = CreateServerConfiguration();
+    NetRemoteServer server{ serverConfiguration };
+    server.Run();
+
+    auto channel = grpc::CreateChannel(RemoteServiceAddressHttp, grpc::InsecureChannelCredentials());
+    auto client = NetRemoteDataStreaming::NewStub(channel);
+
+    SECTION("Aggregates results of parallel streams")
+    {
+        static constexpr auto NumberOfParallelDownloads = 4;
+        static constexpr auto NumberOfDataBlocksToStream = 100;
+        static constexpr auto DataBlockSize = 16 * 1024;
+
+        DataStreamSessionCreateResult sessionCreateResult{};
+        {
+            grpc::ClientContext clientContext{};
+            const grpc::Status status = client->DataStreamSessionCreate(&clientContext, DataStreamSessionCreateRequest{}, &sessionCreateResult);
+            REQUIRE(status.ok());
+            REQUIRE(sessionCreateResult.status().code() == DataStreamOperationStatusCodeSucceeded);
+            REQUIRE_FALSE(sessionCreateResult.sessionid().empty());
+        }
+
+        DataStreamFixedTypeProperties fixedTypeProperties{};
+        fixedTypeProperties.set_numberofdatablockstostream(NumberOfDataBlocksToStream);
+
+        DataStreamProperties properties{};
+        properties.set_type(DataStreamType::DataStreamTypeFixed);
+        properties.set_pattern(DataStreamPattern::DataStreamPatternConstant);
+        properties.set_datablocksize(DataBlockSize);
+        properties.set_sessionid(sessionCreateResult.sessionid());
+        *properties.mutable_fixed() = std::move(fixedTypeProperties);
+
+        DataStreamDownloadRequest request{};
+        *request.mutable_properties() = properties;
+
+        // Start all streams before waiting for any of them so that they run in parallel.
+        std::vector<std::unique_ptr<DataStreamReader>> dataStreamReaders{};
+        for (auto i = 0; i < NumberOfParallelDownloads; i++) {
+            dataStreamReaders.push_back(std::make_unique<DataStreamReader>(client.get(), &request));
+        }
+        DataStreamReaderWriter dataStreamReaderWriter{ client.get(), properties };
+
+        for (auto& dataStreamReader : dataStreamReaders) {
+            uint32_t numberOfDataBlocksReceived{};
+            DataStreamOperationStatus operationStatus{};
+            std::span<uint32_t> lostDataBlockSequenceNumbers{};
+            const grpc::Status status = dataStreamReader->Await(&numberOfDataBlocksReceived, &operationStatus, lostDataBlockSequenceNumbers);
+            REQUIRE(status.ok());
+            REQUIRE(numberOfDataBlocksReceived == NumberOfDataBlocksToStream);
+        }
+        {
+            uint32_t numberOfDataBlocksReceived{};
+            DataStreamOperationStatus operationStatus{};
+            std::span<uint32_t> lostDataBlockSequenceNumbers{};
+            const grpc::Status status = dataStreamReaderWriter.Await(&numberOfDataBlocksReceived, &operationStatus, lostDataBlockSequenceNumbers);
+            REQUIRE(status.ok());
+        }
+
+        DataStreamSessionResultRequest sessionResultRequest{};
+        sessionResultRequest.set_sessionid(sessionCreateResult.sessionid());
+        sessionResultRequest.set_close(true);
+
+        grpc::ClientContext clientContext{};
+        DataStreamSessionResult sessionResult{};
+        const grpc::Status status = client->DataStreamSessionGetResult(&clientContext, sessionResultRequest, &sessionResult);
+        REQUIRE(status.ok());
+        REQUIRE(sessionResult.status().code() == DataStreamOperationStatusCodeSucceeded);
+        REQUIRE(sessionResult.streams_size() == NumberOfParallelDownloads + 1);
+        REQUIRE(sessionResult.numberofbytessent() >= static_cast<uint64_t>(NumberOfParallelDownloads) * NumberOfDataBlocksToStream * DataBlockSize);
+        REQUIRE(sessionResult.numberofbytesreceived() > 0);
+        REQUIRE(sessionResult.goodputbitspersecond() > 0);
+        REQUIRE(sessionResult.fairnessindex() > 0);
+        REQUIRE(sessionResult.fairnessindex() <= 1);
+
+        uint32_t numberOfDownloadStreams{};
+        for (const auto& stream : sessionResult.streams()) {
+            if (stream.direction() == DataStreamSessionStreamDirection::DataStreamSessionStreamDirectionDownload) {
+                REQUIRE(stream.numberofbytessent() == static_cast<uint64_t>(NumberOfDataBlocksToStream) * DataBlockSize);
+                numberOfDownloadStreams++;
+            } else {
+                REQUIRE(stream.direction() == DataStreamSessionStreamDirection::DataStreamSessionStreamDirectionBidirectional);
+            }
+        }
+        REQUIRE(numberOfDownloadStreams == NumberOfParallelDownloads);
+
+        // The session was closed, so its result is no longer available.
+        grpc::ClientContext clientContextClosed{};
+        DataStreamSessionResult sessionResultClosed{};
+        REQUIRE(client->DataStreamSessionGetResult(&clientContextClosed, sessionResultRequest, &sessionResultClosed).ok());
+        REQUIRE(sessionResultClosed.status().code() == DataStreamOperationStatusCodeFailed);
+    }
+
+    SECTION("Fails to attach a stream to a session that does not exist")
+    {
+        DataStreamFixedTypeProperties fixedTypeProperties{};
+        fixedTypeProperties.set_numberofdatablockstostream(1);
+
+        DataStreamProperties properties{};
+        properties.set_type(DataStreamType::DataStreamTypeFixed);
+        properties.set_pattern(DataStreamPattern::DataStreamPatternConstant);
+        properties.set_sessionid("does-not-exist");
+        *properties.mutable_fixed() = std::move(fixedTypeProperties);
+
+        DataStreamDownloadRequest request{};
+        *request.mutable_properties() = std::move(properties);
+
+        DataStreamReader dataStreamReader{ client.get(), &request };
+
+        uint32_t numberOfDataBlocksReceived{};
+        DataStreamOperationStatus operationStatus{};
+        std::span<uint32_t> lostDataBlockSequenceNumbers{};
+        const grpc::Status status = dataStreamReader.Await(&numberOfDataBlocksReceived, &operationStatus, lostDataBlockSequenceNumbers);
+        REQUIRE(status.ok());
+        REQUIRE(operationStatus.code() == DataStreamOperationStatusCodeFailed);
+    }
+}
+
+#ifdef NETREMOTE_DATASTREAM_RAW_STREAMS
+TEST_CASE("DataStreamRaw API", "[basic][rpc][client][remote][stream]")
+{
+    using namespace Microsoft::Net::Remote;
+    using namespace Microsoft::Net::Remote::DataStream;
+    using namespace Microsoft::Net::Remote::Service;
+    using namespace Microsoft::Net::Wifi::Test;
+
+    // An access point on the loopback interface, which raw streams may be bound to.
+    static constexpr auto AccessPointIdLoopback{ "lo" };
+
+    auto apManagerTest = std::make_shared<AccessPointManagerTest>();
+    apManagerTest->AddAccessPoint(std::make_shared<AccessPointTest>(AccessPointIdLoopback));
+
+    const auto serverConfiguration = CreateServerConfiguration(apManagerTest);
+    NetRemoteServer server{ serverConfiguration };
+    server.Run();
+
+    auto channel = grpc::CreateChannel(RemoteServiceAddressHttp, grpc::InsecureChannelCredentials());
+    auto client = NetRemoteDataStreaming::NewStub(channel);
+
+    const auto startRawStream = [&](DataStreamRawProtocol protocol, DataStreamRawRole role, uint32_t port, std::chrono::milliseconds duration, DataStreamRawIoEngine ioEngine = DataStreamRawIoEngineEpoll, DataStreamRawTrafficClass trafficClass = DataStreamRawTrafficClassBestEffort) {
+        DataStreamRawStartRequest request{};
+        request.set_ioengine(ioEngine);
+        request.set_trafficclass(trafficClass);
+        request.set_protocol(protocol);
+        request.set_role(role);
+        request.set_address("127.0.0.1");
+        request.set_port(port);
+        *request.mutable_duration() = google::protobuf::util::TimeUtil::MillisecondsToDuration(duration.count());
+
+        grpc::ClientContext clientContext{};
+        DataStreamRawStartResult result{};
+        const grpc::Status status = client->DataStreamRawStart(&clientContext, request, &result);
+        REQUIRE(status.ok());
+
+        return result;
+    };
+
+    const auto awaitRawStream = [&](const std::string& id, bool close) {
+        static constexpr auto PollInterval{ std::chrono::milliseconds(50) };
+        static constexpr auto NumberOfPollsMaximum{ 200 };
+
+        DataStreamRawResultRequest request{};
+        request.set_id(id);
+
+        DataStreamRawResult result{};
+        for (auto i = 0; i < NumberOfPollsMaximum && !result.iscompleted(); i++) {
+            std::this_thread::sleep_for(PollInterval);
+            grpc::ClientContext clientContext{};
+            REQUIRE(client->DataStreamRawGetResult(&clientContext, request, &result).ok());
+            REQUIRE(result.status().code() == DataStreamOperationStatusCodeSucceeded);
+        }
+
+        REQUIRE(result.iscompleted());
+
+        if (close) {
+            request.set_close(true);
+            grpc::ClientContext clientContext{};
+            REQUIRE(client->DataStreamRawGetResult(&clientContext, request, &result).ok());
+        }
+
+        return result;
+    };
+
+    SECTION("Transfers data between a receiver and a sender on loopback")
+    {
+        const auto protocol = GENERATE(DataStreamRawProtocolTcp, DataStreamRawProtocolUdp);
+        const auto ioEngine = GENERATE(DataStreamRawIoEngineEpoll, DataStreamRawIoEngineIoUring);
+
+        const auto receiverStartResult = startRawStream(protocol, DataStreamRawRoleReceiver, 0, std::chrono::seconds(5), ioEngine);
+        REQUIRE(receiverStartResult.status().code() == DataStreamOperationStatusCodeSucceeded);
+        REQUIRE(receiverStartResult.port() != 0);
+
+        const auto senderStartResult = startRawStream(protocol, DataStreamRawRoleSender, receiverStartResult.port(), std::chrono::milliseconds(200), ioEngine);
+        REQUIRE(senderStartResult.status().code() == DataStreamOperationStatusCodeSucceeded);
+
+        const auto senderResult = awaitRawStream(senderStartResult.id(), true);
+        const auto receiverResult = awaitRawStream(receiverStartResult.id(), true);
+        REQUIRE(senderResult.numberofbytes() > 0);
+        REQUIRE(receiverResult.numberofbytes() > 0);
+        REQUIRE(receiverResult.numberofbytes() <= senderResult.numberofbytes());
+        REQUIRE(receiverResult.goodputbitspersecond() > 0);
+        if (protocol == DataStreamRawProtocolTcp) {
+            REQUIRE(receiverResult.numberofbytes() == senderResult.numberofbytes());
+        }
+
+        // The streams were closed, so their results are no longer available.
+        DataStreamRawResultRequest request{};
+        request.set_id(receiverStartResult.id());
+        grpc::ClientContext clientContext{};
+        DataStreamRawResult result{};
+        REQUIRE(client->DataStreamRawGetResult(&clientContext, request, &result).ok());
+        REQUIRE(result.status().code() == DataStreamOperationStatusCodeFailed);
+    }
+
+    SECTION("Reports the CPU cost of each TCP send mode")
+    {
+        const auto sendMode = GENERATE(DataStreamRawSendModeCopy, DataStreamRawSendModeZeroCopy, DataStreamRawSendModeSendfile);
+
+        const auto receiverStartResult = startRawStream(DataStreamRawProtocolTcp, DataStreamRawRoleReceiver, 0, std::chrono::seconds(5));
+        REQUIRE(receiverStartResult.status().code() == DataStreamOperationStatusCodeSucceeded);
+
+        DataStreamRawStartRequest request{};
+        request.set_protocol(DataStreamRawProtocolTcp);
+        request.set_role(DataStreamRawRoleSender);
+        request.set_address("127.0.0.1");
+        request.set_port(receiverStartResult.port());
+        request.set_sendmode(sendMode);
+        *request.mutable_duration() = google::protobuf::util::TimeUtil::MillisecondsToDuration(200);
+
+        grpc::ClientContext clientContext{};
+        DataStreamRawStartResult senderStartResult{};
+        REQUIRE(client->DataStreamRawStart(&clientContext, request, &senderStartResult).ok());
+        REQUIRE(senderStartResult.status().code() == DataStreamOperationStatusCodeSucceeded);
+
+        const auto senderResult = awaitRawStream(senderStartResult.id(), true);
+        const auto receiverResult = awaitRawStream(receiverStartResult.id(), true);
+        REQUIRE(receiverResult.numberofbytes() == senderResult.numberofbytes());
+        REQUIRE(google::protobuf::util::TimeUtil::DurationToNanoseconds(senderResult.cputime()) > 0);
+        REQUIRE(senderResult.cpucyclesperbyte() >= 0);
+        if (sendMode == DataStreamRawSendModeZeroCopy) {
+            REQUIRE(senderResult.numberofzerocopysendscompleted() > 0);
+        }
+    }
+
+    SECTION("Binds raw streams to an access point")
+    {
+        const auto receiverStartResult = startRawStream(DataStreamRawProtocolTcp, DataStreamRawRoleReceiver, 0, std::chrono::seconds(5));
+        REQUIRE(receiverStartResult.status().code() == DataStreamOperationStatusCodeSucceeded);
+
+        DataStreamRawStartRequest request{};
+        request.set_protocol(DataStreamRawProtocolTcp);
+        request.set_role(DataStreamRawRoleSender);
+        request.set_address("127.0.0.1");
+        request.set_port(receiverStartResult.port());
+        request.set_accesspointid(AccessPointIdLoopback);
+        *request.mutable_duration() = google::protobuf::util::TimeUtil::MillisecondsToDuration(200);
+
+        grpc::ClientContext clientContext{};
+        DataStreamRawStartResult senderStartResult{};
+        REQUIRE(client->DataStreamRawStart(&clientContext, request, &senderStartResult).ok());
+        REQUIRE(senderStartResult.status().code() == DataStreamOperationStatusCodeSucceeded);
+
+        const auto senderResult = awaitRawStream(senderStartResult.id(), true);
+        const auto receiverResult = awaitRawStream(receiverStartResult.id(), true);
+        REQUIRE(senderResult.numberofbytes() > 0);
+        REQUIRE(receiverResult.numberofbytes() == senderResult.numberofbytes());
+
+        request.set_accesspointid("TestDataStreamRawAccessPointInvalid");
+        grpc::ClientContext clientContextInvalid{};
+        DataStreamRawStartResult startResultInvalid{};
+        REQUIRE(client->DataStreamRawStart(&clientContextInvalid, request, &startResultInvalid).ok());
+        REQUIRE(startResultInvalid.status().code() == DataStreamOperationStatusCodeFailed);
+    }
+
+    SECTION("Aggregates the results of concurrent raw streams by traffic class")
+    {
+        DataStreamRawTrafficClassResultRequest request{};
+        for (const auto trafficClass : { DataStreamRawTrafficClassVoice, DataStreamRawTrafficClassBackground }) {
+            const auto receiverStartResult = startRawStream(DataStreamRawProtocolUdp, DataStreamRawRoleReceiver, 0, std::chrono::seconds(5), DataStreamRawIoEngineEpoll, trafficClass);
+            REQUIRE(receiverStartResult.status().code() == DataStreamOperationStatusCodeSucceeded);
+            const auto senderStartResult = startRawStream(DataStreamRawProtocolUdp, DataStreamRawRoleSender, receiverStartResult.port(), std::chrono::milliseconds(200), DataStreamRawIoEngineEpoll, trafficClass);
+            REQUIRE(senderStartResult.status().code() == DataStreamOperationStatusCodeSucceeded);
+
+            request.add_ids(receiverStartResult.id());
+            request.add_ids(senderStartResult.id());
+        }
+
+        for (const auto& id : request.ids()) {
+            awaitRawStream(id, false);
+        }
+
+        grpc::ClientContext clientContext{};
+        DataStreamRawTrafficClassResults results{};
+        REQUIRE(client->DataStreamRawGetTrafficClassResults(&clientContext, request, &results).ok());
+        REQUIRE(results.status().code() == DataStreamOperationStatusCodeSucceeded);
+        REQUIRE(results.trafficclasses_size() == 4);
+        REQUIRE(results.trafficclasses(0).trafficclass() == DataStreamRawTrafficClassBackground);
+        REQUIRE(results.trafficclasses(3).trafficclass() == DataStreamRawTrafficClassVoice);
+        for (const auto& result : results.trafficclasses()) {
+            REQUIRE(result.numberofstreams() == 1);
+            REQUIRE(result.numberofbytes() > 0);
+        }
+
+        for (const auto& id : request.ids()) {
+            awaitRawStream(id, true);
+        }
+
+        request.add_ids("TestDataStreamRawIdInvalid");
+        grpc::ClientContext clientContextInvalid{};
+        REQUIRE(client->DataStreamRawGetTrafficClassResults(&clientContextInvalid, request, &results).ok());
+        REQUIRE(results.status().code() == DataStreamOperationStatusCodeFailed);
+    }
+
+    SECTION("Stops a raw stream on request")
+    {
+        const auto startResult = startRawStream(DataStreamRawProtocolTcp, DataStreamRawRoleReceiver, 0, std::chrono::minutes(1));
+        REQUIRE(startResult.status().code() == DataStreamOperationStatusCodeSucceeded);
+
+        DataStreamRawResultRequest request{};
+        request.set_id(startResult.id());
+        request.set_stop(true);
+
+        grpc::ClientContext clientContext{};
+        DataStreamRawResult result{};
+        REQUIRE(client->DataStreamRawGetResult(&clientContext, request, &result).ok());
+        REQUIRE(result.status().code() == DataStreamOperationStatusCodeSucceeded);
+
+        const auto resultStopped = awaitRawStream(startResult.id(), true);
+        REQUIRE(resultStopped.numberofbytes() == 0);
+    }
+
+    SECTION("Fails with an invalid request")
+    {
+        const auto startResult = startRawStream(DataStreamRawProtocolUnknown, DataStreamRawRoleReceiver, 0, std::chrono::seconds(1));
+        REQUIRE(startResult.status().code() == DataStreamOperationStatusCodeFailed);
+
+        const auto startResultInvalidPort = startRawStream(DataStreamRawProtocolUdp, DataStreamRawRoleReceiver, std::numeric_limits<uint16_t>::max() + 1U, std::chrono::seconds(1));
+        REQUIRE(startResultInvalidPort.status().code() == DataStreamOperationStatusCodeFailed);
     }
 }
+#endif // NETREMOTE_DATASTREAM_RAW_STREAMS
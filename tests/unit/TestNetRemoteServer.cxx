@@ -2,21 +2,28 @@
 #include <chrono>
 #include <cstdlib>
 #include <filesystem>
+#include <format>
 #include <fstream>
 #include <memory>
 #include <optional>
 #include <ranges>
+#include <string>
+#include <vector>
 
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
 #include <catch2/generators/catch_generators_range.hpp>
 #include <grpc/impl/codegen/connectivity_state.h>
+#include <grpcpp/client_context.h>
 #include <grpcpp/create_channel.h>
 #include <grpcpp/security/credentials.h>
 #include <microsoft/net/remote/protocol/NetRemoteService.grpc.pb.h>
+#include <microsoft/net/remote/protocol/NetRemoteWifi.pb.h>
 #include <microsoft/net/remote/service/NetRemoteServer.hxx>
 #include <microsoft/net/remote/service/NetRemoteServerConfiguration.hxx>
 #include <microsoft/net/remote/service/NetRemoteServerJsonConfiguration.hxx>
 #include <microsoft/net/wifi/AccessPointManager.hxx>
+#include <nlohmann/json.hpp>
 
 #include "TestNetRemoteCommon.hxx"
 
@@ -94,6 +101,41 @@ CreateServerConfigurationJsonFileInvalid()
 
     return configurationFilePath;
 }
+
+/**
+ * @brief Create a JSON server configuration file with the specified content.
+ *
+ * @param fileName The name of the file to create in the temporary directory.
+ * @param content The content of the file.
+ * @return std::filesystem::path The path to the created JSON configuration file.
+ */
+std::filesystem::path
+CreateServerConfigurationJsonFile(const std::string& fileName, const std::string& content)
+{
+    const auto configurationFilePath{ std::filesystem::temp_directory_path() / fileName };
+    std::ofstream configurationFileStream{ configurationFilePath, std::ios::out | std::ios::trunc };
+
+    configurationFileStream << content;
+
+    return configurationFilePath;
+}
+
+/**
+ * @brief Create a server configuration from command-line arguments, throwing if they cannot be parsed.
+ *
+ * @param arguments The command-line arguments, including the program name.
+ * @return NetRemoteServerConfiguration
+ */
+NetRemoteServerConfiguration
+CreateServerConfigurationFromCommandLine(std::vector<std::string> arguments)
+{
+    std::vector<char*> argv{};
+    for (auto& argument : arguments) {
+        argv.push_back(std::data(argument));
+    }
+
+    return NetRemoteServerConfiguration::FromCommandLineArguments(static_cast<int>(std::size(argv)), std::data(argv), /* throwOnParseError */ true);
+}
 } // namespace Microsoft::Net::Remote::Service::Test
 
 TEST_CASE("Parse JSON server configuration from file", "[basic][json][config]")
@@ -170,6 +212,123 @@ TEST_CASE("Parse JSON server configuration from file", "[basic][json][config]")
     }
 }
 
+TEST_CASE("Parse JSON server tuning configuration", "[basic][json][config]")
+{
+    using namespace Microsoft::Net::Remote::Service;
+    using namespace std::chrono_literals;
+
+    SECTION("TryParseFromJson parses Server fields and leaves unspecified fields empty")
+    {
+        const auto configurationJson = nlohmann::json::parse(R"({
+    "Server": {
+        "DataStreamsMaximum": 8,
+        "AccessPointOperationThreads": 2,
+        "Http2StreamsMaximum": 32,
+        "MessageSizeReceiveMaximum": 1048576,
+        "KeepaliveTimeMs": 30000,
+        "KeepalivePermitWithoutCalls": true
+    }
+})");
+        const auto configuration = NetRemoteServerJsonConfiguration::TryParseFromJson(configurationJson);
+        REQUIRE(configuration.has_value());
+        REQUIRE(configuration->Server.has_value());
+
+        const auto& server = configuration->Server.value();
+        REQUIRE(server.DataStreamsMaximum == 8U);
+        REQUIRE(server.AccessPointOperationThreads == 2U);
+        REQUIRE(server.Http2StreamsMaximum == 32U);
+        REQUIRE(server.MessageSizeReceiveMaximum == 1048576U);
+        REQUIRE(server.KeepaliveTime == 30000ms);
+        REQUIRE(server.KeepalivePermitWithoutCalls == true);
+        REQUIRE_FALSE(server.DataStreamBytesInFlightMaximum.has_value());
+        REQUIRE_FALSE(server.KeepaliveTimeout.has_value());
+    }
+
+    SECTION("ApplyTo only overrides specified fields")
+    {
+        NetRemoteServerConfiguration serverConfiguration{};
+        serverConfiguration.KeepaliveTimeout = 5000ms;
+
+        const NetRemoteServerJsonConfiguration::ServerTuning server{
+            .DataStreamsMaximum = 4,
+            .KeepaliveTime = 1000ms,
+        };
+        server.ApplyTo(serverConfiguration);
+
+        REQUIRE(serverConfiguration.DataStreamsMaximum == 4);
+        REQUIRE(serverConfiguration.KeepaliveTime == 1000ms);
+        REQUIRE(serverConfiguration.KeepaliveTimeout == 5000ms);
+        REQUIRE(serverConfiguration.DataStreamBytesInFlightMaximum == NetRemoteServerConfiguration::DataStreamBytesInFlightMaximumDefault);
+    }
+
+    SECTION("TryParseFromJson fails with Server fields of the wrong type")
+    {
+        const auto configurationJson = nlohmann::json::parse(R"({ "Server": { "Http2StreamsMaximum": "many" } })");
+        REQUIRE_FALSE(NetRemoteServerJsonConfiguration::TryParseFromJson(configurationJson).has_value());
+    }
+
+    SECTION("TryParseFromJson fails when Server is not an object")
+    {
+        const auto configurationJson = nlohmann::json::parse(R"({ "Server": 1 })");
+        REQUIRE_FALSE(NetRemoteServerJsonConfiguration::TryParseFromJson(configurationJson).has_value());
+    }
+
+    SECTION("TryParseFromJson fails with Server fields out of range")
+    {
+        const auto configurationJsonContent = GENERATE(
+            R"({ "Server": { "MessageSizeReceiveMaximum": 2147483648 } })",
+            R"({ "Server": { "KeepaliveTimeMs": 2147483648 } })",
+            R"({ "Server": { "DataStreamsMaximum": 4294967296 } })",
+            R"({ "Server": { "DataStreamsMaximum": -1 } })",
+            R"({ "Server": { "Http2StreamsMaximum": 1.5 } })");
+        REQUIRE_FALSE(NetRemoteServerJsonConfiguration::TryParseFromJson(nlohmann::json::parse(configurationJsonContent)).has_value());
+    }
+
+    SECTION("TryParseFromJson accepts Server fields at the maximum")
+    {
+        const auto configurationJson = nlohmann::json::parse(R"({ "Server": { "MessageSizeReceiveMaximum": 2147483647, "KeepaliveTimeMs": 2147483647 } })");
+        const auto configuration = NetRemoteServerJsonConfiguration::TryParseFromJson(configurationJson);
+        REQUIRE(configuration.has_value());
+        REQUIRE(configuration->Server->MessageSizeReceiveMaximum == NetRemoteServerConfiguration::GrpcOptionValueMaximum);
+        REQUIRE(configuration->Server->KeepaliveTime == std::chrono::milliseconds(NetRemoteServerConfiguration::GrpcOptionValueMaximum));
+    }
+}
+
+TEST_CASE("Parse server configuration from command line arguments", "[basic][json][config]")
+{
+    using namespace Microsoft::Net::Remote::Service;
+
+    SECTION("Malformed Server JSON configuration doesn't cause a crash")
+    {
+        const auto configurationJsonContent = GENERATE(
+            R"({ "Server": 1 })",
+            R"({ "Server": { "Http2StreamsMaximum": "many" } })",
+            R"({ "Server": { "MessageSizeReceiveMaximum": 4294967295 } })");
+        const auto configurationFilePath = Test::CreateServerConfigurationJsonFile("NetRemoteServerConfigurationMalformed.json", configurationJsonContent);
+
+        NetRemoteServerConfiguration configuration{};
+        REQUIRE_NOTHROW(configuration = Test::CreateServerConfigurationFromCommandLine({ "netremote-server", "--config", configurationFilePath.string() }));
+        REQUIRE(configuration.Http2StreamsMaximum == 0);
+        REQUIRE(configuration.MessageSizeReceiveMaximum == 0);
+    }
+
+    SECTION("Command-line options take precedence over the JSON configuration file")
+    {
+        const auto configurationFilePath = Test::CreateServerConfigurationJsonFile("NetRemoteServerConfigurationServer.json", R"({ "Server": { "Http2StreamsMaximum": 32, "DataStreamsMaximum": 8 } })");
+
+        const auto configuration = Test::CreateServerConfigurationFromCommandLine({ "netremote-server", "--http2-streams-max", "16", "--config", configurationFilePath.string() });
+        REQUIRE(configuration.Http2StreamsMaximum == 16);
+        REQUIRE(configuration.DataStreamsMaximum == 8);
+    }
+
+    SECTION("Command-line options passed to gRPC as an int are limited to its range")
+    {
+        const auto optionName = GENERATE("--http2-streams-max", "--message-size-receive-max", "--message-size-send-max", "--keepalive-time-ms", "--keepalive-timeout-ms", "--keepalive-ping-interval-min-ms");
+        REQUIRE_THROWS(Test::CreateServerConfigurationFromCommandLine({ "netremote-server", optionName, "2147483648" }));
+        REQUIRE_NOTHROW(Test::CreateServerConfigurationFromCommandLine({ "netremote-server", optionName, "2147483647" }));
+    }
+}
+
 TEST_CASE("Create a NetRemoteServer instance", "[basic][rpc][remote]")
 {
     using namespace Microsoft::Net::Remote::Service;
@@ -229,6 +388,71 @@ TEST_CASE("NetRemoteServer can be reached", "[basic][rpc][remote]")
     }
 }
 
+TEST_CASE("NetRemoteServer can be reached with tuning applied", "[basic][rpc][remote]")
+{
+    using namespace Microsoft::Net::Remote;
+    using namespace Microsoft::Net::Remote::Service;
+    using namespace Microsoft::Net::Remote::Wifi;
+
+    auto serverConfiguration = CreateServerConfiguration();
+    serverConfiguration.AccessPointOperationThreads = 1;
+    serverConfiguration.AccessPointOperationQueueDepthMaximum = 4;
+    serverConfiguration.CompletionQueues = 1;
+    serverConfiguration.SyncServerThreadsMinimum = 1;
+    serverConfiguration.SyncServerThreadsMaximum = 2;
+    serverConfiguration.ResourceQuotaThreadsMaximum = 8;
+    serverConfiguration.ResourceQuotaBytes = 32 * 1024 * 1024;
+    serverConfiguration.Http2StreamsMaximum = 16;
+    serverConfiguration.MessageSizeReceiveMaximum = 1024 * 1024;
+    serverConfiguration.MessageSizeSendMaximum = 1024 * 1024;
+    serverConfiguration.KeepaliveTime = 10s;
+    serverConfiguration.KeepaliveTimeout = 5s;
+    serverConfiguration.KeepalivePingIntervalMinimum = 5s;
+    serverConfiguration.KeepalivePermitWithoutCalls = true;
+
+    NetRemoteServer server{ serverConfiguration };
+    server.Run();
+
+    auto channel = grpc::CreateChannel(RemoteServiceAddressHttp, grpc::InsecureChannelCredentials());
+    auto client = NetRemote::NewStub(channel);
+    REQUIRE(channel->WaitForConnected(std::chrono::system_clock::now() + RemoteServiceConnectionTimeout));
+
+    const WifiAccessPointsEnumerateRequest request{};
+    WifiAccessPointsEnumerateResult result{};
+    grpc::ClientContext clientContext{};
+    REQUIRE(client->WifiAccessPointsEnumerate(&clientContext, request, &result).ok());
+}
+
+TEST_CASE("NetRemoteServer can be reached on additional addresses", "[basic][rpc][remote]")
+{
+    using namespace Microsoft::Net::Remote;
+    using namespace Microsoft::Net::Remote::Service;
+    using namespace Microsoft::Net::Remote::Wifi;
+
+    const auto unixSocketPath = std::filesystem::temp_directory_path() / "netremote-test.sock";
+    const auto unixSocketAddress = std::format("unix:{}", unixSocketPath.string());
+    const auto unixAbstractSocketAddress = std::string{ "unix-abstract:netremote-test" };
+
+    auto serverConfiguration = CreateServerConfiguration();
+    serverConfiguration.AdditionalServerAddresses = { unixSocketAddress, unixAbstractSocketAddress };
+
+    NetRemoteServer server{ serverConfiguration };
+    server.Run();
+    REQUIRE(server.GetGrpcServer() != nullptr);
+
+    const auto serverAddress = GENERATE_COPY(std::string{ RemoteServiceAddressHttp }, unixSocketAddress, unixAbstractSocketAddress);
+    CAPTURE(serverAddress);
+
+    auto channel = grpc::CreateChannel(serverAddress, grpc::InsecureChannelCredentials());
+    auto client = NetRemote::NewStub(channel);
+    REQUIRE(channel->WaitForConnected(std::chrono::system_clock::now() + RemoteServiceConnectionTimeout));
+
+    const WifiAccessPointsEnumerateRequest request{};
+    WifiAccessPointsEnumerateResult result{};
+    grpc::ClientContext clientContext{};
+    REQUIRE(client->WifiAccessPointsEnumerate(&clientContext, request, &result).ok());
+}
+
 TEST_CASE("NetRemoteServer shuts down correctly", "[basic][rpc][remote]")
 {
     using namespace Microsoft::Net::Remote;
@@ -1191,3 +1191,212 @@ TEST_CASE("WifiAccessPointGetAttributes API", "[basic][rpc][client][remote]")
         REQUIRE(properties.at(InterfaceAttributesPropertyKey) == InterfaceAttributesPropertyValue);
     }
 }
+
+TEST_CASE("WifiAccessPointsWatch API", "[basic][rpc][client][remote]")
+{
+    using namespace Microsoft::Net::Remote;
+    using namespace Microsoft::Net::Remote::Service;
+    using namespace Microsoft::Net::Remote::Test;
+    using namespace Microsoft::Net::Remote::Wifi;
+    using namespace Microsoft::Net::Wifi;
+    using namespace Microsoft::Net::Wifi::Test;
+
+    constexpr auto InterfaceName1{ "TestWifiAccessPointsWatch1" };
+    constexpr auto InterfaceName2{ "TestWifiAccessPointsWatch2" };
+
+    auto apManagerTest = std::make_shared<AccessPointManagerTest>();
+    const Ieee80211AccessPointCapabilities apCapabilities{
+        .PhyTypes{ std::cbegin(AllPhyTypes), std::cend(AllPhyTypes) }
+    };
+
+    auto apTest1 = std::make_shared<AccessPointTest>(InterfaceName1, apCapabilities);
+    auto apTest2 = std::make_shared<AccessPointTest>(InterfaceName2, apCapabilities);
+    apManagerTest->AddAccessPoint(apTest1);
+
+    const auto serverConfiguration = CreateServerConfiguration(apManagerTest);
+    NetRemoteServer server{ serverConfiguration };
+    server.Run();
+
+    auto channel = grpc::CreateChannel(RemoteServiceAddressHttp, grpc::InsecureChannelCredentials());
+    auto client = NetRemote::NewStub(channel);
+
+    const WifiAccessPointsWatchRequest request{};
+    grpc::ClientContext clientContext{};
+    auto reader = client->WifiAccessPointsWatch(&clientContext, request);
+
+    WifiAccessPointsWatchResult result{};
+    REQUIRE(reader->Read(&result));
+    REQUIRE(result.status().code() == WifiAccessPointOperationStatusCode::WifiAccessPointOperationStatusCodeSucceeded);
+    REQUIRE(result.eventtype() == WifiAccessPointsWatchEventType::WifiAccessPointsWatchEventTypeSnapshot);
+    REQUIRE(result.accesspoints_size() == 1);
+    REQUIRE(result.accesspoints(0).accesspointid() == InterfaceName1);
+
+    SECTION("Reports changes in the order they occur")
+    {
+        apManagerTest->AddAccessPoint(apTest2);
+        REQUIRE(apTest2->CreateController()->SetOperationalState(AccessPointOperationalState::Enabled));
+        apManagerTest->RemoveAccessPoint(apTest2);
+
+        REQUIRE(reader->Read(&result));
+        REQUIRE(result.eventtype() == WifiAccessPointsWatchEventType::WifiAccessPointsWatchEventTypeAdded);
+        REQUIRE(result.accesspoints_size() == 1);
+        REQUIRE(result.accesspoints(0).accesspointid() == InterfaceName2);
+
+        REQUIRE(reader->Read(&result));
+        REQUIRE(result.eventtype() == WifiAccessPointsWatchEventType::WifiAccessPointsWatchEventTypeEnabled);
+        REQUIRE(result.accesspoints_size() == 1);
+        REQUIRE(result.accesspoints(0).accesspointid() == InterfaceName2);
+        REQUIRE(result.accesspoints(0).isenabled());
+
+        REQUIRE(reader->Read(&result));
+        REQUIRE(result.eventtype() == WifiAccessPointsWatchEventType::WifiAccessPointsWatchEventTypeRemoved);
+        REQUIRE(result.accesspoints_size() == 1);
+        REQUIRE(result.accesspoints(0).accesspointid() == InterfaceName2);
+
+        clientContext.TryCancel();
+        while (reader->Read(&result)) {
+        }
+
+        REQUIRE(reader->Finish().error_code() == grpc::StatusCode::CANCELLED);
+    }
+
+    SECTION("Ends when the server is stopped")
+    {
+        REQUIRE_NOTHROW(server.Stop());
+        while (reader->Read(&result)) {
+        }
+
+        REQUIRE_FALSE(reader->Finish().ok());
+    }
+}
+
+TEST_CASE("WifiAccessPointStationsWatch API", "[basic][rpc][client][remote]")
+{
+    using namespace Microsoft::Net::Remote;
+    using namespace Microsoft::Net::Remote::Service;
+    using namespace Microsoft::Net::Remote::Test;
+    using namespace Microsoft::Net::Remote::Wifi;
+    using namespace Microsoft::Net::Wifi;
+    using namespace Microsoft::Net::Wifi::Test;
+
+    constexpr auto InterfaceName1{ "TestWifiAccessPointStationsWatch1" };
+    constexpr auto InterfaceName2{ "TestWifiAccessPointStationsWatch2" };
+
+    auto apManagerTest = std::make_shared<AccessPointManagerTest>();
+    const Ieee80211AccessPointCapabilities apCapabilities{
+        .PhyTypes{ std::cbegin(AllPhyTypes), std::cend(AllPhyTypes) }
+    };
+
+    auto apTest1 = std::make_shared<AccessPointTest>(InterfaceName1, apCapabilities);
+    auto apTest2 = std::make_shared<AccessPointTest>(InterfaceName2, apCapabilities);
+    apManagerTest->AddAccessPoint(apTest1);
+    apManagerTest->AddAccessPoint(apTest2);
+
+    const auto serverConfiguration = CreateServerConfiguration(apManagerTest);
+    NetRemoteServer server{ serverConfiguration };
+    server.Run();
+
+    auto channel = grpc::CreateChannel(RemoteServiceAddressHttp, grpc::InsecureChannelCredentials());
+    auto client = NetRemote::NewStub(channel);
+
+    SECTION("Station events are reported to all watchers")
+    {
+        // Each watcher is registered for events once its initial metadata is received.
+        const WifiAccessPointStationsWatchRequest request{};
+        grpc::ClientContext clientContext1{};
+        grpc::ClientContext clientContext2{};
+        auto reader1 = client->WifiAccessPointStationsWatch(&clientContext1, request);
+        auto reader2 = client->WifiAccessPointStationsWatch(&clientContext2, request);
+        reader1->WaitForInitialMetadata();
+        reader2->WaitForInitialMetadata();
+
+        apTest1->OnStationChanged(AccessPointStationChange::Connected, MacAddressDefault);
+        apTest2->OnStationChanged(AccessPointStationChange::Disconnected, MacAddressDefault);
+
+        for (auto* reader : { reader1.get(), reader2.get() }) {
+            WifiAccessPointStationsWatchResult result{};
+            REQUIRE(reader->Read(&result));
+            REQUIRE(result.status().code() == WifiAccessPointOperationStatusCode::WifiAccessPointOperationStatusCodeSucceeded);
+            REQUIRE(result.accesspointid() == InterfaceName1);
+            REQUIRE(result.eventtype() == WifiAccessPointStationsWatchEventType::WifiAccessPointStationsWatchEventTypeConnected);
+            REQUIRE(result.stationmacaddress().value() == std::string(std::cbegin(MacAddressDefault), std::cend(MacAddressDefault)));
+            REQUIRE(result.numberofeventsdiscarded() == 0);
+
+            REQUIRE(reader->Read(&result));
+            REQUIRE(result.accesspointid() == InterfaceName2);
+            REQUIRE(result.eventtype() == WifiAccessPointStationsWatchEventType::WifiAccessPointStationsWatchEventTypeDisconnected);
+        }
+
+        for (auto [clientContext, reader] : { std::pair{ &clientContext1, reader1.get() }, std::pair{ &clientContext2, reader2.get() } }) {
+            clientContext->TryCancel();
+            WifiAccessPointStationsWatchResult result{};
+            while (reader->Read(&result)) {
+            }
+
+            REQUIRE(reader->Finish().error_code() == grpc::StatusCode::CANCELLED);
+        }
+    }
+
+    SECTION("Only station events of the requested access point are reported")
+    {
+        WifiAccessPointStationsWatchRequest request{};
+        request.set_accesspointid(InterfaceName2);
+
+        grpc::ClientContext clientContext{};
+        auto reader = client->WifiAccessPointStationsWatch(&clientContext, request);
+        reader->WaitForInitialMetadata();
+
+        apTest1->OnStationChanged(AccessPointStationChange::Connected, MacAddressDefault);
+        apTest2->OnStationChanged(AccessPointStationChange::Connected, MacAddressDefault);
+
+        WifiAccessPointStationsWatchResult result{};
+        REQUIRE(reader->Read(&result));
+        REQUIRE(result.accesspointid() == InterfaceName2);
+
+        clientContext.TryCancel();
+        while (reader->Read(&result)) {
+        }
+
+        REQUIRE(reader->Finish().error_code() == grpc::StatusCode::CANCELLED);
+    }
+
+    SECTION("Ends when the server is stopped")
+    {
+        const WifiAccessPointStationsWatchRequest request{};
+        grpc::ClientContext clientContext{};
+        auto reader = client->WifiAccessPointStationsWatch(&clientContext, request);
+        reader->WaitForInitialMetadata();
+
+        REQUIRE_NOTHROW(server.Stop());
+
+        WifiAccessPointStationsWatchResult result{};
+        while (reader->Read(&result)) {
+        }
+
+        REQUIRE_FALSE(reader->Finish().ok());
+    }
+
+    SECTION("Ends together with access point watches when the server is stopped")
+    {
+        grpc::ClientContext stationsClientContext{};
+        auto stationsReader = client->WifiAccessPointStationsWatch(&stationsClientContext, WifiAccessPointStationsWatchRequest{});
+        stationsReader->WaitForInitialMetadata();
+
+        grpc::ClientContext accessPointsClientContext{};
+        auto accessPointsReader = client->WifiAccessPointsWatch(&accessPointsClientContext, WifiAccessPointsWatchRequest{});
+        WifiAccessPointsWatchResult accessPointsResult{};
+        REQUIRE(accessPointsReader->Read(&accessPointsResult));
+
+        REQUIRE_NOTHROW(server.Stop());
+
+        WifiAccessPointStationsWatchResult stationsResult{};
+        while (stationsReader->Read(&stationsResult)) {
+        }
+        while (accessPointsReader->Read(&accessPointsResult)) {
+        }
+
+        REQUIRE_FALSE(stationsReader->Finish().ok());
+        REQUIRE_FALSE(accessPointsReader->Finish().ok());
+        REQUIRE(server.GetGrpcServer() == nullptr);
+    }
+}
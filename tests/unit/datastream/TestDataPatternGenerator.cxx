@@ -0,0 +1,131 @@
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <microsoft/net/remote/datastream/DataPatternGenerator.hxx>
+
+TEST_CASE("DataPatternGenerator generates verifiable data", "[datastream][pattern]")
+{
+    using namespace Microsoft::Net::Remote::DataStream;
+
+    static constexpr uint64_t Seed{ 0xABCDEF };
+    static constexpr std::size_t DataBlockSize{ 1000 };
+
+    const auto dataPattern = GENERATE(DataPattern::PseudoRandom, DataPattern::Counter, DataPattern::Zeros, DataPattern::Ones);
+
+    SECTION("Generated data verifies")
+    {
+        DataPatternGenerator generator{ dataPattern, Seed };
+        DataPatternGenerator verifier{ dataPattern, Seed };
+
+        std::string data(DataBlockSize, '\0');
+        for (uint64_t sequenceNumber = 1; sequenceNumber <= 10; sequenceNumber++) {
+            const uint64_t offset = (sequenceNumber - 1) * DataBlockSize;
+            generator.Fill(data, sequenceNumber, offset);
+            REQUIRE(verifier.Verify(data, sequenceNumber, offset));
+        }
+    }
+
+    SECTION("Data blocks can be generated in any order")
+    {
+        DataPatternGenerator generator1{ dataPattern, Seed };
+        DataPatternGenerator generator2{ dataPattern, Seed };
+
+        std::string data1(DataBlockSize, '\0');
+        std::string data2(DataBlockSize, '\0');
+        generator1.Fill(data1, 1, 0);
+        generator1.Fill(data1, 5, 4 * DataBlockSize);
+        generator2.Fill(data2, 5, 4 * DataBlockSize);
+        REQUIRE(data1 == data2);
+    }
+
+    SECTION("Corrupted data doesn't verify")
+    {
+        DataPatternGenerator generator{ dataPattern, Seed };
+
+        std::string data(DataBlockSize, '\0');
+        generator.Fill(data, 1, 0);
+        data[DataBlockSize / 2] = static_cast<char>(data[DataBlockSize / 2] ^ 0x01);
+        REQUIRE_FALSE(generator.Verify(data, 1, 0));
+    }
+
+    SECTION("Empty data verifies")
+    {
+        DataPatternGenerator generator{ dataPattern, Seed };
+        REQUIRE(generator.Verify(std::string{}, 1, 0));
+    }
+}
+
+TEST_CASE("DataPatternGenerator detects misplaced data", "[datastream][pattern]")
+{
+    using namespace Microsoft::Net::Remote::DataStream;
+
+    static constexpr std::size_t DataBlockSize{ 64 };
+
+    SECTION("PseudoRandom data depends on the sequence number")
+    {
+        DataPatternGenerator generator{ DataPattern::PseudoRandom, 1 };
+
+        std::string data(DataBlockSize, '\0');
+        generator.Fill(data, 1, 0);
+        REQUIRE_FALSE(generator.Verify(data, 2, 0));
+    }
+
+    SECTION("PseudoRandom data depends on the seed")
+    {
+        DataPatternGenerator generator{ DataPattern::PseudoRandom, 1 };
+        DataPatternGenerator verifier{ DataPattern::PseudoRandom, 2 };
+
+        std::string data(DataBlockSize, '\0');
+        generator.Fill(data, 1, 0);
+        REQUIRE_FALSE(verifier.Verify(data, 1, 0));
+    }
+
+    SECTION("Counter data depends on the offset")
+    {
+        DataPatternGenerator generator{ DataPattern::Counter };
+
+        std::string data(DataBlockSize, '\0');
+        generator.Fill(data, 1, 0);
+        REQUIRE_FALSE(generator.Verify(data, 1, DataBlockSize));
+    }
+}
+
+TEST_CASE("DataPatternGenerator counter pattern", "[datastream][pattern]")
+{
+    using namespace Microsoft::Net::Remote::DataStream;
+
+    SECTION("Counter pattern is a sequence of little-endian 64-bit integers")
+    {
+        DataPatternGenerator generator{ DataPattern::Counter };
+
+        std::vector<uint8_t> data(3 * sizeof(uint64_t));
+        generator.Fill(data, 1, 0);
+        REQUIRE(data == std::vector<uint8_t>{ 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0 });
+    }
+
+    SECTION("Counter pattern is continuous across unaligned blocks")
+    {
+        static constexpr std::size_t DataSize{ 100 };
+        static constexpr std::size_t DataBlockSize{ 13 };
+
+        DataPatternGenerator generator{ DataPattern::Counter };
+
+        std::vector<uint8_t> dataExpected(DataSize);
+        generator.Fill(dataExpected, 1, 0);
+
+        std::vector<uint8_t> data(DataSize);
+        for (std::size_t offset = 0; offset < DataSize; offset += DataBlockSize) {
+            const auto size = std::min(DataBlockSize, DataSize - offset);
+            generator.Fill(std::span<uint8_t>(std::data(data) + offset, size), 1, offset);
+        }
+
+        REQUIRE(data == dataExpected);
+    }
+}
@@ -0,0 +1,102 @@
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include <catch2/catch_test_macros.hpp>
+#include <microsoft/net/remote/datastream/Histogram.hxx>
+
+TEST_CASE("Histogram records values", "[datastream][histogram]")
+{
+    using namespace Microsoft::Net::Remote::DataStream;
+
+    SECTION("Empty histogram reports zero values")
+    {
+        const Histogram histogram{};
+        REQUIRE(histogram.GetCount() == 0);
+        REQUIRE(histogram.GetMinimum() == 0);
+        REQUIRE(histogram.GetMaximum() == 0);
+        REQUIRE(histogram.GetMean() == 0.0);
+        REQUIRE(histogram.GetValueAtPercentile(50) == 0);
+        REQUIRE(histogram.GetBuckets().empty());
+    }
+
+    SECTION("Small values are recorded exactly")
+    {
+        Histogram histogram{};
+        for (uint64_t value = 0; value < Histogram::SubBucketCount; value++) {
+            histogram.Record(value);
+        }
+
+        const auto buckets = histogram.GetBuckets();
+        REQUIRE(std::size(buckets) == Histogram::SubBucketCount);
+        for (uint64_t value = 0; value < Histogram::SubBucketCount; value++) {
+            REQUIRE(buckets[value].LowerBound == value);
+            REQUIRE(buckets[value].UpperBound == value + 1);
+            REQUIRE(buckets[value].Count == 1);
+        }
+    }
+
+    SECTION("Count, minimum, maximum, and mean are exact")
+    {
+        Histogram histogram{};
+        histogram.Record(10);
+        histogram.Record(1000);
+        histogram.Record(100);
+
+        REQUIRE(histogram.GetCount() == 3);
+        REQUIRE(histogram.GetMinimum() == 10);
+        REQUIRE(histogram.GetMaximum() == 1000);
+        REQUIRE(histogram.GetMean() == 370.0);
+    }
+
+    SECTION("Values are recorded in a bucket containing them")
+    {
+        for (const uint64_t value : { uint64_t{ 8 }, uint64_t{ 9 }, uint64_t{ 1000 }, uint64_t{ 123456789 }, std::numeric_limits<uint64_t>::max() - 1 }) {
+            const auto bucket = Histogram::GetBucketBounds(Histogram::GetBucketIndex(value));
+            REQUIRE(bucket.LowerBound <= value);
+            REQUIRE(value < bucket.UpperBound);
+        }
+    }
+
+    SECTION("Bucket widths bound the relative error")
+    {
+        for (std::size_t index = Histogram::SubBucketCount; index < Histogram::NumberOfBuckets - 1; index++) {
+            const auto bucket = Histogram::GetBucketBounds(index);
+            REQUIRE((bucket.UpperBound - bucket.LowerBound) * Histogram::SubBucketCount <= bucket.LowerBound);
+        }
+    }
+
+    SECTION("Percentiles are within the bucket of the value at that rank")
+    {
+        Histogram histogram{};
+        for (uint64_t value = 1; value <= 100; value++) {
+            histogram.Record(value * 1000);
+        }
+
+        const auto p50 = histogram.GetValueAtPercentile(50);
+        REQUIRE(p50 >= 50000);
+        REQUIRE(p50 <= 50000 + (50000 / Histogram::SubBucketCount));
+        REQUIRE(histogram.GetValueAtPercentile(0) == 1000);
+        REQUIRE(histogram.GetValueAtPercentile(100) == 100000);
+    }
+
+    SECTION("Merge combines recorded values")
+    {
+        Histogram histogram1{};
+        histogram1.Record(5);
+        histogram1.Record(500);
+
+        Histogram histogram2{};
+        histogram2.Record(1);
+        histogram2.Record(5000);
+
+        histogram1.Merge(histogram2);
+        REQUIRE(histogram1.GetCount() == 4);
+        REQUIRE(histogram1.GetMinimum() == 1);
+        REQUIRE(histogram1.GetMaximum() == 5000);
+
+        histogram1.Reset();
+        REQUIRE(histogram1.GetCount() == 0);
+    }
+}
@@ -0,0 +1,141 @@
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <linux/io_uring.h>
+#include <microsoft/net/remote/datastream/IoUring.hxx>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace detail
+{
+/**
+ * @brief The maximum time to wait for io_uring completions.
+ */
+constexpr auto IoUringAwaitTimeout{ std::chrono::seconds(5) };
+} // namespace detail
+
+TEST_CASE("IoUring completes submitted operations", "[datastream][iouring]")
+{
+    using namespace Microsoft::Net::Remote::DataStream;
+
+    static constexpr uint32_t NumberOfEntries{ 8 };
+
+    std::error_code error{};
+    auto ioUring = IoUring::Create(NumberOfEntries, error);
+    if (ioUring == nullptr) {
+        // io_uring may be disabled, for example by seccomp policies of container runtimes.
+        WARN("io_uring is unavailable: " << error.message());
+        return;
+    }
+
+    SECTION("A batch of operations is submitted at once")
+    {
+        for (uint64_t i = 0; i < NumberOfEntries; i++) {
+            auto* entry = ioUring->GetSubmissionQueueEntry();
+            REQUIRE(entry != nullptr);
+            entry->opcode = IORING_OP_NOP;
+            entry->user_data = i;
+        }
+
+        // The submission queue is full until submitted.
+        REQUIRE(ioUring->GetSubmissionQueueEntry() == nullptr);
+        REQUIRE_FALSE(ioUring->Submit(NumberOfEntries, detail::IoUringAwaitTimeout));
+
+        std::vector<uint64_t> userData{};
+        const auto numberOfCompletions = ioUring->ForEachCompletion([&](const io_uring_cqe& completion) {
+            REQUIRE(completion.res == 0);
+            userData.push_back(completion.user_data);
+        });
+        REQUIRE(numberOfCompletions == NumberOfEntries);
+        REQUIRE(std::size(userData) == NumberOfEntries);
+        REQUIRE(ioUring->ForEachCompletion([](const io_uring_cqe&) {}) == 0);
+    }
+
+    SECTION("Writes use registered buffers")
+    {
+        std::array<int, 2> sockets{};
+        REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, std::data(sockets)) == 0);
+
+        std::string data{ "registered" };
+        const std::array<iovec, 1> buffers{ iovec{ .iov_base = std::data(data), .iov_len = std::size(data) } };
+        REQUIRE_FALSE(ioUring->RegisterBuffers(buffers));
+
+        auto* entry = ioUring->GetSubmissionQueueEntry();
+        entry->opcode = IORING_OP_WRITE_FIXED;
+        entry->fd = sockets[0];
+        entry->addr = reinterpret_cast<uint64_t>(std::data(data)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        entry->len = static_cast<uint32_t>(std::size(data));
+        entry->buf_index = 0;
+        REQUIRE_FALSE(ioUring->Submit(1, detail::IoUringAwaitTimeout));
+        REQUIRE(ioUring->ForEachCompletion([&](const io_uring_cqe& completion) {
+            REQUIRE(completion.res == static_cast<int32_t>(std::size(data)));
+        }) == 1);
+
+        std::string dataRead(std::size(data), '\0');
+        REQUIRE(read(sockets[1], std::data(dataRead), std::size(dataRead)) == static_cast<ssize_t>(std::size(data)));
+        REQUIRE(dataRead == data);
+
+        close(sockets[0]);
+        close(sockets[1]);
+    }
+
+    SECTION("Multishot receives fill provided buffers")
+    {
+        static constexpr uint16_t NumberOfBuffers{ 4 };
+        static constexpr std::size_t BufferSize{ 64 };
+        static constexpr std::array<std::string_view, 3> Datagrams{ "first", "second", "third" };
+
+        // Buffer rings require Linux 5.19, and multishot receives Linux 6.0.
+        if (const auto errorRegister = ioUring->RegisterBufferRing(NumberOfBuffers, BufferSize); errorRegister) {
+            WARN("io_uring buffer rings are unavailable: " << errorRegister.message());
+            return;
+        }
+
+        std::array<int, 2> sockets{};
+        REQUIRE(socketpair(AF_UNIX, SOCK_DGRAM, 0, std::data(sockets)) == 0);
+
+        auto* entry = ioUring->GetSubmissionQueueEntry();
+        entry->opcode = IORING_OP_RECV;
+        entry->fd = sockets[1];
+        entry->ioprio = IORING_RECV_MULTISHOT;
+        entry->flags = IOSQE_BUFFER_SELECT;
+        entry->buf_group = IoUring::BufferGroupId;
+        REQUIRE_FALSE(ioUring->Submit(0, detail::IoUringAwaitTimeout));
+
+        // More datagrams than buffers are received, which requires buffers to be recycled.
+        std::vector<std::string> datagramsReceived{};
+        for (std::size_t i = 0; i < NumberOfBuffers * 2; i++) {
+            const auto datagram = Datagrams[i % std::size(Datagrams)];
+            REQUIRE(write(sockets[0], std::data(datagram), std::size(datagram)) == static_cast<ssize_t>(std::size(datagram)));
+
+            REQUIRE_FALSE(ioUring->Submit(1, detail::IoUringAwaitTimeout));
+            ioUring->ForEachCompletion([&](const io_uring_cqe& completion) {
+                REQUIRE(completion.res >= 0);
+                REQUIRE((completion.flags & IORING_CQE_F_BUFFER) != 0);
+                REQUIRE((completion.flags & IORING_CQE_F_MORE) != 0);
+
+                const auto bufferId = static_cast<uint16_t>(completion.flags >> IORING_CQE_BUFFER_SHIFT);
+                const auto data = ioUring->GetBuffer(bufferId, static_cast<std::size_t>(completion.res));
+                datagramsReceived.emplace_back(std::data(data), std::size(data));
+                ioUring->RecycleBuffer(bufferId);
+            });
+        }
+
+        REQUIRE(std::size(datagramsReceived) == NumberOfBuffers * 2);
+        for (std::size_t i = 0; i < std::size(datagramsReceived); i++) {
+            REQUIRE(datagramsReceived[i] == Datagrams[i % std::size(Datagrams)]);
+        }
+
+        close(sockets[0]);
+        close(sockets[1]);
+    }
+}
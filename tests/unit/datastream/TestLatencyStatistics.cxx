@@ -0,0 +1,54 @@
+
+#include <chrono>
+
+#include <catch2/catch_test_macros.hpp>
+#include <microsoft/net/remote/datastream/LatencyStatistics.hxx>
+
+TEST_CASE("LatencyStatistics computes round-trip time and clock offset", "[datastream][statistics]")
+{
+    using namespace Microsoft::Net::Remote::DataStream;
+    using namespace std::chrono_literals;
+
+    const auto timeStart = std::chrono::system_clock::now();
+
+    SECTION("No probes recorded")
+    {
+        const LatencyStatistics statistics{};
+        REQUIRE(statistics.GetCount() == 0);
+        REQUIRE_FALSE(statistics.GetClockOffset().has_value());
+    }
+
+    SECTION("Time spent in the server is excluded from the round-trip time")
+    {
+        // 1ms each way, 5ms in the server, with synchronized clocks.
+        LatencyStatistics statistics{};
+        statistics.Record(timeStart, timeStart + 1ms, timeStart + 6ms, timeStart + 7ms);
+
+        REQUIRE(statistics.GetCount() == 1);
+        REQUIRE(statistics.GetRoundTripTimeHistogram().GetMinimum() == 2000);
+        REQUIRE(statistics.GetClockOffset() == 0us);
+    }
+
+    SECTION("Clock offset of a server ahead of the client is positive")
+    {
+        // Server clock 100ms ahead, 1ms each way.
+        LatencyStatistics statistics{};
+        statistics.Record(timeStart, timeStart + 101ms, timeStart + 101ms, timeStart + 2ms);
+
+        REQUIRE(statistics.GetRoundTripTimeHistogram().GetMinimum() == 2000);
+        REQUIRE(statistics.GetClockOffset() == 100ms);
+    }
+
+    SECTION("Clock offset is taken from the probe with the smallest round-trip time")
+    {
+        // Server clock 50ms behind. The first probe is delayed by 10ms on the way to the server, skewing its estimate.
+        LatencyStatistics statistics{};
+        statistics.Record(timeStart, timeStart - 40ms, timeStart - 40ms, timeStart + 10ms);
+        statistics.Record(timeStart + 1s, timeStart + 1s - 49ms, timeStart + 1s - 49ms, timeStart + 1s + 2ms);
+
+        REQUIRE(statistics.GetCount() == 2);
+        REQUIRE(statistics.GetRoundTripTimeHistogram().GetMinimum() == 2000);
+        REQUIRE(statistics.GetRoundTripTimeHistogram().GetMaximum() == 10000);
+        REQUIRE(statistics.GetClockOffset() == -50ms);
+    }
+}
@@ -0,0 +1,137 @@
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <microsoft/net/remote/datastream/RandomDataGenerator.hxx>
+#include <plog/Log.h>
+
+TEST_CASE("RandomDataGenerator generates data", "[datastream][generator]")
+{
+    using namespace Microsoft::Net::Remote::DataStream;
+
+    static constexpr uint64_t Seed{ 0x6E657472656D6F74ULL };
+
+    SECTION("Generate doesn't cause a crash")
+    {
+        RandomDataGenerator generator{};
+        REQUIRE_NOTHROW(generator.Generate(1024));
+    }
+
+    SECTION("Generate returns data of the requested length")
+    {
+        RandomDataGenerator generator{};
+        for (const std::size_t length : { 0, 1, 7, 8, 31, 32, 33, 1000, 65536 }) {
+            REQUIRE(std::size(generator.Generate(length)) == length);
+        }
+    }
+
+    SECTION("Generators with the same seed generate the same data")
+    {
+        RandomDataGenerator generator1{ Seed };
+        RandomDataGenerator generator2{ Seed };
+        REQUIRE(generator1.Generate(4096) == generator2.Generate(4096));
+    }
+
+    SECTION("Generators with different seeds generate different data")
+    {
+        RandomDataGenerator generator1{ Seed };
+        RandomDataGenerator generator2{ Seed + 1 };
+        REQUIRE(generator1.Generate(4096) != generator2.Generate(4096));
+    }
+
+    SECTION("Re-seeding restarts the sequence")
+    {
+        RandomDataGenerator generator{ Seed };
+        const auto data1 = generator.Generate(1000);
+        generator.Seed(Seed);
+        const auto data2 = generator.Generate(1000);
+        REQUIRE(data1 == data2);
+    }
+
+    SECTION("Partial blocks are filled")
+    {
+        // Each fill of less than one block consumes a full step of the generator, so consecutive partial fills must
+        // differ and must not leave the tail of the buffer untouched.
+        RandomDataGenerator generator{ Seed };
+        std::vector<uint8_t> data1(RandomDataGenerator::BlockSize - 1, 0);
+        std::vector<uint8_t> data2(RandomDataGenerator::BlockSize - 1, 0);
+        generator.Fill(data1);
+        generator.Fill(data2);
+        REQUIRE(data1 != data2);
+        REQUIRE(std::ranges::count(data1, 0) < static_cast<std::ptrdiff_t>(std::size(data1) / 4));
+        REQUIRE(std::ranges::count(data2, 0) < static_cast<std::ptrdiff_t>(std::size(data2) / 4));
+    }
+
+    SECTION("Generated data uses all byte values")
+    {
+        RandomDataGenerator generator{ Seed };
+        const auto data = generator.Generate(64 * 1024);
+
+        std::vector<std::size_t> histogram(std::numeric_limits<uint8_t>::max() + 1, 0);
+        for (const auto value : data) {
+            histogram[static_cast<uint8_t>(value)]++;
+        }
+
+        // With 64 KiB of data, each byte value is expected 256 times; a value not occurring at all indicates a defect.
+        REQUIRE(std::ranges::none_of(histogram, [](auto count) {
+            return count == 0;
+        }));
+    }
+}
+
+TEST_CASE("RandomDataGenerator performance", "[datastream][generator][benchmark][.]")
+{
+    using namespace Microsoft::Net::Remote::DataStream;
+
+    SECTION("Throughput")
+    {
+        static constexpr std::size_t BufferSize{ 1024 * 1024 };
+        static constexpr std::size_t NumberOfIterations{ 1024 };
+
+        RandomDataGenerator generator{};
+        std::vector<uint8_t> buffer(BufferSize);
+
+        const auto timeStart = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < NumberOfIterations; i++) {
+            generator.Fill(buffer);
+        }
+        const auto timeEnd = std::chrono::steady_clock::now();
+
+        const std::chrono::duration<double> duration = timeEnd - timeStart;
+        const double gigabytesPerSecond = (static_cast<double>(BufferSize * NumberOfIterations) / duration.count()) / 1e9;
+        LOGI << std::format("RandomDataGenerator throughput: {:.2f} GB/s (single core)", gigabytesPerSecond);
+        REQUIRE(gigabytesPerSecond > 0);
+    }
+
+    for (const std::size_t size : { std::size_t{ 64 }, std::size_t{ 1024 }, std::size_t{ 64 * 1024 }, std::size_t{ 1024 * 1024 } }) {
+        RandomDataGenerator generator{};
+        std::vector<uint8_t> buffer(size);
+
+        BENCHMARK(std::format("RandomDataGenerator::Fill {} bytes", size))
+        {
+            generator.Fill(buffer);
+            return buffer[0];
+        };
+    }
+
+    BENCHMARK("Per-byte std::mt19937 64 KiB (reference)")
+    {
+        static std::mt19937 generator{ std::random_device{}() };
+        std::string data;
+        data.reserve(64 * 1024);
+        for (std::size_t i = 0; i < 64 * 1024; i++) {
+            std::uniform_int_distribution<uint32_t> distribution(0, std::numeric_limits<uint8_t>::max());
+            data.push_back(static_cast<char>(distribution(generator)));
+        }
+        return data;
+    };
+}
@@ -0,0 +1,404 @@
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <microsoft/net/remote/datastream/RawStream.hxx>
+#include <microsoft/net/remote/datastream/RawStreamManager.hxx>
+#include <plog/Log.h>
+
+namespace detail
+{
+/**
+ * @brief The maximum time to wait for a raw stream to complete.
+ */
+constexpr auto RawStreamAwaitTimeout{ std::chrono::seconds(10) };
+
+/**
+ * @brief Create and start a raw stream on loopback.
+ *
+ * @param protocol The protocol of the stream.
+ * @param role The role of the stream.
+ * @param duration The duration of the stream.
+ * @param port For a sender, the port of the receiver to send to.
+ * @param targetBitrate For a sender, the rate at which to send data, or 0 to send as fast as possible.
+ * @param ioEngine The mechanism used to perform socket I/O.
+ * @return std::unique_ptr<Microsoft::Net::Remote::DataStream::RawStream>
+ */
+std::unique_ptr<Microsoft::Net::Remote::DataStream::RawStream>
+StartLoopback(Microsoft::Net::Remote::DataStream::RawStreamProtocol protocol, Microsoft::Net::Remote::DataStream::RawStreamRole role, std::chrono::milliseconds duration, uint16_t port = 0, uint64_t targetBitrate = 0, Microsoft::Net::Remote::DataStream::RawStreamIoEngine ioEngine = Microsoft::Net::Remote::DataStream::RawStreamIoEngine::Epoll)
+{
+    using namespace Microsoft::Net::Remote::DataStream;
+
+    auto rawStream = std::make_unique<RawStream>("test", RawStreamConfiguration{
+                                                             .Protocol = protocol,
+                                                             .Role = role,
+                                                             .Address = "127.0.0.1",
+                                                             .Port = port,
+                                                             .Duration = duration,
+                                                             .TargetBitrate = targetBitrate,
+                                                             .IoEngine = ioEngine,
+                                                         });
+    REQUIRE(rawStream->Start());
+
+    return rawStream;
+}
+} // namespace detail
+
+TEST_CASE("RawStream transfers data over sockets", "[datastream][raw]")
+{
+    using namespace Microsoft::Net::Remote::DataStream;
+
+    static constexpr auto SendDuration{ std::chrono::milliseconds(200) };
+    static constexpr auto ReceiveDuration{ std::chrono::seconds(5) };
+
+    SECTION("TCP data sent on loopback is received in full")
+    {
+        auto receiver = detail::StartLoopback(RawStreamProtocol::Tcp, RawStreamRole::Receiver, ReceiveDuration);
+        REQUIRE(receiver->GetPort() != 0);
+
+        auto sender = detail::StartLoopback(RawStreamProtocol::Tcp, RawStreamRole::Sender, SendDuration, receiver->GetPort());
+        REQUIRE(sender->Await(detail::RawStreamAwaitTimeout));
+        REQUIRE(receiver->Await(detail::RawStreamAwaitTimeout));
+
+        const auto senderResult = sender->GetResult();
+        const auto receiverResult = receiver->GetResult();
+        REQUIRE(senderResult.ErrorMessage.empty());
+        REQUIRE(receiverResult.ErrorMessage.empty());
+        REQUIRE(senderResult.NumberOfBytes > 0);
+        REQUIRE(receiverResult.NumberOfBytes == senderResult.NumberOfBytes);
+        REQUIRE(receiverResult.GoodputBitsPerSecond > 0);
+    }
+
+    SECTION("TCP data is received in full with every send mode")
+    {
+        for (const auto sendMode : { RawStreamSendMode::Copy, RawStreamSendMode::ZeroCopy, RawStreamSendMode::Sendfile }) {
+            auto receiver = detail::StartLoopback(RawStreamProtocol::Tcp, RawStreamRole::Receiver, ReceiveDuration);
+            RawStream sender{ "test", RawStreamConfiguration{
+                                          .Protocol = RawStreamProtocol::Tcp,
+                                          .Role = RawStreamRole::Sender,
+                                          .Address = "127.0.0.1",
+                                          .Port = receiver->GetPort(),
+                                          .Duration = SendDuration,
+                                          .SendMode = sendMode,
+                                      } };
+            REQUIRE(sender.Start());
+            REQUIRE(sender.Await(detail::RawStreamAwaitTimeout));
+            REQUIRE(receiver->Await(detail::RawStreamAwaitTimeout));
+
+            const auto senderResult = sender.GetResult();
+            const auto receiverResult = receiver->GetResult();
+            REQUIRE(senderResult.ErrorMessage.empty());
+            REQUIRE(senderResult.NumberOfBytes > 0);
+            REQUIRE(receiverResult.NumberOfBytes == senderResult.NumberOfBytes);
+            REQUIRE(senderResult.CpuTime.count() > 0);
+            REQUIRE(senderResult.CpuCyclesPerByte >= 0);
+
+            if (sendMode == RawStreamSendMode::ZeroCopy) {
+                // Loopback can't transmit from user pages, so the kernel reports every send as copied.
+                REQUIRE(senderResult.NumberOfZeroCopySendsCompleted > 0);
+                REQUIRE(senderResult.NumberOfZeroCopySendsCopied <= senderResult.NumberOfZeroCopySendsCompleted);
+            } else {
+                REQUIRE(senderResult.NumberOfZeroCopySendsCompleted == 0);
+            }
+        }
+    }
+
+    SECTION("UDP data sent on loopback is received with sequence statistics")
+    {
+        static constexpr uint64_t TargetBitrate{ 10'000'000 };
+
+        auto receiver = detail::StartLoopback(RawStreamProtocol::Udp, RawStreamRole::Receiver, ReceiveDuration);
+        auto sender = detail::StartLoopback(RawStreamProtocol::Udp, RawStreamRole::Sender, SendDuration, receiver->GetPort(), TargetBitrate);
+        REQUIRE(sender->Await(detail::RawStreamAwaitTimeout));
+
+        // The receiver completes upon receiving the datagrams that end the stream, well before its duration elapses.
+        REQUIRE(receiver->Await(detail::RawStreamAwaitTimeout));
+
+        const auto senderResult = sender->GetResult();
+        const auto receiverResult = receiver->GetResult();
+        REQUIRE(senderResult.ErrorMessage.empty());
+        REQUIRE(receiverResult.ErrorMessage.empty());
+        REQUIRE(senderResult.NumberOfDataBlocks > 0);
+        REQUIRE(receiverResult.NumberOfDataBlocks + receiverResult.NumberOfDataBlocksLost <= senderResult.NumberOfDataBlocks);
+        REQUIRE(receiverResult.NumberOfDataBlocksDuplicated == 0);
+        REQUIRE(receiverResult.NumberOfBytes == receiverResult.NumberOfDataBlocks * RawStreamConfiguration::DataBlockSizeDefaultUdp);
+        REQUIRE(receiverResult.JitterMicroseconds >= 0);
+    }
+
+    SECTION("Data is received in full with the io_uring engine")
+    {
+        for (const auto protocol : { RawStreamProtocol::Tcp, RawStreamProtocol::Udp }) {
+            auto receiver = detail::StartLoopback(protocol, RawStreamRole::Receiver, ReceiveDuration, 0, 0, RawStreamIoEngine::IoUring);
+            auto sender = detail::StartLoopback(protocol, RawStreamRole::Sender, SendDuration, receiver->GetPort(), 0, RawStreamIoEngine::IoUring);
+            REQUIRE(sender->Await(detail::RawStreamAwaitTimeout));
+            REQUIRE(receiver->Await(detail::RawStreamAwaitTimeout));
+
+            // Streams fall back to epoll where io_uring is unavailable, which both report.
+            const auto senderResult = sender->GetResult();
+            const auto receiverResult = receiver->GetResult();
+            REQUIRE(senderResult.ErrorMessage.empty());
+            REQUIRE(receiverResult.ErrorMessage.empty());
+            REQUIRE(senderResult.NumberOfBytes > 0);
+            REQUIRE(receiverResult.NumberOfBytes > 0);
+            REQUIRE(receiverResult.NumberOfDataBlocksDuplicated == 0);
+            if (protocol == RawStreamProtocol::Tcp) {
+                REQUIRE(receiverResult.NumberOfBytes == senderResult.NumberOfBytes);
+            } else {
+                REQUIRE(receiverResult.NumberOfDataBlocks + receiverResult.NumberOfDataBlocksLost <= senderResult.NumberOfDataBlocks);
+            }
+        }
+    }
+
+    SECTION("Senders are paced to the target bitrate")
+    {
+        static constexpr uint64_t TargetBitrate{ 8'000'000 };
+
+        auto receiver = detail::StartLoopback(RawStreamProtocol::Udp, RawStreamRole::Receiver, ReceiveDuration);
+        for (const auto ioEngine : { RawStreamIoEngine::Epoll, RawStreamIoEngine::IoUring }) {
+            auto sender = detail::StartLoopback(RawStreamProtocol::Udp, RawStreamRole::Sender, std::chrono::milliseconds(500), receiver->GetPort(), TargetBitrate, ioEngine);
+            REQUIRE(sender->Await(detail::RawStreamAwaitTimeout));
+
+            const auto senderResult = sender->GetResult();
+            REQUIRE(senderResult.GoodputBitsPerSecond > TargetBitrate * 3 / 4);
+            REQUIRE(senderResult.GoodputBitsPerSecond < TargetBitrate * 5 / 4);
+        }
+    }
+
+    SECTION("Receivers complete once their duration elapses without a sender")
+    {
+        auto receiver = detail::StartLoopback(RawStreamProtocol::Udp, RawStreamRole::Receiver, SendDuration);
+        REQUIRE(receiver->Await(detail::RawStreamAwaitTimeout));
+
+        const auto receiverResult = receiver->GetResult();
+        REQUIRE(receiverResult.ErrorMessage.empty());
+        REQUIRE(receiverResult.NumberOfBytes == 0);
+    }
+
+    SECTION("Stopping a stream completes it early")
+    {
+        auto receiver = detail::StartLoopback(RawStreamProtocol::Tcp, RawStreamRole::Receiver, std::chrono::minutes(1));
+        REQUIRE_FALSE(receiver->Await(std::chrono::milliseconds(10)));
+
+        receiver->Stop();
+        REQUIRE(receiver->Await(detail::RawStreamAwaitTimeout));
+    }
+
+    SECTION("Data is received in full by streams bound to an interface")
+    {
+        for (const auto protocol : { RawStreamProtocol::Tcp, RawStreamProtocol::Udp }) {
+            RawStream receiver{ "test", RawStreamConfiguration{
+                                            .Protocol = protocol,
+                                            .Role = RawStreamRole::Receiver,
+                                            .InterfaceName = "lo",
+                                            .Duration = ReceiveDuration,
+                                        } };
+            REQUIRE(receiver.Start());
+
+            RawStream sender{ "test", RawStreamConfiguration{
+                                          .Protocol = protocol,
+                                          .Role = RawStreamRole::Sender,
+                                          .Address = "127.0.0.1",
+                                          .Port = receiver.GetPort(),
+                                          .InterfaceName = "lo",
+                                          .Duration = SendDuration,
+                                      } };
+            REQUIRE(sender.Start());
+            REQUIRE(sender.Await(detail::RawStreamAwaitTimeout));
+            REQUIRE(receiver.Await(detail::RawStreamAwaitTimeout));
+
+            const auto senderResult = sender.GetResult();
+            const auto receiverResult = receiver.GetResult();
+            REQUIRE(senderResult.ErrorMessage.empty());
+            REQUIRE(receiverResult.ErrorMessage.empty());
+            REQUIRE(receiverResult.NumberOfBytes > 0);
+            REQUIRE(receiverResult.NumberOfBytes <= senderResult.NumberOfBytes);
+        }
+    }
+
+    SECTION("Streams of each traffic class run concurrently and are aggregated by class")
+    {
+        static constexpr uint64_t TargetBitrate{ 10'000'000 };
+        static constexpr std::array<RawStreamTrafficClass, 4> TrafficClasses{ RawStreamTrafficClass::Voice, RawStreamTrafficClass::Video, RawStreamTrafficClass::BestEffort, RawStreamTrafficClass::Background };
+
+        std::vector<std::shared_ptr<RawStream>> rawStreams{};
+        for (const auto trafficClass : TrafficClasses) {
+            auto receiver = std::make_shared<RawStream>("test", RawStreamConfiguration{
+                                                                    .Protocol = RawStreamProtocol::Udp,
+                                                                    .Role = RawStreamRole::Receiver,
+                                                                    .Address = "127.0.0.1",
+                                                                    .Duration = ReceiveDuration,
+                                                                    .TrafficClass = trafficClass,
+                                                                });
+            REQUIRE(receiver->Start());
+
+            auto sender = std::make_shared<RawStream>("test", RawStreamConfiguration{
+                                                                  .Protocol = RawStreamProtocol::Udp,
+                                                                  .Role = RawStreamRole::Sender,
+                                                                  .Address = "127.0.0.1",
+                                                                  .Port = receiver->GetPort(),
+                                                                  .Duration = SendDuration,
+                                                                  .TargetBitrate = TargetBitrate,
+                                                                  .TrafficClass = trafficClass,
+                                                              });
+            REQUIRE(sender->Start());
+
+            rawStreams.push_back(std::move(receiver));
+            rawStreams.push_back(std::move(sender));
+        }
+
+        for (const auto& rawStream : rawStreams) {
+            REQUIRE(rawStream->Await(detail::RawStreamAwaitTimeout));
+            REQUIRE(rawStream->GetResult().ErrorMessage.empty());
+        }
+
+        // Each traffic class has a sender and a receiver, ordered by traffic class, then role.
+        const auto results = RawStream::GetTrafficClassResults(rawStreams);
+        REQUIRE(std::size(results) == std::size(TrafficClasses) * 2);
+        for (std::size_t i = 0; i < std::size(results); i++) {
+            const auto& result = results[i];
+            REQUIRE(result.TrafficClass == static_cast<RawStreamTrafficClass>(i / 2));
+            REQUIRE(result.Role == ((i % 2 == 0) ? RawStreamRole::Sender : RawStreamRole::Receiver));
+            REQUIRE(result.NumberOfStreams == 1);
+            REQUIRE(result.NumberOfBytes > 0);
+            REQUIRE(result.GoodputBitsPerSecond > 0);
+            if (result.Role == RawStreamRole::Receiver) {
+                // Both endpoints share a clock on loopback, so the delay is not skewed by any clock offset.
+                REQUIRE(result.OneWayDelayMicroseconds >= 0);
+                REQUIRE(result.JitterMicroseconds >= 0);
+            }
+        }
+    }
+
+    SECTION("TCP senders report a failure to connect")
+    {
+        uint16_t port{ 0 };
+        {
+            auto receiver = detail::StartLoopback(RawStreamProtocol::Tcp, RawStreamRole::Receiver, std::chrono::minutes(1));
+            port = receiver->GetPort();
+        }
+
+        auto sender = detail::StartLoopback(RawStreamProtocol::Tcp, RawStreamRole::Sender, SendDuration, port);
+        REQUIRE(sender->Await(detail::RawStreamAwaitTimeout));
+        REQUIRE_FALSE(sender->GetResult().ErrorMessage.empty());
+    }
+
+    SECTION("Invalid configurations fail to start")
+    {
+        RawStream senderWithoutAddress{ "test", RawStreamConfiguration{ .Role = RawStreamRole::Sender } };
+        REQUIRE_FALSE(senderWithoutAddress.Start());
+        REQUIRE(senderWithoutAddress.GetResult().IsCompleted);
+        REQUIRE_FALSE(senderWithoutAddress.GetResult().ErrorMessage.empty());
+
+        RawStream datagramTooSmall{ "test", RawStreamConfiguration{ .Protocol = RawStreamProtocol::Udp, .DataBlockSize = RawStream::UdpHeaderSize - 1 } };
+        REQUIRE_FALSE(datagramTooSmall.Start());
+        REQUIRE_FALSE(datagramTooSmall.GetResult().ErrorMessage.empty());
+
+        RawStream datagramZeroCopy{ "test", RawStreamConfiguration{ .Protocol = RawStreamProtocol::Udp, .SendMode = RawStreamSendMode::ZeroCopy } };
+        REQUIRE_FALSE(datagramZeroCopy.Start());
+        REQUIRE_FALSE(datagramZeroCopy.GetResult().ErrorMessage.empty());
+
+        RawStream unknownInterface{ "test", RawStreamConfiguration{ .InterfaceName = "netremote-none" } };
+        REQUIRE_FALSE(unknownInterface.Start());
+        REQUIRE_FALSE(unknownInterface.GetResult().ErrorMessage.empty());
+    }
+}
+
+TEST_CASE("RawStreamManager tracks raw streams", "[datastream][raw]")
+{
+    using namespace Microsoft::Net::Remote::DataStream;
+
+    RawStreamManager rawStreamManager{};
+
+    SECTION("Raw streams can be found until removed")
+    {
+        const auto rawStream = rawStreamManager.Create(RawStreamConfiguration{});
+        REQUIRE(rawStream != nullptr);
+        REQUIRE(rawStreamManager.Find(rawStream->GetId()) == rawStream);
+        REQUIRE(rawStreamManager.Remove(rawStream->GetId()));
+        REQUIRE(rawStreamManager.Find(rawStream->GetId()) == nullptr);
+        REQUIRE_FALSE(rawStreamManager.Remove(rawStream->GetId()));
+    }
+
+    SECTION("The number of raw streams is limited")
+    {
+        std::vector<std::shared_ptr<RawStream>> rawStreams{};
+        for (std::size_t i = 0; i < RawStreamManager::NumberOfRawStreamsMaximum; i++) {
+            rawStreams.push_back(rawStreamManager.Create(RawStreamConfiguration{}));
+            REQUIRE(rawStreams.back() != nullptr);
+        }
+
+        REQUIRE(rawStreamManager.Create(RawStreamConfiguration{}) == nullptr);
+
+        REQUIRE(rawStreamManager.Remove(rawStreams.front()->GetId()));
+        REQUIRE(rawStreamManager.Create(RawStreamConfiguration{}) != nullptr);
+    }
+
+    SECTION("Raw streams are removed once they expire after completing")
+    {
+        const auto rawStreamNotStarted = rawStreamManager.Create(RawStreamConfiguration{});
+        REQUIRE(rawStreamNotStarted != nullptr);
+
+        // A sender without an address completes as soon as it is started.
+        const auto rawStreamCompleted = rawStreamManager.Create(RawStreamConfiguration{ .Role = RawStreamRole::Sender });
+        REQUIRE(rawStreamCompleted != nullptr);
+        REQUIRE_FALSE(rawStreamCompleted->Start());
+        REQUIRE(rawStreamCompleted->GetTimeCompleted().has_value());
+
+        REQUIRE(rawStreamManager.RemoveExpired(RawStreamManager::Clock::now()) == 0);
+        REQUIRE(rawStreamManager.RemoveExpired(RawStreamManager::Clock::now() + RawStreamManager::ExpiryTimeoutDefault) == 1);
+        REQUIRE(rawStreamManager.Find(rawStreamCompleted->GetId()) == nullptr);
+        REQUIRE(rawStreamManager.Find(rawStreamNotStarted->GetId()) == rawStreamNotStarted);
+    }
+
+    SECTION("Expired raw streams do not prevent new raw streams from being created")
+    {
+        RawStreamManager rawStreamManagerNoExpiryTimeout{ std::chrono::seconds(0) };
+        for (std::size_t i = 0; i < RawStreamManager::NumberOfRawStreamsMaximum; i++) {
+            const auto rawStream = rawStreamManagerNoExpiryTimeout.Create(RawStreamConfiguration{ .Role = RawStreamRole::Sender });
+            REQUIRE(rawStream != nullptr);
+            REQUIRE_FALSE(rawStream->Start());
+        }
+
+        REQUIRE(rawStreamManagerNoExpiryTimeout.Create(RawStreamConfiguration{}) != nullptr);
+    }
+}
+
+TEST_CASE("RawStream performance", "[datastream][raw][benchmark][.]")
+{
+    using namespace Microsoft::Net::Remote::DataStream;
+
+    static constexpr auto SendDuration{ std::chrono::seconds(2) };
+    static constexpr auto ReceiveDuration{ std::chrono::seconds(10) };
+
+    // Small datagrams make the per-packet cost of each I/O engine dominate.
+    for (const auto ioEngine : { RawStreamIoEngine::Epoll, RawStreamIoEngine::IoUring }) {
+        const auto ioEngineName = (ioEngine == RawStreamIoEngine::IoUring) ? "io_uring" : "epoll";
+
+        RawStream receiver{ "receiver", RawStreamConfiguration{ .Protocol = RawStreamProtocol::Udp, .Address = "127.0.0.1", .Duration = ReceiveDuration, .IoEngine = ioEngine } };
+        REQUIRE(receiver.Start());
+
+        RawStream sender{ "sender", RawStreamConfiguration{ .Protocol = RawStreamProtocol::Udp, .Role = RawStreamRole::Sender, .Address = "127.0.0.1", .Port = receiver.GetPort(), .Duration = SendDuration, .DataBlockSize = 64, .IoEngine = ioEngine } };
+        REQUIRE(sender.Start());
+        REQUIRE(sender.Await(detail::RawStreamAwaitTimeout));
+        REQUIRE(receiver.Await(detail::RawStreamAwaitTimeout));
+
+        for (const auto& [role, result] : { std::pair{ "sender", sender.GetResult() }, std::pair{ "receiver", receiver.GetResult() } }) {
+            REQUIRE(result.ErrorMessage.empty());
+            REQUIRE(result.NumberOfDataBlocks > 0);
+
+            const std::chrono::duration<double> duration = result.Duration;
+            const double packetsPerSecond = static_cast<double>(result.NumberOfDataBlocks) / duration.count();
+            const double cpuNanosecondsPerPacket = static_cast<double>(result.CpuTime.count()) / static_cast<double>(result.NumberOfDataBlocks);
+            const double cpuUtilization = std::chrono::duration<double>(result.CpuTime).count() / duration.count();
+            LOGI << std::format("UDP {} ({} requested, {} used): {:.0f} packets/s, {:.0f} ns CPU/packet, {:.0f}% CPU, {:.2f} cycles/byte", role, ioEngineName, (result.IoEngine == RawStreamIoEngine::IoUring) ? "io_uring" : "epoll", packetsPerSecond, cpuNanosecondsPerPacket, cpuUtilization * 100, result.CpuCyclesPerByte);
+        }
+    }
+}
@@ -0,0 +1,75 @@
+
+#include <chrono>
+
+#include <catch2/catch_test_macros.hpp>
+#include <microsoft/net/remote/datastream/ReceiveStatistics.hxx>
+
+TEST_CASE("ReceiveStatistics computes throughput and timing statistics", "[datastream][statistics]")
+{
+    using namespace Microsoft::Net::Remote::DataStream;
+    using namespace std::chrono_literals;
+
+    SECTION("No data received")
+    {
+        const ReceiveStatistics statistics{};
+        REQUIRE(statistics.GetNumberOfDataBlocks() == 0);
+        REQUIRE(statistics.GetNumberOfBytes() == 0);
+        REQUIRE_FALSE(statistics.GetTimeFirstReceived().has_value());
+        REQUIRE_FALSE(statistics.GetTimeLastReceived().has_value());
+        REQUIRE(statistics.GetGoodputBitsPerSecond() == 0);
+    }
+
+    SECTION("Single data block received")
+    {
+        ReceiveStatistics statistics{};
+        statistics.Record(1000);
+
+        REQUIRE(statistics.GetNumberOfDataBlocks() == 1);
+        REQUIRE(statistics.GetNumberOfBytes() == 1000);
+        REQUIRE(statistics.GetTimeFirstReceived() == statistics.GetTimeLastReceived());
+        REQUIRE(statistics.GetGoodputBitsPerSecond() == 0);
+        REQUIRE(statistics.GetInterArrivalTimeHistogram().GetCount() == 0);
+    }
+
+    SECTION("Data blocks received at a steady rate")
+    {
+        const auto timeStart = ReceiveStatistics::Clock::now();
+
+        // 11 blocks of 1250 bytes, 1ms apart: 10 blocks (100000 bits) received over 10ms after the first one.
+        ReceiveStatistics statistics{};
+        for (int i = 0; i <= 10; i++) {
+            statistics.Record(1250, timeStart + (i * 1ms));
+        }
+
+        REQUIRE(statistics.GetNumberOfDataBlocks() == 11);
+        REQUIRE(statistics.GetNumberOfBytes() == 11 * 1250);
+        REQUIRE(statistics.GetDuration() == 10ms);
+        REQUIRE(statistics.GetGoodputBitsPerSecond() == 10'000'000);
+        REQUIRE(*statistics.GetTimeLastReceived() - *statistics.GetTimeFirstReceived() == 10ms);
+
+        const auto& interArrivalTimeHistogram = statistics.GetInterArrivalTimeHistogram();
+        REQUIRE(interArrivalTimeHistogram.GetCount() == 10);
+        REQUIRE(interArrivalTimeHistogram.GetMinimum() == 1000);
+        REQUIRE(interArrivalTimeHistogram.GetMaximum() == 1000);
+
+        const auto& interArrivalJitterHistogram = statistics.GetInterArrivalJitterHistogram();
+        REQUIRE(interArrivalJitterHistogram.GetCount() == 9);
+        REQUIRE(interArrivalJitterHistogram.GetMaximum() == 0);
+    }
+
+    SECTION("Jitter is the difference between consecutive inter-arrival times")
+    {
+        const auto timeStart = ReceiveStatistics::Clock::now();
+
+        ReceiveStatistics statistics{};
+        statistics.Record(1, timeStart);
+        statistics.Record(1, timeStart + 1ms);
+        statistics.Record(1, timeStart + 4ms);
+        statistics.Record(1, timeStart + 5ms);
+
+        const auto& interArrivalJitterHistogram = statistics.GetInterArrivalJitterHistogram();
+        REQUIRE(interArrivalJitterHistogram.GetCount() == 2);
+        REQUIRE(interArrivalJitterHistogram.GetMinimum() == 2000);
+        REQUIRE(interArrivalJitterHistogram.GetMaximum() == 2000);
+    }
+}
@@ -0,0 +1,117 @@
+
+#include <cstdint>
+#include <initializer_list>
+
+#include <catch2/catch_test_macros.hpp>
+#include <microsoft/net/remote/datastream/SequenceTracker.hxx>
+
+namespace detail
+{
+/**
+ * @brief Create a sequence tracker that recorded the specified sequence numbers, in order.
+ *
+ * @param sequenceNumbers The sequence numbers to record.
+ * @return Microsoft::Net::Remote::DataStream::SequenceTracker
+ */
+Microsoft::Net::Remote::DataStream::SequenceTracker
+Track(std::initializer_list<uint64_t> sequenceNumbers)
+{
+    Microsoft::Net::Remote::DataStream::SequenceTracker sequenceTracker{};
+    for (const auto sequenceNumber : sequenceNumbers) {
+        sequenceTracker.Record(sequenceNumber);
+    }
+
+    return sequenceTracker;
+}
+} // namespace detail
+
+TEST_CASE("SequenceTracker detects lost, duplicated and reordered data blocks", "[datastream][statistics]")
+{
+    using namespace Microsoft::Net::Remote::DataStream;
+
+    SECTION("No data blocks received")
+    {
+        const SequenceTracker sequenceTracker{};
+        REQUIRE(sequenceTracker.GetNumberOfDataBlocksUnique() == 0);
+        REQUIRE(sequenceTracker.GetNumberOfDataBlocksLost() == 0);
+        REQUIRE(sequenceTracker.GetSequenceNumberHighest() == 0);
+    }
+
+    SECTION("Data blocks received in order")
+    {
+        const auto sequenceTracker = detail::Track({ 1, 2, 3, 4, 5 });
+        REQUIRE(sequenceTracker.GetNumberOfDataBlocksUnique() == 5);
+        REQUIRE(sequenceTracker.GetNumberOfDataBlocksLost() == 0);
+        REQUIRE(sequenceTracker.GetNumberOfDataBlocksDuplicated() == 0);
+        REQUIRE(sequenceTracker.GetNumberOfDataBlocksOutOfOrder() == 0);
+        REQUIRE(sequenceTracker.GetNumberOfGaps() == 0);
+        REQUIRE(sequenceTracker.GetSequenceNumberHighest() == 5);
+    }
+
+    SECTION("Lost data blocks are counted per data block and per gap")
+    {
+        const auto sequenceTracker = detail::Track({ 2, 3, 6, 7, 10 });
+        REQUIRE(sequenceTracker.GetNumberOfDataBlocksLost() == 5);
+        REQUIRE(sequenceTracker.GetNumberOfGaps() == 3);
+        REQUIRE(sequenceTracker.GetNumberOfDataBlocksOutOfOrder() == 0);
+    }
+
+    SECTION("Late data blocks fill gaps and are counted as out of order")
+    {
+        const auto sequenceTracker = detail::Track({ 1, 3, 4, 2, 5, 8, 6 });
+        REQUIRE(sequenceTracker.GetNumberOfDataBlocksUnique() == 7);
+        REQUIRE(sequenceTracker.GetNumberOfDataBlocksLost() == 1);
+        REQUIRE(sequenceTracker.GetNumberOfDataBlocksOutOfOrder() == 2);
+        REQUIRE(sequenceTracker.GetNumberOfGaps() == 2);
+        REQUIRE(sequenceTracker.GetReorderDistanceMaximum() == 2);
+    }
+
+    SECTION("Duplicated data blocks are detected")
+    {
+        const auto sequenceTracker = detail::Track({ 1, 1, 2, 3, 2, 3, 3 });
+        REQUIRE(sequenceTracker.GetNumberOfDataBlocksUnique() == 3);
+        REQUIRE(sequenceTracker.GetNumberOfDataBlocksDuplicated() == 4);
+        REQUIRE(sequenceTracker.GetNumberOfDataBlocksOutOfOrder() == 0);
+        REQUIRE(sequenceTracker.GetNumberOfDataBlocksLost() == 0);
+    }
+
+    SECTION("Duplicates of late data blocks are detected")
+    {
+        const auto sequenceTracker = detail::Track({ 1, 3, 2, 2 });
+        REQUIRE(sequenceTracker.GetNumberOfDataBlocksOutOfOrder() == 1);
+        REQUIRE(sequenceTracker.GetNumberOfDataBlocksDuplicated() == 1);
+        REQUIRE(sequenceTracker.GetNumberOfDataBlocksLost() == 0);
+    }
+
+    SECTION("Sequence numbers are forgotten once they leave the window")
+    {
+        SequenceTracker sequenceTracker{};
+        for (uint64_t sequenceNumber = 1; sequenceNumber <= SequenceTracker::WindowSize * 2; sequenceNumber++) {
+            sequenceTracker.Record(sequenceNumber);
+        }
+        REQUIRE(sequenceTracker.GetNumberOfDataBlocksDuplicated() == 0);
+
+        // A data block within the window is recognized as a duplicate.
+        sequenceTracker.Record(SequenceTracker::WindowSize + 1);
+        REQUIRE(sequenceTracker.GetNumberOfDataBlocksDuplicated() == 1);
+
+        // A data block older than that is only known to be out of order.
+        sequenceTracker.Record(SequenceTracker::WindowSize);
+        REQUIRE(sequenceTracker.GetNumberOfDataBlocksDuplicated() == 1);
+        REQUIRE(sequenceTracker.GetNumberOfDataBlocksOutOfOrder() == 1);
+        REQUIRE(sequenceTracker.GetReorderDistanceMaximum() == SequenceTracker::WindowSize);
+    }
+
+    SECTION("Skipping more sequence numbers than the window holds doesn't report stale duplicates")
+    {
+        SequenceTracker sequenceTracker{};
+        sequenceTracker.Record(1);
+        sequenceTracker.Record(2);
+        sequenceTracker.Record(SequenceTracker::WindowSize + 3);
+        sequenceTracker.Record(SequenceTracker::WindowSize + 2);
+        REQUIRE(sequenceTracker.GetNumberOfDataBlocksDuplicated() == 0);
+        REQUIRE(sequenceTracker.GetNumberOfDataBlocksOutOfOrder() == 1);
+        REQUIRE(sequenceTracker.GetNumberOfDataBlocksLost() == SequenceTracker::WindowSize - 1);
+        REQUIRE(sequenceTracker.GetNumberOfGaps() == 1);
+    }
+}
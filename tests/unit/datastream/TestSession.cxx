@@ -0,0 +1,101 @@
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <microsoft/net/remote/datastream/Session.hxx>
+
+TEST_CASE("SessionStream records data transferred", "[datastream][session]")
+{
+    using namespace Microsoft::Net::Remote::DataStream;
+    using namespace std::chrono_literals;
+
+    const auto timeStart = SessionStream::Clock::now();
+
+    SECTION("No data transferred")
+    {
+        const SessionStream stream{ 1, SessionStreamDirection::Upload, timeStart };
+        const auto result = stream.GetResult();
+        REQUIRE(result.Id == 1);
+        REQUIRE(result.Direction == SessionStreamDirection::Upload);
+        REQUIRE(result.NumberOfBytesReceived == 0);
+        REQUIRE(result.GoodputBitsPerSecond == 0);
+        REQUIRE_FALSE(result.IsCompleted);
+    }
+
+    SECTION("Goodput spans from the start of the stream to the last data block")
+    {
+        SessionStream stream{ 1, SessionStreamDirection::Bidirectional, timeStart };
+        stream.RecordReceived(500, timeStart + 5ms);
+        stream.RecordSent(750, timeStart + 10ms);
+
+        const auto result = stream.GetResult();
+        REQUIRE(result.NumberOfDataBlocksReceived == 1);
+        REQUIRE(result.NumberOfBytesReceived == 500);
+        REQUIRE(result.NumberOfDataBlocksSent == 1);
+        REQUIRE(result.NumberOfBytesSent == 750);
+        REQUIRE(result.Duration == 10ms);
+        REQUIRE(result.GoodputBitsPerSecond == 1'000'000);
+    }
+
+    SECTION("No data is recorded once completed")
+    {
+        SessionStream stream{ 1, SessionStreamDirection::Download, timeStart };
+        stream.RecordSent(100, timeStart + 1ms);
+        stream.Complete();
+        stream.RecordSent(100, timeStart + 2ms);
+
+        const auto result = stream.GetResult();
+        REQUIRE(result.IsCompleted);
+        REQUIRE(result.NumberOfBytesSent == 100);
+        REQUIRE(result.Duration == 1ms);
+    }
+}
+
+TEST_CASE("Session aggregates results of its streams", "[datastream][session]")
+{
+    using namespace Microsoft::Net::Remote::DataStream;
+
+    SECTION("Streams are numbered in the order they are attached")
+    {
+        Session session{ "test" };
+        REQUIRE(session.GetId() == "test");
+        REQUIRE(session.AddStream(SessionStreamDirection::Upload)->GetResult().Id == 1);
+        REQUIRE(session.AddStream(SessionStreamDirection::Download)->GetResult().Id == 2);
+    }
+
+    SECTION("Totals include all streams")
+    {
+        Session session{ "test" };
+        auto streamUpload = session.AddStream(SessionStreamDirection::Upload);
+        auto streamDownload = session.AddStream(SessionStreamDirection::Download);
+        streamUpload->RecordReceived(1000);
+        streamDownload->RecordSent(2000);
+        streamDownload->Complete();
+
+        const auto result = session.GetResult();
+        REQUIRE(std::size(result.Streams) == 2);
+        REQUIRE(result.NumberOfBytesReceived == 1000);
+        REQUIRE(result.NumberOfBytesSent == 2000);
+        REQUIRE(result.NumberOfStreamsActive == 1);
+    }
+
+    SECTION("Attaching streams beyond the maximum fails")
+    {
+        Session session{ "test" };
+        for (std::size_t i = 0; i < Session::NumberOfStreamsMaximum; i++) {
+            REQUIRE(session.AddStream(SessionStreamDirection::Upload) != nullptr);
+        }
+        REQUIRE(session.AddStream(SessionStreamDirection::Upload) == nullptr);
+    }
+
+    SECTION("Fairness index ranges from 1/n to 1")
+    {
+        REQUIRE(Session::ComputeFairnessIndex({}) == 0);
+        REQUIRE(Session::ComputeFairnessIndex({ 0, 0 }) == 0);
+        REQUIRE(Session::ComputeFairnessIndex({ 100, 100, 100, 100 }) == 1.0);
+        REQUIRE(Session::ComputeFairnessIndex({ 100, 0, 0, 0 }) == 0.25);
+        REQUIRE(Session::ComputeFairnessIndex({ 300, 100 }) == 0.8);
+    }
+}
@@ -0,0 +1,78 @@
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <microsoft/net/remote/datastream/Session.hxx>
+#include <microsoft/net/remote/datastream/SessionManager.hxx>
+
+TEST_CASE("SessionManager removes idle sessions", "[datastream][session]")
+{
+    using namespace Microsoft::Net::Remote::DataStream;
+    using namespace std::chrono_literals;
+
+    static constexpr auto IdleTimeout{ 10s };
+
+    SessionManager sessionManager{ IdleTimeout };
+
+    SECTION("Sessions without streams are removed once the idle timeout elapses")
+    {
+        const auto session = sessionManager.Create();
+        REQUIRE(session != nullptr);
+
+        REQUIRE(sessionManager.RemoveIdle(SessionManager::Clock::now()) == 0);
+        REQUIRE(sessionManager.Find(session->GetId()) != nullptr);
+
+        REQUIRE(sessionManager.RemoveIdle(SessionManager::Clock::now() + IdleTimeout + 1s) == 1);
+        REQUIRE(sessionManager.Find(session->GetId()) == nullptr);
+    }
+
+    SECTION("Sessions with active streams are not removed")
+    {
+        const auto session = sessionManager.Create();
+        REQUIRE(session != nullptr);
+        const auto stream = session->AddStream(SessionStreamDirection::Upload);
+        REQUIRE(stream != nullptr);
+
+        REQUIRE(sessionManager.RemoveIdle(SessionManager::Clock::now() + IdleTimeout + 1s) == 0);
+        REQUIRE(sessionManager.Find(session->GetId()) != nullptr);
+
+        stream->Complete();
+        REQUIRE(sessionManager.RemoveIdle(SessionManager::Clock::now() + IdleTimeout + 1s) == 1);
+    }
+
+    SECTION("Sessions are idle from the last data transferred on their streams")
+    {
+        const auto session = sessionManager.Create();
+        REQUIRE(session != nullptr);
+        const auto stream = session->AddStream(SessionStreamDirection::Download);
+        REQUIRE(stream != nullptr);
+        const auto timeSent = SessionManager::Clock::now() + IdleTimeout;
+        stream->RecordSent(1000, timeSent);
+        stream->Complete();
+
+        REQUIRE(sessionManager.RemoveIdle(timeSent + 1s) == 0);
+        REQUIRE(sessionManager.RemoveIdle(timeSent + IdleTimeout + 1s) == 1);
+    }
+
+    SECTION("Abandoned sessions do not prevent new sessions from being created")
+    {
+        SessionManager sessionManagerNoTimeout{ 0s };
+
+        std::vector<std::shared_ptr<SessionStream>> streams{};
+        for (std::size_t i = 0; i < SessionManager::NumberOfSessionsMaximum; i++) {
+            const auto session = sessionManagerNoTimeout.Create();
+            REQUIRE(session != nullptr);
+            streams.push_back(session->AddStream(SessionStreamDirection::Upload));
+        }
+        REQUIRE(sessionManagerNoTimeout.Create() == nullptr);
+
+        // Simulate the clients exiting without removing their sessions.
+        for (const auto& stream : streams) {
+            stream->Complete();
+        }
+        REQUIRE(sessionManagerNoTimeout.Create() != nullptr);
+    }
+}
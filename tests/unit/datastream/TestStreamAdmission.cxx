@@ -0,0 +1,92 @@
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <microsoft/net/remote/datastream/StreamAdmission.hxx>
+
+TEST_CASE("StreamAdmission limits concurrent streams", "[datastream][admission]")
+{
+    using namespace Microsoft::Net::Remote::DataStream;
+
+    static constexpr uint32_t NumberOfStreamsMaximum{ 2 };
+    static constexpr std::size_t NumberOfBytesInFlightMaximum{ 1000 };
+
+    StreamAdmission streamAdmission{ StreamAdmissionConfiguration{ .NumberOfStreamsMaximum = NumberOfStreamsMaximum, .NumberOfBytesInFlightMaximum = NumberOfBytesInFlightMaximum } };
+
+    SECTION("Streams beyond the maximum are rejected until another is released")
+    {
+        auto ticket1 = streamAdmission.TryAdmit();
+        auto ticket2 = streamAdmission.TryAdmit();
+        REQUIRE(ticket1.has_value());
+        REQUIRE(ticket2.has_value());
+        REQUIRE(streamAdmission.GetNumberOfStreams() == NumberOfStreamsMaximum);
+        REQUIRE_FALSE(streamAdmission.TryAdmit().has_value());
+        REQUIRE(streamAdmission.GetNumberOfStreamsRejected() == 1);
+
+        ticket1.reset();
+        REQUIRE(streamAdmission.GetNumberOfStreams() == 1);
+        REQUIRE(streamAdmission.TryAdmit().has_value());
+    }
+
+    SECTION("Bytes in flight are reserved within the budget and released with the ticket")
+    {
+        auto ticket1 = streamAdmission.TryAdmit();
+        auto ticket2 = streamAdmission.TryAdmit();
+        REQUIRE(ticket1->TryReserve(600));
+        REQUIRE_FALSE(ticket2->TryReserve(600));
+        REQUIRE(ticket2->TryReserve(400));
+        REQUIRE(ticket2->GetNumberOfBytesReserved() == 400);
+        REQUIRE(streamAdmission.GetNumberOfBytesInFlight() == NumberOfBytesInFlightMaximum);
+        REQUIRE(streamAdmission.GetNumberOfStreamsRejected() == 1);
+
+        ticket1.reset();
+        REQUIRE(streamAdmission.GetNumberOfBytesInFlight() == 400);
+        REQUIRE(ticket2->TryReserve(600));
+    }
+
+    SECTION("Moving a ticket transfers the admission")
+    {
+        auto ticket = streamAdmission.TryAdmit();
+        REQUIRE(ticket->TryReserve(100));
+
+        StreamAdmissionTicket ticketMoved{ std::move(ticket.value()) };
+        ticket.reset();
+        REQUIRE(streamAdmission.GetNumberOfStreams() == 1);
+        REQUIRE(streamAdmission.GetNumberOfBytesInFlight() == 100);
+        REQUIRE(ticketMoved.GetNumberOfBytesReserved() == 100);
+
+        ticketMoved = StreamAdmissionTicket{};
+        REQUIRE(streamAdmission.GetNumberOfStreams() == 0);
+        REQUIRE(streamAdmission.GetNumberOfBytesInFlight() == 0);
+    }
+
+    SECTION("Empty tickets cannot reserve bytes")
+    {
+        StreamAdmissionTicket ticket{};
+        REQUIRE_FALSE(ticket.TryReserve(1));
+    }
+}
+
+TEST_CASE("StreamAdmission without limits admits all streams", "[datastream][admission]")
+{
+    using namespace Microsoft::Net::Remote::DataStream;
+
+    StreamAdmission streamAdmission{};
+
+    static constexpr uint32_t NumberOfStreams{ 100 };
+
+    std::vector<StreamAdmissionTicket> tickets{};
+    for (uint32_t i = 0; i < NumberOfStreams; i++) {
+        auto ticket = streamAdmission.TryAdmit();
+        REQUIRE(ticket.has_value());
+        REQUIRE(ticket->TryReserve(1024 * 1024));
+        tickets.push_back(std::move(ticket.value()));
+    }
+
+    REQUIRE(streamAdmission.GetNumberOfStreams() == NumberOfStreams);
+    REQUIRE(streamAdmission.GetNumberOfStreamsRejected() == 0);
+}
@@ -0,0 +1,61 @@
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <microsoft/net/remote/datastream/Histogram.hxx>
+#include <microsoft/net/remote/datastream/StreamMetrics.hxx>
+
+TEST_CASE("StreamMetrics aggregates the metrics of streams", "[datastream][metrics]")
+{
+    using namespace Microsoft::Net::Remote::DataStream;
+
+    StreamMetrics streamMetrics{};
+
+    SECTION("No streams recorded")
+    {
+        REQUIRE(streamMetrics.GetNumberOfStreams() == 0);
+        REQUIRE(streamMetrics.GetWriteCompletionLatency().GetCount() == 0);
+    }
+
+    SECTION("Write completion latencies of streams are merged")
+    {
+        Histogram writeCompletionLatency1{};
+        writeCompletionLatency1.Record(1);
+        writeCompletionLatency1.Record(2);
+        Histogram writeCompletionLatency2{};
+        writeCompletionLatency2.Record(1000);
+
+        streamMetrics.RecordWriteCompletionLatency(writeCompletionLatency1);
+        streamMetrics.RecordWriteCompletionLatency(writeCompletionLatency2);
+
+        const auto writeCompletionLatency = streamMetrics.GetWriteCompletionLatency();
+        REQUIRE(streamMetrics.GetNumberOfStreams() == 2);
+        REQUIRE(writeCompletionLatency.GetCount() == 3);
+        REQUIRE(writeCompletionLatency.GetMinimum() == 1);
+        REQUIRE(writeCompletionLatency.GetMaximum() == 1000);
+    }
+
+    SECTION("Streams may be recorded concurrently")
+    {
+        static constexpr uint32_t NumberOfThreads{ 4 };
+        static constexpr uint32_t NumberOfStreamsPerThread{ 100 };
+
+        Histogram writeCompletionLatency{};
+        writeCompletionLatency.Record(10);
+
+        std::vector<std::jthread> threads{};
+        for (uint32_t i = 0; i < NumberOfThreads; i++) {
+            threads.emplace_back([&] {
+                for (uint32_t j = 0; j < NumberOfStreamsPerThread; j++) {
+                    streamMetrics.RecordWriteCompletionLatency(writeCompletionLatency);
+                }
+            });
+        }
+        threads.clear();
+
+        REQUIRE(streamMetrics.GetNumberOfStreams() == NumberOfThreads * NumberOfStreamsPerThread);
+        REQUIRE(streamMetrics.GetWriteCompletionLatency().GetCount() == NumberOfThreads * NumberOfStreamsPerThread);
+    }
+}
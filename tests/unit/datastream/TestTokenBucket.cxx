@@ -0,0 +1,51 @@
+
+#include <chrono>
+
+#include <catch2/catch_test_macros.hpp>
+#include <microsoft/net/remote/datastream/TokenBucket.hxx>
+
+TEST_CASE("TokenBucket paces reservations to the token rate", "[datastream][pacing]")
+{
+    using namespace Microsoft::Net::Remote::DataStream;
+    using namespace std::chrono_literals;
+
+    const auto timeStart = TokenBucket::Clock::now();
+
+    SECTION("Reservations within capacity are available immediately")
+    {
+        TokenBucket tokenBucket{ 1000, 100, timeStart };
+        REQUIRE(tokenBucket.Reserve(50, timeStart) == timeStart);
+        REQUIRE(tokenBucket.Reserve(50, timeStart) == timeStart);
+    }
+
+    SECTION("Reservations exceeding available tokens are delayed until the debt is repaid")
+    {
+        TokenBucket tokenBucket{ 1000, 100, timeStart };
+        REQUIRE(tokenBucket.Reserve(100, timeStart) == timeStart);
+        REQUIRE(tokenBucket.Reserve(100, timeStart) == timeStart + 100ms);
+        REQUIRE(tokenBucket.Reserve(100, timeStart + 100ms) == timeStart + 200ms);
+    }
+
+    SECTION("Tokens accumulate over time up to the capacity")
+    {
+        TokenBucket tokenBucket{ 1000, 100, timeStart };
+        REQUIRE(tokenBucket.Reserve(100, timeStart) == timeStart);
+
+        // 10s worth of tokens is capped at the capacity, so only one burst of 100 is available.
+        const auto timeLater = timeStart + 10s;
+        REQUIRE(tokenBucket.Reserve(100, timeLater) == timeLater);
+        REQUIRE(tokenBucket.Reserve(1, timeLater) == timeLater + 1ms);
+    }
+
+    SECTION("Sustained reservations converge to the token rate")
+    {
+        TokenBucket tokenBucket{ 1000, 10, timeStart };
+        auto timeNext = timeStart;
+        for (int i = 0; i < 100; i++) {
+            timeNext = tokenBucket.Reserve(10, timeNext);
+        }
+
+        // The first reservation is covered by the initial capacity; the remaining 99 take 10ms each.
+        REQUIRE(timeNext == timeStart + 990ms);
+    }
+}
@@ -1,4 +1,5 @@
 
+#include <Wpa/HostapdEvent.hxx>
 #include <Wpa/ProtocolHostapd.hxx>
 #include <catch2/catch_test_macros.hpp>
 
@@ -13,3 +14,57 @@ TEST_CASE("Test WpaKeyManagement conversions (root)", "[wpa][hostapd][client]")
         }
     }
 }
+
+TEST_CASE("Parse hostapd events", "[wpa][hostapd][client]")
+{
+    using namespace Wpa;
+
+    SECTION("Access point state events are interpreted")
+    {
+        auto hostapdEvent = HostapdEvent::Parse(ProtocolHostapd::EventPayloadApEnabled);
+        REQUIRE(hostapdEvent.has_value());
+        REQUIRE(hostapdEvent->Type == HostapdEventType::ApEnabled);
+
+        hostapdEvent = HostapdEvent::Parse(ProtocolHostapd::EventPayloadApDisabled);
+        REQUIRE(hostapdEvent.has_value());
+        REQUIRE(hostapdEvent->Type == HostapdEventType::ApDisabled);
+    }
+
+    SECTION("Station events are interpreted with the station mac address")
+    {
+        auto hostapdEvent = HostapdEvent::Parse("AP-STA-CONNECTED 00:11:22:33:44:55");
+        REQUIRE(hostapdEvent.has_value());
+        REQUIRE(hostapdEvent->Type == HostapdEventType::StationConnected);
+        REQUIRE(hostapdEvent->StationMacAddress == "00:11:22:33:44:55");
+
+        hostapdEvent = HostapdEvent::Parse("AP-STA-DISCONNECTED 00:11:22:33:44:55");
+        REQUIRE(hostapdEvent.has_value());
+        REQUIRE(hostapdEvent->Type == HostapdEventType::StationDisconnected);
+        REQUIRE(hostapdEvent->StationMacAddress == "00:11:22:33:44:55");
+    }
+
+    SECTION("Station events with additional arguments are interpreted")
+    {
+        const auto hostapdEvent = HostapdEvent::Parse("AP-STA-CONNECTED 00:11:22:33:44:55 keyid=1");
+        REQUIRE(hostapdEvent.has_value());
+        REQUIRE(hostapdEvent->Type == HostapdEventType::StationConnected);
+        REQUIRE(hostapdEvent->StationMacAddress == "00:11:22:33:44:55");
+    }
+
+    SECTION("Station events without a station mac address are not interpreted")
+    {
+        REQUIRE_FALSE(HostapdEvent::Parse(ProtocolHostapd::EventPayloadStationConnected).has_value());
+        REQUIRE_FALSE(HostapdEvent::Parse("AP-STA-DISCONNECTED ").has_value());
+    }
+
+    SECTION("Events with a common prefix are not confused")
+    {
+        REQUIRE_FALSE(HostapdEvent::Parse("AP-ENABLED-FOO").has_value());
+    }
+
+    SECTION("Other events are not interpreted")
+    {
+        REQUIRE_FALSE(HostapdEvent::Parse("CTRL-EVENT-EAP-STARTED 00:11:22:33:44:55").has_value());
+        REQUIRE_FALSE(HostapdEvent::Parse("").has_value());
+    }
+}
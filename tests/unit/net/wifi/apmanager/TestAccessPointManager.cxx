@@ -1,11 +1,17 @@
 
 #include <memory>
+#include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include <catch2/catch_test_macros.hpp>
 #include <microsoft/net/wifi/AccessPointDiscoveryAgent.hxx>
 #include <microsoft/net/wifi/AccessPointManager.hxx>
+#include <microsoft/net/wifi/AccessPointOperationStatus.hxx>
+#include <microsoft/net/wifi/IAccessPoint.hxx>
+#include <microsoft/net/wifi/Ieee80211.hxx>
+#include <microsoft/net/wifi/test/AccessPointTest.hxx>
 
 #include "AccessPointDiscoveryAgentOperationsTest.hxx"
 
@@ -162,3 +168,184 @@ TEST_CASE("AccessPointManager discards access points reported to have departed b
         REQUIRE(std::empty(accessPointsAll));
     }
 }
+
+TEST_CASE("AccessPointManager reports access point changes to registered callbacks", "[wifi][core][apmanager]")
+{
+    using namespace Microsoft::Net::Wifi;
+    using Test::AccessPointDiscoveryAgentOperationsTest;
+
+    std::string_view accessPointInterfaceName{ "accessPointTest" };
+
+    auto accessPointDiscoveryAgentOperationsTest{ std::make_unique<AccessPointDiscoveryAgentOperationsTest>() };
+    auto* accessPointDiscoveryAgentOperationsTestPtr{ accessPointDiscoveryAgentOperationsTest.get() };
+    auto accessPointDiscoveryAgentTest{ AccessPointDiscoveryAgent::Create(std::move(accessPointDiscoveryAgentOperationsTest)) };
+
+    auto accessPointManager{ AccessPointManager::Create() };
+    accessPointManager->AddDiscoveryAgent(std::move(accessPointDiscoveryAgentTest));
+
+    std::vector<std::pair<AccessPointChange, std::string>> accessPointChanges{};
+    const auto accessPointChangedCallbackToken = accessPointManager->RegisterAccessPointChangedCallback([&](AccessPointChange change, const std::shared_ptr<IAccessPoint>& accessPoint) {
+        accessPointChanges.emplace_back(change, accessPoint->GetInterfaceName());
+    });
+
+    SECTION("Arrival and departure of an access point are reported")
+    {
+        accessPointDiscoveryAgentOperationsTestPtr->AddAccessPoint(accessPointInterfaceName);
+        accessPointDiscoveryAgentOperationsTestPtr->RemoveAccessPoint(accessPointInterfaceName);
+
+        REQUIRE(std::size(accessPointChanges) == 2);
+        REQUIRE(accessPointChanges[0] == std::pair{ AccessPointChange::Added, std::string(accessPointInterfaceName) });
+        REQUIRE(accessPointChanges[1] == std::pair{ AccessPointChange::Removed, std::string(accessPointInterfaceName) });
+    }
+
+    SECTION("Operational state changes of an access point are reported")
+    {
+        accessPointDiscoveryAgentOperationsTestPtr->AddAccessPoint(accessPointInterfaceName);
+        auto accessPoint{ accessPointManager->GetAccessPoint(accessPointInterfaceName).value().lock() };
+        auto accessPointController{ accessPoint->CreateController() };
+
+        REQUIRE(accessPointController->SetOperationalState(AccessPointOperationalState::Enabled));
+        REQUIRE(accessPointController->SetOperationalState(AccessPointOperationalState::Disabled));
+
+        REQUIRE(std::size(accessPointChanges) == 3);
+        REQUIRE(accessPointChanges[1].first == AccessPointChange::Enabled);
+        REQUIRE(accessPointChanges[2].first == AccessPointChange::Disabled);
+    }
+
+    SECTION("Operational state changes of a removed access point are not reported")
+    {
+        accessPointDiscoveryAgentOperationsTestPtr->AddAccessPoint(accessPointInterfaceName);
+        auto accessPoint{ accessPointManager->GetAccessPoint(accessPointInterfaceName).value().lock() };
+        accessPointDiscoveryAgentOperationsTestPtr->RemoveAccessPoint(accessPointInterfaceName);
+
+        REQUIRE(accessPoint->CreateController()->SetOperationalState(AccessPointOperationalState::Enabled));
+        REQUIRE(std::size(accessPointChanges) == 2);
+    }
+
+    SECTION("Changes are not reported after the callback is unregistered")
+    {
+        accessPointManager->UnregisterAccessPointChangedCallback(accessPointChangedCallbackToken);
+        accessPointDiscoveryAgentOperationsTestPtr->AddAccessPoint(accessPointInterfaceName);
+
+        REQUIRE(std::empty(accessPointChanges));
+    }
+}
+
+TEST_CASE("AccessPointManager reports station changes to registered callbacks", "[wifi][core][apmanager]")
+{
+    using namespace Microsoft::Net::Wifi;
+    using Test::AccessPointDiscoveryAgentOperationsTest;
+    using Test::AccessPointTest;
+
+    std::string_view accessPointInterfaceName{ "accessPointTest" };
+    constexpr Ieee80211MacAddress StationMacAddress{ 0x00, 0x11, 0x22, 0x33, 0x44, 0x55 };
+
+    auto accessPointDiscoveryAgentOperationsTest{ std::make_unique<AccessPointDiscoveryAgentOperationsTest>() };
+    auto* accessPointDiscoveryAgentOperationsTestPtr{ accessPointDiscoveryAgentOperationsTest.get() };
+    auto accessPointDiscoveryAgentTest{ AccessPointDiscoveryAgent::Create(std::move(accessPointDiscoveryAgentOperationsTest)) };
+
+    auto accessPointManager{ AccessPointManager::Create() };
+    accessPointManager->AddDiscoveryAgent(std::move(accessPointDiscoveryAgentTest));
+    accessPointDiscoveryAgentOperationsTestPtr->AddAccessPoint(accessPointInterfaceName);
+    auto accessPoint{ std::dynamic_pointer_cast<AccessPointTest>(accessPointManager->GetAccessPoint(accessPointInterfaceName).value().lock()) };
+    REQUIRE(accessPoint != nullptr);
+
+    // Register two callbacks to verify changes are delivered to each of them.
+    std::vector<std::pair<AccessPointStationChange, std::string>> stationChanges1{};
+    std::vector<std::pair<AccessPointStationChange, std::string>> stationChanges2{};
+    const auto stationChangedCallbackToken1 = accessPointManager->RegisterStationChangedCallback([&](AccessPointStationChange change, const Ieee80211MacAddress& stationMacAddress, const std::shared_ptr<IAccessPoint>& accessPoint) {
+        REQUIRE(stationMacAddress == StationMacAddress);
+        stationChanges1.emplace_back(change, accessPoint->GetInterfaceName());
+    });
+    accessPointManager->RegisterStationChangedCallback([&](AccessPointStationChange change, [[maybe_unused]] const Ieee80211MacAddress& stationMacAddress, const std::shared_ptr<IAccessPoint>& accessPoint) {
+        stationChanges2.emplace_back(change, accessPoint->GetInterfaceName());
+    });
+
+    SECTION("Station connection and disconnection are reported to all callbacks")
+    {
+        accessPoint->OnStationChanged(AccessPointStationChange::Connected, StationMacAddress);
+        accessPoint->OnStationChanged(AccessPointStationChange::Disconnected, StationMacAddress);
+
+        const std::vector<std::pair<AccessPointStationChange, std::string>> stationChangesExpected{
+            { AccessPointStationChange::Connected, std::string(accessPointInterfaceName) },
+            { AccessPointStationChange::Disconnected, std::string(accessPointInterfaceName) },
+        };
+        REQUIRE(stationChanges1 == stationChangesExpected);
+        REQUIRE(stationChanges2 == stationChangesExpected);
+    }
+
+    SECTION("Station changes of a removed access point are not reported")
+    {
+        accessPointDiscoveryAgentOperationsTestPtr->RemoveAccessPoint(accessPointInterfaceName);
+        accessPoint->OnStationChanged(AccessPointStationChange::Connected, StationMacAddress);
+
+        REQUIRE(std::empty(stationChanges1));
+        REQUIRE(std::empty(stationChanges2));
+    }
+
+    SECTION("Station changes are not reported after the callback is unregistered")
+    {
+        accessPointManager->UnregisterStationChangedCallback(stationChangedCallbackToken1);
+        accessPoint->OnStationChanged(AccessPointStationChange::Connected, StationMacAddress);
+
+        REQUIRE(std::empty(stationChanges1));
+        REQUIRE(std::size(stationChanges2) == 1);
+    }
+}
+
+TEST_CASE("AccessPointManager only sets access point callbacks while callbacks are registered", "[wifi][core][apmanager]")
+{
+    using namespace Microsoft::Net::Wifi;
+    using Test::AccessPointDiscoveryAgentOperationsTest;
+    using Test::AccessPointTest;
+
+    std::string_view accessPointInterfaceName{ "accessPointTest" };
+    std::string_view accessPointInterfaceName2{ "accessPointTest2" };
+
+    auto accessPointDiscoveryAgentOperationsTest{ std::make_unique<AccessPointDiscoveryAgentOperationsTest>() };
+    auto* accessPointDiscoveryAgentOperationsTestPtr{ accessPointDiscoveryAgentOperationsTest.get() };
+    auto accessPointDiscoveryAgentTest{ AccessPointDiscoveryAgent::Create(std::move(accessPointDiscoveryAgentOperationsTest)) };
+
+    auto accessPointManager{ AccessPointManager::Create() };
+    accessPointManager->AddDiscoveryAgent(std::move(accessPointDiscoveryAgentTest));
+    accessPointDiscoveryAgentOperationsTestPtr->AddAccessPoint(accessPointInterfaceName);
+    auto accessPoint{ std::dynamic_pointer_cast<AccessPointTest>(accessPointManager->GetAccessPoint(accessPointInterfaceName).value().lock()) };
+    REQUIRE(accessPoint != nullptr);
+
+    SECTION("Callbacks are not set without registered callbacks")
+    {
+        REQUIRE_FALSE(accessPoint->HasOperationalStateChangedCallback());
+        REQUIRE_FALSE(accessPoint->HasStationChangedCallback());
+    }
+
+    SECTION("Operational state changed callbacks are set while access point changed callbacks are registered")
+    {
+        const auto accessPointChangedCallbackToken1 = accessPointManager->RegisterAccessPointChangedCallback([](AccessPointChange, const std::shared_ptr<IAccessPoint>&) {});
+        const auto accessPointChangedCallbackToken2 = accessPointManager->RegisterAccessPointChangedCallback([](AccessPointChange, const std::shared_ptr<IAccessPoint>&) {});
+        REQUIRE(accessPoint->HasOperationalStateChangedCallback());
+        REQUIRE_FALSE(accessPoint->HasStationChangedCallback());
+
+        // Access points added while callbacks are registered get them too.
+        accessPointDiscoveryAgentOperationsTestPtr->AddAccessPoint(accessPointInterfaceName2);
+        auto accessPoint2{ std::dynamic_pointer_cast<AccessPointTest>(accessPointManager->GetAccessPoint(accessPointInterfaceName2).value().lock()) };
+        REQUIRE(accessPoint2 != nullptr);
+        REQUIRE(accessPoint2->HasOperationalStateChangedCallback());
+
+        accessPointManager->UnregisterAccessPointChangedCallback(accessPointChangedCallbackToken1);
+        REQUIRE(accessPoint->HasOperationalStateChangedCallback());
+
+        accessPointManager->UnregisterAccessPointChangedCallback(accessPointChangedCallbackToken2);
+        REQUIRE_FALSE(accessPoint->HasOperationalStateChangedCallback());
+        REQUIRE_FALSE(accessPoint2->HasOperationalStateChangedCallback());
+    }
+
+    SECTION("Station changed callbacks are set while station changed callbacks are registered")
+    {
+        const auto stationChangedCallbackToken = accessPointManager->RegisterStationChangedCallback([](AccessPointStationChange, const Ieee80211MacAddress&, const std::shared_ptr<IAccessPoint>&) {});
+        REQUIRE(accessPoint->HasStationChangedCallback());
+        REQUIRE_FALSE(accessPoint->HasOperationalStateChangedCallback());
+
+        accessPointManager->UnregisterStationChangedCallback(stationChangedCallbackToken);
+        REQUIRE_FALSE(accessPoint->HasStationChangedCallback());
+    }
+}
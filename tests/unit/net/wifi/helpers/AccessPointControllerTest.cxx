@@ -68,7 +68,12 @@ AccessPointControllerTest::SetOperationalState(AccessPointOperationalState opera
         return AccessPointOperationStatus::InvalidAccessPoint("null AccessPoint");
     }
 
+    const bool operationalStateChanged{ AccessPoint->OperationalState != operationalState };
     AccessPoint->OperationalState = operationalState;
+    if (operationalStateChanged) {
+        AccessPoint->OnOperationalStateChanged(operationalState);
+    }
+
     return AccessPointOperationStatus::MakeSucceeded(AccessPoint->InterfaceName);
 }
 
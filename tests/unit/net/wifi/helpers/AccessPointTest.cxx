@@ -1,4 +1,5 @@
 #include <memory>
+#include <mutex>
 #include <string_view>
 #include <utility>
 
@@ -42,6 +43,52 @@ AccessPointTest::CreateController()
     return std::make_unique<AccessPointControllerTest>(this);
 }
 
+void
+AccessPointTest::SetOperationalStateChangedCallback(AccessPointOperationalStateChangedCallback operationalStateChangedCallback)
+{
+    const std::scoped_lock operationalStateChangedCallbackLock{ m_operationalStateChangedCallbackGate };
+    m_operationalStateChangedCallback = std::move(operationalStateChangedCallback);
+}
+
+void
+AccessPointTest::OnOperationalStateChanged(AccessPointOperationalState operationalState)
+{
+    const std::scoped_lock operationalStateChangedCallbackLock{ m_operationalStateChangedCallbackGate };
+    if (m_operationalStateChangedCallback) {
+        m_operationalStateChangedCallback(operationalState);
+    }
+}
+
+bool
+AccessPointTest::HasOperationalStateChangedCallback()
+{
+    const std::scoped_lock operationalStateChangedCallbackLock{ m_operationalStateChangedCallbackGate };
+    return (m_operationalStateChangedCallback != nullptr);
+}
+
+void
+AccessPointTest::SetStationChangedCallback(AccessPointStationChangedCallback stationChangedCallback)
+{
+    const std::scoped_lock stationChangedCallbackLock{ m_stationChangedCallbackGate };
+    m_stationChangedCallback = std::move(stationChangedCallback);
+}
+
+void
+AccessPointTest::OnStationChanged(AccessPointStationChange change, const Ieee80211MacAddress& stationMacAddress)
+{
+    const std::scoped_lock stationChangedCallbackLock{ m_stationChangedCallbackGate };
+    if (m_stationChangedCallback) {
+        m_stationChangedCallback(change, stationMacAddress);
+    }
+}
+
+bool
+AccessPointTest::HasStationChangedCallback()
+{
+    const std::scoped_lock stationChangedCallbackLock{ m_stationChangedCallbackGate };
+    return (m_stationChangedCallback != nullptr);
+}
+
 std::shared_ptr<IAccessPoint>
 AccessPointFactoryTest::Create(std::string_view interfaceName, [[maybe_unused]] std::unique_ptr<IAccessPointCreateArgs> createArgs)
 {
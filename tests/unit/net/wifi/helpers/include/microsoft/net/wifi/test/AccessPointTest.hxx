@@ -3,6 +3,7 @@
 #define ACCESS_POINT_TEST_HXX
 
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -98,6 +99,65 @@ struct AccessPointTest final :
      */
     std::unique_ptr<IAccessPointController>
     CreateController() override;
+
+    /**
+     * @brief Set the callback to invoke when the operational state of the access point changes.
+     *
+     * @param operationalStateChangedCallback The callback to invoke, or nullptr to stop invoking a callback.
+     */
+    void
+    SetOperationalStateChangedCallback(AccessPointOperationalStateChangedCallback operationalStateChangedCallback) override;
+
+    /**
+     * @brief Invoke the operational state changed callback, if one is set. This emulates the notification a real
+     * access point raises when its operational state changes.
+     *
+     * @param operationalState The new operational state.
+     */
+    void
+    OnOperationalStateChanged(AccessPointOperationalState operationalState);
+
+    /**
+     * @brief Determine whether an operational state changed callback is set.
+     *
+     * @return true If a callback is set.
+     * @return false Otherwise.
+     */
+    bool
+    HasOperationalStateChangedCallback();
+
+    /**
+     * @brief Set the callback to invoke when a station connects to or disconnects from the access point.
+     *
+     * @param stationChangedCallback The callback to invoke, or nullptr to stop invoking a callback.
+     */
+    void
+    SetStationChangedCallback(AccessPointStationChangedCallback stationChangedCallback) override;
+
+    /**
+     * @brief Invoke the station changed callback, if one is set. This emulates the notification a real access point
+     * raises when a station connects or disconnects.
+     *
+     * @param change The kind of change.
+     * @param stationMacAddress The mac address of the station.
+     */
+    void
+    OnStationChanged(AccessPointStationChange change, const Ieee80211MacAddress& stationMacAddress);
+
+    /**
+     * @brief Determine whether a station changed callback is set.
+     *
+     * @return true If a callback is set.
+     * @return false Otherwise.
+     */
+    bool
+    HasStationChangedCallback();
+
+private:
+    std::mutex m_operationalStateChangedCallbackGate;
+    AccessPointOperationalStateChangedCallback m_operationalStateChangedCallback{ nullptr };
+    std::mutex m_stationChangedCallbackGate;
+    AccessPointStationChangedCallback m_stationChangedCallback{ nullptr };
 };
 
 /**